@@ -291,15 +291,11 @@ namespace Org.Whatever.QtTesting
             }
             public void SetMaximum(int value)
             {
-                NativeImplClient.PushInt32(value);
-                Handle__Push(this);
-                NativeImplClient.InvokeModuleMethod(_handle_setMaximum);
+                FastCalls.fast_AbstractSlider_Handle_setMaximum(NativeHandle, value);
             }
             public void SetMinimum(int value)
             {
-                NativeImplClient.PushInt32(value);
-                Handle__Push(this);
-                NativeImplClient.InvokeModuleMethod(_handle_setMinimum);
+                FastCalls.fast_AbstractSlider_Handle_setMinimum(NativeHandle, value);
             }
             public void SetOrientation(Orientation orient)
             {
@@ -327,9 +323,7 @@ namespace Org.Whatever.QtTesting
             }
             public void SetSliderPosition(int pos)
             {
-                NativeImplClient.PushInt32(pos);
-                Handle__Push(this);
-                NativeImplClient.InvokeModuleMethod(_handle_setSliderPosition);
+                FastCalls.fast_AbstractSlider_Handle_setSliderPosition(NativeHandle, pos);
             }
             public void SetTracking(bool value)
             {
@@ -339,16 +333,11 @@ namespace Org.Whatever.QtTesting
             }
             public void SetValue(int value)
             {
-                NativeImplClient.PushInt32(value);
-                Handle__Push(this);
-                NativeImplClient.InvokeModuleMethod(_handle_setValue);
+                FastCalls.fast_AbstractSlider_Handle_setValue(NativeHandle, value);
             }
             public void SetRange(int min, int max)
             {
-                NativeImplClient.PushInt32(max);
-                NativeImplClient.PushInt32(min);
-                Handle__Push(this);
-                NativeImplClient.InvokeModuleMethod(_handle_setRange);
+                FastCalls.fast_AbstractSlider_Handle_setRange(NativeHandle, min, max);
             }
         }
 
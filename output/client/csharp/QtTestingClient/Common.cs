@@ -23,17 +23,16 @@ namespace Org.Whatever.QtTesting
             }
         }
 
+        internal static int Point__TypeId;
+
         internal static void Point__Push(Point value, bool isReturn)
         {
-            NativeImplClient.PushInt32(value.Y);
-            NativeImplClient.PushInt32(value.X);
+            NativeImplClient.PushStruct(Point__TypeId, value);
         }
 
         internal static Point Point__Pop()
         {
-            var x = NativeImplClient.PopInt32();
-            var y = NativeImplClient.PopInt32();
-            return new Point(x, y);
+            return NativeImplClient.PopStruct<Point>(Point__TypeId);
         }
         public struct PointF {
             public double X;
@@ -45,17 +44,16 @@ namespace Org.Whatever.QtTesting
             }
         }
 
+        internal static int PointF__TypeId;
+
         internal static void PointF__Push(PointF value, bool isReturn)
         {
-            NativeImplClient.PushDouble(value.Y);
-            NativeImplClient.PushDouble(value.X);
+            NativeImplClient.PushStruct(PointF__TypeId, value);
         }
 
         internal static PointF PointF__Pop()
         {
-            var x = NativeImplClient.PopDouble();
-            var y = NativeImplClient.PopDouble();
-            return new PointF(x, y);
+            return NativeImplClient.PopStruct<PointF>(PointF__TypeId);
         }
         public struct Size {
             public int Width;
@@ -67,17 +65,16 @@ namespace Org.Whatever.QtTesting
             }
         }
 
+        internal static int Size__TypeId;
+
         internal static void Size__Push(Size value, bool isReturn)
         {
-            NativeImplClient.PushInt32(value.Height);
-            NativeImplClient.PushInt32(value.Width);
+            NativeImplClient.PushStruct(Size__TypeId, value);
         }
 
         internal static Size Size__Pop()
         {
-            var width = NativeImplClient.PopInt32();
-            var height = NativeImplClient.PopInt32();
-            return new Size(width, height);
+            return NativeImplClient.PopStruct<Size>(Size__TypeId);
         }
         public struct Rect {
             public int X;
@@ -93,21 +90,16 @@ namespace Org.Whatever.QtTesting
             }
         }
 
+        internal static int Rect__TypeId;
+
         internal static void Rect__Push(Rect value, bool isReturn)
         {
-            NativeImplClient.PushInt32(value.Height);
-            NativeImplClient.PushInt32(value.Width);
-            NativeImplClient.PushInt32(value.Y);
-            NativeImplClient.PushInt32(value.X);
+            NativeImplClient.PushStruct(Rect__TypeId, value);
         }
 
         internal static Rect Rect__Pop()
         {
-            var x = NativeImplClient.PopInt32();
-            var y = NativeImplClient.PopInt32();
-            var width = NativeImplClient.PopInt32();
-            var height = NativeImplClient.PopInt32();
-            return new Rect(x, y, width, height);
+            return NativeImplClient.PopStruct<Rect>(Rect__TypeId);
         }
         public struct RectF {
             public double X;
@@ -123,27 +115,27 @@ namespace Org.Whatever.QtTesting
             }
         }
 
+        internal static int RectF__TypeId;
+
         internal static void RectF__Push(RectF value, bool isReturn)
         {
-            NativeImplClient.PushDouble(value.Height);
-            NativeImplClient.PushDouble(value.Width);
-            NativeImplClient.PushDouble(value.Y);
-            NativeImplClient.PushDouble(value.X);
+            NativeImplClient.PushStruct(RectF__TypeId, value);
         }
 
         internal static RectF RectF__Pop()
         {
-            var x = NativeImplClient.PopDouble();
-            var y = NativeImplClient.PopDouble();
-            var width = NativeImplClient.PopDouble();
-            var height = NativeImplClient.PopDouble();
-            return new RectF(x, y, width, height);
+            return NativeImplClient.PopStruct<RectF>(RectF__TypeId);
         }
 
         internal static void __Init()
         {
             _module = NativeImplClient.GetModule("Common");
             // assign module handles
+            Point__TypeId = NativeImplClient.GetStructType<Point>(_module, "Point");
+            PointF__TypeId = NativeImplClient.GetStructType<PointF>(_module, "PointF");
+            Size__TypeId = NativeImplClient.GetStructType<Size>(_module, "Size");
+            Rect__TypeId = NativeImplClient.GetStructType<Rect>(_module, "Rect");
+            RectF__TypeId = NativeImplClient.GetStructType<RectF>(_module, "RectF");
 
             // no static init
         }
@@ -0,0 +1,61 @@
+using System.Runtime.InteropServices;
+
+namespace Org.Whatever.QtTesting;
+
+// the server's typed entry points for @fastcall methods (see FastCallExport.h on the server side):
+// arguments straight through, nothing pushed or popped. handles go as their native pointers, structs spread out into their fields
+internal static partial class FastCalls
+{
+    // Widget
+    [LibraryImport("QtTestingServer")]
+    [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
+    internal static partial void fast_Widget_Handle_setGeometry_overload1(IntPtr _this, int x, int y, int width, int height);
+
+    [LibraryImport("QtTestingServer")]
+    [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
+    internal static partial void fast_Widget_Handle_update(IntPtr _this);
+
+    // ModelIndex
+    [LibraryImport("QtTestingServer")]
+    [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
+    internal static partial int fast_ModelIndex_Handle_row(IntPtr _this);
+
+    [LibraryImport("QtTestingServer")]
+    [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
+    internal static partial int fast_ModelIndex_Handle_column(IntPtr _this);
+
+    // Painter
+    [LibraryImport("QtTestingServer")]
+    [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
+    internal static partial void fast_Painter_Handle_fillRect(IntPtr _this, int rect_x, int rect_y, int rect_width, int rect_height, IntPtr brush);
+
+    [LibraryImport("QtTestingServer")]
+    [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
+    internal static partial void fast_Painter_Handle_fillRect_overload1(IntPtr _this, int rect_x, int rect_y, int rect_width, int rect_height, IntPtr color);
+
+    // ProgressBar
+    [LibraryImport("QtTestingServer")]
+    [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
+    internal static partial void fast_ProgressBar_Handle_setValue(IntPtr _this, int value);
+
+    // AbstractSlider
+    [LibraryImport("QtTestingServer")]
+    [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
+    internal static partial void fast_AbstractSlider_Handle_setMaximum(IntPtr _this, int value);
+
+    [LibraryImport("QtTestingServer")]
+    [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
+    internal static partial void fast_AbstractSlider_Handle_setMinimum(IntPtr _this, int value);
+
+    [LibraryImport("QtTestingServer")]
+    [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
+    internal static partial void fast_AbstractSlider_Handle_setSliderPosition(IntPtr _this, int pos);
+
+    [LibraryImport("QtTestingServer")]
+    [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
+    internal static partial void fast_AbstractSlider_Handle_setValue(IntPtr _this, int value);
+
+    [LibraryImport("QtTestingServer")]
+    [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
+    internal static partial void fast_AbstractSlider_Handle_setRange(IntPtr _this, int min, int max);
+}
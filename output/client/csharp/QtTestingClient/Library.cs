@@ -68,6 +68,14 @@ public static class Library
         TreeView.__Init();
     }
 
+    // for strings the app sends over and over (object names, style classes, label texts): after this, sending an equal string
+    // only sends a small id, and the server reuses the QString it made the first time. meant for a bounded set of strings:
+    // they're never freed, and once the server's table is full this returns false and the string goes over as before
+    public static bool InternString(string str)
+    {
+        return NativeImplClient.InternString(str) != 0;
+    }
+
     public static void Shutdown()
     {
         // module static shutdowns (if any, might be empty)
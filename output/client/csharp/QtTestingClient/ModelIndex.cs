@@ -51,15 +51,11 @@ namespace Org.Whatever.QtTesting
             }
             public int Row()
             {
-                Handle__Push(this);
-                NativeImplClient.InvokeModuleMethod(_handle_row);
-                return NativeImplClient.PopInt32();
+                return FastCalls.fast_ModelIndex_Handle_row(NativeHandle);
             }
             public int Column()
             {
-                Handle__Push(this);
-                NativeImplClient.InvokeModuleMethod(_handle_column);
-                return NativeImplClient.PopInt32();
+                return FastCalls.fast_ModelIndex_Handle_column(NativeHandle);
             }
         }
 
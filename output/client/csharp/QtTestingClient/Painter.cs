@@ -18,66 +18,27 @@ namespace Org.Whatever.QtTesting
     {
         private static ModuleHandle _module;
 
-        // built-in array type: int[]
+        // POD struct array, crosses as one contiguous block
 
         internal static void __Point_Array__Push(Point[] items, bool isReturn)
         {
-            var count = items.Length;
-            var f0Values = new int[count];
-            var f1Values = new int[count];
-            for (var i = 0; i < count; i++)
-            {
-                f0Values[i] = items[i].X;
-                f1Values[i] = items[i].Y;
-            }
-            NativeImplClient.PushInt32Array(f1Values);
-            NativeImplClient.PushInt32Array(f0Values);
+            NativeImplClient.PushStructArray(Point__TypeId, items);
         }
 
         internal static Point[] __Point_Array__Pop()
         {
-            var f0Values = NativeImplClient.PopInt32Array();
-            var f1Values = NativeImplClient.PopInt32Array();
-            var count = f0Values.Length;
-            var ret = new Point[count];
-            for (var i = 0; i < count; i++)
-            {
-                var f0 = f0Values[i];
-                var f1 = f1Values[i];
-                ret[i] = new Point(f0, f1);
-            }
-            return ret;
+            return NativeImplClient.PopStructArray<Point>(Point__TypeId);
         }
-
-        // built-in array type: double[]
+        // POD struct array, crosses as one contiguous block
 
         internal static void __PointF_Array__Push(PointF[] items, bool isReturn)
         {
-            var count = items.Length;
-            var f0Values = new double[count];
-            var f1Values = new double[count];
-            for (var i = 0; i < count; i++)
-            {
-                f0Values[i] = items[i].X;
-                f1Values[i] = items[i].Y;
-            }
-            NativeImplClient.PushDoubleArray(f1Values);
-            NativeImplClient.PushDoubleArray(f0Values);
+            NativeImplClient.PushStructArray(PointF__TypeId, items);
         }
 
         internal static PointF[] __PointF_Array__Pop()
         {
-            var f0Values = NativeImplClient.PopDoubleArray();
-            var f1Values = NativeImplClient.PopDoubleArray();
-            var count = f0Values.Length;
-            var ret = new PointF[count];
-            for (var i = 0; i < count; i++)
-            {
-                var f0 = f0Values[i];
-                var f1 = f1Values[i];
-                ret[i] = new PointF(f0, f1);
-            }
-            return ret;
+            return NativeImplClient.PopStructArray<PointF>(PointF__TypeId);
         }
         internal static ModuleMethodHandle _handle_setRenderHint;
         internal static ModuleMethodHandle _handle_setRenderHints;
@@ -215,17 +176,11 @@ namespace Org.Whatever.QtTesting
             }
             public void FillRect(Rect rect, Brush brush)
             {
-                Brush__Push(brush);
-                Rect__Push(rect, false);
-                Handle__Push(this);
-                NativeImplClient.InvokeModuleMethod(_handle_fillRect);
+                FastCalls.fast_Painter_Handle_fillRect(NativeHandle, rect.X, rect.Y, rect.Width, rect.Height, brush?.NativeHandle ?? IntPtr.Zero);
             }
             public void FillRect(Rect rect, Color color)
             {
-                Color__Push(color);
-                Rect__Push(rect, false);
-                Handle__Push(this);
-                NativeImplClient.InvokeModuleMethod(_handle_fillRect_overload1);
+                FastCalls.fast_Painter_Handle_fillRect_overload1(NativeHandle, rect.X, rect.Y, rect.Width, rect.Height, color?.NativeHandle ?? IntPtr.Zero);
             }
             public void DrawRect(Rect rect)
             {
@@ -291,9 +291,7 @@ namespace Org.Whatever.QtTesting
             }
             public void SetValue(int value)
             {
-                NativeImplClient.PushInt32(value);
-                Handle__Push(this);
-                NativeImplClient.InvokeModuleMethod(_handle_setValue);
+                FastCalls.fast_ProgressBar_Handle_setValue(NativeHandle, value);
             }
             public void SetRange(int min, int max)
             {
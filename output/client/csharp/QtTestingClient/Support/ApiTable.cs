@@ -0,0 +1,160 @@
+namespace Org.Whatever.QtTesting.Support
+{
+    // mirrors ni_ApiTable (DirectExport.h on the server side): the server's per-call API as one table of function pointers,
+    // the server swaps the active table while capturing or out-of-process, so it's loaded from the slot on each call (see NativeImplClient.Api)
+    // bools are bytes here (these calls don't marshal anything), and pointers are raw
+#pragma warning disable CS0649 // (only ever filled in on the server side)
+    internal unsafe struct ApiTable
+    {
+        public const uint Version = 2;
+
+        public uint version;
+        public uint size;
+        // invocation
+        public delegate* unmanaged[Cdecl]<IntPtr, void> invokeModuleMethod;
+        public delegate* unmanaged[Cdecl]<IntPtr, IntPtr> invokeModuleMethodWithExceptions;
+        public delegate* unmanaged[Cdecl]<IntPtr, int, void> invokeInterfaceMethod;
+        public delegate* unmanaged[Cdecl]<IntPtr, int, IntPtr> invokeInterfaceMethodWithExceptions;
+        public delegate* unmanaged[Cdecl]<int, void> execServerFunc;
+        public delegate* unmanaged[Cdecl]<int, IntPtr> execServerFuncWithExceptions;
+        public delegate* unmanaged[Cdecl]<IntPtr, nint, IntPtr, nint, int> invokeBatch;
+        // scalars
+        public delegate* unmanaged[Cdecl]<IntPtr, void> pushPtr;
+        public delegate* unmanaged[Cdecl]<IntPtr> popPtr;
+        public delegate* unmanaged[Cdecl]<nint, void> pushSizeT;
+        public delegate* unmanaged[Cdecl]<nint> popSizeT;
+        public delegate* unmanaged[Cdecl]<byte, void> pushBool;
+        public delegate* unmanaged[Cdecl]<byte> popBool;
+        public delegate* unmanaged[Cdecl]<sbyte, void> pushInt8;
+        public delegate* unmanaged[Cdecl]<sbyte> popInt8;
+        public delegate* unmanaged[Cdecl]<byte, void> pushUInt8;
+        public delegate* unmanaged[Cdecl]<byte> popUInt8;
+        public delegate* unmanaged[Cdecl]<short, void> pushInt16;
+        public delegate* unmanaged[Cdecl]<short> popInt16;
+        public delegate* unmanaged[Cdecl]<ushort, void> pushUInt16;
+        public delegate* unmanaged[Cdecl]<ushort> popUInt16;
+        public delegate* unmanaged[Cdecl]<int, void> pushInt32;
+        public delegate* unmanaged[Cdecl]<int> popInt32;
+        public delegate* unmanaged[Cdecl]<uint, void> pushUInt32;
+        public delegate* unmanaged[Cdecl]<uint> popUInt32;
+        public delegate* unmanaged[Cdecl]<long, void> pushInt64;
+        public delegate* unmanaged[Cdecl]<long> popInt64;
+        public delegate* unmanaged[Cdecl]<ulong, void> pushUInt64;
+        public delegate* unmanaged[Cdecl]<ulong> popUInt64;
+        public delegate* unmanaged[Cdecl]<float, void> pushFloat;
+        public delegate* unmanaged[Cdecl]<float> popFloat;
+        public delegate* unmanaged[Cdecl]<double, void> pushDouble;
+        public delegate* unmanaged[Cdecl]<double> popDouble;
+        // instances, function values, null
+        public delegate* unmanaged[Cdecl]<int, byte, void> pushInstance;
+        public delegate* unmanaged[Cdecl]<byte*, int> popInstance;
+        public delegate* unmanaged[Cdecl]<int, void> pushClientFunc;
+        public delegate* unmanaged[Cdecl]<int> popServerFunc;
+        public delegate* unmanaged[Cdecl]<void> pushNull;
+        // strings
+        public delegate* unmanaged[Cdecl]<byte*, nint, void> pushString;
+        public delegate* unmanaged[Cdecl]<byte*, nint, void> pushStringBorrowed;
+        public delegate* unmanaged[Cdecl]<byte**, nint*, void> popString;
+        public delegate* unmanaged[Cdecl]<byte**, nint*, void> popStringView;
+        // arrays
+        public delegate* unmanaged[Cdecl]<IntPtr*, nint, void> pushPtrArray;
+        public delegate* unmanaged[Cdecl]<IntPtr*, nint, void> pushPtrArrayBorrowed;
+        public delegate* unmanaged[Cdecl]<IntPtr**, nint*, void> popPtrArray;
+        public delegate* unmanaged[Cdecl]<IntPtr**, nint*, void> popPtrArrayView;
+        public delegate* unmanaged[Cdecl]<nint*, nint, void> pushSizeTArray;
+        public delegate* unmanaged[Cdecl]<nint*, nint, void> pushSizeTArrayBorrowed;
+        public delegate* unmanaged[Cdecl]<nint**, nint*, void> popSizeTArray;
+        public delegate* unmanaged[Cdecl]<nint**, nint*, void> popSizeTArrayView;
+        public delegate* unmanaged[Cdecl]<byte*, nint, void> pushBoolArray;
+        public delegate* unmanaged[Cdecl]<byte*, nint, void> pushBoolArrayBorrowed;
+        public delegate* unmanaged[Cdecl]<byte**, nint*, void> popBoolArray;
+        public delegate* unmanaged[Cdecl]<byte**, nint*, void> popBoolArrayView;
+        public delegate* unmanaged[Cdecl]<sbyte*, nint, void> pushInt8Array;
+        public delegate* unmanaged[Cdecl]<sbyte*, nint, void> pushInt8ArrayBorrowed;
+        public delegate* unmanaged[Cdecl]<sbyte**, nint*, void> popInt8Array;
+        public delegate* unmanaged[Cdecl]<sbyte**, nint*, void> popInt8ArrayView;
+        public delegate* unmanaged[Cdecl]<byte*, nint, void> pushUInt8Array;
+        public delegate* unmanaged[Cdecl]<byte*, nint, void> pushUInt8ArrayBorrowed;
+        public delegate* unmanaged[Cdecl]<byte**, nint*, void> popUInt8Array;
+        public delegate* unmanaged[Cdecl]<byte**, nint*, void> popUInt8ArrayView;
+        public delegate* unmanaged[Cdecl]<short*, nint, void> pushInt16Array;
+        public delegate* unmanaged[Cdecl]<short*, nint, void> pushInt16ArrayBorrowed;
+        public delegate* unmanaged[Cdecl]<short**, nint*, void> popInt16Array;
+        public delegate* unmanaged[Cdecl]<short**, nint*, void> popInt16ArrayView;
+        public delegate* unmanaged[Cdecl]<ushort*, nint, void> pushUInt16Array;
+        public delegate* unmanaged[Cdecl]<ushort*, nint, void> pushUInt16ArrayBorrowed;
+        public delegate* unmanaged[Cdecl]<ushort**, nint*, void> popUInt16Array;
+        public delegate* unmanaged[Cdecl]<ushort**, nint*, void> popUInt16ArrayView;
+        public delegate* unmanaged[Cdecl]<int*, nint, void> pushInt32Array;
+        public delegate* unmanaged[Cdecl]<int*, nint, void> pushInt32ArrayBorrowed;
+        public delegate* unmanaged[Cdecl]<int**, nint*, void> popInt32Array;
+        public delegate* unmanaged[Cdecl]<int**, nint*, void> popInt32ArrayView;
+        public delegate* unmanaged[Cdecl]<uint*, nint, void> pushUInt32Array;
+        public delegate* unmanaged[Cdecl]<uint*, nint, void> pushUInt32ArrayBorrowed;
+        public delegate* unmanaged[Cdecl]<uint**, nint*, void> popUInt32Array;
+        public delegate* unmanaged[Cdecl]<uint**, nint*, void> popUInt32ArrayView;
+        public delegate* unmanaged[Cdecl]<long*, nint, void> pushInt64Array;
+        public delegate* unmanaged[Cdecl]<long*, nint, void> pushInt64ArrayBorrowed;
+        public delegate* unmanaged[Cdecl]<long**, nint*, void> popInt64Array;
+        public delegate* unmanaged[Cdecl]<long**, nint*, void> popInt64ArrayView;
+        public delegate* unmanaged[Cdecl]<ulong*, nint, void> pushUInt64Array;
+        public delegate* unmanaged[Cdecl]<ulong*, nint, void> pushUInt64ArrayBorrowed;
+        public delegate* unmanaged[Cdecl]<ulong**, nint*, void> popUInt64Array;
+        public delegate* unmanaged[Cdecl]<ulong**, nint*, void> popUInt64ArrayView;
+        public delegate* unmanaged[Cdecl]<float*, nint, void> pushFloatArray;
+        public delegate* unmanaged[Cdecl]<float*, nint, void> pushFloatArrayBorrowed;
+        public delegate* unmanaged[Cdecl]<float**, nint*, void> popFloatArray;
+        public delegate* unmanaged[Cdecl]<float**, nint*, void> popFloatArrayView;
+        public delegate* unmanaged[Cdecl]<double*, nint, void> pushDoubleArray;
+        public delegate* unmanaged[Cdecl]<double*, nint, void> pushDoubleArrayBorrowed;
+        public delegate* unmanaged[Cdecl]<double**, nint*, void> popDoubleArray;
+        public delegate* unmanaged[Cdecl]<double**, nint*, void> popDoubleArrayView;
+        public delegate* unmanaged[Cdecl]<ulong*, nint, void> pushBitArray;
+        public delegate* unmanaged[Cdecl]<ulong*, nint, void> pushBitArrayBorrowed;
+        public delegate* unmanaged[Cdecl]<ulong**, nint*, void> popBitArray;
+        public delegate* unmanaged[Cdecl]<ulong**, nint*, void> popBitArrayView;
+        public delegate* unmanaged[Cdecl]<byte**, nint*, nint, void> pushStringArray;
+        public delegate* unmanaged[Cdecl]<byte**, nint*, nint, void> pushStringArrayBorrowed;
+        public delegate* unmanaged[Cdecl]<byte***, nint**, nint*, void> popStringArray;
+        public delegate* unmanaged[Cdecl]<byte***, nint**, nint*, void> popStringArrayView;
+        public delegate* unmanaged[Cdecl]<byte*, ulong*, nint, void> pushStringArrayBlob;
+        public delegate* unmanaged[Cdecl]<byte*, ulong*, nint, void> pushStringArrayBlobBorrowed;
+        public delegate* unmanaged[Cdecl]<byte**, ulong**, nint*, void> popStringArrayBlob;
+        // structs
+        public delegate* unmanaged[Cdecl]<IntPtr, byte*, int> getStructType;
+        public delegate* unmanaged[Cdecl]<int, nint*, IntPtr*, nint*, byte> getStructLayout;
+        public delegate* unmanaged[Cdecl]<int, IntPtr, nint, void> pushStruct;
+        public delegate* unmanaged[Cdecl]<int, IntPtr, nint, void> popStruct;
+        public delegate* unmanaged[Cdecl]<int, IntPtr, nint, void> pushStructArray;
+        public delegate* unmanaged[Cdecl]<int, IntPtr, nint, void> pushStructArrayBorrowed;
+        public delegate* unmanaged[Cdecl]<int, IntPtr*, nint*, void> popStructArray;
+        public delegate* unmanaged[Cdecl]<int, IntPtr*, nint*, void> popStructArrayView;
+        // buffers
+        public delegate* unmanaged[Cdecl]<int, byte, NativeMethods.BufferDescriptor*, void> pushBuffer;
+        public delegate* unmanaged[Cdecl]<int*, byte*, NativeMethods.BufferDescriptor*, void> popBuffer;
+        public delegate* unmanaged[Cdecl]<NativeMethods.BufferDescriptor*, IntPtr, int, int, ulong*, byte> describeBuffer;
+        public delegate* unmanaged[Cdecl]<NativeMethods.BufferDescriptor*, ulong*, ulong*, NativeMethods.BufferDescriptor*, byte> bufferRegion;
+        public delegate* unmanaged[Cdecl]<NativeMethods.BufferDescriptor*, int, ulong, NativeMethods.BufferDescriptor*, byte> bufferSlice;
+        public delegate* unmanaged[Cdecl]<NativeMethods.BufferDescriptor*, byte> bufferIsContiguous;
+        // resources, exceptions
+        public delegate* unmanaged[Cdecl]<int, void> releaseServerResource;
+        public delegate* unmanaged[Cdecl]<int*, nint, void> releaseServerResources;
+        public delegate* unmanaged[Cdecl]<void> clearServerSafetyArea;
+        public delegate* unmanaged[Cdecl]<IntPtr, void> setException;
+        // lookups
+        public delegate* unmanaged[Cdecl]<byte*, IntPtr> getModule;
+        public delegate* unmanaged[Cdecl]<IntPtr, byte*, IntPtr> getModuleMethod;
+        public delegate* unmanaged[Cdecl]<IntPtr, byte*, IntPtr> getInterface;
+        public delegate* unmanaged[Cdecl]<IntPtr, byte*, IntPtr> getInterfaceMethod;
+        public delegate* unmanaged[Cdecl]<IntPtr, byte*, IntPtr> getException;
+        public delegate* unmanaged[Cdecl]<IntPtr, void> pushModuleConstants;
+        public delegate* unmanaged[Cdecl]<int> getModuleCount;
+        public delegate* unmanaged[Cdecl]<int, IntPtr> getModuleByOrdinal;
+        public delegate* unmanaged[Cdecl]<IntPtr, int> getModuleMethodCount;
+        public delegate* unmanaged[Cdecl]<IntPtr, int, IntPtr> getModuleMethodByOrdinal;
+        // version 2: interned strings
+        public delegate* unmanaged[Cdecl]<byte*, nint, int> internString;
+        public delegate* unmanaged[Cdecl]<int, byte> pushInternedString;
+    }
+#pragma warning restore CS0649
+}
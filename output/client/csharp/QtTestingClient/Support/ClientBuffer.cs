@@ -10,12 +10,26 @@ namespace Org.Whatever.QtTesting.Support
         private readonly int[] _dims;
         private readonly long _totalCount;
         private readonly long _totalSize;
+        private readonly ulong[] _shape;
         public ClientBuffer(params int[] dims)
         {
             _dims = dims;
             _elementSize = Marshal.SizeOf<T>();
             _totalCount = dims.Aggregate(1L, (product, i) => product * i);
             _totalSize = _totalCount * _elementSize;
+            // (past the maximum rank, the innermost dimensions are folded into one - same as the server side)
+            _shape = dims.Length > 0 ? new ulong[Math.Min(dims.Length, NativeMethods.BufferMaxRank)] : new ulong[] { 1 };
+            for (var i = 0; i < dims.Length; i++)
+            {
+                if (i < _shape.Length)
+                {
+                    _shape[i] = (ulong)dims[i];
+                }
+                else
+                {
+                    _shape[^1] *= (ulong)dims[i];
+                }
+            }
             _block = Marshal.AllocHGlobal((IntPtr)_totalSize);
             GC.AddMemoryPressure(_totalSize);
             Console.WriteLine("ClientBuffer {0} allocated", _block);
@@ -33,11 +47,7 @@ namespace Org.Whatever.QtTesting.Support
         
         protected override void NativePush()
         {
-            NativeMethods.BufferDescriptor descriptor;
-            descriptor.Start = _block;
-            descriptor.ElementSize = _elementSize;
-            descriptor.TotalCount = (IntPtr)_totalCount;
-            descriptor.TotalSize = (IntPtr)_totalSize;
+            NativeMethods.describeBuffer(out var descriptor, _block, _elementSize, _shape.Length, _shape);
             NativeMethods.pushBuffer(Id, true, ref descriptor);
         }
 
@@ -14,9 +14,9 @@
             _key = key;
         }
         
-        protected override void NativePush()
+        protected override unsafe void NativePush()
         {
-            NativeMethods.pushClientFunc(Id);
+            NativeImplClient.Api->pushClientFunc(Id);
             // NOW we can put in the Reverse dictionary! we didn't have the ID until this point ...
             ReverseFuncValDict[_key] = Id;
         }
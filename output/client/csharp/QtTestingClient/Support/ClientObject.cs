@@ -2,9 +2,9 @@
 
 internal abstract class ClientObject : ClientResource
 {
-    protected override void NativePush()
+    protected override unsafe void NativePush()
     {
-        NativeMethods.pushInstance(Id, true);
+        NativeImplClient.Api->pushInstance(Id, 1);
     }
     public static ClientObject GetById(int id)
     {
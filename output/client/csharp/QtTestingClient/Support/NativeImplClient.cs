@@ -1,4 +1,5 @@
-﻿using System.Runtime.InteropServices;
+﻿using System.Collections.Concurrent;
+using System.Runtime.InteropServices;
 using System.Text;
 
 namespace Org.Whatever.QtTesting.Support
@@ -12,9 +13,15 @@ namespace Org.Whatever.QtTesting.Support
         private static NativeMethods.ExecFunctionDelegate _savedExecFunctionDelegate;
         private static NativeMethods.ClientMethodDelegate _savedClientMethodDelegate;
         private static NativeMethods.ClientResourceReleaseDelegate _savedClientResourceReleaseDelegate;
+        private static NativeMethods.ClientResourceReleaseBatchDelegate _savedClientResourceReleaseBatchDelegate;
         private static NativeMethods.ClientClearSafetyAreaDelegate _savedClientClearSafetyAreaDelegate;
 
         public static bool RemoteIsShutdown;
+
+        // the server's per-call entry points, called straight through (see ApiTable) - the table active at the time of the call
+        private static unsafe ApiTable** _apiSlot;
+        internal static unsafe ApiTable* Api => (ApiTable*)Volatile.Read(ref *(IntPtr*)_apiSlot);
+
         private static readonly Dictionary<IntPtr, MethodWrapper> MethodWrappers = new();
         public static readonly Dictionary<IntPtr, ExceptionBuildAndThrowDelegate> ExceptionBuildAndThrowDelegates = new();
 
@@ -41,13 +48,26 @@ namespace Org.Whatever.QtTesting.Support
             _savedClientMethodDelegate = InvokeClientMethod;
             _savedClientResourceReleaseDelegate = ReleaseClientResourceId;
             _savedClientClearSafetyAreaDelegate = ClientClearSafetyArea;
+            _savedClientResourceReleaseBatchDelegate = ReleaseClientResourceIds;
 
-            return NativeMethods.nativeImplInit(
+            // opt in to batched releases (server proxies being destroyed en masse, eg after a model reset)
+            NativeMethods.setClientResourceReleaseBatch(_savedClientResourceReleaseBatchDelegate);
+
+            var ret = NativeMethods.nativeImplInit(
                 _savedExecFunctionDelegate,
                 _savedClientMethodDelegate,
                 _savedClientResourceReleaseDelegate,
                 _savedClientClearSafetyAreaDelegate
                 );
+            unsafe
+            {
+                _apiSlot = NativeMethods.getApiTableSlot(ApiTable.Version);
+                if (_apiSlot == null)
+                {
+                    throw new Exception("NativeImplClient: server library is older than this client");
+                }
+            }
+            return ret;
         }
 
         public static void Shutdown()
@@ -88,28 +108,28 @@ namespace Org.Whatever.QtTesting.Support
             NativeMethods.pushModuleConstants(module.Handle);
         }
 
-        public static void InvokeModuleMethod(ModuleMethodHandle method)
+        public static unsafe void InvokeModuleMethod(ModuleMethodHandle method)
         {
-            NativeMethods.invokeModuleMethod(method.Handle);
+            Api->invokeModuleMethod(method.Handle);
         }
 
-        public static void InvokeModuleMethodWithExceptions(ModuleMethodHandle method)
+        public static unsafe void InvokeModuleMethodWithExceptions(ModuleMethodHandle method)
         {
-            var exceptionHandle = NativeMethods.invokeModuleMethodWithExceptions(method.Handle);
+            var exceptionHandle = Api->invokeModuleMethodWithExceptions(method.Handle);
             if (exceptionHandle != IntPtr.Zero)
             {
                 ExceptionBuildAndThrowDelegates[exceptionHandle]();
             }
         }
 
-        public static void PushPtr(IntPtr value)
+        public static unsafe void PushPtr(IntPtr value)
         {
-            NativeMethods.pushPtr(value);
+            Api->pushPtr(value);
         }
         
-        public static IntPtr PopPtr()
+        public static unsafe IntPtr PopPtr()
         {
-            return NativeMethods.popPtr();
+            return Api->popPtr();
         }
         
         public static void PushPtrArray(IntPtr[] values)
@@ -128,14 +148,14 @@ namespace Org.Whatever.QtTesting.Support
             return ret;
         }
         
-        public static void PushSizeT(IntPtr value)
+        public static unsafe void PushSizeT(IntPtr value)
         {
-            NativeMethods.pushSizeT(value);
+            Api->pushSizeT(value);
         }
 
-        public static IntPtr PopSizeT()
+        public static unsafe IntPtr PopSizeT()
         {
-            return NativeMethods.popSizeT();
+            return Api->popSizeT();
         }
 
         public static void PushSizeTArray(IntPtr[] values)
@@ -154,42 +174,58 @@ namespace Org.Whatever.QtTesting.Support
             return ret;
         }
 
-        public static void PushBool(bool b)
+        public static unsafe void PushBool(bool b)
         {
-            NativeMethods.pushBool(b);
+            Api->pushBool(b ? (byte)1 : (byte)0);
         }
 
-        public static bool PopBool()
+        public static unsafe bool PopBool()
         {
-            return NativeMethods.popBool();
+            return Api->popBool() != 0;
         }
 
-        public static void PushBoolArray(bool[] values)
+        // bool arrays cross bit-packed, 64 to a word (bit i being bit i % 64 of word i / 64)
+        public static unsafe void PushBoolArray(bool[] values)
         {
-            var bytes = values.Select(b => (byte)(b ? 1 : 0)).ToArray();
-            NativeMethods.pushBoolArray(bytes, (IntPtr)values.Length);
+            var words = new ulong[(values.Length + 63) / 64];
+            for (var i = 0; i < values.Length; i++)
+            {
+                if (values[i])
+                {
+                    words[i / 64] |= 1UL << (i % 64);
+                }
+            }
+            fixed (ulong* wordsPtr = words)
+            {
+                NativeMethods.pushBitArray(wordsPtr, values.Length);
+            }
         }
 
-        public static bool[] PopBoolArray()
+        public static unsafe bool[] PopBoolArray()
         {
-            NativeMethods.popBoolArray(out var valuesPtr, out var count);
-            var ret = new byte[(int)count]; // bool[] won't work for the Copy below
-            if (count != IntPtr.Zero)
+            NativeMethods.popBitArrayView(out var wordsPtr, out var count);
+            var words = (ulong*)wordsPtr;
+            var ret = new bool[(int)count];
+            for (var w = 0; w * 64 < ret.Length; w++)
             {
-                Marshal.Copy(valuesPtr, ret, 0, (int)count);
+                // (only the set ones need visiting)
+                for (var word = words[w]; word != 0; word &= word - 1)
+                {
+                    ret[w * 64 + System.Numerics.BitOperations.TrailingZeroCount(word)] = true;
+                }
             }
-            return ret.Select(v => v != 0).ToArray();
+            return ret;
         }
         
         // INT8 =========================================
-        public static void PushInt8(sbyte x)
+        public static unsafe void PushInt8(sbyte x)
         {
-            NativeMethods.pushInt8(x);
+            Api->pushInt8(x);
         }
 
-        public static sbyte PopInt8()
+        public static unsafe sbyte PopInt8()
         {
-            return NativeMethods.popInt8();
+            return Api->popInt8();
         }
 
         public static void PushInt8Array(sbyte[] values)
@@ -210,14 +246,14 @@ namespace Org.Whatever.QtTesting.Support
             return ret;
         }
         
-        public static void PushUInt8(byte x)
+        public static unsafe void PushUInt8(byte x)
         {
-            NativeMethods.pushUInt8(x);
+            Api->pushUInt8(x);
         }
 
-        public static byte PopUInt8()
+        public static unsafe byte PopUInt8()
         {
-            return NativeMethods.popUInt8();
+            return Api->popUInt8();
         }
 
         public static void PushUInt8Array(byte[] values)
@@ -237,14 +273,14 @@ namespace Org.Whatever.QtTesting.Support
         }
         
         // INT16 =========================================
-        public static void PushInt16(short x)
+        public static unsafe void PushInt16(short x)
         {
-            NativeMethods.pushInt16(x);
+            Api->pushInt16(x);
         }
 
-        public static short PopInt16()
+        public static unsafe short PopInt16()
         {
-            return NativeMethods.popInt16();
+            return Api->popInt16();
         }
 
         public static void PushInt16Array(short[] values)
@@ -263,14 +299,14 @@ namespace Org.Whatever.QtTesting.Support
             return ret;
         }
         
-        public static void PushUInt16(ushort x)
+        public static unsafe void PushUInt16(ushort x)
         {
-            NativeMethods.pushUInt16(x);
+            Api->pushUInt16(x);
         }
 
-        public static ushort PopUInt16()
+        public static unsafe ushort PopUInt16()
         {
-            return NativeMethods.popUInt16();
+            return Api->popUInt16();
         }
 
         public static void PushUInt16Array(ushort[] values)
@@ -292,14 +328,14 @@ namespace Org.Whatever.QtTesting.Support
         }
         
         // INT32 =========================================
-        public static void PushInt32(int x)
+        public static unsafe void PushInt32(int x)
         {
-            NativeMethods.pushInt32(x);
+            Api->pushInt32(x);
         }
 
-        public static int PopInt32()
+        public static unsafe int PopInt32()
         {
-            return NativeMethods.popInt32();
+            return Api->popInt32();
         }
 
         public static void PushInt32Array(int[] values)
@@ -318,14 +354,14 @@ namespace Org.Whatever.QtTesting.Support
             return ret;
         }
         
-        public static void PushUInt32(uint x)
+        public static unsafe void PushUInt32(uint x)
         {
-            NativeMethods.pushUInt32(x);
+            Api->pushUInt32(x);
         }
 
-        public static uint PopUInt32()
+        public static unsafe uint PopUInt32()
         {
-            return NativeMethods.popUInt32();
+            return Api->popUInt32();
         }
 
         public static void PushUInt32Array(uint[] values)
@@ -347,14 +383,14 @@ namespace Org.Whatever.QtTesting.Support
         }
         
         // INT64 =========================================
-        public static void PushInt64(long x)
+        public static unsafe void PushInt64(long x)
         {
-            NativeMethods.pushInt64(x);
+            Api->pushInt64(x);
         }
 
-        public static long PopInt64()
+        public static unsafe long PopInt64()
         {
-            return NativeMethods.popInt64();
+            return Api->popInt64();
         }
 
         public static void PushInt64Array(long[] values)
@@ -373,14 +409,14 @@ namespace Org.Whatever.QtTesting.Support
             return ret;
         }
         
-        public static void PushUInt64(ulong x)
+        public static unsafe void PushUInt64(ulong x)
         {
-            NativeMethods.pushUInt64(x);
+            Api->pushUInt64(x);
         }
 
-        public static ulong PopUInt64()
+        public static unsafe ulong PopUInt64()
         {
-            return NativeMethods.popUInt64();
+            return Api->popUInt64();
         }
 
         public static void PushUInt64Array(ulong[] values)
@@ -403,14 +439,14 @@ namespace Org.Whatever.QtTesting.Support
         
         // ===========================
         
-        public static void PushFloat(float x)
+        public static unsafe void PushFloat(float x)
         {
-            NativeMethods.pushFloat(x);
+            Api->pushFloat(x);
         }
 
-        public static float PopFloat()
+        public static unsafe float PopFloat()
         {
-            return NativeMethods.popFloat();
+            return Api->popFloat();
         }
 
         public static void PushFloatArray(float[] values)
@@ -429,14 +465,14 @@ namespace Org.Whatever.QtTesting.Support
             return ret;
         }
         
-        public static void PushDouble(double x)
+        public static unsafe void PushDouble(double x)
         {
-            NativeMethods.pushDouble(x);
+            Api->pushDouble(x);
         }
         
-        public static double PopDouble()
+        public static unsafe double PopDouble()
         {
-            return NativeMethods.popDouble();
+            return Api->popDouble();
         }
         
         public static void PushDoubleArray(double[] values)
@@ -455,8 +491,45 @@ namespace Org.Whatever.QtTesting.Support
             return ret;
         }
 
+        // strings sent over and over (object names, style classes, labels flipping between a few values) can be interned:
+        // handed to the server once, after which PushString sends just the id - no UTF-8 conversion or copying on either side,
+        // and the server keeps its own converted copy (see ni_internString on the server side). there's no un-interning, and the
+        // server's table holds about a million: past that InternString returns 0 and the string keeps going over the ordinary way
+        private static readonly ConcurrentDictionary<string, int> InternedStrings = new();
+        private static volatile bool _anyInterned;
+
+        public static unsafe int InternString(string str)
+        {
+            if (InternedStrings.TryGetValue(str, out var id))
+            {
+                return id;
+            }
+            var bytes = Encoding.UTF8.GetBytes(str);
+            fixed (byte* ptr = bytes)
+            {
+                // (the same bytes always get the same id, so a race between two threads here is harmless)
+                id = Api->internString(ptr, bytes.Length);
+            }
+            if (id != 0)
+            {
+                InternedStrings[str] = id;
+                _anyInterned = true;
+            }
+            return id;
+        }
+
+        private static unsafe bool PushInternedString(int id)
+        {
+            // (only fails for an id the server didn't hand out, in which case the bytes go instead)
+            return Api->pushInternedString(id) != 0;
+        }
+
         public static void PushString(string str)
         {
+            if (_anyInterned && InternedStrings.TryGetValue(str, out var id) && PushInternedString(id))
+            {
+                return;
+            }
             if (str.Length > 0)
             {
                 var bytes = Encoding.UTF8.GetBytes(str);
@@ -477,82 +550,108 @@ namespace Org.Whatever.QtTesting.Support
             return length > 0 ? Marshal.PtrToStringUTF8(ptr, (int)length) : "";
         }
 
-        public static void PushStringArray(string[] strs)
+        // string arrays cross as one UTF-8 blob plus offsets (string i being bytes[offsets[i]..offsets[i + 1]])
+        public static unsafe void PushStringArray(string[] strs)
         {
-            var pointers = new IntPtr[strs.Length];
-            var lengths = new IntPtr[strs.Length];
+            var offsets = new ulong[strs.Length + 1];
+            var total = 0;
             for (var i = 0; i < strs.Length; i++)
             {
-                if (strs[i].Length > 0)
-                {
-                    var bytes = Encoding.UTF8.GetBytes(strs[i]);
-                    var ptr = Marshal.AllocHGlobal(bytes.Length);
-                    Marshal.Copy(bytes, 0, ptr, bytes.Length);
-                    pointers[i] = ptr;
-                    lengths[i] = bytes.Length;
-                }
-                else
-                {
-                    pointers[i] = 0;
-                    lengths[i] = 0;
-                }
+                total += Encoding.UTF8.GetByteCount(strs[i]);
+                offsets[i + 1] = (ulong)total;
             }
-            NativeMethods.pushStringArray(pointers, lengths, strs.Length);
-            foreach (var p in pointers)
+            var bytes = new byte[total];
+            for (var i = 0; i < strs.Length; i++)
             {
-                if (p != 0)
-                {
-                    Marshal.FreeHGlobal(p);
-                }
+                Encoding.UTF8.GetBytes(strs[i], 0, strs[i].Length, bytes, (int)offsets[i]);
+            }
+            fixed (byte* bytesPtr = bytes)
+            fixed (ulong* offsetsPtr = offsets)
+            {
+                NativeMethods.pushStringArrayBlob(bytesPtr, offsetsPtr, strs.Length);
             }
         }
 
-        public static string[] PopStringArray()
+        public static unsafe string[] PopStringArray()
         {
-            NativeMethods.popStringArray(out var ptrsPtr, out var lengthsPtr, out var count);
-            var intCount = (int)count;
-            var ptrs = new IntPtr[intCount];
-            var lengths = new IntPtr[intCount];
-            Marshal.Copy(ptrsPtr, ptrs, 0, intCount);
-            Marshal.Copy(lengthsPtr, lengths, 0, intCount);
-            var result = new string[intCount];
-            for (var i = 0; i < intCount; i++)
+            NativeMethods.popStringArrayBlob(out var bytes, out var offsetsPtr, out var count);
+            var offsets = (ulong*)offsetsPtr;
+            var result = new string[(int)count];
+            for (var i = 0; i < result.Length; i++)
             {
-                if (lengths[i] > 0)
-                {
-                    result[i] = Marshal.PtrToStringUTF8(ptrs[i], (int)lengths[i]);
-                }
-                else
-                {
-                    result[i] = "";
-                }
+                var length = (int)(offsets[i + 1] - offsets[i]);
+                result[i] = length > 0 ? Encoding.UTF8.GetString((byte*)bytes + offsets[i], length) : "";
             }
             return result;
         }
         
-        public static int PopServerFuncValId()
+        // POD structs cross as a single item, the layout is checked against the server's when the type is looked up
+        public static unsafe int GetStructType<T>(ModuleHandle module, string name) where T : unmanaged
         {
-            return NativeMethods.popServerFunc();
+            var typeId = NativeMethods.getStructType(module.Handle, name);
+            if (typeId < 0 || !NativeMethods.getStructLayout(typeId, out var size, out _, out _) || (int)size != sizeof(T))
+            {
+                throw new Exception($"NativeImplClient: struct {name} is missing or has a different layout on the server");
+            }
+            return typeId;
         }
 
-        public static void PushNull()
+        public static unsafe void PushStruct<T>(int typeId, T value) where T : unmanaged
         {
-            NativeMethods.pushNull();
+            Api->pushStruct(typeId, (IntPtr)(&value), sizeof(T));
         }
 
-        public static void PopInstanceId(out int id, out bool isClientId)
+        public static unsafe T PopStruct<T>(int typeId) where T : unmanaged
         {
-            id = NativeMethods.popInstance(out isClientId);
+            T value;
+            Api->popStruct(typeId, (IntPtr)(&value), sizeof(T));
+            return value;
         }
 
-        public static void InvokeInterfaceMethod(InterfaceMethodHandle method, int serverId)
+        public static unsafe void PushStructArray<T>(int typeId, T[] values) where T : unmanaged
         {
-            NativeMethods.invokeInterfaceMethod(method.Handle, serverId);
+            fixed (T* ptr = values)
+            {
+                NativeMethods.pushStructArray(typeId, ptr, (IntPtr)values.Length);
+            }
         }
 
-        public static void InvokeInterfaceMethodWithExceptions(InterfaceMethodHandle method, int serverId)
+        public static unsafe T[] PopStructArray<T>(int typeId) where T : unmanaged
         {
-            var exceptionHandle = NativeMethods.invokeInterfaceMethodWithExceptions(method.Handle, serverId);
+            NativeMethods.popStructArray(typeId, out var valuesPtr, out var count);
+            var ret = new T[(int)count];
+            if (count != IntPtr.Zero)
+            {
+                new ReadOnlySpan<T>((void*)valuesPtr, (int)count).CopyTo(ret);
+            }
+            return ret;
+        }
+
+        public static unsafe int PopServerFuncValId()
+        {
+            return Api->popServerFunc();
+        }
+
+        public static unsafe void PushNull()
+        {
+            Api->pushNull();
+        }
+
+        public static unsafe void PopInstanceId(out int id, out bool isClientId)
+        {
+            byte isClient;
+            id = Api->popInstance(&isClient);
+            isClientId = isClient != 0;
+        }
+
+        public static unsafe void InvokeInterfaceMethod(InterfaceMethodHandle method, int serverId)
+        {
+            Api->invokeInterfaceMethod(method.Handle, serverId);
+        }
+
+        public static unsafe void InvokeInterfaceMethodWithExceptions(InterfaceMethodHandle method, int serverId)
+        {
+            var exceptionHandle = Api->invokeInterfaceMethodWithExceptions(method.Handle, serverId);
             if (exceptionHandle != IntPtr.Zero)
             {
                 ExceptionBuildAndThrowDelegates[exceptionHandle]();
@@ -570,6 +669,24 @@ namespace Org.Whatever.QtTesting.Support
             // should we check for _remoteIsShutdown here?
             ClientResource.GetResourceById(id).Release();
         }
+
+        private static unsafe void ReleaseClientResourceIds(IntPtr ids, nint count) // called from remote
+        {
+            var span = new ReadOnlySpan<int>((void*)ids, (int)count);
+            foreach (var id in span)
+            {
+                ClientResource.GetResourceById(id).Release();
+            }
+        }
+
+        // for dropping many server resources at once (one crossing instead of one per id)
+        public static unsafe void ReleaseServerResources(ReadOnlySpan<int> ids)
+        {
+            fixed (int* ptr = ids)
+            {
+                NativeMethods.releaseServerResources(ptr, ids.Length);
+            }
+        }
         
         private static void InvokeClientMethod(IntPtr methodHandle, int clientId)
         {
@@ -577,7 +694,8 @@ namespace Org.Whatever.QtTesting.Support
             MethodWrappers[methodHandle](obj);
         }
 
-        // call this after receiving an interface (maybe even a function, eventually?) as a return value
+        // no longer needed after receiving an interface as a return value - the server lets go of its return protections itself,
+        // when the next invocation begins. still works for forcing it early
         public static void ServerClearSafetyArea()
         {
             // TODO: in the future, perhaps check to see if the remote safety area is 'dirty' -- we'll know from the flags returned on popInstace()
@@ -606,6 +724,63 @@ namespace Org.Whatever.QtTesting.Support
             
             Console.WriteLine("=========================================");
         }
+
+        // 0 = off, 1 = errors, 2 = warnings (the default), 3 = info, 4 = debug (every resource push/release)
+        public static void SetTraceLevel(int level)
+        {
+            NativeMethods.setTraceLevel(level);
+        }
+
+        public static void DumpTrace()
+        {
+            NativeMethods.dumpTrace();
+        }
+
+        // per-method boundary stats (calls, latency percentiles, items/bytes each way), collected while profiling is on
+        public static void SetProfiling(bool enabled)
+        {
+            NativeMethods.setProfiling(enabled);
+        }
+
+        public static unsafe string GetStats(bool json = false)
+        {
+            var format = json ? 1 : 0;
+            var length = NativeMethods.getStats(format, null, 0);
+            var buffer = new byte[length + 1];
+            fixed (byte* ptr = buffer)
+            {
+                // (more calls may have come in meanwhile, anything past the first measurement is just cut off)
+                length = Math.Min(length, NativeMethods.getStats(format, ptr, (nuint)buffer.Length));
+            }
+            return Encoding.UTF8.GetString(buffer, 0, (int)length);
+        }
+
+        public static void ResetStats()
+        {
+            NativeMethods.resetStats();
+        }
+
+        // begin/end of every crossing, per thread, for chrome://tracing or ui.perfetto.dev - turning it on starts a new recording
+        public static void SetTimeline(bool enabled)
+        {
+            NativeMethods.setTimeline(enabled);
+        }
+
+        public static bool WriteTimeline(string path)
+        {
+            return NativeMethods.writeTimeline(path);
+        }
+
+        // records everything this thread sends across (and the callbacks coming back) for QtTestingReplay - or set NI_CAPTURE=<path> to record from startup
+        public static bool StartCapture(string path)
+        {
+            return NativeMethods.startCapture(path);
+        }
+
+        public static void StopCapture()
+        {
+            NativeMethods.stopCapture();
+        }
         
         public static void SetExceptionBuilder(ExceptionHandle eh, ExceptionBuildAndThrowDelegate builder)
         {
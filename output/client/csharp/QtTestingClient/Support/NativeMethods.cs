@@ -7,6 +7,7 @@ namespace Org.Whatever.QtTesting.Support
         internal delegate void ExecFunctionDelegate(int id);
         internal delegate void ClientMethodDelegate(IntPtr methodHandle, int objectId);
         internal delegate void ClientResourceReleaseDelegate(int id);
+        internal delegate void ClientResourceReleaseBatchDelegate(IntPtr ids, nint count);
         internal delegate void ClientClearSafetyAreaDelegate();
 
         [LibraryImport("QtTestingServer")]
@@ -22,6 +23,10 @@ namespace Org.Whatever.QtTesting.Support
         [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
         internal static partial void nativeImplShutdown();
 
+        [LibraryImport("QtTestingServer")]
+        [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
+        internal static partial void setClientResourceReleaseBatch(ClientResourceReleaseBatchDelegate resourceReleaseBatchDelegate);
+
         [LibraryImport("QtTestingServer", StringMarshalling = StringMarshalling.Custom, StringMarshallingCustomType = typeof(System.Runtime.InteropServices.Marshalling.AnsiStringMarshaller))]
         [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
         internal static partial IntPtr getModule(string name);
@@ -94,11 +99,11 @@ namespace Org.Whatever.QtTesting.Support
 
         [LibraryImport("QtTestingServer")]
         [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
-        internal static partial void pushBoolArray(byte[] values, IntPtr count); // bool*, size_t
+        internal static unsafe partial void pushBitArray(ulong* words, IntPtr count); // const uint64_t*, size_t (count in bits)
 
         [LibraryImport("QtTestingServer")]
         [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
-        internal static partial void popBoolArray(out IntPtr valuesPtr, out IntPtr count); // bool**, size_t*
+        internal static partial void popBitArrayView(out IntPtr wordsPtr, out IntPtr count); // const uint64_t**, size_t*
         
         [LibraryImport("QtTestingServer")]
         [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
@@ -276,12 +281,52 @@ namespace Org.Whatever.QtTesting.Support
         [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
         internal static partial void popStringArray(out IntPtr strsPtr, out IntPtr lengthsPtr, out IntPtr count); // const char ***, size_t**, size_t*
 
-        public struct BufferDescriptor
+        [LibraryImport("QtTestingServer")]
+        [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
+        internal static unsafe partial void pushStringArrayBlob(byte* bytes, ulong* offsets, IntPtr count); // const char*, const uint64_t* (count + 1), size_t
+
+        [LibraryImport("QtTestingServer")]
+        [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
+        internal static partial void popStringArrayBlob(out IntPtr bytes, out IntPtr offsets, out IntPtr count); // const char**, const uint64_t**, size_t*
+
+        [LibraryImport("QtTestingServer", StringMarshalling = StringMarshalling.Custom, StringMarshallingCustomType = typeof(System.Runtime.InteropServices.Marshalling.AnsiStringMarshaller))]
+        [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
+        internal static partial int getStructType(IntPtr module, string name);
+
+        [LibraryImport("QtTestingServer")]
+        [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
+        [return: MarshalAs(UnmanagedType.U1)]
+        internal static partial bool getStructLayout(int typeId, out IntPtr size, out IntPtr fields, out IntPtr fieldCount); // size_t*, const ni_StructField**, size_t*
+
+        [LibraryImport("QtTestingServer")]
+        [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
+        internal static unsafe partial void pushStruct(int typeId, void* value, IntPtr size); // size_t size
+
+        [LibraryImport("QtTestingServer")]
+        [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
+        internal static unsafe partial void popStruct(int typeId, void* value, IntPtr size); // size_t size
+
+        [LibraryImport("QtTestingServer")]
+        [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
+        internal static unsafe partial void pushStructArray(int typeId, void* values, IntPtr count); // size_t count
+
+        [LibraryImport("QtTestingServer")]
+        [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
+        internal static partial void popStructArray(int typeId, out IntPtr values, out IntPtr count); // void**, size_t*
+
+        public const int BufferMaxRank = 4;
+
+        // row-major; strides are in bytes, and TotalSize is the span from Start to the end of the last element
+        public unsafe struct BufferDescriptor
         {
             public IntPtr Start;
             public int ElementSize;
             public IntPtr TotalCount;
             public IntPtr TotalSize;
+            public int Rank;
+            public int Reserved;
+            public fixed ulong Shape[BufferMaxRank];
+            public fixed ulong Strides[BufferMaxRank];
         }
 
         [LibraryImport("QtTestingServer")]
@@ -292,6 +337,26 @@ namespace Org.Whatever.QtTesting.Support
         [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
         internal static partial void popBuffer(out int id, [MarshalAs(UnmanagedType.U1)] out bool isClientId, out BufferDescriptor descriptor);
 
+        [LibraryImport("QtTestingServer")]
+        [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
+        [return: MarshalAs(UnmanagedType.U1)]
+        internal static partial bool describeBuffer(out BufferDescriptor descriptor, IntPtr start, int elementSize, int rank, ulong[] shape);
+
+        [LibraryImport("QtTestingServer")]
+        [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
+        [return: MarshalAs(UnmanagedType.U1)]
+        internal static partial bool bufferRegion(in BufferDescriptor buffer, ulong[] begin, ulong[] extent, out BufferDescriptor view);
+
+        [LibraryImport("QtTestingServer")]
+        [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
+        [return: MarshalAs(UnmanagedType.U1)]
+        internal static partial bool bufferSlice(in BufferDescriptor buffer, int dim, ulong index, out BufferDescriptor view);
+
+        [LibraryImport("QtTestingServer")]
+        [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
+        [return: MarshalAs(UnmanagedType.U1)]
+        internal static partial bool bufferIsContiguous(in BufferDescriptor buffer);
+
         [LibraryImport("QtTestingServer")]
         [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
         internal static partial void pushClientFunc(int id);
@@ -332,6 +397,10 @@ namespace Org.Whatever.QtTesting.Support
         [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
         internal static partial int releaseServerResource(int id);
 
+        [LibraryImport("QtTestingServer")]
+        [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
+        internal static unsafe partial void releaseServerResources(int* ids, nint count);
+
         [LibraryImport("QtTestingServer")]
         [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
         internal static partial void clearServerSafetyArea();
@@ -340,6 +409,44 @@ namespace Org.Whatever.QtTesting.Support
         [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
         internal static partial void dumpTables();
 
+        [LibraryImport("QtTestingServer")]
+        [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
+        internal static partial void setTraceLevel(int level);
+
+        [LibraryImport("QtTestingServer")]
+        [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
+        internal static partial void dumpTrace();
+
+        [LibraryImport("QtTestingServer")]
+        [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
+        internal static partial void setProfiling([MarshalAs(UnmanagedType.U1)] bool enabled);
+
+        [LibraryImport("QtTestingServer")]
+        [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
+        internal static unsafe partial nuint getStats(int format, byte* buffer, nuint bufferSize);
+
+        [LibraryImport("QtTestingServer")]
+        [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
+        internal static partial void resetStats();
+
+        [LibraryImport("QtTestingServer")]
+        [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
+        internal static partial void setTimeline([MarshalAs(UnmanagedType.U1)] bool enabled);
+
+        [LibraryImport("QtTestingServer", StringMarshalling = StringMarshalling.Utf8)]
+        [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
+        [return: MarshalAs(UnmanagedType.U1)]
+        internal static partial bool writeTimeline(string path);
+
+        [LibraryImport("QtTestingServer", StringMarshalling = StringMarshalling.Utf8)]
+        [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
+        [return: MarshalAs(UnmanagedType.U1)]
+        internal static partial bool startCapture(string path);
+
+        [LibraryImport("QtTestingServer")]
+        [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
+        internal static partial void stopCapture();
+
         [LibraryImport("QtTestingServer")]
         [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
         internal static partial void pushModuleConstants(IntPtr module);
@@ -347,5 +454,10 @@ namespace Org.Whatever.QtTesting.Support
         [LibraryImport("QtTestingServer")]
         [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
         internal static partial void setException(IntPtr exceptionHandle);
+
+        // the hot entry points go through this instead (see ApiTable)
+        [LibraryImport("QtTestingServer")]
+        [UnmanagedCallConv(CallConvs = new [] { typeof(System.Runtime.CompilerServices.CallConvCdecl) })]
+        internal static unsafe partial ApiTable** getApiTableSlot(uint version);
     }
 }
\ No newline at end of file
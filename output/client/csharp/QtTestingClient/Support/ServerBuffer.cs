@@ -1,4 +1,6 @@
-﻿namespace Org.Whatever.QtTesting.Support
+﻿using System.Runtime.InteropServices;
+
+namespace Org.Whatever.QtTesting.Support
 {
     internal class ServerBuffer<T> : ServerResource, INativeBuffer<T>
     {
@@ -19,12 +21,26 @@
             ServerDispose();
         }
 
+        public NativeMethods.BufferDescriptor Descriptor => _desc;
+
+        // the box [begin, begin + extent) of this buffer (eg a band of an image's rows), with no copy; null if out of bounds
+        // (a plain description of the server's memory: it stays valid only as long as this buffer does)
+        public NativeMethods.BufferDescriptor? Region(ulong[] begin, ulong[] extent)
+        {
+            if (begin.Length != _desc.Rank || extent.Length != _desc.Rank)
+            {
+                return null;
+            }
+            return NativeMethods.bufferRegion(in _desc, begin, extent, out var view) ? view : null;
+        }
+
         public Span<T> GetSpan(out int length)
         {
             unsafe
             {
                 var ptr = _desc.Start.ToPointer();
-                length = (int)_desc.TotalCount;
+                // (everything from Start up to the last element - for a strided view, index it through Strides)
+                length = (int)((long)_desc.TotalSize / Marshal.SizeOf<T>());
                 return new Span<T>(ptr, length);
             }
         }
@@ -14,14 +14,14 @@
             throw new NotImplementedException();
         }
         
-        public void Exec()
+        public unsafe void Exec()
         {
-            NativeMethods.execServerFunc(Id);
+            NativeImplClient.Api->execServerFunc(Id);
         }
         
-        public void ExecWithExceptions()
+        public unsafe void ExecWithExceptions()
         {
-            var exceptionHandle = NativeMethods.execServerFuncWithExceptions(Id);
+            var exceptionHandle = NativeImplClient.Api->execServerFuncWithExceptions(Id);
             if (exceptionHandle != IntPtr.Zero)
             {
                 NativeImplClient.ExceptionBuildAndThrowDelegates[exceptionHandle]();
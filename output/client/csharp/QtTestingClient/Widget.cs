@@ -437,12 +437,7 @@ namespace Org.Whatever.QtTesting
             }
             public void SetGeometry(int x, int y, int width, int height)
             {
-                NativeImplClient.PushInt32(height);
-                NativeImplClient.PushInt32(width);
-                NativeImplClient.PushInt32(y);
-                NativeImplClient.PushInt32(x);
-                Handle__Push(this);
-                NativeImplClient.InvokeModuleMethod(_handle_setGeometry_overload1);
+                FastCalls.fast_Widget_Handle_setGeometry_overload1(NativeHandle, x, y, width, height);
             }
             public int Height()
             {
@@ -771,8 +766,7 @@ namespace Org.Whatever.QtTesting
             }
             public void Update()
             {
-                Handle__Push(this);
-                NativeImplClient.InvokeModuleMethod(_handle_update);
+                FastCalls.fast_Widget_Handle_update(NativeHandle);
             }
             public void Update(int x, int y, int width, int height)
             {
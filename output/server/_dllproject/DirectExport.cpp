@@ -1,6 +1,234 @@
 #include "DirectExport.h"
 
 #include "core/NativeImplCore.h"
+#include "capture/Capture.h"
+#include "remote/Remote.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+
+// where invocations go: here, or over to the host process in out-of-process mode (pushes and pops stay local either way)
+namespace Dispatch {
+    static inline void invokeModuleMethod(ni_ModuleMethodRef method) {
+        Remote::connected() ? Remote::invokeModuleMethod(method) : ni_invokeModuleMethod(method);
+    }
+    static inline ni_ExceptionRef invokeModuleMethodWithExceptions(ni_ModuleMethodRef method) {
+        return Remote::connected() ? Remote::invokeModuleMethodWithExceptions(method) : ni_invokeModuleMethodWithExceptions(method);
+    }
+    static inline void invokeInterfaceMethod(ni_InterfaceMethodRef method, int serverID) {
+        Remote::connected() ? Remote::invokeInterfaceMethod(method, serverID) : ni_invokeInterfaceMethod(method, serverID);
+    }
+    static inline ni_ExceptionRef invokeInterfaceMethodWithExceptions(ni_InterfaceMethodRef method, int serverID) {
+        return Remote::connected() ? Remote::invokeInterfaceMethodWithExceptions(method, serverID) : ni_invokeInterfaceMethodWithExceptions(method, serverID);
+    }
+    static inline void invokeServerFunc(int id) {
+        Remote::connected() ? Remote::execServerFunc(id) : ni_invokeServerFunc(id);
+    }
+    static inline ni_ExceptionRef invokeServerFuncWithExceptions(int id) {
+        return Remote::connected() ? Remote::execServerFuncWithExceptions(id) : ni_invokeServerFuncWithExceptions(id);
+    }
+    static inline void pushModuleConstants(ni_ModuleRef m) {
+        Remote::connected() ? Remote::pushModuleConstants(m) : ni_pushModuleConstants(m);
+    }
+    static inline int invokeBatch(const void* buffer, size_t length, ni_BatchResult* results, size_t maxResults) {
+        return Remote::connected() ? Remote::invokeBatch(buffer, length, results, maxResults) : ni_invokeBatch(buffer, length, results, maxResults);
+    }
+    static inline void releaseServerResource(int id) {
+        Remote::connected() ? Remote::releaseServerResources(&id, 1) : ni_releaseServerResource(id);
+    }
+    static inline void releaseServerResources(const int* ids, size_t count) {
+        Remote::connected() ? Remote::releaseServerResources(ids, count) : ni_releaseServerResources(ids, count);
+    }
+    static inline void clearServerSafetyArea() {
+        Remote::connected() ? Remote::clearServerSafetyArea() : ni_clearServerSafetyArea();
+    }
+    static inline void dumpTables() {
+        Remote::connected() ? Remote::dumpTables() : ni_dumpTables();
+    }
+}
+
+// see ni_ApiTable: one table straight to the core, one through the exports (which check for capture and out-of-process mode),
+// neither changing once built - only which one is active does
+static ni_ApiTable makeApiTable(bool direct)
+{
+    ni_ApiTable apiTable {};
+    apiTable.version = ni_ApiVersion;
+    apiTable.size = sizeof(ni_ApiTable);
+#define ENTRY(name) apiTable.name = direct ? &ni_##name : &::name
+    ENTRY(invokeModuleMethod);
+    ENTRY(invokeModuleMethodWithExceptions);
+    ENTRY(invokeInterfaceMethod);
+    ENTRY(invokeInterfaceMethodWithExceptions);
+    apiTable.execServerFunc = direct ? &ni_invokeServerFunc : &::execServerFunc; // (the framed one, as the export uses)
+    apiTable.execServerFuncWithExceptions = direct ? &ni_invokeServerFuncWithExceptions : &::execServerFuncWithExceptions; // (the framed one, as the export uses)
+    ENTRY(invokeBatch);
+    ENTRY(pushPtr);
+    ENTRY(popPtr);
+    ENTRY(pushSizeT);
+    ENTRY(popSizeT);
+    ENTRY(pushBool);
+    ENTRY(popBool);
+    ENTRY(pushInt8);
+    ENTRY(popInt8);
+    ENTRY(pushUInt8);
+    ENTRY(popUInt8);
+    ENTRY(pushInt16);
+    ENTRY(popInt16);
+    ENTRY(pushUInt16);
+    ENTRY(popUInt16);
+    ENTRY(pushInt32);
+    ENTRY(popInt32);
+    ENTRY(pushUInt32);
+    ENTRY(popUInt32);
+    ENTRY(pushInt64);
+    ENTRY(popInt64);
+    ENTRY(pushUInt64);
+    ENTRY(popUInt64);
+    ENTRY(pushFloat);
+    ENTRY(popFloat);
+    ENTRY(pushDouble);
+    ENTRY(popDouble);
+    ENTRY(pushInstance);
+    ENTRY(popInstance);
+    ENTRY(pushClientFunc);
+    ENTRY(popServerFunc);
+    ENTRY(pushNull);
+    ENTRY(pushString);
+    ENTRY(pushStringBorrowed);
+    ENTRY(popString);
+    ENTRY(popStringView);
+    ENTRY(pushPtrArray);
+    ENTRY(pushPtrArrayBorrowed);
+    ENTRY(popPtrArray);
+    ENTRY(popPtrArrayView);
+    ENTRY(pushSizeTArray);
+    ENTRY(pushSizeTArrayBorrowed);
+    ENTRY(popSizeTArray);
+    ENTRY(popSizeTArrayView);
+    ENTRY(pushBoolArray);
+    ENTRY(pushBoolArrayBorrowed);
+    ENTRY(popBoolArray);
+    ENTRY(popBoolArrayView);
+    ENTRY(pushInt8Array);
+    ENTRY(pushInt8ArrayBorrowed);
+    ENTRY(popInt8Array);
+    ENTRY(popInt8ArrayView);
+    ENTRY(pushUInt8Array);
+    ENTRY(pushUInt8ArrayBorrowed);
+    ENTRY(popUInt8Array);
+    ENTRY(popUInt8ArrayView);
+    ENTRY(pushInt16Array);
+    ENTRY(pushInt16ArrayBorrowed);
+    ENTRY(popInt16Array);
+    ENTRY(popInt16ArrayView);
+    ENTRY(pushUInt16Array);
+    ENTRY(pushUInt16ArrayBorrowed);
+    ENTRY(popUInt16Array);
+    ENTRY(popUInt16ArrayView);
+    ENTRY(pushInt32Array);
+    ENTRY(pushInt32ArrayBorrowed);
+    ENTRY(popInt32Array);
+    ENTRY(popInt32ArrayView);
+    ENTRY(pushUInt32Array);
+    ENTRY(pushUInt32ArrayBorrowed);
+    ENTRY(popUInt32Array);
+    ENTRY(popUInt32ArrayView);
+    ENTRY(pushInt64Array);
+    ENTRY(pushInt64ArrayBorrowed);
+    ENTRY(popInt64Array);
+    ENTRY(popInt64ArrayView);
+    ENTRY(pushUInt64Array);
+    ENTRY(pushUInt64ArrayBorrowed);
+    ENTRY(popUInt64Array);
+    ENTRY(popUInt64ArrayView);
+    ENTRY(pushFloatArray);
+    ENTRY(pushFloatArrayBorrowed);
+    ENTRY(popFloatArray);
+    ENTRY(popFloatArrayView);
+    ENTRY(pushDoubleArray);
+    ENTRY(pushDoubleArrayBorrowed);
+    ENTRY(popDoubleArray);
+    ENTRY(popDoubleArrayView);
+    ENTRY(pushBitArray);
+    ENTRY(pushBitArrayBorrowed);
+    ENTRY(popBitArray);
+    ENTRY(popBitArrayView);
+    ENTRY(pushStringArray);
+    ENTRY(pushStringArrayBorrowed);
+    ENTRY(popStringArray);
+    ENTRY(popStringArrayView);
+    ENTRY(pushStringArrayBlob);
+    ENTRY(pushStringArrayBlobBorrowed);
+    ENTRY(popStringArrayBlob);
+    ENTRY(getStructType);
+    ENTRY(getStructLayout);
+    ENTRY(pushStruct);
+    ENTRY(popStruct);
+    ENTRY(pushStructArray);
+    ENTRY(pushStructArrayBorrowed);
+    ENTRY(popStructArray);
+    ENTRY(popStructArrayView);
+    ENTRY(pushBuffer);
+    ENTRY(popBuffer);
+    ENTRY(describeBuffer);
+    ENTRY(bufferRegion);
+    ENTRY(bufferSlice);
+    ENTRY(bufferIsContiguous);
+    ENTRY(releaseServerResource);
+    ENTRY(releaseServerResources);
+    ENTRY(clearServerSafetyArea);
+    ENTRY(setException);
+    ENTRY(getModule);
+    ENTRY(getModuleMethod);
+    ENTRY(getInterface);
+    ENTRY(getInterfaceMethod);
+    ENTRY(getException);
+    ENTRY(pushModuleConstants);
+    ENTRY(getModuleCount);
+    ENTRY(getModuleByOrdinal);
+    ENTRY(getModuleMethodCount);
+    ENTRY(getModuleMethodByOrdinal);
+    ENTRY(internString);
+    ENTRY(pushInternedString);
+#undef ENTRY
+    return apiTable;
+}
+
+static const ni_ApiTable directApiTable = makeApiTable(true);
+static const ni_ApiTable exportApiTable = makeApiTable(false);
+static std::atomic<const ni_ApiTable*> activeApiTable{ &exportApiTable };
+static_assert(sizeof(activeApiTable) == sizeof(const ni_ApiTable*) && std::atomic<const ni_ApiTable*>::is_always_lock_free,
+    "getApiTableSlot hands out the atomic as a plain pointer");
+
+// the direct table unless capturing or in out-of-process mode
+// (locked, so that a check made before capture starts or stops can't land after the one made since)
+static void pointApiTable()
+{
+    static std::mutex lock;
+    std::lock_guard<std::mutex> guard(lock);
+    auto direct = !Capture::capturing() && !Remote::connected();
+    activeApiTable.store(direct ? &directApiTable : &exportApiTable, std::memory_order_release);
+}
+
+const ni_ApiTable* getApiTable(uint32_t version)
+{
+    if (version > ni_ApiVersion) {
+        return nullptr;
+    }
+    pointApiTable();
+    return activeApiTable.load(std::memory_order_acquire);
+}
+
+const ni_ApiTable* const* getApiTableSlot(uint32_t version)
+{
+    if (version > ni_ApiVersion) {
+        return nullptr;
+    }
+    pointApiTable();
+    return (const ni_ApiTable* const*)&activeApiTable;
+}
 
 int nativeImplInit(
     niClientFuncExec clientFuncExec,
@@ -8,407 +236,1209 @@ int nativeImplInit(
     niClientResourceRelease clientResourceRelease,
     niClientClearSafetyArea clientClearSafetyArea)
 {
-    return ni_nativeImplInit(
+    // capturing from the very start, so that the module/method lookups the client does up front are in it
+    if (auto capturePath = getenv("NI_CAPTURE")) {
+        if (Capture::start(capturePath)) {
+            Capture::simple(Capture::Op::Init);
+        }
+    }
+    Capture::wrapClientCallbacks(&clientFuncExec, &clientMethodExec, &clientResourceRelease, &clientClearSafetyArea);
+    auto ret = ni_nativeImplInit(
         clientFuncExec,
         clientMethodExec,
         clientResourceRelease,
         clientClearSafetyArea);
+    // (the registrations above happen on this side too, the handles the client looks up are this side's)
+    if (auto hostPath = getenv("NI_REMOTE_HOST")) {
+        if (!Remote::start(hostPath)) {
+            fprintf(stderr, "ni remote: running in-process instead\n");
+        }
+    }
+    pointApiTable();
+    return ret;
 }
 
 void nativeImplShutdown()
 {
+    Remote::stop();
+    if (Capture::capturing()) {
+        Capture::simple(Capture::Op::Shutdown);
+        Capture::stop();
+    }
+    pointApiTable();
     return ni_nativeImplShutdown();
 }
 
+void setClientResourceReleaseBatch(niClientResourceReleaseBatch clientResourceReleaseBatch)
+{
+    if (Capture::capturing() && clientResourceReleaseBatch) {
+        Capture::simple(Capture::Op::UseReleaseBatch);
+    }
+    auto wrapped = Capture::wrapClientResourceReleaseBatch(clientResourceReleaseBatch);
+    ni_setClientResourceReleaseBatch(wrapped);
+    Remote::setClientResourceReleaseBatch(wrapped);
+}
+
 ni_ModuleRef getModule(const char* name)
 {
-    return ni_getModule(name);
+    auto ret = ni_getModule(name);
+    if (Capture::capturing()) {
+        Capture::lookup(ni_RefModule, nullptr, name, ret);
+    }
+    return ret;
 }
 
 ni_ModuleMethodRef getModuleMethod(ni_ModuleRef m, const char* name)
 {
-    return ni_getModuleMethod(m, name);
+    auto ret = ni_getModuleMethod(m, name);
+    if (Capture::capturing()) {
+        Capture::lookup(ni_RefModuleMethod, m, name, ret);
+    }
+    return ret;
 }
 
 ni_InterfaceRef getInterface(ni_ModuleRef m, const char* name)
 {
-    return ni_getInterface(m, name);
+    auto ret = ni_getInterface(m, name);
+    if (Capture::capturing()) {
+        Capture::lookup(ni_RefInterface, m, name, ret);
+    }
+    return ret;
 }
 
 ni_InterfaceMethodRef getInterfaceMethod(ni_InterfaceRef iface, const char* name)
 {
-    return ni_getInterfaceMethod(iface, name);
+    auto ret = ni_getInterfaceMethod(iface, name);
+    if (Capture::capturing()) {
+        Capture::lookup(ni_RefInterfaceMethod, iface, name, ret);
+    }
+    return ret;
 }
 
 ni_ExceptionRef getException(ni_ModuleRef m, const char* name)
 {
-    return ni_getException(m, name);
+    auto ret = ni_getException(m, name);
+    if (Capture::capturing()) {
+        Capture::lookup(ni_RefException, m, name, ret);
+    }
+    return ret;
 }
 
 void pushModuleConstants(ni_ModuleRef m)
 {
-    ni_pushModuleConstants(m);
+    Dispatch::pushModuleConstants(m);
+    if (Capture::capturing()) {
+        Capture::pushModuleConstants(m);
+    }
+}
+
+int getModuleCount()
+{
+    return ni_getModuleCount();
+}
+
+ni_ModuleRef getModuleByOrdinal(int ordinal)
+{
+    auto ret = ni_getModuleByOrdinal(ordinal);
+    if (Capture::capturing()) {
+        Capture::lookupOrdinal(ni_RefModule, nullptr, ordinal, ret);
+    }
+    return ret;
+}
+
+int getModuleMethodCount(ni_ModuleRef m)
+{
+    return ni_getModuleMethodCount(m);
+}
+
+ni_ModuleMethodRef getModuleMethodByOrdinal(ni_ModuleRef m, int ordinal)
+{
+    auto ret = ni_getModuleMethodByOrdinal(m, ordinal);
+    if (Capture::capturing()) {
+        Capture::lookupOrdinal(ni_RefModuleMethod, m, ordinal, ret);
+    }
+    return ret;
 }
 
 void invokeModuleMethod(ni_ModuleMethodRef method)
 {
-    ni_invokeModuleMethod(method);
+    if (Capture::capturing()) {
+        auto recorded = Capture::invokeModuleMethod(false, method);
+        Dispatch::invokeModuleMethod(method);
+        Capture::invokeEnd(recorded, 0);
+        return;
+    }
+    Dispatch::invokeModuleMethod(method);
 }
 
 ni_ExceptionRef invokeModuleMethodWithExceptions(ni_ModuleMethodRef method)
 {
-    return ni_invokeModuleMethodWithExceptions(method);
+    if (Capture::capturing()) {
+        auto recorded = Capture::invokeModuleMethod(true, method);
+        auto ret = Dispatch::invokeModuleMethodWithExceptions(method);
+        Capture::invokeEnd(recorded, (uint64_t)(uintptr_t)ret);
+        return ret;
+    }
+    return Dispatch::invokeModuleMethodWithExceptions(method);
+}
+
+int invokeBatch(const void* buffer, size_t length, ni_BatchResult* results, size_t maxResults)
+{
+    if (Capture::capturing()) {
+        auto recorded = Capture::invokeBatch(buffer, length, maxResults, results != nullptr);
+        auto ret = Dispatch::invokeBatch(buffer, length, results, maxResults);
+        Capture::invokeEnd(recorded, (uint64_t)(int64_t)ret);
+        return ret;
+    }
+    return Dispatch::invokeBatch(buffer, length, results, maxResults);
 }
 
 void pushPtr(void* value)
 {
     ni_pushPtr(value);
+    if (Capture::capturing()) {
+        Capture::scalar(Capture::Op::PushScalar, ni_BatchPtr, value);
+    }
 }
 
 void* popPtr()
 {
-    return ni_popPtr();
+    auto ret = ni_popPtr();
+    if (Capture::capturing()) {
+        Capture::scalar(Capture::Op::PopScalar, ni_BatchPtr, ret);
+    }
+    return ret;
 }
 
 void pushPtrArray(void** values, size_t count)
 {
     ni_pushPtrArray(values, count);
+    if (Capture::capturing()) {
+        Capture::pushArray(ni_BatchPtrArray, false, values, count, sizeof(void*));
+    }
+}
+
+void pushPtrArrayBorrowed(void* const* values, size_t count)
+{
+    ni_pushPtrArrayBorrowed(values, count);
+    if (Capture::capturing()) {
+        Capture::pushArray(ni_BatchPtrArray, true, values, count, sizeof(void*));
+    }
 }
 
 void popPtrArray(void*** values, size_t* count)
 {
     ni_popPtrArray(values, count);
+    if (Capture::capturing()) {
+        Capture::popArray(ni_BatchPtrArray, false, *count);
+    }
+}
+
+void popPtrArrayView(void* const** values, size_t* count)
+{
+    ni_popPtrArrayView(values, count);
+    if (Capture::capturing()) {
+        Capture::popArray(ni_BatchPtrArray, true, *count);
+    }
 }
 
 void pushSizeT(size_t value)
 {
     ni_pushSizeT(value);
+    if (Capture::capturing()) {
+        Capture::scalar(Capture::Op::PushScalar, ni_BatchSizeT, value);
+    }
 }
 
 size_t popSizeT()
 {
-    return ni_popSizeT();
+    auto ret = ni_popSizeT();
+    if (Capture::capturing()) {
+        Capture::scalar(Capture::Op::PopScalar, ni_BatchSizeT, ret);
+    }
+    return ret;
 }
 
 void pushSizeTArray(size_t* values, size_t count)
 {
     ni_pushSizeTArray(values, count);
+    if (Capture::capturing()) {
+        Capture::pushArray(ni_BatchSizeTArray, false, values, count, sizeof(size_t));
+    }
+}
+
+void pushSizeTArrayBorrowed(const size_t* values, size_t count)
+{
+    ni_pushSizeTArrayBorrowed(values, count);
+    if (Capture::capturing()) {
+        Capture::pushArray(ni_BatchSizeTArray, true, values, count, sizeof(size_t));
+    }
 }
 
 void popSizeTArray(size_t** values, size_t* count)
 {
     ni_popSizeTArray(values, count);
+    if (Capture::capturing()) {
+        Capture::popArray(ni_BatchSizeTArray, false, *count);
+    }
+}
+
+void popSizeTArrayView(const size_t** values, size_t* count)
+{
+    ni_popSizeTArrayView(values, count);
+    if (Capture::capturing()) {
+        Capture::popArray(ni_BatchSizeTArray, true, *count);
+    }
 }
 
 void pushBool(bool value)
 {
     ni_pushBool(value);
+    if (Capture::capturing()) {
+        Capture::scalar(Capture::Op::PushScalar, ni_BatchBool, value);
+    }
 }
 
 bool popBool()
 {
-    return ni_popBool();
+    auto ret = ni_popBool();
+    if (Capture::capturing()) {
+        Capture::scalar(Capture::Op::PopScalar, ni_BatchBool, ret);
+    }
+    return ret;
 }
 
 void pushBoolArray(bool* values, size_t count)
 {
     ni_pushBoolArray(values, count);
+    if (Capture::capturing()) {
+        Capture::pushArray(ni_BatchBoolArray, false, values, count, sizeof(bool));
+    }
+}
+
+void pushBoolArrayBorrowed(const bool* values, size_t count)
+{
+    ni_pushBoolArrayBorrowed(values, count);
+    if (Capture::capturing()) {
+        Capture::pushArray(ni_BatchBoolArray, true, values, count, sizeof(bool));
+    }
 }
 
 void popBoolArray(bool** values, size_t* count)
 {
     ni_popBoolArray(values, count);
+    if (Capture::capturing()) {
+        Capture::popArray(ni_BatchBoolArray, false, *count);
+    }
+}
+
+void popBoolArrayView(const bool** values, size_t* count)
+{
+    ni_popBoolArrayView(values, count);
+    if (Capture::capturing()) {
+        Capture::popArray(ni_BatchBoolArray, true, *count);
+    }
+}
+
+void pushBitArray(const uint64_t* words, size_t count)
+{
+    ni_pushBitArray(words, count);
+    if (Capture::capturing()) {
+        Capture::pushArray(ni_BatchBitArray, false, words, count, 0);
+    }
+}
+
+void pushBitArrayBorrowed(const uint64_t* words, size_t count)
+{
+    ni_pushBitArrayBorrowed(words, count);
+    if (Capture::capturing()) {
+        Capture::pushArray(ni_BatchBitArray, true, words, count, 0);
+    }
+}
+
+void popBitArray(uint64_t** words, size_t* count)
+{
+    ni_popBitArray(words, count);
+    if (Capture::capturing()) {
+        Capture::popArray(ni_BatchBitArray, false, *count);
+    }
+}
+
+void popBitArrayView(const uint64_t** words, size_t* count)
+{
+    ni_popBitArrayView(words, count);
+    if (Capture::capturing()) {
+        Capture::popArray(ni_BatchBitArray, true, *count);
+    }
 }
 
 void pushInt8(int8_t x)
 {
     ni_pushInt8(x);
+    if (Capture::capturing()) {
+        Capture::scalar(Capture::Op::PushScalar, ni_BatchInt8, x);
+    }
 }
 
 int8_t popInt8()
 {
-    return ni_popInt8();
+    auto ret = ni_popInt8();
+    if (Capture::capturing()) {
+        Capture::scalar(Capture::Op::PopScalar, ni_BatchInt8, ret);
+    }
+    return ret;
 }
 
 void pushInt8Array(int8_t* values, size_t count)
 {
     ni_pushInt8Array(values, count);
+    if (Capture::capturing()) {
+        Capture::pushArray(ni_BatchInt8Array, false, values, count, sizeof(int8_t));
+    }
+}
+
+void pushInt8ArrayBorrowed(const int8_t* values, size_t count)
+{
+    ni_pushInt8ArrayBorrowed(values, count);
+    if (Capture::capturing()) {
+        Capture::pushArray(ni_BatchInt8Array, true, values, count, sizeof(int8_t));
+    }
 }
 
 void popInt8Array(int8_t** values, size_t* count)
 {
     ni_popInt8Array(values, count);
+    if (Capture::capturing()) {
+        Capture::popArray(ni_BatchInt8Array, false, *count);
+    }
+}
+
+void popInt8ArrayView(const int8_t** values, size_t* count)
+{
+    ni_popInt8ArrayView(values, count);
+    if (Capture::capturing()) {
+        Capture::popArray(ni_BatchInt8Array, true, *count);
+    }
 }
 
 void pushUInt8(uint8_t x)
 {
     ni_pushUInt8(x);
+    if (Capture::capturing()) {
+        Capture::scalar(Capture::Op::PushScalar, ni_BatchUInt8, x);
+    }
 }
 
 uint8_t popUInt8()
 {
-    return ni_popUInt8();
+    auto ret = ni_popUInt8();
+    if (Capture::capturing()) {
+        Capture::scalar(Capture::Op::PopScalar, ni_BatchUInt8, ret);
+    }
+    return ret;
 }
 
 void pushUInt8Array(uint8_t* values, size_t count)
 {
     ni_pushUInt8Array(values, count);
+    if (Capture::capturing()) {
+        Capture::pushArray(ni_BatchUInt8Array, false, values, count, sizeof(uint8_t));
+    }
+}
+
+void pushUInt8ArrayBorrowed(const uint8_t* values, size_t count)
+{
+    ni_pushUInt8ArrayBorrowed(values, count);
+    if (Capture::capturing()) {
+        Capture::pushArray(ni_BatchUInt8Array, true, values, count, sizeof(uint8_t));
+    }
 }
 
 void popUInt8Array(uint8_t** values, size_t* count)
 {
     ni_popUInt8Array(values, count);
+    if (Capture::capturing()) {
+        Capture::popArray(ni_BatchUInt8Array, false, *count);
+    }
+}
+
+void popUInt8ArrayView(const uint8_t** values, size_t* count)
+{
+    ni_popUInt8ArrayView(values, count);
+    if (Capture::capturing()) {
+        Capture::popArray(ni_BatchUInt8Array, true, *count);
+    }
 }
 
 void pushInt16(int16_t x)
 {
     ni_pushInt16(x);
+    if (Capture::capturing()) {
+        Capture::scalar(Capture::Op::PushScalar, ni_BatchInt16, x);
+    }
 }
 
 int16_t popInt16()
 {
-    return ni_popInt16();
+    auto ret = ni_popInt16();
+    if (Capture::capturing()) {
+        Capture::scalar(Capture::Op::PopScalar, ni_BatchInt16, ret);
+    }
+    return ret;
 }
 
 void pushInt16Array(int16_t* values, size_t count)
 {
     ni_pushInt16Array(values, count);
+    if (Capture::capturing()) {
+        Capture::pushArray(ni_BatchInt16Array, false, values, count, sizeof(int16_t));
+    }
+}
+
+void pushInt16ArrayBorrowed(const int16_t* values, size_t count)
+{
+    ni_pushInt16ArrayBorrowed(values, count);
+    if (Capture::capturing()) {
+        Capture::pushArray(ni_BatchInt16Array, true, values, count, sizeof(int16_t));
+    }
 }
 
 void popInt16Array(int16_t** values, size_t* count)
 {
     ni_popInt16Array(values, count);
+    if (Capture::capturing()) {
+        Capture::popArray(ni_BatchInt16Array, false, *count);
+    }
+}
+
+void popInt16ArrayView(const int16_t** values, size_t* count)
+{
+    ni_popInt16ArrayView(values, count);
+    if (Capture::capturing()) {
+        Capture::popArray(ni_BatchInt16Array, true, *count);
+    }
 }
 
 void pushUInt16(uint16_t x)
 {
     ni_pushUInt16(x);
+    if (Capture::capturing()) {
+        Capture::scalar(Capture::Op::PushScalar, ni_BatchUInt16, x);
+    }
 }
 
 uint16_t popUInt16()
 {
-    return ni_popUInt16();
+    auto ret = ni_popUInt16();
+    if (Capture::capturing()) {
+        Capture::scalar(Capture::Op::PopScalar, ni_BatchUInt16, ret);
+    }
+    return ret;
 }
 
 void pushUInt16Array(uint16_t* values, size_t count)
 {
     ni_pushUInt16Array(values, count);
+    if (Capture::capturing()) {
+        Capture::pushArray(ni_BatchUInt16Array, false, values, count, sizeof(uint16_t));
+    }
+}
+
+void pushUInt16ArrayBorrowed(const uint16_t* values, size_t count)
+{
+    ni_pushUInt16ArrayBorrowed(values, count);
+    if (Capture::capturing()) {
+        Capture::pushArray(ni_BatchUInt16Array, true, values, count, sizeof(uint16_t));
+    }
 }
 
 void popUInt16Array(uint16_t** values, size_t* count)
 {
     ni_popUInt16Array(values, count);
+    if (Capture::capturing()) {
+        Capture::popArray(ni_BatchUInt16Array, false, *count);
+    }
+}
+
+void popUInt16ArrayView(const uint16_t** values, size_t* count)
+{
+    ni_popUInt16ArrayView(values, count);
+    if (Capture::capturing()) {
+        Capture::popArray(ni_BatchUInt16Array, true, *count);
+    }
 }
 
 void pushInt32(int32_t x)
 {
     ni_pushInt32(x);
+    if (Capture::capturing()) {
+        Capture::scalar(Capture::Op::PushScalar, ni_BatchInt32, x);
+    }
 }
 
 int32_t popInt32()
 {
-    return ni_popInt32();
+    auto ret = ni_popInt32();
+    if (Capture::capturing()) {
+        Capture::scalar(Capture::Op::PopScalar, ni_BatchInt32, ret);
+    }
+    return ret;
 }
 
 void pushInt32Array(int32_t* values, size_t count)
 {
     ni_pushInt32Array(values, count);
+    if (Capture::capturing()) {
+        Capture::pushArray(ni_BatchInt32Array, false, values, count, sizeof(int32_t));
+    }
+}
+
+void pushInt32ArrayBorrowed(const int32_t* values, size_t count)
+{
+    ni_pushInt32ArrayBorrowed(values, count);
+    if (Capture::capturing()) {
+        Capture::pushArray(ni_BatchInt32Array, true, values, count, sizeof(int32_t));
+    }
 }
 
 void popInt32Array(int32_t** values, size_t* count)
 {
     ni_popInt32Array(values, count);
+    if (Capture::capturing()) {
+        Capture::popArray(ni_BatchInt32Array, false, *count);
+    }
+}
+
+void popInt32ArrayView(const int32_t** values, size_t* count)
+{
+    ni_popInt32ArrayView(values, count);
+    if (Capture::capturing()) {
+        Capture::popArray(ni_BatchInt32Array, true, *count);
+    }
 }
 
 void pushUInt32(uint32_t x)
 {
     ni_pushUInt32(x);
+    if (Capture::capturing()) {
+        Capture::scalar(Capture::Op::PushScalar, ni_BatchUInt32, x);
+    }
 }
 
 uint32_t popUInt32()
 {
-    return ni_popUInt32();
+    auto ret = ni_popUInt32();
+    if (Capture::capturing()) {
+        Capture::scalar(Capture::Op::PopScalar, ni_BatchUInt32, ret);
+    }
+    return ret;
 }
 
 void pushUInt32Array(uint32_t* values, size_t count)
 {
     ni_pushUInt32Array(values, count);
+    if (Capture::capturing()) {
+        Capture::pushArray(ni_BatchUInt32Array, false, values, count, sizeof(uint32_t));
+    }
+}
+
+void pushUInt32ArrayBorrowed(const uint32_t* values, size_t count)
+{
+    ni_pushUInt32ArrayBorrowed(values, count);
+    if (Capture::capturing()) {
+        Capture::pushArray(ni_BatchUInt32Array, true, values, count, sizeof(uint32_t));
+    }
 }
 
 void popUInt32Array(uint32_t** values, size_t* count)
 {
     ni_popUInt32Array(values, count);
+    if (Capture::capturing()) {
+        Capture::popArray(ni_BatchUInt32Array, false, *count);
+    }
+}
+
+void popUInt32ArrayView(const uint32_t** values, size_t* count)
+{
+    ni_popUInt32ArrayView(values, count);
+    if (Capture::capturing()) {
+        Capture::popArray(ni_BatchUInt32Array, true, *count);
+    }
 }
 
 void pushInt64(int64_t x)
 {
     ni_pushInt64(x);
+    if (Capture::capturing()) {
+        Capture::scalar(Capture::Op::PushScalar, ni_BatchInt64, x);
+    }
 }
 
 int64_t popInt64()
 {
-    return ni_popInt64();
+    auto ret = ni_popInt64();
+    if (Capture::capturing()) {
+        Capture::scalar(Capture::Op::PopScalar, ni_BatchInt64, ret);
+    }
+    return ret;
 }
 
 void pushInt64Array(int64_t* values, size_t count)
 {
     ni_pushInt64Array(values, count);
+    if (Capture::capturing()) {
+        Capture::pushArray(ni_BatchInt64Array, false, values, count, sizeof(int64_t));
+    }
+}
+
+void pushInt64ArrayBorrowed(const int64_t* values, size_t count)
+{
+    ni_pushInt64ArrayBorrowed(values, count);
+    if (Capture::capturing()) {
+        Capture::pushArray(ni_BatchInt64Array, true, values, count, sizeof(int64_t));
+    }
 }
 
 void popInt64Array(int64_t** values, size_t* count)
 {
     ni_popInt64Array(values, count);
+    if (Capture::capturing()) {
+        Capture::popArray(ni_BatchInt64Array, false, *count);
+    }
+}
+
+void popInt64ArrayView(const int64_t** values, size_t* count)
+{
+    ni_popInt64ArrayView(values, count);
+    if (Capture::capturing()) {
+        Capture::popArray(ni_BatchInt64Array, true, *count);
+    }
 }
 
 void pushUInt64(uint64_t x)
 {
     ni_pushUInt64(x);
+    if (Capture::capturing()) {
+        Capture::scalar(Capture::Op::PushScalar, ni_BatchUInt64, x);
+    }
 }
 
 uint64_t popUInt64()
 {
-    return ni_popUInt64();
+    auto ret = ni_popUInt64();
+    if (Capture::capturing()) {
+        Capture::scalar(Capture::Op::PopScalar, ni_BatchUInt64, ret);
+    }
+    return ret;
 }
 
 void pushUInt64Array(uint64_t* values, size_t count)
 {
     ni_pushUInt64Array(values, count);
+    if (Capture::capturing()) {
+        Capture::pushArray(ni_BatchUInt64Array, false, values, count, sizeof(uint64_t));
+    }
+}
+
+void pushUInt64ArrayBorrowed(const uint64_t* values, size_t count)
+{
+    ni_pushUInt64ArrayBorrowed(values, count);
+    if (Capture::capturing()) {
+        Capture::pushArray(ni_BatchUInt64Array, true, values, count, sizeof(uint64_t));
+    }
 }
 
 void popUInt64Array(uint64_t** values, size_t* count)
 {
     ni_popUInt64Array(values, count);
+    if (Capture::capturing()) {
+        Capture::popArray(ni_BatchUInt64Array, false, *count);
+    }
+}
+
+void popUInt64ArrayView(const uint64_t** values, size_t* count)
+{
+    ni_popUInt64ArrayView(values, count);
+    if (Capture::capturing()) {
+        Capture::popArray(ni_BatchUInt64Array, true, *count);
+    }
 }
 
 void pushFloat(float x)
 {
     ni_pushFloat(x);
+    if (Capture::capturing()) {
+        Capture::scalar(Capture::Op::PushScalar, ni_BatchFloat, x);
+    }
 }
 
 float popFloat()
 {
-    return ni_popFloat();
+    auto ret = ni_popFloat();
+    if (Capture::capturing()) {
+        Capture::scalar(Capture::Op::PopScalar, ni_BatchFloat, ret);
+    }
+    return ret;
 }
 
 void pushFloatArray(float* values, size_t count)
 {
     ni_pushFloatArray(values, count);
+    if (Capture::capturing()) {
+        Capture::pushArray(ni_BatchFloatArray, false, values, count, sizeof(float));
+    }
+}
+
+void pushFloatArrayBorrowed(const float* values, size_t count)
+{
+    ni_pushFloatArrayBorrowed(values, count);
+    if (Capture::capturing()) {
+        Capture::pushArray(ni_BatchFloatArray, true, values, count, sizeof(float));
+    }
 }
 
 void popFloatArray(float** values, size_t* count)
 {
     ni_popFloatArray(values, count);
+    if (Capture::capturing()) {
+        Capture::popArray(ni_BatchFloatArray, false, *count);
+    }
+}
+
+void popFloatArrayView(const float** values, size_t* count)
+{
+    ni_popFloatArrayView(values, count);
+    if (Capture::capturing()) {
+        Capture::popArray(ni_BatchFloatArray, true, *count);
+    }
 }
 
 void pushDouble(double x)
 {
     ni_pushDouble(x);
+    if (Capture::capturing()) {
+        Capture::scalar(Capture::Op::PushScalar, ni_BatchDouble, x);
+    }
 }
 
 double popDouble()
 {
-    return ni_popDouble();
+    auto ret = ni_popDouble();
+    if (Capture::capturing()) {
+        Capture::scalar(Capture::Op::PopScalar, ni_BatchDouble, ret);
+    }
+    return ret;
 }
 
 void pushDoubleArray(double* values, size_t count)
 {
     ni_pushDoubleArray(values, count);
+    if (Capture::capturing()) {
+        Capture::pushArray(ni_BatchDoubleArray, false, values, count, sizeof(double));
+    }
+}
+
+void pushDoubleArrayBorrowed(const double* values, size_t count)
+{
+    ni_pushDoubleArrayBorrowed(values, count);
+    if (Capture::capturing()) {
+        Capture::pushArray(ni_BatchDoubleArray, true, values, count, sizeof(double));
+    }
 }
 
 void popDoubleArray(double** values, size_t* count)
 {
     ni_popDoubleArray(values, count);
+    if (Capture::capturing()) {
+        Capture::popArray(ni_BatchDoubleArray, false, *count);
+    }
+}
+
+void popDoubleArrayView(const double** values, size_t* count)
+{
+    ni_popDoubleArrayView(values, count);
+    if (Capture::capturing()) {
+        Capture::popArray(ni_BatchDoubleArray, true, *count);
+    }
 }
 
 void pushString(const char* str, size_t length) {
     ni_pushString(str, length);
+    if (Capture::capturing()) {
+        Capture::pushArray(ni_BatchString, false, str, length, 1);
+    }
+}
+
+void pushStringBorrowed(const char* str, size_t length) {
+    ni_pushStringBorrowed(str, length);
+    if (Capture::capturing()) {
+        Capture::pushArray(ni_BatchString, true, str, length, 1);
+    }
+}
+
+int internString(const char* str, size_t length) {
+    return ni_internString(str, length);
+}
+
+bool pushInternedString(int id) {
+    if (!ni_pushInternedString(id)) {
+        return false;
+    }
+    if (Capture::capturing()) {
+        // as the string it stands for, the id means nothing to a replay
+        const char* str;
+        size_t length;
+        ni_getInternedString(id, &str, &length);
+        Capture::pushArray(ni_BatchString, false, str, length, 1);
+    }
+    return true;
 }
 
 void popString(const char** strPtr, size_t* length) {
     ni_popString(strPtr, length);
+    if (Capture::capturing()) {
+        Capture::popArray(ni_BatchString, false, *length);
+    }
+}
+
+void popStringView(const char** strPtr, size_t* length) {
+    ni_popStringView(strPtr, length);
+    if (Capture::capturing()) {
+        Capture::popArray(ni_BatchString, true, *length);
+    }
 }
 
 void pushStringArray(const char** strs, size_t* lengths, size_t count)
 {
     ni_pushStringArray(strs, lengths, count);
+    if (Capture::capturing()) {
+        Capture::pushStringArray(false, strs, lengths, count);
+    }
+}
+
+void pushStringArrayBorrowed(const char* const* strs, const size_t* lengths, size_t count)
+{
+    ni_pushStringArrayBorrowed(strs, lengths, count);
+    if (Capture::capturing()) {
+        Capture::pushStringArray(true, strs, lengths, count);
+    }
 }
 
 void popStringArray(const char*** strs, size_t** lengths, size_t* count)
 {
     ni_popStringArray(strs, lengths, count);
+    if (Capture::capturing()) {
+        Capture::popStringArray(false, *count);
+    }
+}
+
+void popStringArrayView(const char* const** strs, const size_t** lengths, size_t* count)
+{
+    ni_popStringArrayView(strs, lengths, count);
+    if (Capture::capturing()) {
+        Capture::popStringArray(true, *count);
+    }
+}
+
+void pushStringArrayBlob(const char* bytes, const uint64_t* offsets, size_t count)
+{
+    ni_pushStringArrayBlob(bytes, offsets, count);
+    if (Capture::capturing()) {
+        Capture::pushStringArrayBlob(false, bytes, offsets, count);
+    }
+}
+
+void pushStringArrayBlobBorrowed(const char* bytes, const uint64_t* offsets, size_t count)
+{
+    ni_pushStringArrayBlobBorrowed(bytes, offsets, count);
+    if (Capture::capturing()) {
+        Capture::pushStringArrayBlob(true, bytes, offsets, count);
+    }
+}
+
+void popStringArrayBlob(const char** bytes, const uint64_t** offsets, size_t* count)
+{
+    ni_popStringArrayBlob(bytes, offsets, count);
+    if (Capture::capturing()) {
+        Capture::popStringArray(true, *count);
+    }
+}
+
+int getStructType(ni_ModuleRef m, const char* name)
+{
+    auto ret = ni_getStructType(m, name);
+    if (Capture::capturing()) {
+        Capture::lookup(ni_RefStructType, m, name, (const void*)(intptr_t)ret);
+    }
+    return ret;
+}
+
+bool getStructLayout(int typeId, size_t* size, const ni_StructField** fields, size_t* fieldCount)
+{
+    return ni_getStructLayout(typeId, size, fields, fieldCount);
+}
+
+void pushStruct(int typeId, const void* value, size_t size)
+{
+    ni_pushStruct(typeId, value, size);
+    if (Capture::capturing()) {
+        Capture::pushStruct(typeId, value, size);
+    }
+}
+
+void popStruct(int typeId, void* value, size_t size)
+{
+    ni_popStruct(typeId, value, size);
+    if (Capture::capturing()) {
+        Capture::popStruct(typeId, size);
+    }
+}
+
+void pushStructArray(int typeId, const void* values, size_t count)
+{
+    ni_pushStructArray(typeId, values, count);
+    if (Capture::capturing()) {
+        Capture::pushStructArray(typeId, false, values, count);
+    }
+}
+
+void pushStructArrayBorrowed(int typeId, const void* values, size_t count)
+{
+    ni_pushStructArrayBorrowed(typeId, values, count);
+    if (Capture::capturing()) {
+        Capture::pushStructArray(typeId, true, values, count);
+    }
+}
+
+void popStructArray(int typeId, void** values, size_t* count)
+{
+    ni_popStructArray(typeId, values, count);
+    if (Capture::capturing()) {
+        Capture::popStructArray(typeId, false, *count);
+    }
+}
+
+void popStructArrayView(int typeId, const void** values, size_t* count)
+{
+    ni_popStructArrayView(typeId, values, count);
+    if (Capture::capturing()) {
+        Capture::popStructArray(typeId, true, *count);
+    }
 }
 
 void pushBuffer(int id, bool isClientId, ni_BufferDescriptor* descriptor)
 {
     ni_pushBuffer(id, isClientId, descriptor);
+    if (Capture::capturing()) {
+        Capture::buffer(Capture::Op::PushBuffer, id, isClientId, descriptor);
+    }
 }
 
 void popBuffer(int* id, bool* isClientId, ni_BufferDescriptor* descriptor)
 {
     ni_popBuffer(id, isClientId, descriptor);
+    if (Capture::capturing()) {
+        Capture::buffer(Capture::Op::PopBuffer, *id, *isClientId, descriptor);
+    }
+}
+
+bool describeBuffer(ni_BufferDescriptor* descriptor, void* start, int elementSize, int rank, const uint64_t* shape)
+{
+    return ni_describeBuffer(descriptor, start, elementSize, rank, shape);
+}
+
+bool bufferRegion(const ni_BufferDescriptor* buffer, const uint64_t* begin, const uint64_t* extent, ni_BufferDescriptor* view)
+{
+    return ni_bufferRegion(buffer, begin, extent, view);
+}
+
+bool bufferSlice(const ni_BufferDescriptor* buffer, int dim, uint64_t index, ni_BufferDescriptor* view)
+{
+    return ni_bufferSlice(buffer, dim, index, view);
+}
+
+bool bufferIsContiguous(const ni_BufferDescriptor* buffer)
+{
+    return ni_bufferIsContiguous(buffer);
 }
 
 void pushClientFunc(int id)
 {
     ni_pushClientFunc(id);
+    if (Capture::capturing()) {
+        Capture::id(Capture::Op::PushClientFunc, id);
+    }
 }
 
 int popServerFunc()
 {
-    return ni_popServerFunc();
+    auto ret = ni_popServerFunc();
+    if (Capture::capturing()) {
+        Capture::id(Capture::Op::PopServerFunc, ret);
+    }
+    return ret;
 }
 
 void execServerFunc(int id)
 {
-    ni_execServerFunc(id);
+    if (Capture::capturing()) {
+        auto recorded = Capture::execServerFunc(false, id);
+        Dispatch::invokeServerFunc(id);
+        Capture::invokeEnd(recorded, 0);
+        return;
+    }
+    Dispatch::invokeServerFunc(id);
 }
 
 ni_ExceptionRef execServerFuncWithExceptions(int id)
 {
-    return ni_execServerFuncWithExceptions(id);
+    if (Capture::capturing()) {
+        auto recorded = Capture::execServerFunc(true, id);
+        auto ret = Dispatch::invokeServerFuncWithExceptions(id);
+        Capture::invokeEnd(recorded, (uint64_t)(uintptr_t)ret);
+        return ret;
+    }
+    return Dispatch::invokeServerFuncWithExceptions(id);
 }
 
 void invokeInterfaceMethod(ni_InterfaceMethodRef method, int serverID)
 {
-    ni_invokeInterfaceMethod(method, serverID);
+    if (Capture::capturing()) {
+        auto recorded = Capture::invokeInterfaceMethod(false, method, serverID);
+        Dispatch::invokeInterfaceMethod(method, serverID);
+        Capture::invokeEnd(recorded, 0);
+        return;
+    }
+    Dispatch::invokeInterfaceMethod(method, serverID);
 }
 
 ni_ExceptionRef invokeInterfaceMethodWithExceptions(ni_InterfaceMethodRef method, int serverID)
 {
-    return ni_invokeInterfaceMethodWithExceptions(method, serverID);
+    if (Capture::capturing()) {
+        auto recorded = Capture::invokeInterfaceMethod(true, method, serverID);
+        auto ret = Dispatch::invokeInterfaceMethodWithExceptions(method, serverID);
+        Capture::invokeEnd(recorded, (uint64_t)(uintptr_t)ret);
+        return ret;
+    }
+    return Dispatch::invokeInterfaceMethodWithExceptions(method, serverID);
 }
 
 void pushInstance(int id, bool isClientId)
 {
     ni_pushInstance(id, isClientId);
+    if (Capture::capturing()) {
+        Capture::instance(Capture::Op::PushInstance, id, isClientId);
+    }
 }
 
 int popInstance(bool* isClientID)
 {
-    return ni_popInstance(isClientID);
+    auto ret = ni_popInstance(isClientID);
+    if (Capture::capturing()) {
+        Capture::instance(Capture::Op::PopInstance, ret, *isClientID);
+    }
+    return ret;
 }
 
 void pushNull()
 {
     ni_pushNull();
+    if (Capture::capturing()) {
+        Capture::simple(Capture::Op::PushNull);
+    }
 }
 
 void releaseServerResource(int id)
 {
-    ni_releaseServerResource(id);
+    if (Capture::capturing()) {
+        Capture::id(Capture::Op::ReleaseServerResource, id);
+    }
+    Dispatch::releaseServerResource(id);
+}
+
+void releaseServerResources(const int* ids, size_t count)
+{
+    if (Capture::capturing()) {
+        Capture::releaseServerResources(ids, count);
+    }
+    Dispatch::releaseServerResources(ids, count);
 }
 
 void clearServerSafetyArea()
 {
-    ni_clearServerSafetyArea();
+    if (Capture::capturing()) {
+        Capture::simple(Capture::Op::ClearServerSafetyArea);
+    }
+    Dispatch::clearServerSafetyArea();
 }
 
 void dumpTables()
 {
-    ni_dumpTables();
+    Dispatch::dumpTables();
+}
+
+void setTraceLevel(int level)
+{
+    ni_setTraceLevel(level);
+}
+
+void dumpTrace()
+{
+    ni_dumpTrace();
+}
+
+void setProfiling(bool enabled)
+{
+    ni_setProfiling(enabled);
+}
+
+size_t getStats(int format, char* buffer, size_t bufferSize)
+{
+    return ni_getStats(format, buffer, bufferSize);
+}
+
+void resetStats()
+{
+    ni_resetStats();
+}
+
+void setTimeline(bool enabled)
+{
+    ni_setTimeline(enabled);
+}
+
+bool writeTimeline(const char* path)
+{
+    return ni_writeTimeline(path);
+}
+
+bool startCapture(const char* path)
+{
+    auto ret = Capture::start(path);
+    pointApiTable();
+    return ret;
+}
+
+void stopCapture()
+{
+    Capture::stop();
+    pointApiTable();
+}
+
+int remoteHostMain(int argc, char** argv)
+{
+    return Remote::hostMain(argc, argv);
+}
+
+void setRemoteHostLost(void (*handler)(int status))
+{
+    Remote::setHostLostHandler(handler);
 }
 
 void setException(ni_ExceptionRef e)
 {
     ni_setException(e);
+    if (Capture::capturing()) {
+        Capture::setException(e);
+    }
 }
@@ -4,8 +4,12 @@
 #include <cstdint>
 
 #ifdef _WIN32
+#ifdef QTTESTINGSERVER_LIBRARY
 #define QTTESTINGSERVER_EXPORT __declspec(dllexport)
 #else
+#define QTTESTINGSERVER_EXPORT __declspec(dllimport)
+#endif
+#else
 #define QTTESTINGSERVER_EXPORT __attribute__ ((visibility ("default")))
 #endif
 
@@ -17,6 +21,7 @@ extern "C" {
 		niClientClearSafetyArea clientClearSafetyArea
 	);
 	QTTESTINGSERVER_EXPORT void nativeImplShutdown();
+	QTTESTINGSERVER_EXPORT void setClientResourceReleaseBatch(niClientResourceReleaseBatch clientResourceReleaseBatch);
 
 	QTTESTINGSERVER_EXPORT ni_ModuleRef getModule(const char* name);
 	QTTESTINGSERVER_EXPORT ni_ModuleMethodRef getModuleMethod(ni_ModuleRef m, const char* name);
@@ -24,82 +29,141 @@ extern "C" {
 	QTTESTINGSERVER_EXPORT ni_InterfaceMethodRef getInterfaceMethod(ni_InterfaceRef iface, const char* name);
 	QTTESTINGSERVER_EXPORT ni_ExceptionRef getException(ni_ModuleRef m, const char* name);
 	QTTESTINGSERVER_EXPORT void pushModuleConstants(ni_ModuleRef m);
+	QTTESTINGSERVER_EXPORT int getModuleCount();
+	QTTESTINGSERVER_EXPORT ni_ModuleRef getModuleByOrdinal(int ordinal);
+	QTTESTINGSERVER_EXPORT int getModuleMethodCount(ni_ModuleRef m);
+	QTTESTINGSERVER_EXPORT ni_ModuleMethodRef getModuleMethodByOrdinal(ni_ModuleRef m, int ordinal);
 
 	QTTESTINGSERVER_EXPORT void invokeModuleMethod(ni_ModuleMethodRef method);
 	QTTESTINGSERVER_EXPORT ni_ExceptionRef invokeModuleMethodWithExceptions(ni_ModuleMethodRef method);
+	QTTESTINGSERVER_EXPORT int invokeBatch(const void* buffer, size_t length, ni_BatchResult* results, size_t maxResults);
 
 	QTTESTINGSERVER_EXPORT void pushPtr(void* value);
 	QTTESTINGSERVER_EXPORT void* popPtr();
 	QTTESTINGSERVER_EXPORT void pushPtrArray(void** values, size_t count);
+	QTTESTINGSERVER_EXPORT void pushPtrArrayBorrowed(void* const* values, size_t count);
 	QTTESTINGSERVER_EXPORT void popPtrArray(void*** values, size_t* count);
+	QTTESTINGSERVER_EXPORT void popPtrArrayView(void* const** values, size_t* count);
 
 	QTTESTINGSERVER_EXPORT void pushSizeT(size_t value);
 	QTTESTINGSERVER_EXPORT size_t popSizeT();
 	QTTESTINGSERVER_EXPORT void pushSizeTArray(size_t* values, size_t count);
+	QTTESTINGSERVER_EXPORT void pushSizeTArrayBorrowed(const size_t* values, size_t count);
 	QTTESTINGSERVER_EXPORT void popSizeTArray(size_t** values, size_t* count);
+	QTTESTINGSERVER_EXPORT void popSizeTArrayView(const size_t** values, size_t* count);
 
 	QTTESTINGSERVER_EXPORT void pushBool(bool value);
 	QTTESTINGSERVER_EXPORT bool popBool();
-	QTTESTINGSERVER_EXPORT void pushBoolArray(bool* values, size_t count);
+	QTTESTINGSERVER_EXPORT void pushBoolArray(bool* values, size_t count); // (these go across as bit arrays, see ni_pushBoolArray)
+	QTTESTINGSERVER_EXPORT void pushBoolArrayBorrowed(const bool* values, size_t count);
 	QTTESTINGSERVER_EXPORT void popBoolArray(bool** values, size_t* count);
+	QTTESTINGSERVER_EXPORT void popBoolArrayView(const bool** values, size_t* count);
+	QTTESTINGSERVER_EXPORT void pushBitArray(const uint64_t* words, size_t count);
+	QTTESTINGSERVER_EXPORT void pushBitArrayBorrowed(const uint64_t* words, size_t count);
+	QTTESTINGSERVER_EXPORT void popBitArray(uint64_t** words, size_t* count);
+	QTTESTINGSERVER_EXPORT void popBitArrayView(const uint64_t** words, size_t* count);
 
 	QTTESTINGSERVER_EXPORT void pushInt8(int8_t x);
 	QTTESTINGSERVER_EXPORT int8_t popInt8();
 	QTTESTINGSERVER_EXPORT void pushInt8Array(int8_t* values, size_t count);
+	QTTESTINGSERVER_EXPORT void pushInt8ArrayBorrowed(const int8_t* values, size_t count);
 	QTTESTINGSERVER_EXPORT void popInt8Array(int8_t** values, size_t* count);
+	QTTESTINGSERVER_EXPORT void popInt8ArrayView(const int8_t** values, size_t* count);
 
 	QTTESTINGSERVER_EXPORT void pushUInt8(uint8_t x);
 	QTTESTINGSERVER_EXPORT uint8_t popUInt8();
 	QTTESTINGSERVER_EXPORT void pushUInt8Array(uint8_t* values, size_t count);
+	QTTESTINGSERVER_EXPORT void pushUInt8ArrayBorrowed(const uint8_t* values, size_t count);
 	QTTESTINGSERVER_EXPORT void popUInt8Array(uint8_t** values, size_t* count);
+	QTTESTINGSERVER_EXPORT void popUInt8ArrayView(const uint8_t** values, size_t* count);
 
 	QTTESTINGSERVER_EXPORT void pushInt16(int16_t x);
 	QTTESTINGSERVER_EXPORT int16_t popInt16();
 	QTTESTINGSERVER_EXPORT void pushInt16Array(int16_t* values, size_t count);
+	QTTESTINGSERVER_EXPORT void pushInt16ArrayBorrowed(const int16_t* values, size_t count);
 	QTTESTINGSERVER_EXPORT void popInt16Array(int16_t** values, size_t* count);
+	QTTESTINGSERVER_EXPORT void popInt16ArrayView(const int16_t** values, size_t* count);
 
 	QTTESTINGSERVER_EXPORT void pushUInt16(uint16_t x);
 	QTTESTINGSERVER_EXPORT uint16_t popUInt16();
 	QTTESTINGSERVER_EXPORT void pushUInt16Array(uint16_t* values, size_t count);
+	QTTESTINGSERVER_EXPORT void pushUInt16ArrayBorrowed(const uint16_t* values, size_t count);
 	QTTESTINGSERVER_EXPORT void popUInt16Array(uint16_t** values, size_t* count);
+	QTTESTINGSERVER_EXPORT void popUInt16ArrayView(const uint16_t** values, size_t* count);
 
 	QTTESTINGSERVER_EXPORT void pushInt32(int32_t x);
 	QTTESTINGSERVER_EXPORT int32_t popInt32();
 	QTTESTINGSERVER_EXPORT void pushInt32Array(int32_t* values, size_t count);
+	QTTESTINGSERVER_EXPORT void pushInt32ArrayBorrowed(const int32_t* values, size_t count);
 	QTTESTINGSERVER_EXPORT void popInt32Array(int32_t** values, size_t* count);
+	QTTESTINGSERVER_EXPORT void popInt32ArrayView(const int32_t** values, size_t* count);
 
 	QTTESTINGSERVER_EXPORT void pushUInt32(uint32_t x);
 	QTTESTINGSERVER_EXPORT uint32_t popUInt32();
 	QTTESTINGSERVER_EXPORT void pushUInt32Array(uint32_t* values, size_t count);
+	QTTESTINGSERVER_EXPORT void pushUInt32ArrayBorrowed(const uint32_t* values, size_t count);
 	QTTESTINGSERVER_EXPORT void popUInt32Array(uint32_t** values, size_t* count);
+	QTTESTINGSERVER_EXPORT void popUInt32ArrayView(const uint32_t** values, size_t* count);
 
 	QTTESTINGSERVER_EXPORT void pushInt64(int64_t x);
 	QTTESTINGSERVER_EXPORT int64_t popInt64();
 	QTTESTINGSERVER_EXPORT void pushInt64Array(int64_t* values, size_t count);
+	QTTESTINGSERVER_EXPORT void pushInt64ArrayBorrowed(const int64_t* values, size_t count);
 	QTTESTINGSERVER_EXPORT void popInt64Array(int64_t** values, size_t* count);
+	QTTESTINGSERVER_EXPORT void popInt64ArrayView(const int64_t** values, size_t* count);
 
 	QTTESTINGSERVER_EXPORT void pushUInt64(uint64_t x);
 	QTTESTINGSERVER_EXPORT uint64_t popUInt64();
 	QTTESTINGSERVER_EXPORT void pushUInt64Array(uint64_t* values, size_t count);
+	QTTESTINGSERVER_EXPORT void pushUInt64ArrayBorrowed(const uint64_t* values, size_t count);
 	QTTESTINGSERVER_EXPORT void popUInt64Array(uint64_t** values, size_t* count);
+	QTTESTINGSERVER_EXPORT void popUInt64ArrayView(const uint64_t** values, size_t* count);
 
 	QTTESTINGSERVER_EXPORT void pushFloat(float x);
 	QTTESTINGSERVER_EXPORT float popFloat();
 	QTTESTINGSERVER_EXPORT void pushFloatArray(float* values, size_t count);
+	QTTESTINGSERVER_EXPORT void pushFloatArrayBorrowed(const float* values, size_t count);
 	QTTESTINGSERVER_EXPORT void popFloatArray(float** values, size_t* count);
+	QTTESTINGSERVER_EXPORT void popFloatArrayView(const float** values, size_t* count);
 
 	QTTESTINGSERVER_EXPORT void pushDouble(double x);
 	QTTESTINGSERVER_EXPORT double popDouble();
 	QTTESTINGSERVER_EXPORT void pushDoubleArray(double* values, size_t count);
+	QTTESTINGSERVER_EXPORT void pushDoubleArrayBorrowed(const double* values, size_t count);
 	QTTESTINGSERVER_EXPORT void popDoubleArray(double** values, size_t* count);
+	QTTESTINGSERVER_EXPORT void popDoubleArrayView(const double** values, size_t* count);
 
 	QTTESTINGSERVER_EXPORT void pushString(const char* str, size_t length);
+	QTTESTINGSERVER_EXPORT void pushStringBorrowed(const char* str, size_t length);
 	QTTESTINGSERVER_EXPORT void popString(const char** strPtr, size_t* length);
+	QTTESTINGSERVER_EXPORT void popStringView(const char** strPtr, size_t* length);
 	QTTESTINGSERVER_EXPORT void pushStringArray(const char** strs, size_t* lengths, size_t count);
+	QTTESTINGSERVER_EXPORT void pushStringArrayBorrowed(const char* const* strs, const size_t* lengths, size_t count);
 	QTTESTINGSERVER_EXPORT void popStringArray(const char*** strs, size_t** lengths, size_t* count);
+	QTTESTINGSERVER_EXPORT void popStringArrayView(const char* const** strs, const size_t** lengths, size_t* count);
+	QTTESTINGSERVER_EXPORT void pushStringArrayBlob(const char* bytes, const uint64_t* offsets, size_t count);
+	QTTESTINGSERVER_EXPORT void pushStringArrayBlobBorrowed(const char* bytes, const uint64_t* offsets, size_t count);
+	QTTESTINGSERVER_EXPORT void popStringArrayBlob(const char** bytes, const uint64_t** offsets, size_t* count);
+	// see ni_internString (0 once the table is full - keep pushing that string the ordinary way)
+	QTTESTINGSERVER_EXPORT int internString(const char* str, size_t length);
+	QTTESTINGSERVER_EXPORT bool pushInternedString(int id); // false, with nothing pushed, for an unknown id
+
+	QTTESTINGSERVER_EXPORT int getStructType(ni_ModuleRef m, const char* name);
+	QTTESTINGSERVER_EXPORT bool getStructLayout(int typeId, size_t* size, const ni_StructField** fields, size_t* fieldCount);
+	QTTESTINGSERVER_EXPORT void pushStruct(int typeId, const void* value, size_t size);
+	QTTESTINGSERVER_EXPORT void popStruct(int typeId, void* value, size_t size);
+	QTTESTINGSERVER_EXPORT void pushStructArray(int typeId, const void* values, size_t count);
+	QTTESTINGSERVER_EXPORT void pushStructArrayBorrowed(int typeId, const void* values, size_t count);
+	QTTESTINGSERVER_EXPORT void popStructArray(int typeId, void** values, size_t* count);
+	QTTESTINGSERVER_EXPORT void popStructArrayView(int typeId, const void** values, size_t* count);
 
 	QTTESTINGSERVER_EXPORT void pushBuffer(int id, bool isClientId, ni_BufferDescriptor* descriptor);
 	QTTESTINGSERVER_EXPORT void popBuffer(int* id, bool* isClientId, ni_BufferDescriptor* descriptor);
+	// (pure descriptor arithmetic, nothing to capture)
+	QTTESTINGSERVER_EXPORT bool describeBuffer(ni_BufferDescriptor* descriptor, void* start, int elementSize, int rank, const uint64_t* shape);
+	QTTESTINGSERVER_EXPORT bool bufferRegion(const ni_BufferDescriptor* buffer, const uint64_t* begin, const uint64_t* extent, ni_BufferDescriptor* view);
+	QTTESTINGSERVER_EXPORT bool bufferSlice(const ni_BufferDescriptor* buffer, int dim, uint64_t index, ni_BufferDescriptor* view);
+	QTTESTINGSERVER_EXPORT bool bufferIsContiguous(const ni_BufferDescriptor* buffer);
 
 	QTTESTINGSERVER_EXPORT void pushClientFunc(int id);
 	QTTESTINGSERVER_EXPORT int popServerFunc();
@@ -116,10 +180,189 @@ extern "C" {
 	QTTESTINGSERVER_EXPORT void pushNull();
 
 	QTTESTINGSERVER_EXPORT void releaseServerResource(int id);
+	QTTESTINGSERVER_EXPORT void releaseServerResources(const int* ids, size_t count);
 
 	QTTESTINGSERVER_EXPORT void clearServerSafetyArea(); // clear server resources from safety area (protects values being returned with no other shared_ptrs existing)
 
 	QTTESTINGSERVER_EXPORT void dumpTables();
+	QTTESTINGSERVER_EXPORT void setTraceLevel(int level);
+	QTTESTINGSERVER_EXPORT void dumpTrace();
+
+	QTTESTINGSERVER_EXPORT void setProfiling(bool enabled);
+	QTTESTINGSERVER_EXPORT size_t getStats(int format, char* buffer, size_t bufferSize);
+	QTTESTINGSERVER_EXPORT void resetStats();
+	QTTESTINGSERVER_EXPORT void setTimeline(bool enabled);
+	QTTESTINGSERVER_EXPORT bool writeTimeline(const char* path);
+
+	// records everything crossing this boundary on the calling thread to a file, for QtTestingReplay (see capture/Capture.h)
+	QTTESTINGSERVER_EXPORT bool startCapture(const char* path);
+	QTTESTINGSERVER_EXPORT void stopCapture();
+
+	// out-of-process mode (NI_REMOTE_HOST, see remote/Remote.h): the host executable's main, and what to do before the client exits
+	// when the host is lost (status as from waitpid)
+	QTTESTINGSERVER_EXPORT int remoteHostMain(int argc, char** argv);
+	QTTESTINGSERVER_EXPORT void setRemoteHostLost(void (*handler)(int status));
 
 	QTTESTINGSERVER_EXPORT void setException(ni_ExceptionRef e);
+
+	// the per-call part of the above as one table of function pointers, for bindings that would rather resolve a single symbol
+	// there are two, neither of which ever changes: one pointing straight at the core for while none of the exports' own work
+	// is needed (capture, out-of-process mode), and one pointing at the exports - the active one is swapped when that changes,
+	// so load it from the slot (getApiTableSlot) on each call rather than holding on to a table or copying entries out of it
+	// append-only: new entries go at the end along with a version bump, 'size' is the table's size in bytes
+	enum { ni_ApiVersion = 2 };
+	struct ni_ApiTable {
+		uint32_t version;
+		uint32_t size;
+		// invocation
+		void (*invokeModuleMethod)(ni_ModuleMethodRef method);
+		ni_ExceptionRef (*invokeModuleMethodWithExceptions)(ni_ModuleMethodRef method);
+		void (*invokeInterfaceMethod)(ni_InterfaceMethodRef method, int serverID);
+		ni_ExceptionRef (*invokeInterfaceMethodWithExceptions)(ni_InterfaceMethodRef method, int serverID);
+		void (*execServerFunc)(int id);
+		ni_ExceptionRef (*execServerFuncWithExceptions)(int id);
+		int (*invokeBatch)(const void* buffer, size_t length, ni_BatchResult* results, size_t maxResults);
+		// scalars
+		void (*pushPtr)(void* value);
+		void* (*popPtr)();
+		void (*pushSizeT)(size_t value);
+		size_t (*popSizeT)();
+		void (*pushBool)(bool value);
+		bool (*popBool)();
+		void (*pushInt8)(int8_t x);
+		int8_t (*popInt8)();
+		void (*pushUInt8)(uint8_t x);
+		uint8_t (*popUInt8)();
+		void (*pushInt16)(int16_t x);
+		int16_t (*popInt16)();
+		void (*pushUInt16)(uint16_t x);
+		uint16_t (*popUInt16)();
+		void (*pushInt32)(int32_t x);
+		int32_t (*popInt32)();
+		void (*pushUInt32)(uint32_t x);
+		uint32_t (*popUInt32)();
+		void (*pushInt64)(int64_t x);
+		int64_t (*popInt64)();
+		void (*pushUInt64)(uint64_t x);
+		uint64_t (*popUInt64)();
+		void (*pushFloat)(float x);
+		float (*popFloat)();
+		void (*pushDouble)(double x);
+		double (*popDouble)();
+		// instances, function values, null
+		void (*pushInstance)(int id, bool isClientId);
+		int (*popInstance)(bool* isClientId);
+		void (*pushClientFunc)(int id);
+		int (*popServerFunc)();
+		void (*pushNull)();
+		// strings
+		void (*pushString)(const char* str, size_t length);
+		void (*pushStringBorrowed)(const char* str, size_t length);
+		void (*popString)(const char** strPtr, size_t* length);
+		void (*popStringView)(const char** strPtr, size_t* length);
+		// arrays
+		void (*pushPtrArray)(void** values, size_t count);
+		void (*pushPtrArrayBorrowed)(void* const* values, size_t count);
+		void (*popPtrArray)(void*** values, size_t* count);
+		void (*popPtrArrayView)(void* const** values, size_t* count);
+		void (*pushSizeTArray)(size_t* values, size_t count);
+		void (*pushSizeTArrayBorrowed)(const size_t* values, size_t count);
+		void (*popSizeTArray)(size_t** values, size_t* count);
+		void (*popSizeTArrayView)(const size_t** values, size_t* count);
+		void (*pushBoolArray)(bool* values, size_t count);
+		void (*pushBoolArrayBorrowed)(const bool* values, size_t count);
+		void (*popBoolArray)(bool** values, size_t* count);
+		void (*popBoolArrayView)(const bool** values, size_t* count);
+		void (*pushInt8Array)(int8_t* values, size_t count);
+		void (*pushInt8ArrayBorrowed)(const int8_t* values, size_t count);
+		void (*popInt8Array)(int8_t** values, size_t* count);
+		void (*popInt8ArrayView)(const int8_t** values, size_t* count);
+		void (*pushUInt8Array)(uint8_t* values, size_t count);
+		void (*pushUInt8ArrayBorrowed)(const uint8_t* values, size_t count);
+		void (*popUInt8Array)(uint8_t** values, size_t* count);
+		void (*popUInt8ArrayView)(const uint8_t** values, size_t* count);
+		void (*pushInt16Array)(int16_t* values, size_t count);
+		void (*pushInt16ArrayBorrowed)(const int16_t* values, size_t count);
+		void (*popInt16Array)(int16_t** values, size_t* count);
+		void (*popInt16ArrayView)(const int16_t** values, size_t* count);
+		void (*pushUInt16Array)(uint16_t* values, size_t count);
+		void (*pushUInt16ArrayBorrowed)(const uint16_t* values, size_t count);
+		void (*popUInt16Array)(uint16_t** values, size_t* count);
+		void (*popUInt16ArrayView)(const uint16_t** values, size_t* count);
+		void (*pushInt32Array)(int32_t* values, size_t count);
+		void (*pushInt32ArrayBorrowed)(const int32_t* values, size_t count);
+		void (*popInt32Array)(int32_t** values, size_t* count);
+		void (*popInt32ArrayView)(const int32_t** values, size_t* count);
+		void (*pushUInt32Array)(uint32_t* values, size_t count);
+		void (*pushUInt32ArrayBorrowed)(const uint32_t* values, size_t count);
+		void (*popUInt32Array)(uint32_t** values, size_t* count);
+		void (*popUInt32ArrayView)(const uint32_t** values, size_t* count);
+		void (*pushInt64Array)(int64_t* values, size_t count);
+		void (*pushInt64ArrayBorrowed)(const int64_t* values, size_t count);
+		void (*popInt64Array)(int64_t** values, size_t* count);
+		void (*popInt64ArrayView)(const int64_t** values, size_t* count);
+		void (*pushUInt64Array)(uint64_t* values, size_t count);
+		void (*pushUInt64ArrayBorrowed)(const uint64_t* values, size_t count);
+		void (*popUInt64Array)(uint64_t** values, size_t* count);
+		void (*popUInt64ArrayView)(const uint64_t** values, size_t* count);
+		void (*pushFloatArray)(float* values, size_t count);
+		void (*pushFloatArrayBorrowed)(const float* values, size_t count);
+		void (*popFloatArray)(float** values, size_t* count);
+		void (*popFloatArrayView)(const float** values, size_t* count);
+		void (*pushDoubleArray)(double* values, size_t count);
+		void (*pushDoubleArrayBorrowed)(const double* values, size_t count);
+		void (*popDoubleArray)(double** values, size_t* count);
+		void (*popDoubleArrayView)(const double** values, size_t* count);
+		void (*pushBitArray)(const uint64_t* words, size_t count);
+		void (*pushBitArrayBorrowed)(const uint64_t* words, size_t count);
+		void (*popBitArray)(uint64_t** words, size_t* count);
+		void (*popBitArrayView)(const uint64_t** words, size_t* count);
+		void (*pushStringArray)(const char** strs, size_t* lengths, size_t count);
+		void (*pushStringArrayBorrowed)(const char* const* strs, const size_t* lengths, size_t count);
+		void (*popStringArray)(const char*** strs, size_t** lengths, size_t* count);
+		void (*popStringArrayView)(const char* const** strs, const size_t** lengths, size_t* count);
+		void (*pushStringArrayBlob)(const char* bytes, const uint64_t* offsets, size_t count);
+		void (*pushStringArrayBlobBorrowed)(const char* bytes, const uint64_t* offsets, size_t count);
+		void (*popStringArrayBlob)(const char** bytes, const uint64_t** offsets, size_t* count);
+		// structs
+		int (*getStructType)(ni_ModuleRef m, const char* name);
+		bool (*getStructLayout)(int typeId, size_t* size, const ni_StructField** fields, size_t* fieldCount);
+		void (*pushStruct)(int typeId, const void* value, size_t size);
+		void (*popStruct)(int typeId, void* value, size_t size);
+		void (*pushStructArray)(int typeId, const void* values, size_t count);
+		void (*pushStructArrayBorrowed)(int typeId, const void* values, size_t count);
+		void (*popStructArray)(int typeId, void** values, size_t* count);
+		void (*popStructArrayView)(int typeId, const void** values, size_t* count);
+		// buffers
+		void (*pushBuffer)(int id, bool isClientId, ni_BufferDescriptor* descriptor);
+		void (*popBuffer)(int* id, bool* isClientId, ni_BufferDescriptor* descriptor);
+		bool (*describeBuffer)(ni_BufferDescriptor* descriptor, void* start, int elementSize, int rank, const uint64_t* shape);
+		bool (*bufferRegion)(const ni_BufferDescriptor* buffer, const uint64_t* begin, const uint64_t* extent, ni_BufferDescriptor* view);
+		bool (*bufferSlice)(const ni_BufferDescriptor* buffer, int dim, uint64_t index, ni_BufferDescriptor* view);
+		bool (*bufferIsContiguous)(const ni_BufferDescriptor* buffer);
+		// resources, exceptions
+		void (*releaseServerResource)(int id);
+		void (*releaseServerResources)(const int* ids, size_t count);
+		void (*clearServerSafetyArea)();
+		void (*setException)(ni_ExceptionRef e);
+		// lookups
+		ni_ModuleRef (*getModule)(const char* name);
+		ni_ModuleMethodRef (*getModuleMethod)(ni_ModuleRef m, const char* name);
+		ni_InterfaceRef (*getInterface)(ni_ModuleRef m, const char* name);
+		ni_InterfaceMethodRef (*getInterfaceMethod)(ni_InterfaceRef iface, const char* name);
+		ni_ExceptionRef (*getException)(ni_ModuleRef m, const char* name);
+		void (*pushModuleConstants)(ni_ModuleRef m);
+		int (*getModuleCount)();
+		ni_ModuleRef (*getModuleByOrdinal)(int ordinal);
+		int (*getModuleMethodCount)(ni_ModuleRef m);
+		ni_ModuleMethodRef (*getModuleMethodByOrdinal)(ni_ModuleRef m, int ordinal);
+		// version 2: interned strings
+		int (*internString)(const char* str, size_t length);
+		bool (*pushInternedString)(int id);
+	};
+	// null if 'version' is newer than this library's (the table covers every version up to its own)
+	// getApiTable is the table active right now, the slot is where the active one is published (a pointer-sized atomic store,
+	// release ordered - read it with an acquire load)
+	QTTESTINGSERVER_EXPORT const ni_ApiTable* getApiTable(uint32_t version);
+	QTTESTINGSERVER_EXPORT const ni_ApiTable* const* getApiTableSlot(uint32_t version);
 }
@@ -0,0 +1,199 @@
+#include "FastCallExport.h"
+
+#include "core/NativeImplCore.h"
+#include "capture/Capture.h"
+#include "remote/Remote.h"
+#include "../cpp/QtTestingImpl/generated/FastCall.h"
+
+// straight into the implementation, unless something is watching the stack path: a capture has to record the call,
+// a remote host has to run it, and stats/timeline have to time it (see ni_beginDirectCall)
+struct DirectCall {
+    bool entered = !Capture::capturing() && !Remote::connected() && ni_beginDirectCall();
+    ~DirectCall() {
+        if (entered) {
+            ni_endDirectCall();
+        }
+    }
+};
+
+// otherwise it's the same pushes and invocation the client would have made, through the exports above so that capture sees them
+static ni_ModuleMethodRef stackMethod(const char* module, const char* method)
+{
+    return ni_getModuleMethod(ni_getModule(module), method);
+}
+
+static void pushRect(int32_t x, int32_t y, int32_t width, int32_t height)
+{
+    static const int typeId = ni_getStructType(ni_getModule("Common"), "Rect");
+    const int32_t rect[] = { x, y, width, height };
+    pushStruct(typeId, rect, sizeof(rect));
+}
+
+// Widget
+
+void fast_Widget_Handle_setGeometry_overload1(void* _this, int32_t x, int32_t y, int32_t width, int32_t height)
+{
+    DirectCall call;
+    if (call.entered) {
+        FastCall::Widget_Handle_setGeometry_overload1(_this, x, y, width, height);
+        return;
+    }
+    static auto method = stackMethod("Widget", "Handle_setGeometry_overload1");
+    pushInt32(height);
+    pushInt32(width);
+    pushInt32(y);
+    pushInt32(x);
+    pushPtr(_this);
+    invokeModuleMethod(method);
+}
+
+void fast_Widget_Handle_update(void* _this)
+{
+    DirectCall call;
+    if (call.entered) {
+        FastCall::Widget_Handle_update(_this);
+        return;
+    }
+    static auto method = stackMethod("Widget", "Handle_update");
+    pushPtr(_this);
+    invokeModuleMethod(method);
+}
+
+// ModelIndex
+
+int32_t fast_ModelIndex_Handle_row(void* _this)
+{
+    DirectCall call;
+    if (call.entered) {
+        return FastCall::ModelIndex_Handle_row(_this);
+    }
+    static auto method = stackMethod("ModelIndex", "Handle_row");
+    pushPtr(_this);
+    invokeModuleMethod(method);
+    return popInt32();
+}
+
+int32_t fast_ModelIndex_Handle_column(void* _this)
+{
+    DirectCall call;
+    if (call.entered) {
+        return FastCall::ModelIndex_Handle_column(_this);
+    }
+    static auto method = stackMethod("ModelIndex", "Handle_column");
+    pushPtr(_this);
+    invokeModuleMethod(method);
+    return popInt32();
+}
+
+// Painter
+
+void fast_Painter_Handle_fillRect(void* _this, int32_t rect_x, int32_t rect_y, int32_t rect_width, int32_t rect_height, void* brush)
+{
+    DirectCall call;
+    if (call.entered) {
+        FastCall::Painter_Handle_fillRect(_this, rect_x, rect_y, rect_width, rect_height, brush);
+        return;
+    }
+    static auto method = stackMethod("Painter", "Handle_fillRect");
+    pushPtr(brush);
+    pushRect(rect_x, rect_y, rect_width, rect_height);
+    pushPtr(_this);
+    invokeModuleMethod(method);
+}
+
+void fast_Painter_Handle_fillRect_overload1(void* _this, int32_t rect_x, int32_t rect_y, int32_t rect_width, int32_t rect_height, void* color)
+{
+    DirectCall call;
+    if (call.entered) {
+        FastCall::Painter_Handle_fillRect_overload1(_this, rect_x, rect_y, rect_width, rect_height, color);
+        return;
+    }
+    static auto method = stackMethod("Painter", "Handle_fillRect_overload1");
+    pushPtr(color);
+    pushRect(rect_x, rect_y, rect_width, rect_height);
+    pushPtr(_this);
+    invokeModuleMethod(method);
+}
+
+// ProgressBar
+
+void fast_ProgressBar_Handle_setValue(void* _this, int32_t value)
+{
+    DirectCall call;
+    if (call.entered) {
+        FastCall::ProgressBar_Handle_setValue(_this, value);
+        return;
+    }
+    static auto method = stackMethod("ProgressBar", "Handle_setValue");
+    pushInt32(value);
+    pushPtr(_this);
+    invokeModuleMethod(method);
+}
+
+// AbstractSlider
+
+void fast_AbstractSlider_Handle_setMaximum(void* _this, int32_t value)
+{
+    DirectCall call;
+    if (call.entered) {
+        FastCall::AbstractSlider_Handle_setMaximum(_this, value);
+        return;
+    }
+    static auto method = stackMethod("AbstractSlider", "Handle_setMaximum");
+    pushInt32(value);
+    pushPtr(_this);
+    invokeModuleMethod(method);
+}
+
+void fast_AbstractSlider_Handle_setMinimum(void* _this, int32_t value)
+{
+    DirectCall call;
+    if (call.entered) {
+        FastCall::AbstractSlider_Handle_setMinimum(_this, value);
+        return;
+    }
+    static auto method = stackMethod("AbstractSlider", "Handle_setMinimum");
+    pushInt32(value);
+    pushPtr(_this);
+    invokeModuleMethod(method);
+}
+
+void fast_AbstractSlider_Handle_setSliderPosition(void* _this, int32_t pos)
+{
+    DirectCall call;
+    if (call.entered) {
+        FastCall::AbstractSlider_Handle_setSliderPosition(_this, pos);
+        return;
+    }
+    static auto method = stackMethod("AbstractSlider", "Handle_setSliderPosition");
+    pushInt32(pos);
+    pushPtr(_this);
+    invokeModuleMethod(method);
+}
+
+void fast_AbstractSlider_Handle_setValue(void* _this, int32_t value)
+{
+    DirectCall call;
+    if (call.entered) {
+        FastCall::AbstractSlider_Handle_setValue(_this, value);
+        return;
+    }
+    static auto method = stackMethod("AbstractSlider", "Handle_setValue");
+    pushInt32(value);
+    pushPtr(_this);
+    invokeModuleMethod(method);
+}
+
+void fast_AbstractSlider_Handle_setRange(void* _this, int32_t min, int32_t max)
+{
+    DirectCall call;
+    if (call.entered) {
+        FastCall::AbstractSlider_Handle_setRange(_this, min, max);
+        return;
+    }
+    static auto method = stackMethod("AbstractSlider", "Handle_setRange");
+    pushInt32(max);
+    pushInt32(min);
+    pushPtr(_this);
+    invokeModuleMethod(method);
+}
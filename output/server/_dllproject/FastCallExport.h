@@ -0,0 +1,31 @@
+#pragma once
+
+#include "DirectExport.h"
+
+// typed entry points for the methods marked @fastcall in the IDL: arguments and return value straight through as a plain C call,
+// nothing pushed or popped. each does exactly what its module method does (handles as void*, struct arguments spread out into
+// their fields) and the module method stays registered as usual, so that everything else keeps going through the stack
+// while capturing, in out-of-process mode, or with stats/timeline on, these quietly take the stack path themselves (see FastCallExport.cpp)
+extern "C" {
+	// Widget
+	QTTESTINGSERVER_EXPORT void fast_Widget_Handle_setGeometry_overload1(void* _this, int32_t x, int32_t y, int32_t width, int32_t height);
+	QTTESTINGSERVER_EXPORT void fast_Widget_Handle_update(void* _this);
+
+	// ModelIndex
+	QTTESTINGSERVER_EXPORT int32_t fast_ModelIndex_Handle_row(void* _this);
+	QTTESTINGSERVER_EXPORT int32_t fast_ModelIndex_Handle_column(void* _this);
+
+	// Painter
+	QTTESTINGSERVER_EXPORT void fast_Painter_Handle_fillRect(void* _this, int32_t rect_x, int32_t rect_y, int32_t rect_width, int32_t rect_height, void* brush);
+	QTTESTINGSERVER_EXPORT void fast_Painter_Handle_fillRect_overload1(void* _this, int32_t rect_x, int32_t rect_y, int32_t rect_width, int32_t rect_height, void* color);
+
+	// ProgressBar
+	QTTESTINGSERVER_EXPORT void fast_ProgressBar_Handle_setValue(void* _this, int32_t value);
+
+	// AbstractSlider
+	QTTESTINGSERVER_EXPORT void fast_AbstractSlider_Handle_setMaximum(void* _this, int32_t value);
+	QTTESTINGSERVER_EXPORT void fast_AbstractSlider_Handle_setMinimum(void* _this, int32_t value);
+	QTTESTINGSERVER_EXPORT void fast_AbstractSlider_Handle_setSliderPosition(void* _this, int32_t pos);
+	QTTESTINGSERVER_EXPORT void fast_AbstractSlider_Handle_setValue(void* _this, int32_t value);
+	QTTESTINGSERVER_EXPORT void fast_AbstractSlider_Handle_setRange(void* _this, int32_t min, int32_t max);
+}
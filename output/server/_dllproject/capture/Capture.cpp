@@ -0,0 +1,496 @@
+#include "Capture.h"
+
+#include <cstdio>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <utility>
+
+namespace Capture {
+	std::atomic<bool> active = false;
+
+	// everything below is guarded by lock (taken per record, so stop() can come from any thread)
+	static std::mutex lock;
+	static FILE* file = nullptr;
+	static Writer writer;
+	static std::thread::id captureThread;
+	static std::set<std::pair<int, uint64_t>> definedRefs;
+	static uint64_t otherThreadCalls = 0;
+	static constexpr size_t FlushSize = 1 << 20;
+
+	static niClientFuncExec clientFuncExec;
+	static niClientMethodExec clientMethodExec;
+	static niClientResourceRelease clientResourceRelease;
+	static niClientClearSafetyArea clientClearSafetyArea;
+	static niClientResourceReleaseBatch clientResourceReleaseBatch;
+
+	// the lock, held while a record is written - false (and not locked) if there's nothing to record on this thread
+	class Record {
+		std::unique_lock<std::mutex> guard;
+	public:
+		Record() : guard(lock) {
+			if (file && std::this_thread::get_id() != captureThread) {
+				otherThreadCalls++;
+				guard.unlock();
+			}
+			else if (!file) {
+				guard.unlock();
+			}
+		}
+		~Record() {
+			if (guard.owns_lock() && writer.buffer.size() >= FlushSize) {
+				fwrite(writer.buffer.data(), 1, writer.buffer.size(), file);
+				writer.buffer.clear();
+			}
+		}
+		explicit operator bool() const {
+			return guard.owns_lock();
+		}
+	};
+
+	static uint64_t handleValue(int kind, const void* ref) {
+		// struct type ids start from 0, so they're shifted up one to keep 0 meaning none
+		return kind == ni_RefStructType ? (uint64_t)((intptr_t)ref + 1) : (uint64_t)(uintptr_t)ref;
+	}
+
+	// call before starting the record that refers to it
+	static void define(int kind, const void* ref) {
+		auto value = handleValue(kind, ref);
+		if (value == 0 || !definedRefs.insert({ kind, value }).second) {
+			return;
+		}
+		const char *module, *owner, *name;
+		if (!ni_getRefNames(kind, ref, &module, &owner, &name)) {
+			return;
+		}
+		writer.op(Op::DefineRef);
+		writer.u((uint64_t)kind);
+		writer.u(value);
+		writer.str(module);
+		writer.str(owner);
+		writer.str(name);
+	}
+
+	bool start(const char* path) {
+		std::lock_guard<std::mutex> guard(lock);
+		if (file) {
+			return false;
+		}
+		file = fopen(path, "wb");
+		if (!file) {
+			return false;
+		}
+		captureThread = std::this_thread::get_id();
+		definedRefs.clear();
+		otherThreadCalls = 0;
+		writer.buffer.clear();
+		writer.raw(Magic, sizeof(Magic));
+		writer.u(Version);
+		active = true;
+		return true;
+	}
+
+	void stop() {
+		std::lock_guard<std::mutex> guard(lock);
+		if (!file) {
+			return;
+		}
+		active = false;
+		fwrite(writer.buffer.data(), 1, writer.buffer.size(), file);
+		fclose(file);
+		file = nullptr;
+		writer.buffer.clear();
+		writer.buffer.shrink_to_fit();
+		if (otherThreadCalls > 0) {
+			printf("capture: %llu calls from threads other than the capturing one weren't recorded\n", (unsigned long long)otherThreadCalls);
+			fflush(stdout);
+		}
+	}
+
+	// callbacks ====================
+
+	static bool callbackBegin(CallbackKind kind, const void* method, int id) {
+		Record record;
+		if (record) {
+			if (method) {
+				define(ni_RefInterfaceMethod, method);
+			}
+			writer.op(Op::CallbackBegin);
+			writer.buffer.push_back((uint8_t)kind);
+			if (method) {
+				writer.u((uint64_t)(uintptr_t)method);
+			}
+			if (kind != CallbackKind::ClearSafetyArea) {
+				writer.s(id);
+			}
+		}
+		return (bool)record;
+	}
+
+	static void callbackEnd(bool recorded) {
+		Record record;
+		if (recorded && record) {
+			writer.op(Op::CallbackEnd);
+		}
+	}
+
+	static void recordingClientFuncExec(int id) {
+		auto recorded = capturing() && callbackBegin(CallbackKind::ClientFunc, nullptr, id);
+		clientFuncExec(id);
+		callbackEnd(recorded);
+	}
+
+	static void recordingClientMethodExec(ni_InterfaceMethodRef method, int objID) {
+		auto recorded = capturing() && callbackBegin(CallbackKind::ClientMethod, method, objID);
+		clientMethodExec(method, objID);
+		callbackEnd(recorded);
+	}
+
+	static void recordingClientResourceRelease(int id) {
+		auto recorded = capturing() && callbackBegin(CallbackKind::ResourceRelease, nullptr, id);
+		clientResourceRelease(id);
+		callbackEnd(recorded);
+	}
+
+	static void recordingClientClearSafetyArea() {
+		auto recorded = capturing() && callbackBegin(CallbackKind::ClearSafetyArea, nullptr, 0);
+		clientClearSafetyArea();
+		callbackEnd(recorded);
+	}
+
+	static void recordingClientResourceReleaseBatch(const int* ids, size_t count) {
+		bool recorded = false;
+		if (capturing()) {
+			Record record;
+			if (record) {
+				writer.op(Op::CallbackBegin);
+				writer.buffer.push_back((uint8_t)CallbackKind::ResourceReleaseBatch);
+				writer.u(count);
+				for (size_t i = 0; i < count; i++) {
+					writer.s(ids[i]);
+				}
+				recorded = true;
+			}
+		}
+		clientResourceReleaseBatch(ids, count);
+		callbackEnd(recorded);
+	}
+
+	void wrapClientCallbacks(niClientFuncExec* funcExec, niClientMethodExec* methodExec,
+		niClientResourceRelease* resourceRelease, niClientClearSafetyArea* clearSafetyArea)
+	{
+		clientFuncExec = *funcExec;
+		clientMethodExec = *methodExec;
+		clientResourceRelease = *resourceRelease;
+		clientClearSafetyArea = *clearSafetyArea;
+		*funcExec = &recordingClientFuncExec;
+		*methodExec = &recordingClientMethodExec;
+		*resourceRelease = &recordingClientResourceRelease;
+		*clearSafetyArea = &recordingClientClearSafetyArea;
+	}
+
+	niClientResourceReleaseBatch wrapClientResourceReleaseBatch(niClientResourceReleaseBatch releaseBatch) {
+		clientResourceReleaseBatch = releaseBatch;
+		return releaseBatch ? &recordingClientResourceReleaseBatch : nullptr;
+	}
+
+	// client -> server ====================
+
+	void simple(Op op) {
+		Record record;
+		if (record) {
+			writer.op(op);
+		}
+	}
+
+	void id(Op op, int id) {
+		Record record;
+		if (record) {
+			writer.op(op);
+			writer.s(id);
+		}
+	}
+
+	void instance(Op op, int id, bool isClientId) {
+		Record record;
+		if (record) {
+			writer.op(op);
+			writer.s(id);
+			writer.u(isClientId);
+		}
+	}
+
+	void lookup(ni_RefKind kind, const void* parent, const char* name, const void* result) {
+		Record record;
+		if (record) {
+			auto parentKind = kind == ni_RefInterfaceMethod ? ni_RefInterface : ni_RefModule;
+			if (parent) {
+				define(parentKind, parent);
+			}
+			define(kind, result);
+			writer.op(Op::Lookup);
+			writer.u((uint64_t)kind);
+			writer.u(parent ? handleValue(parentKind, parent) : 0);
+			writer.str(name);
+			writer.u(handleValue(kind, result));
+		}
+	}
+
+	void lookupOrdinal(ni_RefKind kind, const void* parent, int ordinal, const void* result) {
+		Record record;
+		if (record) {
+			if (parent) {
+				define(ni_RefModule, parent);
+			}
+			define(kind, result);
+			writer.op(Op::LookupOrdinal);
+			writer.u((uint64_t)kind);
+			writer.u((uint64_t)(uintptr_t)parent);
+			writer.s(ordinal);
+			writer.u((uint64_t)(uintptr_t)result);
+		}
+	}
+
+	void pushModuleConstants(ni_ModuleRef m) {
+		Record record;
+		if (record) {
+			define(ni_RefModule, m);
+			writer.op(Op::PushModuleConstants);
+			writer.u((uint64_t)(uintptr_t)m);
+		}
+	}
+
+	void setException(ni_ExceptionRef e) {
+		Record record;
+		if (record) {
+			define(ni_RefException, e);
+			writer.op(Op::SetException);
+			writer.u((uint64_t)(uintptr_t)e);
+		}
+	}
+
+	void releaseServerResources(const int* ids, size_t count) {
+		Record record;
+		if (record) {
+			writer.op(Op::ReleaseServerResources);
+			writer.u(count);
+			for (size_t i = 0; i < count; i++) {
+				writer.s(ids[i]);
+			}
+		}
+	}
+
+	bool invokeModuleMethod(bool withExceptions, ni_ModuleMethodRef method) {
+		Record record;
+		if (record) {
+			define(ni_RefModuleMethod, method);
+			writer.op(Op::InvokeModuleMethod);
+			writer.u(withExceptions);
+			writer.u((uint64_t)(uintptr_t)method);
+		}
+		return (bool)record;
+	}
+
+	bool invokeInterfaceMethod(bool withExceptions, ni_InterfaceMethodRef method, int serverID) {
+		Record record;
+		if (record) {
+			define(ni_RefInterfaceMethod, method);
+			writer.op(Op::InvokeInterfaceMethod);
+			writer.u(withExceptions);
+			writer.u((uint64_t)(uintptr_t)method);
+			writer.s(serverID);
+		}
+		return (bool)record;
+	}
+
+	bool execServerFunc(bool withExceptions, int id) {
+		Record record;
+		if (record) {
+			writer.op(Op::ExecServerFunc);
+			writer.u(withExceptions);
+			writer.s(id);
+		}
+		return (bool)record;
+	}
+
+	bool invokeBatch(const void* buffer, size_t length, size_t maxResults, bool hasResults) {
+		Record record;
+		if (record) {
+			// the commands' method refs (and the struct types of their args) are defined up front
+			walkBatch(const_cast<void*>(buffer), length,
+				[](ni_BatchCommand& cmd) { define(ni_RefModuleMethod, cmd.method); },
+				[](ni_BatchArg& arg) {
+					if (arg.type == ni_BatchStruct || arg.type == ni_BatchStructArray) {
+						define(ni_RefStructType, (const void*)(intptr_t)arg.id);
+					}
+				},
+				[](int typeId) {
+					size_t size = 0, fieldCount;
+					const ni_StructField* fields;
+					return ni_getStructLayout(typeId, &size, &fields, &fieldCount) ? size : 0;
+				});
+			writer.op(Op::InvokeBatch);
+			writer.blob(buffer, length);
+			writer.u(maxResults);
+			writer.u(hasResults);
+		}
+		return (bool)record;
+	}
+
+	void invokeEnd(bool recorded, uint64_t result) {
+		Record record;
+		if (recorded && record) {
+			writer.op(Op::InvokeEnd);
+			writer.u(result);
+		}
+	}
+
+	void scalarBits(Op op, ni_BatchArgType type, uint64_t bits) {
+		Record record;
+		if (record) {
+			writer.op(op);
+			writer.buffer.push_back(type);
+			switch (type) {
+			case ni_BatchInt8:
+			case ni_BatchInt16:
+			case ni_BatchInt32:
+			case ni_BatchInt64:
+				writer.s((int64_t)bits);
+				break;
+			case ni_BatchFloat: {
+				uint32_t f = (uint32_t)bits;
+				writer.raw(&f, sizeof(f));
+				break;
+			}
+			case ni_BatchDouble:
+				writer.raw(&bits, sizeof(bits));
+				break;
+			default:
+				writer.u(bits);
+			}
+		}
+	}
+
+	void pushArray(ni_BatchArgType type, bool borrowed, const void* values, size_t count, size_t elementSize) {
+		Record record;
+		if (record) {
+			writer.op(Op::PushArray);
+			writer.buffer.push_back(type);
+			writer.u(borrowed);
+			writer.u(count);
+			writer.raw(values, elementSize ? count * elementSize : (count + 63) / 64 * sizeof(uint64_t));
+		}
+	}
+
+	void popArray(ni_BatchArgType type, bool view, size_t count) {
+		Record record;
+		if (record) {
+			writer.op(Op::PopArray);
+			writer.buffer.push_back(type);
+			writer.u(view);
+			writer.u(count);
+		}
+	}
+
+	void pushStringArray(bool borrowed, const char* const* strs, const size_t* lengths, size_t count) {
+		Record record;
+		if (record) {
+			writer.op(Op::PushStringArray);
+			writer.u(borrowed);
+			writer.u(count);
+			for (size_t i = 0; i < count; i++) {
+				writer.blob(strs[i], lengths[i]);
+			}
+		}
+	}
+
+	void pushStringArrayBlob(bool borrowed, const char* bytes, const uint64_t* offsets, size_t count) {
+		Record record;
+		if (record) {
+			writer.op(Op::PushStringArray);
+			writer.u(borrowed);
+			writer.u(count);
+			for (size_t i = 0; i < count; i++) {
+				writer.blob(bytes + offsets[i], (size_t)(offsets[i + 1] - offsets[i]));
+			}
+		}
+	}
+
+	void popStringArray(bool view, size_t count) {
+		Record record;
+		if (record) {
+			writer.op(Op::PopStringArray);
+			writer.u(view);
+			writer.u(count);
+		}
+	}
+
+	void pushStruct(int typeId, const void* value, size_t size) {
+		Record record;
+		if (record) {
+			define(ni_RefStructType, (const void*)(intptr_t)typeId);
+			writer.op(Op::PushStruct);
+			writer.u(handleValue(ni_RefStructType, (const void*)(intptr_t)typeId));
+			writer.blob(value, size);
+		}
+	}
+
+	void popStruct(int typeId, size_t size) {
+		Record record;
+		if (record) {
+			define(ni_RefStructType, (const void*)(intptr_t)typeId);
+			writer.op(Op::PopStruct);
+			writer.u(handleValue(ni_RefStructType, (const void*)(intptr_t)typeId));
+			writer.u(size);
+		}
+	}
+
+	void pushStructArray(int typeId, bool borrowed, const void* values, size_t count) {
+		Record record;
+		if (record) {
+			size_t size = 0, fieldCount;
+			const ni_StructField* fields;
+			ni_getStructLayout(typeId, &size, &fields, &fieldCount);
+			define(ni_RefStructType, (const void*)(intptr_t)typeId);
+			writer.op(Op::PushStructArray);
+			writer.u(handleValue(ni_RefStructType, (const void*)(intptr_t)typeId));
+			writer.u(borrowed);
+			writer.u(count);
+			writer.blob(values, count * size);
+		}
+	}
+
+	void popStructArray(int typeId, bool view, size_t count) {
+		Record record;
+		if (record) {
+			define(ni_RefStructType, (const void*)(intptr_t)typeId);
+			writer.op(Op::PopStructArray);
+			writer.u(handleValue(ni_RefStructType, (const void*)(intptr_t)typeId));
+			writer.u(view);
+			writer.u(count);
+		}
+	}
+
+	void buffer(Op op, int id, bool isClientId, const ni_BufferDescriptor* descriptor) {
+		Record record;
+		if (record) {
+			writer.op(op);
+			writer.s(id);
+			writer.u(isClientId);
+			writer.s(descriptor->elementSize);
+			writer.u(descriptor->totalCount);
+			writer.u(descriptor->totalSize);
+			auto rank = descriptor->rank > 0 && descriptor->rank <= ni_BufferMaxRank ? descriptor->rank : 0;
+			writer.u((uint64_t)rank);
+			for (int i = 0; i < rank; i++) {
+				writer.u(descriptor->shape[i]);
+				writer.u(descriptor->strides[i]);
+			}
+			if (op == Op::PushBuffer) {
+				// the client's memory is gone by replay time, so its contents come along
+				auto withContents = isClientId && descriptor->start;
+				writer.blob(descriptor->start, withContents ? descriptor->totalSize : 0);
+			}
+		}
+	}
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "../core/NativeImplCore.h"
+#include "CaptureFormat.h"
+
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+
+// recording what goes across the DirectExport boundary, to be replayed later without the client (see Replay.cpp)
+// started with NI_CAPTURE=<path> in the environment (from nativeImplInit on), or startCapture(path) at any point after
+// only the thread that started it is recorded - the client's UI thread, normally. calls made on other threads are counted, not recorded
+// with no capture running, each export pays one relaxed load (see capturing())
+//
+// the recording functions below are only called behind capturing(), and do nothing when called on a thread other than the capture's
+// the invocation/callback ones return whether they recorded anything, so that the matching end is written only when the beginning was
+
+namespace Capture {
+	extern std::atomic<bool> active;
+
+	inline bool capturing() {
+		return active.load(std::memory_order_relaxed);
+	}
+
+	// false if a capture is already running, or the file couldn't be created
+	bool start(const char* path);
+	void stop();
+
+	// swaps the client's callbacks for trampolines that record them (and whatever the client does during them) while capturing
+	void wrapClientCallbacks(niClientFuncExec* clientFuncExec, niClientMethodExec* clientMethodExec,
+		niClientResourceRelease* clientResourceRelease, niClientClearSafetyArea* clientClearSafetyArea);
+	niClientResourceReleaseBatch wrapClientResourceReleaseBatch(niClientResourceReleaseBatch clientResourceReleaseBatch);
+
+	void simple(Op op);
+	void id(Op op, int id);
+	void instance(Op op, int id, bool isClientId);
+	void lookup(ni_RefKind kind, const void* parent, const char* name, const void* result);
+	void lookupOrdinal(ni_RefKind kind, const void* parent, int ordinal, const void* result);
+	void pushModuleConstants(ni_ModuleRef m);
+	void setException(ni_ExceptionRef e);
+	void releaseServerResources(const int* ids, size_t count);
+
+	bool invokeModuleMethod(bool withExceptions, ni_ModuleMethodRef method);
+	bool invokeInterfaceMethod(bool withExceptions, ni_InterfaceMethodRef method, int serverID);
+	bool execServerFunc(bool withExceptions, int id);
+	bool invokeBatch(const void* buffer, size_t length, size_t maxResults, bool hasResults);
+	void invokeEnd(bool recorded, uint64_t result);
+
+	// scalars are passed around as their bits, widened to 64 (sign-extended for the signed types)
+	void scalarBits(Op op, ni_BatchArgType type, uint64_t bits);
+	template <typename T>
+	inline void scalar(Op op, ni_BatchArgType type, T value) {
+		if constexpr (std::is_floating_point_v<T>) {
+			uint64_t bits = 0;
+			memcpy(&bits, &value, sizeof(T));
+			scalarBits(op, type, bits);
+		}
+		else if constexpr (std::is_pointer_v<T>) {
+			scalarBits(op, type, (uint64_t)(uintptr_t)value);
+		}
+		else if constexpr (std::is_signed_v<T>) {
+			scalarBits(op, type, (uint64_t)(int64_t)value);
+		}
+		else {
+			scalarBits(op, type, (uint64_t)value);
+		}
+	}
+	void pushArray(ni_BatchArgType type, bool borrowed, const void* values, size_t count, size_t elementSize); // (elementSize 0: bits)
+	void popArray(ni_BatchArgType type, bool view, size_t count);
+	void pushStringArray(bool borrowed, const char* const* strs, const size_t* lengths, size_t count);
+	void pushStringArrayBlob(bool borrowed, const char* bytes, const uint64_t* offsets, size_t count); // (recorded as the above)
+	void popStringArray(bool view, size_t count);
+	void pushStruct(int typeId, const void* value, size_t size);
+	void popStruct(int typeId, size_t size);
+	void pushStructArray(int typeId, bool borrowed, const void* values, size_t count);
+	void popStructArray(int typeId, bool view, size_t count);
+	void buffer(Op op, int id, bool isClientId, const ni_BufferDescriptor* descriptor);
+}
@@ -0,0 +1,261 @@
+#pragma once
+
+#include "../core/NativeImplCore.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// capture files: everything that went across the DirectExport boundary on the capturing (client) thread, see Capture.h
+// layout: the magic + version, then records back to back to the end of the file - each one an Op byte followed by its fields:
+//   integers as LEB128 varints (signed ones zigzagged), float/double as their raw bytes, strings/blobs as a varint length + the bytes
+// handles (module/method/interface/exception refs, struct type ids) are written as the values they had in the capturing process,
+// the first appearance of each preceded by a DefineRef with its names, so that the replayer can look up its own
+
+namespace Capture {
+	constexpr char Magic[4] = { 'N', 'I', 'C', 'P' };
+	constexpr uint32_t Version = 3; // 2: buffer shapes/strides, 3: bit arrays
+
+	enum class Op : uint8_t {
+		DefineRef,              // ni_RefKind, handle, module, owner ("" if none), name
+		Init,                   // the capture was started by nativeImplInit (NI_CAPTURE)
+		Shutdown,
+		UseReleaseBatch,        // the client set a batched release callback
+		Lookup,                 // ni_RefKind, parent handle (0 for modules), name, result handle
+		LookupOrdinal,          // ni_RefKind (module or module method), parent handle, ordinal, result handle
+		PushModuleConstants,    // module handle
+		InvokeModuleMethod,     // withExceptions, method handle ... InvokeEnd
+		InvokeInterfaceMethod,  // withExceptions, method handle, server id ... InvokeEnd
+		ExecServerFunc,         // withExceptions, server id ... InvokeEnd
+		InvokeBatch,            // buffer, maxResults, has results ... InvokeEnd
+		InvokeEnd,              // exception handle (0 if none), or for a batch the command count it returned
+		PushScalar,             // ni_BatchArgType, value
+		PopScalar,              // ni_BatchArgType, value popped
+		PushArray,              // ni_BatchArgType (an ...Array or String), borrowed, element count, elements
+		                        // (for a BitArray: the count in bits, the words they're packed into)
+		PopArray,               // ni_BatchArgType, view, element count
+		PushStringArray,        // borrowed, count, then count x string
+		PopStringArray,         // view, count
+		PushStruct,             // type handle, bytes
+		PopStruct,              // type handle, size
+		PushStructArray,        // type handle, borrowed, count, elements
+		PopStructArray,         // type handle, view, count
+		PushBuffer,             // id, isClientId, descriptor (see below), contents (client buffers only, otherwise empty)
+		PopBuffer,              // id, isClientId, descriptor
+		// (a descriptor being elementSize, totalCount, totalSize, rank, then rank x (shape, stride))
+		PushClientFunc,         // id
+		PopServerFunc,          // id
+		PushInstance,           // id, isClientId
+		PopInstance,            // id, isClientId
+		PushNull,
+		ReleaseServerResource,  // id
+		ReleaseServerResources, // count, ids
+		ClearServerSafetyArea,
+		SetException,           // exception handle
+		CallbackBegin,          // CallbackKind, then by kind (see below) ... CallbackEnd
+		CallbackEnd,
+	};
+
+	enum class CallbackKind : uint8_t {
+		ClientFunc,           // id
+		ClientMethod,         // interface method handle, object id
+		ResourceRelease,      // id
+		ResourceReleaseBatch, // count, ids
+		ClearSafetyArea,
+	};
+
+	struct Writer {
+		std::vector<uint8_t> buffer;
+
+		inline void u(uint64_t value) {
+			while (value >= 0x80) {
+				buffer.push_back((uint8_t)(value | 0x80));
+				value >>= 7;
+			}
+			buffer.push_back((uint8_t)value);
+		}
+		inline void s(int64_t value) {
+			u(((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+		}
+		inline void op(Op op) {
+			buffer.push_back((uint8_t)op);
+		}
+		inline void raw(const void* data, size_t length) {
+			auto bytes = (const uint8_t*)data;
+			buffer.insert(buffer.end(), bytes, bytes + length);
+		}
+		inline void blob(const void* data, size_t length) {
+			u(length);
+			if (length > 0) {
+				raw(data, length);
+			}
+		}
+		inline void str(const char* value) {
+			blob(value, value ? strlen(value) : 0);
+		}
+	};
+
+	// reading past the end (a truncated file) sets failed, and yields zeroes from then on
+	struct Reader {
+		const uint8_t* pos;
+		const uint8_t* end;
+		bool failed = false;
+
+		inline bool atEnd() const {
+			return pos >= end;
+		}
+		inline uint64_t u() {
+			uint64_t value = 0;
+			for (int shift = 0; shift < 64; shift += 7) {
+				if (pos >= end) {
+					failed = true;
+					return 0;
+				}
+				auto byte = *pos++;
+				value |= (uint64_t)(byte & 0x7f) << shift;
+				if (!(byte & 0x80)) {
+					break;
+				}
+			}
+			return value;
+		}
+		inline int64_t s() {
+			auto value = u();
+			return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+		}
+		inline Op op() {
+			return (Op)raw(1)[0];
+		}
+		// (points into the file, so it stays valid for as long as the file contents do - on failure, 8 zero bytes)
+		inline const uint8_t* raw(size_t length) {
+			static const uint8_t zeroes[8] = {};
+			if ((size_t)(end - pos) < length) {
+				failed = true;
+				pos = end;
+				return zeroes;
+			}
+			auto ret = pos;
+			pos += length;
+			return ret;
+		}
+		inline const uint8_t* blob(size_t* length) {
+			*length = (size_t)u();
+			auto data = raw(*length);
+			if (failed) {
+				*length = 0;
+			}
+			return data;
+		}
+		inline std::string str() {
+			size_t length;
+			auto data = blob(&length);
+			return std::string((const char*)data, length);
+		}
+	};
+
+	// walks an invokeBatch buffer (layout in NativeImplCore.h), handing each command and then each of its args to the callbacks
+	// in order - which may modify them (the arg before its payload is sized, so a remapped struct type id is what counts)
+	// structSize(typeId) is a struct type's size, 0 if unknown. false if the buffer is malformed
+	template <typename OnCommand, typename OnArg, typename StructSize>
+	bool walkBatch(void* buffer, size_t length, OnCommand&& onCommand, OnArg&& onArg, StructSize&& structSize) {
+		auto pos = (uint8_t*)buffer;
+		auto end = pos + length;
+		auto padded = [](uint64_t n) { return (n + 7) & ~uint64_t(7); };
+		auto take = [&](uint64_t n) {
+			auto ret = pos;
+			n = padded(n);
+			if (n > (uint64_t)(end - pos)) {
+				return (uint8_t*)nullptr;
+			}
+			pos += n;
+			return ret;
+		};
+		while (pos < end) {
+			auto cmd = (ni_BatchCommand*)take(sizeof(ni_BatchCommand));
+			if (!cmd) {
+				return false;
+			}
+			onCommand(*cmd);
+			for (uint32_t i = 0; i < cmd->argCount; i++) {
+				auto arg = (ni_BatchArg*)take(sizeof(ni_BatchArg));
+				if (!arg) {
+					return false;
+				}
+				onArg(*arg);
+				uint64_t payload = 0;
+				switch (arg->type) {
+				case ni_BatchNull: case ni_BatchInstance: case ni_BatchClientFunc: case ni_BatchServerFunc:
+					break;
+				case ni_BatchBuffer:
+					payload = sizeof(ni_BufferDescriptor);
+					break;
+				case ni_BatchStruct:
+				case ni_BatchStructArray: {
+					auto size = (uint64_t)structSize(arg->id);
+					if (size == 0) {
+						return false;
+					}
+					if (arg->type == ni_BatchStructArray) {
+						auto count = (uint64_t*)take(8);
+						if (!count || *count > (uint64_t)(end - pos) / size) {
+							return false;
+						}
+						size *= *count;
+					}
+					payload = size;
+					break;
+				}
+				case ni_BatchStringArray: {
+					auto count = (uint64_t*)take(8);
+					if (!count || *count > (uint64_t)(end - pos) / 8) {
+						return false;
+					}
+					auto lengths = (uint64_t*)take(*count * 8);
+					for (uint64_t j = 0; j < *count; j++) {
+						if (lengths[j] > (uint64_t)(end - pos) - payload) {
+							return false;
+						}
+						payload += lengths[j];
+					}
+					break;
+				}
+				case ni_BatchBitArray: {
+					auto count = (uint64_t*)take(8);
+					if (!count) {
+						return false;
+					}
+					payload = (*count / 64 + (*count % 64 != 0)) * 8;
+					break;
+				}
+				default: {
+					if (arg->type <= ni_BatchDouble) {
+						payload = sizeof(ni_BatchScalar);
+						break;
+					}
+					uint64_t elementSize;
+					switch (arg->type) {
+					case ni_BatchPtrArray: elementSize = sizeof(void*); break;
+					case ni_BatchSizeTArray: elementSize = sizeof(size_t); break;
+					case ni_BatchBoolArray: elementSize = sizeof(bool); break;
+					case ni_BatchInt8Array: case ni_BatchUInt8Array: case ni_BatchString: elementSize = 1; break;
+					case ni_BatchInt16Array: case ni_BatchUInt16Array: elementSize = 2; break;
+					case ni_BatchInt32Array: case ni_BatchUInt32Array: case ni_BatchFloatArray: elementSize = 4; break;
+					case ni_BatchInt64Array: case ni_BatchUInt64Array: case ni_BatchDoubleArray: elementSize = 8; break;
+					default: return false;
+					}
+					auto count = (uint64_t*)take(8);
+					if (!count || *count > (uint64_t)(end - pos) / elementSize) {
+						return false;
+					}
+					payload = *count * elementSize;
+				}
+				}
+				if (payload > 0 && !take(payload)) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+}
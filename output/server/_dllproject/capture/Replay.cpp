@@ -0,0 +1,1186 @@
+// QtTestingReplay: drives the library from a capture file (see Capture.h) with no client attached
+// usage: QtTestingReplay <capture> [--stats] [--timeline <path>]
+//
+// every recorded client call is made again, in order, with handles looked up by name and server ids/pointers translated
+// to what this run handed out. callbacks the library makes are answered with what the client did during the recorded one:
+// - matched: the next unanswered recorded callback (same kind, target and id) within the call that made it, its body replayed
+// - answered: nothing like it was recorded there, so the stack side of an earlier recording of the same callback
+//   (popping the arguments, pushing its return values) is played back, without whatever else the client did during it
+// recorded callbacks the library never makes (mostly ones that came from user input) are replayed "detached" where they
+// were recorded: the arguments they popped get pushed for them first, and whatever they returned popped afterwards
+// with Qt available, event loops run during a call (Application.exec, dialogs) are pumped the same way whenever they go idle,
+// and told to exit once everything recorded inside them has been replayed
+// client memory behind batched buffer args and popped server buffers isn't captured, those get zeroed stand-ins
+
+#include "../DirectExport.h"
+#include "CaptureFormat.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifdef QT_CORE_LIB
+#include <QCoreApplication>
+#include <QTimer>
+#endif
+
+using namespace Capture;
+
+struct RefDefinition {
+	std::string module, owner, name;
+};
+
+struct Record {
+	Op op;
+	uint8_t type = 0;      // ni_BatchArgType, CallbackKind or ni_RefKind, buffer rank
+	bool flag = false;     // withExceptions / borrowed / view / isClientId / has results
+	int64_t id = 0;        // resource/function/object id, ordinal, buffer element size
+	uint64_t handle = 0;   // module/method/interface/exception/struct type handle, or a scalar's bits
+	uint64_t count = 0;    // element count / size / batch maxResults / InvokeEnd result
+	uint64_t extra = 0;    // lookup parent handle, buffer totalCount
+	uint64_t extra2 = 0;   // lookup result handle, buffer totalSize
+	uint8_t* data = nullptr; // blob (8-byte aligned copy), lookup name
+	size_t length = 0;
+	size_t list = 0;       // first entry in ids / strings / dims
+	size_t end = 0;        // invokes and callbacks: index of the matching end record
+	bool consumed = false; // callbacks: replayed (one way or another)
+};
+
+static std::vector<Record> records;
+static std::vector<RefDefinition> refDefinitions; // by DefineRef record's id
+static std::vector<int64_t> ids;                  // id lists (release batches)
+static std::vector<std::pair<const char*, size_t>> strings; // string array elements
+static std::vector<uint64_t> dims;                // buffer (shape, stride) pairs
+static std::vector<std::unique_ptr<uint64_t[]>> blobs;     // aligned copies of the file's blobs, and zeroed stand-ins
+// direct child callbacks of each invoke/callback record (by index), the top level's at records.size()
+static std::unordered_map<size_t, std::vector<size_t>> children;
+// first recording of each callback (kind, target), for answering ones that weren't recorded where they happen now
+static std::map<std::pair<uint8_t, uint64_t>, size_t> firstRecording;
+
+static std::map<std::pair<int, uint64_t>, uint64_t> liveRefs;  // (ni_RefKind, recorded handle) -> this run's
+static std::unordered_map<uint64_t, uint64_t> recordedInterfaceMethods; // this run's -> recorded
+static std::unordered_map<int64_t, int> serverIds;                      // recorded -> this run's
+static std::unordered_map<uint64_t, uint64_t> pointers;                 // recorded -> this run's
+
+struct Counts {
+	size_t invokes = 0, matched = 0, answered = 0, detached = 0, skipped = 0, unanswerable = 0;
+	size_t popMismatches = 0, unmappedIds = 0;
+	double serverMs = 0;
+} counts;
+
+[[noreturn]] static void fail(const char* format, const char* arg = "") {
+	fprintf(stderr, "QtTestingReplay: ");
+	fprintf(stderr, format, arg);
+	fprintf(stderr, "\n");
+	exit(1);
+}
+
+static uint8_t* alignedCopy(const void* data, size_t length) {
+	blobs.emplace_back(new uint64_t[(length + 7) / 8 + 1]());
+	auto ret = (uint8_t*)blobs.back().get();
+	if (data && length > 0) {
+		memcpy(ret, data, length);
+	}
+	return ret;
+}
+
+// parsing ====================
+
+static bool isInvoke(Op op) {
+	return op == Op::InvokeModuleMethod || op == Op::InvokeInterfaceMethod || op == Op::ExecServerFunc || op == Op::InvokeBatch;
+}
+
+static void readScalar(Reader& r, Record& rec) {
+	rec.type = r.raw(1)[0];
+	switch (rec.type) {
+	case ni_BatchInt8: case ni_BatchInt16: case ni_BatchInt32: case ni_BatchInt64:
+		rec.handle = (uint64_t)r.s();
+		break;
+	case ni_BatchFloat: {
+		uint32_t bits;
+		memcpy(&bits, r.raw(4), 4);
+		rec.handle = bits;
+		break;
+	}
+	case ni_BatchDouble:
+		memcpy(&rec.handle, r.raw(8), 8);
+		break;
+	default:
+		rec.handle = r.u();
+	}
+}
+
+static void readBlob(Reader& r, Record& rec) {
+	size_t length;
+	auto data = r.blob(&length);
+	rec.data = alignedCopy(data, length);
+	rec.length = length;
+}
+
+static void parse(const std::vector<uint8_t>& file) {
+	Reader r{ file.data(), file.data() + file.size() };
+	if (file.size() < sizeof(Magic) || memcmp(r.raw(sizeof(Magic)), Magic, sizeof(Magic)) != 0) {
+		fail("not a capture file");
+	}
+	if (r.u() != Version) {
+		fail("unsupported capture version");
+	}
+	std::vector<size_t> open; // invokes/callbacks still waiting for their end
+	while (!r.atEnd() && !r.failed) {
+		Record rec;
+		rec.op = r.op();
+		switch (rec.op) {
+		case Op::DefineRef:
+			rec.type = (uint8_t)r.u();
+			rec.handle = r.u();
+			rec.id = (int64_t)refDefinitions.size();
+			refDefinitions.push_back({ r.str(), r.str(), r.str() });
+			break;
+		case Op::Init: case Op::Shutdown: case Op::UseReleaseBatch: case Op::PushNull: case Op::ClearServerSafetyArea:
+			break;
+		case Op::Lookup:
+		case Op::LookupOrdinal:
+			rec.type = (uint8_t)r.u();
+			rec.extra = r.u();
+			if (rec.op == Op::Lookup) {
+				readBlob(r, rec);
+			}
+			else {
+				rec.id = r.s();
+			}
+			rec.extra2 = r.u();
+			break;
+		case Op::PushModuleConstants: case Op::SetException:
+			rec.handle = r.u();
+			break;
+		case Op::InvokeModuleMethod:
+			rec.flag = r.u() != 0;
+			rec.handle = r.u();
+			break;
+		case Op::InvokeInterfaceMethod:
+			rec.flag = r.u() != 0;
+			rec.handle = r.u();
+			rec.id = r.s();
+			break;
+		case Op::ExecServerFunc:
+			rec.flag = r.u() != 0;
+			rec.id = r.s();
+			break;
+		case Op::InvokeBatch:
+			readBlob(r, rec);
+			rec.count = r.u();
+			rec.flag = r.u() != 0;
+			break;
+		case Op::InvokeEnd:
+			rec.count = r.u();
+			break;
+		case Op::PushScalar: case Op::PopScalar:
+			readScalar(r, rec);
+			break;
+		case Op::PushArray:
+			rec.type = r.raw(1)[0];
+			rec.flag = r.u() != 0;
+			rec.count = r.u();
+			{
+				// (elements, no length prefix - the size follows from the type)
+				size_t elementSize = 1;
+				switch (rec.type) {
+				case ni_BatchPtrArray: elementSize = sizeof(void*); break;
+				case ni_BatchSizeTArray: elementSize = sizeof(size_t); break;
+				case ni_BatchInt16Array: case ni_BatchUInt16Array: elementSize = 2; break;
+				case ni_BatchInt32Array: case ni_BatchUInt32Array: case ni_BatchFloatArray: elementSize = 4; break;
+				case ni_BatchInt64Array: case ni_BatchUInt64Array: case ni_BatchDoubleArray: elementSize = 8; break;
+				}
+				rec.length = rec.type == ni_BatchBitArray ? (size_t)(rec.count + 63) / 64 * 8 : (size_t)rec.count * elementSize;
+				rec.data = alignedCopy(r.raw(rec.length), r.failed ? 0 : rec.length);
+			}
+			break;
+		case Op::PopArray:
+			rec.type = r.raw(1)[0];
+			rec.flag = r.u() != 0;
+			rec.count = r.u();
+			break;
+		case Op::PushStringArray:
+			rec.flag = r.u() != 0;
+			rec.count = r.u();
+			rec.list = strings.size();
+			for (uint64_t i = 0; i < rec.count && !r.failed; i++) {
+				size_t length;
+				auto data = r.blob(&length);
+				strings.push_back({ (const char*)data, length });
+			}
+			break;
+		case Op::PopStringArray:
+			rec.flag = r.u() != 0;
+			rec.count = r.u();
+			break;
+		case Op::PushStruct:
+			rec.handle = r.u();
+			readBlob(r, rec);
+			break;
+		case Op::PopStruct:
+			rec.handle = r.u();
+			rec.count = r.u();
+			break;
+		case Op::PushStructArray:
+			rec.handle = r.u();
+			rec.flag = r.u() != 0;
+			rec.count = r.u();
+			readBlob(r, rec);
+			break;
+		case Op::PopStructArray:
+			rec.handle = r.u();
+			rec.flag = r.u() != 0;
+			rec.count = r.u();
+			break;
+		case Op::PushBuffer:
+		case Op::PopBuffer:
+			rec.id = r.s();
+			rec.flag = r.u() != 0;
+			rec.handle = (uint64_t)r.s(); // element size
+			rec.extra = r.u();
+			rec.extra2 = r.u();
+			rec.type = (uint8_t)r.u();
+			if (rec.type > ni_BufferMaxRank) {
+				fail("bad buffer rank (corrupt capture?)");
+			}
+			rec.list = dims.size();
+			for (int i = 0; i < rec.type * 2 && !r.failed; i++) {
+				dims.push_back(r.u());
+			}
+			if (rec.op == Op::PushBuffer) {
+				readBlob(r, rec);
+			}
+			break;
+		case Op::PushClientFunc: case Op::PopServerFunc: case Op::ReleaseServerResource:
+			rec.id = r.s();
+			break;
+		case Op::PushInstance: case Op::PopInstance:
+			rec.id = r.s();
+			rec.flag = r.u() != 0;
+			break;
+		case Op::ReleaseServerResources:
+			rec.count = r.u();
+			rec.list = ids.size();
+			for (uint64_t i = 0; i < rec.count && !r.failed; i++) {
+				ids.push_back(r.s());
+			}
+			break;
+		case Op::CallbackBegin:
+			rec.type = r.raw(1)[0];
+			switch ((CallbackKind)rec.type) {
+			case CallbackKind::ClientMethod:
+				rec.handle = r.u();
+				rec.id = r.s();
+				break;
+			case CallbackKind::ClientFunc: case CallbackKind::ResourceRelease:
+				rec.id = r.s();
+				break;
+			case CallbackKind::ResourceReleaseBatch:
+				rec.count = r.u();
+				rec.list = ids.size();
+				for (uint64_t i = 0; i < rec.count && !r.failed; i++) {
+					ids.push_back(r.s());
+				}
+				break;
+			case CallbackKind::ClearSafetyArea:
+				break;
+			}
+			break;
+		case Op::CallbackEnd:
+			break;
+		default:
+			fail("unknown record (corrupt capture?)");
+		}
+		if (r.failed) {
+			fprintf(stderr, "QtTestingReplay: capture is truncated, replaying what's complete\n");
+			break;
+		}
+
+		auto index = records.size();
+		if (isInvoke(rec.op) || rec.op == Op::CallbackBegin) {
+			if (rec.op == Op::CallbackBegin) {
+				children[open.empty() ? SIZE_MAX : open.back()].push_back(index);
+				auto key = std::make_pair(rec.type, rec.type == (uint8_t)CallbackKind::ClientMethod ? rec.handle : (uint64_t)rec.id);
+				firstRecording.emplace(key, index);
+			}
+			open.push_back(index);
+		}
+		else if (rec.op == Op::InvokeEnd || rec.op == Op::CallbackEnd) {
+			// (a capture started or stopped mid-call has unmatched ends/beginnings)
+			auto begin = open.empty() ? SIZE_MAX : open.back();
+			if (begin != SIZE_MAX && (rec.op == Op::CallbackEnd) == (records[begin].op == Op::CallbackBegin)) {
+				records[begin].end = index;
+				open.pop_back();
+			}
+			else {
+				continue;
+			}
+		}
+		records.push_back(rec);
+	}
+	for (auto index : open) {
+		records[index].end = records.size();
+	}
+	// the top level's children are filed under SIZE_MAX while parsing
+	children[records.size()] = std::move(children[SIZE_MAX]);
+	children.erase(SIZE_MAX);
+}
+
+// translation ====================
+
+static uint64_t live(int kind, uint64_t recorded) {
+	if (recorded == 0) {
+		return 0;
+	}
+	auto found = liveRefs.find({ kind, recorded });
+	if (found == liveRefs.end() || found->second == 0) {
+		fail("capture refers to something this library doesn't have (see the lookup errors above)");
+	}
+	return found->second;
+}
+
+template <typename T>
+static T liveRef(int kind, uint64_t recorded) {
+	return (T)(uintptr_t)live(kind, recorded);
+}
+
+static int liveStructType(uint64_t recorded) {
+	return (int)live(ni_RefStructType, recorded) - 1;
+}
+
+static int liveServerId(int64_t recorded) {
+	if (recorded == 0) {
+		return 0;
+	}
+	auto found = serverIds.find(recorded);
+	if (found == serverIds.end()) {
+		counts.unmappedIds++;
+		return (int)recorded;
+	}
+	return found->second;
+}
+
+static void* livePointer(uint64_t recorded) {
+	auto found = pointers.find(recorded);
+	return (void*)(uintptr_t)(found != pointers.end() ? found->second : recorded);
+}
+
+static void define(const Record& rec) {
+	auto& def = refDefinitions[rec.id];
+	auto m = getModule(def.module.c_str());
+	uint64_t value = 0;
+	switch (rec.type) {
+	case ni_RefModule: value = (uintptr_t)m; break;
+	case ni_RefModuleMethod: value = m ? (uintptr_t)getModuleMethod(m, def.name.c_str()) : 0; break;
+	case ni_RefInterface: value = m ? (uintptr_t)getInterface(m, def.name.c_str()) : 0; break;
+	case ni_RefInterfaceMethod: {
+		auto iface = m ? getInterface(m, def.owner.c_str()) : nullptr;
+		value = iface ? (uintptr_t)getInterfaceMethod(iface, def.name.c_str()) : 0;
+		recordedInterfaceMethods[value] = rec.handle;
+		break;
+	}
+	case ni_RefException: value = m ? (uintptr_t)getException(m, def.name.c_str()) : 0; break;
+	case ni_RefStructType: value = m ? (uint64_t)(getStructType(m, def.name.c_str()) + 1) : 0; break;
+	}
+	if (value == 0) {
+		fprintf(stderr, "QtTestingReplay: %s%s%s.%s not found\n", def.module.c_str(), def.owner.empty() ? "" : ".", def.owner.c_str(), def.name.c_str());
+	}
+	liveRefs[{ rec.type, rec.handle }] = value;
+}
+
+static size_t structSize(int typeId) {
+	size_t size = 0, fieldCount;
+	const ni_StructField* fields;
+	return getStructLayout(typeId, &size, &fields, &fieldCount) ? size : 0;
+}
+
+// execution ====================
+
+struct Scope {
+	size_t record; // the invoke/callback it's the inside of (records.size() for the top level)
+	size_t nextChild = 0; // children before this are all consumed
+	int idleTicks = 0;
+};
+static std::vector<Scope> scopes;
+static bool serverCallbackSinceTick = false;
+
+static void run(size_t begin, size_t end);
+static void replayDetached(size_t index);
+
+// runs an invoke/callback's records as a nested scope, then replays whatever callbacks recorded in it didn't come
+static void runScope(size_t index, size_t begin, size_t end) {
+	scopes.push_back({ index });
+	run(begin, end);
+	scopes.pop_back();
+}
+
+template <typename F>
+static void invokeScope(size_t index, F&& invoke) {
+	counts.invokes++;
+	scopes.push_back({ index });
+	auto start = std::chrono::steady_clock::now();
+	invoke();
+	counts.serverMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	// callbacks recorded during the call that this run didn't make, in recorded order
+	for (auto child : children[index]) {
+		if (!records[child].consumed) {
+			replayDetached(child);
+		}
+	}
+	scopes.pop_back();
+}
+
+static void pushScalar(uint8_t type, uint64_t bits) {
+	switch (type) {
+	case ni_BatchPtr: pushPtr(livePointer(bits)); break;
+	case ni_BatchSizeT: pushSizeT((size_t)bits); break;
+	case ni_BatchBool: pushBool(bits != 0); break;
+	case ni_BatchInt8: pushInt8((int8_t)bits); break;
+	case ni_BatchUInt8: pushUInt8((uint8_t)bits); break;
+	case ni_BatchInt16: pushInt16((int16_t)bits); break;
+	case ni_BatchUInt16: pushUInt16((uint16_t)bits); break;
+	case ni_BatchInt32: pushInt32((int32_t)bits); break;
+	case ni_BatchUInt32: pushUInt32((uint32_t)bits); break;
+	case ni_BatchInt64: pushInt64((int64_t)bits); break;
+	case ni_BatchUInt64: pushUInt64(bits); break;
+	case ni_BatchFloat: { float f; uint32_t b = (uint32_t)bits; memcpy(&f, &b, 4); pushFloat(f); break; }
+	case ni_BatchDouble: { double d; memcpy(&d, &bits, 8); pushDouble(d); break; }
+	}
+}
+
+static void popScalar(uint8_t type, uint64_t recorded) {
+	uint64_t bits = 0;
+	switch (type) {
+	case ni_BatchPtr: {
+		auto p = (uint64_t)(uintptr_t)popPtr();
+		pointers[recorded] = p;
+		return;
+	}
+	case ni_BatchSizeT: bits = popSizeT(); break;
+	case ni_BatchBool: bits = popBool(); break;
+	case ni_BatchInt8: bits = (uint64_t)(int64_t)popInt8(); break;
+	case ni_BatchUInt8: bits = popUInt8(); break;
+	case ni_BatchInt16: bits = (uint64_t)(int64_t)popInt16(); break;
+	case ni_BatchUInt16: bits = popUInt16(); break;
+	case ni_BatchInt32: bits = (uint64_t)(int64_t)popInt32(); break;
+	case ni_BatchUInt32: bits = popUInt32(); break;
+	case ni_BatchInt64: bits = (uint64_t)popInt64(); break;
+	case ni_BatchUInt64: bits = popUInt64(); break;
+	case ni_BatchFloat: { auto f = popFloat(); uint32_t b; memcpy(&b, &f, 4); bits = b; break; }
+	case ni_BatchDouble: { auto d = popDouble(); memcpy(&bits, &d, 8); break; }
+	}
+	if (bits != recorded) {
+		counts.popMismatches++;
+	}
+}
+
+static void pushArrayRecord(const Record& rec) {
+	auto count = (size_t)rec.count;
+	auto b = rec.flag;
+	switch (rec.type) {
+	case ni_BatchPtrArray: {
+		// pointers go through the same translation as single ones (and are copied for it, so never borrowed)
+		auto values = (void**)alignedCopy(nullptr, count * sizeof(void*));
+		for (size_t i = 0; i < count; i++) {
+			values[i] = livePointer(((const uint64_t*)rec.data)[i]);
+		}
+		pushPtrArray(values, count);
+		break;
+	}
+	case ni_BatchSizeTArray: b ? pushSizeTArrayBorrowed((size_t*)rec.data, count) : pushSizeTArray((size_t*)rec.data, count); break;
+	case ni_BatchBoolArray: b ? pushBoolArrayBorrowed((bool*)rec.data, count) : pushBoolArray((bool*)rec.data, count); break;
+	case ni_BatchInt8Array: b ? pushInt8ArrayBorrowed((int8_t*)rec.data, count) : pushInt8Array((int8_t*)rec.data, count); break;
+	case ni_BatchUInt8Array: b ? pushUInt8ArrayBorrowed((uint8_t*)rec.data, count) : pushUInt8Array((uint8_t*)rec.data, count); break;
+	case ni_BatchInt16Array: b ? pushInt16ArrayBorrowed((int16_t*)rec.data, count) : pushInt16Array((int16_t*)rec.data, count); break;
+	case ni_BatchUInt16Array: b ? pushUInt16ArrayBorrowed((uint16_t*)rec.data, count) : pushUInt16Array((uint16_t*)rec.data, count); break;
+	case ni_BatchInt32Array: b ? pushInt32ArrayBorrowed((int32_t*)rec.data, count) : pushInt32Array((int32_t*)rec.data, count); break;
+	case ni_BatchUInt32Array: b ? pushUInt32ArrayBorrowed((uint32_t*)rec.data, count) : pushUInt32Array((uint32_t*)rec.data, count); break;
+	case ni_BatchInt64Array: b ? pushInt64ArrayBorrowed((int64_t*)rec.data, count) : pushInt64Array((int64_t*)rec.data, count); break;
+	case ni_BatchUInt64Array: b ? pushUInt64ArrayBorrowed((uint64_t*)rec.data, count) : pushUInt64Array((uint64_t*)rec.data, count); break;
+	case ni_BatchFloatArray: b ? pushFloatArrayBorrowed((float*)rec.data, count) : pushFloatArray((float*)rec.data, count); break;
+	case ni_BatchDoubleArray: b ? pushDoubleArrayBorrowed((double*)rec.data, count) : pushDoubleArray((double*)rec.data, count); break;
+	case ni_BatchString: b ? pushStringBorrowed((const char*)rec.data, count) : pushString((const char*)rec.data, count); break;
+	case ni_BatchBitArray: b ? pushBitArrayBorrowed((uint64_t*)rec.data, count) : pushBitArray((uint64_t*)rec.data, count); break;
+	}
+}
+
+static void popArrayRecord(const Record& rec) {
+	size_t count = 0;
+	// (views and copies alike go back to the library's arena, nothing to free)
+	if (rec.type == ni_BatchString) {
+		const char* str;
+		rec.flag ? popStringView(&str, &count) : popString(&str, &count);
+	}
+	else if (rec.flag) {
+		const void* values;
+		switch (rec.type) {
+		case ni_BatchPtrArray: popPtrArrayView((void* const**)&values, &count); break;
+		case ni_BatchSizeTArray: popSizeTArrayView((const size_t**)&values, &count); break;
+		case ni_BatchBoolArray: popBoolArrayView((const bool**)&values, &count); break;
+		case ni_BatchInt8Array: popInt8ArrayView((const int8_t**)&values, &count); break;
+		case ni_BatchUInt8Array: popUInt8ArrayView((const uint8_t**)&values, &count); break;
+		case ni_BatchInt16Array: popInt16ArrayView((const int16_t**)&values, &count); break;
+		case ni_BatchUInt16Array: popUInt16ArrayView((const uint16_t**)&values, &count); break;
+		case ni_BatchInt32Array: popInt32ArrayView((const int32_t**)&values, &count); break;
+		case ni_BatchUInt32Array: popUInt32ArrayView((const uint32_t**)&values, &count); break;
+		case ni_BatchInt64Array: popInt64ArrayView((const int64_t**)&values, &count); break;
+		case ni_BatchUInt64Array: popUInt64ArrayView((const uint64_t**)&values, &count); break;
+		case ni_BatchFloatArray: popFloatArrayView((const float**)&values, &count); break;
+		case ni_BatchDoubleArray: popDoubleArrayView((const double**)&values, &count); break;
+		case ni_BatchBitArray: popBitArrayView((const uint64_t**)&values, &count); break;
+		}
+	}
+	else {
+		void* values;
+		switch (rec.type) {
+		case ni_BatchPtrArray: popPtrArray((void***)&values, &count); break;
+		case ni_BatchSizeTArray: popSizeTArray((size_t**)&values, &count); break;
+		case ni_BatchBoolArray: popBoolArray((bool**)&values, &count); break;
+		case ni_BatchInt8Array: popInt8Array((int8_t**)&values, &count); break;
+		case ni_BatchUInt8Array: popUInt8Array((uint8_t**)&values, &count); break;
+		case ni_BatchInt16Array: popInt16Array((int16_t**)&values, &count); break;
+		case ni_BatchUInt16Array: popUInt16Array((uint16_t**)&values, &count); break;
+		case ni_BatchInt32Array: popInt32Array((int32_t**)&values, &count); break;
+		case ni_BatchUInt32Array: popUInt32Array((uint32_t**)&values, &count); break;
+		case ni_BatchInt64Array: popInt64Array((int64_t**)&values, &count); break;
+		case ni_BatchUInt64Array: popUInt64Array((uint64_t**)&values, &count); break;
+		case ni_BatchFloatArray: popFloatArray((float**)&values, &count); break;
+		case ni_BatchDoubleArray: popDoubleArray((double**)&values, &count); break;
+		case ni_BatchBitArray: popBitArray((uint64_t**)&values, &count); break;
+		}
+	}
+	if (count != rec.count) {
+		counts.popMismatches++;
+	}
+}
+
+static void pushStringArrayRecord(const Record& rec) {
+	std::vector<const char*> strs;
+	std::vector<size_t> lengths;
+	for (size_t i = 0; i < rec.count; i++) {
+		strs.push_back(strings[rec.list + i].first);
+		lengths.push_back(strings[rec.list + i].second);
+	}
+	// (the strings point into the capture file, which outlives everything)
+	if (rec.flag) {
+		pushStringArrayBorrowed(strs.data(), lengths.data(), strs.size());
+	}
+	else {
+		pushStringArray(strs.data(), lengths.data(), strs.size());
+	}
+}
+
+static ni_BufferDescriptor bufferDescriptor(const Record& rec) {
+	ni_BufferDescriptor descriptor{};
+	descriptor.elementSize = (int)rec.handle;
+	descriptor.totalCount = (size_t)rec.extra;
+	descriptor.totalSize = (size_t)rec.extra2;
+	descriptor.rank = rec.type;
+	for (int i = 0; i < descriptor.rank; i++) {
+		descriptor.shape[i] = dims[rec.list + i * 2];
+		descriptor.strides[i] = dims[rec.list + i * 2 + 1];
+	}
+	return descriptor;
+}
+
+static void pushBufferRecord(const Record& rec) {
+	auto descriptor = bufferDescriptor(rec);
+	if (rec.flag) {
+		// the client's buffer, as it was when pushed (or zeroed, for one the capture couldn't see into)
+		descriptor.start = rec.length > 0 ? rec.data : alignedCopy(nullptr, descriptor.totalSize);
+	}
+	pushBuffer(rec.flag ? (int)rec.id : liveServerId(rec.id), rec.flag, &descriptor);
+}
+
+static void invokeBatchRecord(size_t index) {
+	auto& rec = records[index];
+	// translated in a copy, so that a record replayed more than once starts from the recorded values each time
+	auto buffer = alignedCopy(rec.data, rec.length);
+	walkBatch(buffer, rec.length,
+		[](ni_BatchCommand& cmd) { cmd.method = liveRef<ni_ModuleMethodRef>(ni_RefModuleMethod, (uint64_t)(uintptr_t)cmd.method); },
+		[](ni_BatchArg& arg) {
+			if ((arg.type == ni_BatchInstance || arg.type == ni_BatchBuffer) && !arg.isClientId) {
+				arg.id = liveServerId(arg.id);
+			}
+			else if (arg.type == ni_BatchServerFunc) {
+				arg.id = liveServerId(arg.id);
+			}
+			else if (arg.type == ni_BatchStruct || arg.type == ni_BatchStructArray) {
+				arg.id = liveStructType((uint64_t)arg.id + 1);
+			}
+			else if (arg.type == ni_BatchPtr) {
+				auto scalar = (ni_BatchScalar*)(&arg + 1);
+				scalar->ptr = livePointer((uint64_t)(uintptr_t)scalar->ptr);
+			}
+			else if (arg.type == ni_BatchBuffer && arg.isClientId) {
+				auto descriptor = (ni_BufferDescriptor*)(&arg + 1);
+				descriptor->start = alignedCopy(nullptr, descriptor->totalSize);
+			}
+		},
+		structSize);
+	std::vector<ni_BatchResult> results(rec.flag ? (size_t)rec.count : 0);
+	invokeScope(index, [&] {
+		invokeBatch(buffer, rec.length, rec.flag ? results.data() : nullptr, (size_t)rec.count);
+	});
+}
+
+static bool isPop(Op op) {
+	switch (op) {
+	case Op::PopScalar: case Op::PopArray: case Op::PopStringArray: case Op::PopStruct: case Op::PopStructArray:
+	case Op::PopBuffer: case Op::PopServerFunc: case Op::PopInstance:
+		return true;
+	default:
+		return false;
+	}
+}
+
+static bool isPush(Op op) {
+	switch (op) {
+	case Op::PushScalar: case Op::PushArray: case Op::PushStringArray: case Op::PushStruct: case Op::PushStructArray:
+	case Op::PushBuffer: case Op::PushClientFunc: case Op::PushInstance: case Op::PushNull:
+		return true;
+	default:
+		return false;
+	}
+}
+
+// what the client's generated code does in a callback: pops every argument first, pushes the return values last
+static void argumentsAndReturns(size_t index, size_t* argsEnd, size_t* returnsBegin) {
+	auto& rec = records[index];
+	auto i = index + 1;
+	while (i < rec.end && isPop(records[i].op)) {
+		i++;
+	}
+	*argsEnd = i;
+	auto j = rec.end;
+	while (j > i && isPush(records[j - 1].op)) {
+		j--;
+	}
+	*returnsBegin = j;
+}
+
+// pushes what a recorded pop took off the stack (zeroes for contents the capture doesn't have) - false if it can't
+static bool pushPopped(const Record& rec) {
+	switch (rec.op) {
+	case Op::PopScalar:
+		pushScalar(rec.type, rec.type == ni_BatchPtr ? (uint64_t)(uintptr_t)livePointer(rec.handle) : rec.handle);
+		return true;
+	case Op::PopArray: {
+		auto zeroes = alignedCopy(nullptr, (size_t)rec.count * 8);
+		Record push = rec;
+		push.flag = false;
+		push.data = zeroes;
+		pushArrayRecord(push);
+		return true;
+	}
+	case Op::PopStringArray: {
+		std::vector<const char*> strs(rec.count, "");
+		std::vector<size_t> lengths(rec.count, 0);
+		pushStringArray(strs.data(), lengths.data(), strs.size());
+		return true;
+	}
+	case Op::PopStruct: {
+		pushStruct(liveStructType(rec.handle), alignedCopy(nullptr, (size_t)rec.count), (size_t)rec.count);
+		return true;
+	}
+	case Op::PopStructArray: {
+		auto typeId = liveStructType(rec.handle);
+		pushStructArray(typeId, alignedCopy(nullptr, (size_t)rec.count * structSize(typeId)), (size_t)rec.count);
+		return true;
+	}
+	case Op::PopBuffer: {
+		auto descriptor = bufferDescriptor(rec);
+		descriptor.start = alignedCopy(nullptr, descriptor.totalSize);
+		pushBuffer(rec.flag ? (int)rec.id : liveServerId(rec.id), rec.flag, &descriptor);
+		return true;
+	}
+	case Op::PopInstance:
+		pushInstance(rec.flag ? (int)rec.id : liveServerId(rec.id), rec.flag);
+		return true;
+	default:
+		// (server function values can't be pushed from the client side)
+		return false;
+	}
+}
+
+// pops what a recorded push put on the stack - false if it can't
+static bool popPushed(const Record& rec) {
+	switch (rec.op) {
+	case Op::PushScalar:
+		popScalar(rec.type, rec.handle);
+		return true;
+	case Op::PushArray: {
+		Record pop = rec;
+		pop.op = Op::PopArray;
+		pop.flag = true;
+		popArrayRecord(pop);
+		return true;
+	}
+	case Op::PushStringArray: {
+		const char* const* strs;
+		const size_t* lengths;
+		size_t count;
+		popStringArrayView(&strs, &lengths, &count);
+		return true;
+	}
+	case Op::PushStruct: {
+		popStruct(liveStructType(rec.handle), alignedCopy(nullptr, rec.length), rec.length);
+		return true;
+	}
+	case Op::PushStructArray: {
+		const void* values;
+		size_t count;
+		popStructArrayView(liveStructType(rec.handle), &values, &count);
+		return true;
+	}
+	case Op::PushBuffer: {
+		int id;
+		bool isClientId;
+		ni_BufferDescriptor descriptor;
+		popBuffer(&id, &isClientId, &descriptor);
+		return true;
+	}
+	case Op::PushInstance:
+	case Op::PushNull: {
+		bool isClientId;
+		popInstance(&isClientId);
+		return true;
+	}
+	default:
+		return false;
+	}
+}
+
+static void replayDetached(size_t index) {
+	auto& rec = records[index];
+	rec.consumed = true;
+	size_t argsEnd, returnsBegin;
+	argumentsAndReturns(index, &argsEnd, &returnsBegin);
+	for (auto i = index + 1; i < argsEnd; i++) {
+		if (!isPop(records[i].op) || (records[i].op == Op::PopServerFunc)) {
+			counts.skipped++;
+			return;
+		}
+	}
+	for (auto i = returnsBegin; i < rec.end; i++) {
+		if (records[i].op == Op::PushClientFunc) {
+			counts.skipped++;
+			return;
+		}
+	}
+	counts.detached++;
+	for (auto i = argsEnd; i > index + 1; i--) {
+		pushPopped(records[i - 1]);
+	}
+	runScope(index, index + 1, rec.end);
+	for (auto i = rec.end; i > returnsBegin; i--) {
+		popPushed(records[i - 1]);
+	}
+}
+
+// the library calling the client
+static void callback(CallbackKind kind, uint64_t target, int64_t id) {
+	serverCallbackSinceTick = true;
+	auto matches = [&](const Record& rec) {
+		return !rec.consumed && rec.type == (uint8_t)kind
+			&& (kind == CallbackKind::ResourceReleaseBatch || kind == CallbackKind::ClearSafetyArea || (rec.handle == target && rec.id == id));
+	};
+	for (auto s = scopes.rbegin(); s != scopes.rend(); s++) {
+		auto& list = children[s->record];
+		while (s->nextChild < list.size() && records[list[s->nextChild]].consumed) {
+			s->nextChild++;
+		}
+		for (auto c = s->nextChild; c < list.size(); c++) {
+			auto index = list[c];
+			if (matches(records[index])) {
+				records[index].consumed = true;
+				counts.matched++;
+				runScope(index, index + 1, records[index].end);
+				return;
+			}
+		}
+		// only the innermost scope is searched - for anything further out, this would be out of order
+		break;
+	}
+	if (kind != CallbackKind::ClientFunc && kind != CallbackKind::ClientMethod) {
+		return; // nothing to answer
+	}
+	auto found = firstRecording.find({ (uint8_t)kind, kind == CallbackKind::ClientMethod ? target : (uint64_t)id });
+	if (found == firstRecording.end()) {
+		counts.unanswerable++;
+		fprintf(stderr, "QtTestingReplay: warning: %s callback %d never recorded, left unanswered\n",
+			kind == CallbackKind::ClientMethod ? "method" : "function", (int)id);
+		return;
+	}
+	counts.answered++;
+	size_t argsEnd, returnsBegin;
+	argumentsAndReturns(found->second, &argsEnd, &returnsBegin);
+	run(found->second + 1, argsEnd);
+	run(returnsBegin, records[found->second].end);
+}
+
+static void replayClientFuncExec(int id) {
+	callback(CallbackKind::ClientFunc, 0, id);
+}
+
+static void replayClientMethodExec(ni_InterfaceMethodRef method, int objID) {
+	auto found = recordedInterfaceMethods.find((uint64_t)(uintptr_t)method);
+	callback(CallbackKind::ClientMethod, found != recordedInterfaceMethods.end() ? found->second : 0, objID);
+}
+
+static void replayClientResourceRelease(int id) {
+	callback(CallbackKind::ResourceRelease, 0, id);
+}
+
+static void replayClientResourceReleaseBatch(const int* ids, size_t count) {
+	callback(CallbackKind::ResourceReleaseBatch, 0, 0);
+}
+
+static void replayClientClearSafetyArea() {
+	callback(CallbackKind::ClearSafetyArea, 0, 0);
+}
+
+#ifdef QT_CORE_LIB
+// event loops running inside a call get the recorded callbacks nothing made (user input, mostly) fed to them whenever they go idle,
+// and are told to quit once everything recorded inside the call has been replayed
+// (QCoreApplication::exit ends every running loop, not just the innermost, whatever's left further out is replayed after its call returns)
+static QTimer* pump = nullptr;
+static bool pumping = false;
+
+static void pumpTick() {
+	if (pumping || scopes.empty() || !isInvoke(records[scopes.back().record].op)) {
+		return;
+	}
+	// give the library's own callbacks (paints and such) the first go
+	if (serverCallbackSinceTick) {
+		serverCallbackSinceTick = false;
+		return;
+	}
+	auto& scope = scopes.back();
+	auto& list = children[scope.record];
+	while (scope.nextChild < list.size() && records[list[scope.nextChild]].consumed) {
+		scope.nextChild++;
+	}
+	if (scope.nextChild < list.size()) {
+		pumping = true;
+		replayDetached(list[scope.nextChild]);
+		pumping = false;
+		scope.idleTicks = 0;
+	}
+	else if (++scope.idleTicks >= 2) {
+		QCoreApplication::exit(0);
+	}
+}
+
+static void startPump() {
+	if (!pump && QCoreApplication::instance()) {
+		pump = new QTimer();
+		pump->setInterval(0);
+		QObject::connect(pump, &QTimer::timeout, &pumpTick);
+		pump->start();
+	}
+}
+
+static void stopPump() {
+	delete pump;
+	pump = nullptr;
+}
+#else
+static void startPump() {}
+static void stopPump() {}
+#endif
+
+static bool shutDown = false;
+
+static void execute(size_t index) {
+	auto& rec = records[index];
+	switch (rec.op) {
+	case Op::DefineRef:
+		define(rec);
+		break;
+	case Op::Init:
+	case Op::InvokeEnd:
+	case Op::CallbackEnd:
+		break;
+	case Op::Shutdown:
+		stopPump();
+		nativeImplShutdown();
+		shutDown = true;
+		break;
+	case Op::UseReleaseBatch:
+		setClientResourceReleaseBatch(&replayClientResourceReleaseBatch);
+		break;
+	case Op::Lookup: {
+		// made again for the time they take - the translation comes from the DefineRefs
+		auto name = std::string((const char*)rec.data, rec.length);
+		switch (rec.type) {
+		case ni_RefModule: getModule(name.c_str()); break;
+		case ni_RefModuleMethod: getModuleMethod(liveRef<ni_ModuleRef>(ni_RefModule, rec.extra), name.c_str()); break;
+		case ni_RefInterface: getInterface(liveRef<ni_ModuleRef>(ni_RefModule, rec.extra), name.c_str()); break;
+		case ni_RefInterfaceMethod: getInterfaceMethod(liveRef<ni_InterfaceRef>(ni_RefInterface, rec.extra), name.c_str()); break;
+		case ni_RefException: getException(liveRef<ni_ModuleRef>(ni_RefModule, rec.extra), name.c_str()); break;
+		case ni_RefStructType: getStructType(liveRef<ni_ModuleRef>(ni_RefModule, rec.extra), name.c_str()); break;
+		}
+		break;
+	}
+	case Op::LookupOrdinal:
+		if (rec.type == ni_RefModule) {
+			getModuleByOrdinal((int)rec.id);
+		}
+		else {
+			getModuleMethodByOrdinal(liveRef<ni_ModuleRef>(ni_RefModule, rec.extra), (int)rec.id);
+		}
+		break;
+	case Op::PushModuleConstants:
+		pushModuleConstants(liveRef<ni_ModuleRef>(ni_RefModule, rec.handle));
+		break;
+	case Op::InvokeModuleMethod: {
+		auto method = liveRef<ni_ModuleMethodRef>(ni_RefModuleMethod, rec.handle);
+		startPump();
+		invokeScope(index, [&] {
+			if (rec.flag) {
+				invokeModuleMethodWithExceptions(method);
+			}
+			else {
+				invokeModuleMethod(method);
+			}
+		});
+		break;
+	}
+	case Op::InvokeInterfaceMethod: {
+		auto method = liveRef<ni_InterfaceMethodRef>(ni_RefInterfaceMethod, rec.handle);
+		auto serverID = liveServerId(rec.id);
+		invokeScope(index, [&] {
+			if (rec.flag) {
+				invokeInterfaceMethodWithExceptions(method, serverID);
+			}
+			else {
+				invokeInterfaceMethod(method, serverID);
+			}
+		});
+		break;
+	}
+	case Op::ExecServerFunc: {
+		auto id = liveServerId(rec.id);
+		invokeScope(index, [&] {
+			if (rec.flag) {
+				execServerFuncWithExceptions(id);
+			}
+			else {
+				execServerFunc(id);
+			}
+		});
+		break;
+	}
+	case Op::InvokeBatch:
+		invokeBatchRecord(index);
+		break;
+	case Op::PushScalar:
+		pushScalar(rec.type, rec.handle);
+		break;
+	case Op::PopScalar:
+		popScalar(rec.type, rec.handle);
+		break;
+	case Op::PushArray:
+		pushArrayRecord(rec);
+		break;
+	case Op::PopArray:
+		popArrayRecord(rec);
+		break;
+	case Op::PushStringArray:
+		pushStringArrayRecord(rec);
+		break;
+	case Op::PopStringArray:
+		if (rec.flag) {
+			const char* const* strs;
+			const size_t* lengths;
+			size_t count;
+			popStringArrayView(&strs, &lengths, &count);
+		}
+		else {
+			const char** strs;
+			size_t* lengths;
+			size_t count;
+			popStringArray(&strs, &lengths, &count);
+		}
+		break;
+	case Op::PushStruct:
+		pushStruct(liveStructType(rec.handle), rec.data, rec.length);
+		break;
+	case Op::PopStruct:
+		popStruct(liveStructType(rec.handle), alignedCopy(nullptr, (size_t)rec.count), (size_t)rec.count);
+		break;
+	case Op::PushStructArray:
+		if (rec.flag) {
+			pushStructArrayBorrowed(liveStructType(rec.handle), rec.data, (size_t)rec.count);
+		}
+		else {
+			pushStructArray(liveStructType(rec.handle), rec.data, (size_t)rec.count);
+		}
+		break;
+	case Op::PopStructArray: {
+		size_t count;
+		if (rec.flag) {
+			const void* values;
+			popStructArrayView(liveStructType(rec.handle), &values, &count);
+		}
+		else {
+			void* values;
+			popStructArray(liveStructType(rec.handle), &values, &count);
+		}
+		break;
+	}
+	case Op::PushBuffer:
+		pushBufferRecord(rec);
+		break;
+	case Op::PopBuffer: {
+		int id;
+		bool isClientId;
+		ni_BufferDescriptor descriptor;
+		popBuffer(&id, &isClientId, &descriptor);
+		if (!isClientId) {
+			serverIds[rec.id] = id;
+		}
+		break;
+	}
+	case Op::PushClientFunc:
+		pushClientFunc((int)rec.id);
+		break;
+	case Op::PopServerFunc:
+		serverIds[rec.id] = popServerFunc();
+		break;
+	case Op::PushInstance:
+		pushInstance(rec.flag ? (int)rec.id : liveServerId(rec.id), rec.flag);
+		break;
+	case Op::PopInstance: {
+		bool isClientId;
+		auto id = popInstance(&isClientId);
+		if (!isClientId) {
+			serverIds[rec.id] = id;
+		}
+		break;
+	}
+	case Op::PushNull:
+		pushNull();
+		break;
+	case Op::ReleaseServerResource:
+		releaseServerResource(liveServerId(rec.id));
+		break;
+	case Op::ReleaseServerResources: {
+		std::vector<int> live;
+		for (size_t i = 0; i < rec.count; i++) {
+			live.push_back(liveServerId(ids[rec.list + i]));
+		}
+		releaseServerResources(live.data(), live.size());
+		break;
+	}
+	case Op::ClearServerSafetyArea:
+		clearServerSafetyArea();
+		break;
+	case Op::SetException:
+		setException(liveRef<ni_ExceptionRef>(ni_RefException, rec.handle));
+		break;
+	case Op::CallbackBegin:
+		// recorded here, but nothing made it (by now) - see replayDetached
+		if (!rec.consumed) {
+			replayDetached(index);
+		}
+		break;
+	}
+}
+
+static void run(size_t begin, size_t end) {
+	for (auto i = begin; i < end && !shutDown; i++) {
+		execute(i);
+		// what was recorded inside a call or callback has been dealt with by now, one way or another
+		if (isInvoke(records[i].op) || records[i].op == Op::CallbackBegin) {
+			i = records[i].end;
+		}
+	}
+}
+
+int main(int argc, char** argv) {
+	const char* capturePath = nullptr;
+	bool stats = false;
+	const char* timelinePath = nullptr;
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "--stats")) {
+			stats = true;
+		}
+		else if (!strcmp(argv[i], "--timeline") && i + 1 < argc) {
+			timelinePath = argv[++i];
+		}
+		else if (!capturePath) {
+			capturePath = argv[i];
+		}
+		else {
+			capturePath = nullptr;
+			break;
+		}
+	}
+	if (!capturePath) {
+		fprintf(stderr, "usage: QtTestingReplay <capture> [--stats] [--timeline <path>]\n");
+		return 2;
+	}
+
+	auto f = fopen(capturePath, "rb");
+	if (!f) {
+		fail("can't open %s", capturePath);
+	}
+	std::vector<uint8_t> file;
+	uint8_t chunk[1 << 16];
+	size_t n;
+	while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) {
+		file.insert(file.end(), chunk, chunk + n);
+	}
+	fclose(f);
+	// keeps `file` alive for the string array records, which point into it
+	parse(file);
+
+	// no display needed (or wanted) for a replay
+	if (!getenv("QT_QPA_PLATFORM")) {
+#ifdef _WIN32
+		_putenv_s("QT_QPA_PLATFORM", "offscreen");
+#else
+		setenv("QT_QPA_PLATFORM", "offscreen", 1);
+#endif
+	}
+
+	nativeImplInit(&replayClientFuncExec, &replayClientMethodExec, &replayClientResourceRelease, &replayClientClearSafetyArea);
+	setProfiling(stats);
+	if (timelinePath) {
+		setTimeline(true);
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	scopes.push_back({ records.size() });
+	run(0, records.size());
+	scopes.pop_back();
+	auto totalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	printf("replayed %zu records in %.3f ms (%.3f ms in %zu top-level and nested calls)\n", records.size(), totalMs, counts.serverMs, counts.invokes);
+	printf("callbacks: %zu matched, %zu answered from earlier recordings, %zu replayed detached, %zu skipped, %zu unanswerable\n",
+		counts.matched, counts.answered, counts.detached, counts.skipped, counts.unanswerable);
+	printf("%zu popped values differed from the capture, %zu server ids had no counterpart\n", counts.popMismatches, counts.unmappedIds);
+	if (stats) {
+		std::vector<char> buffer(getStats(ni_StatsText, nullptr, 0) + 1);
+		getStats(ni_StatsText, buffer.data(), buffer.size());
+		printf("%s", buffer.data());
+	}
+	if (timelinePath && !writeTimeline(timelinePath)) {
+		fprintf(stderr, "QtTestingReplay: couldn't write %s\n", timelinePath);
+	}
+	fflush(stdout);
+	if (!shutDown) {
+		stopPump();
+		nativeImplShutdown();
+	}
+	return 0;
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <vector>
+#include <algorithm>
+
+// immutable name -> ordinal lookup for the registries (perfect hash via hash-and-displace)
+// built once after registration, then a lookup is one hash of the name, two table reads and a single strcmp
+// only ordinals are stored, the names themselves are fetched back through the nameAt(ordinal) callback
+class NameIndex {
+	uint64_t seed = 0;
+	std::vector<uint32_t> displacements; // one per bucket
+	std::vector<int32_t> slots;          // ordinal, or -1 for an empty slot
+
+	static inline uint64_t mix(uint64_t x) {
+		// splitmix64 finalizer
+		x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ull;
+		x ^= x >> 27; x *= 0x94d049bb133111ebull;
+		x ^= x >> 31;
+		return x;
+	}
+	static inline uint64_t hashName(const char* name, uint64_t seed) {
+		// FNV-1a
+		uint64_t h = 0xcbf29ce484222325ull ^ seed;
+		for (auto p = (const uint8_t*)name; *p; p++) {
+			h = (h ^ *p) * 0x100000001b3ull;
+		}
+		return h;
+	}
+	inline size_t bucketOf(uint64_t h) const {
+		return mix(h) % displacements.size();
+	}
+	inline size_t slotOf(uint64_t h, uint32_t d) const {
+		return mix(h + (d + 1) * 0x9e3779b97f4a7c15ull) % slots.size();
+	}
+
+	template <typename NameAt>
+	bool tryBuild(size_t count, NameAt nameAt) {
+		struct Key { uint64_t h; int32_t ordinal; };
+		auto numBuckets = std::max<size_t>(1, count / 4);
+		displacements.assign(numBuckets, 0);
+		slots.assign(count + count / 8 + 1, -1);
+
+		std::vector<std::vector<Key>> buckets(numBuckets);
+		for (size_t i = 0; i < count; i++) {
+			auto name = nameAt((int)i);
+			auto h = hashName(name, seed);
+			auto& bucket = buckets[bucketOf(h)];
+			bool duplicate = false;
+			for (auto& other : bucket) {
+				if (other.h == h && !strcmp(nameAt(other.ordinal), name)) {
+					printf("NameIndex: name [%s] registered more than once, lookups will find the first\n", name);
+					duplicate = true;
+					break;
+				}
+			}
+			if (!duplicate) {
+				bucket.push_back({ h, (int32_t)i });
+			}
+		}
+
+		// biggest buckets first, while there's still plenty of room
+		std::vector<size_t> order(numBuckets);
+		for (size_t i = 0; i < numBuckets; i++) order[i] = i;
+		std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return buckets[a].size() > buckets[b].size(); });
+
+		std::vector<size_t> taken;
+		for (auto b : order) {
+			auto& bucket = buckets[b];
+			if (bucket.empty()) {
+				break;
+			}
+			uint32_t d = 0;
+			for (;; d++) {
+				if (d == (1u << 20)) {
+					return false; // give up on this seed
+				}
+				taken.clear();
+				bool fits = true;
+				for (auto& key : bucket) {
+					auto s = slotOf(key.h, d);
+					if (slots[s] >= 0 || std::find(taken.begin(), taken.end(), s) != taken.end()) {
+						fits = false;
+						break;
+					}
+					taken.push_back(s);
+				}
+				if (fits) {
+					break;
+				}
+			}
+			displacements[b] = d;
+			for (size_t i = 0; i < bucket.size(); i++) {
+				slots[taken[i]] = bucket[i].ordinal;
+			}
+		}
+		return true;
+	}
+
+public:
+	// nameAt(i) returns the name of ordinal i, for i in [0, count)
+	template <typename NameAt>
+	void build(size_t count, NameAt nameAt) {
+		for (seed = 0; !tryBuild(count, nameAt); seed++) {}
+	}
+
+	// returns the ordinal, or -1 if not found (also -1 if never built)
+	template <typename NameAt>
+	int find(const char* name, NameAt nameAt) const {
+		if (slots.empty()) {
+			return -1;
+		}
+		auto h = hashName(name, seed);
+		auto ordinal = slots[slotOf(h, displacements[bucketOf(h)])];
+		return (ordinal >= 0 && !strcmp(nameAt(ordinal), name)) ? ordinal : -1;
+	}
+};
@@ -1,46 +1,122 @@
 #include "NativeImplCore.h"
 
+#include <chrono>
 #include <cstdio>
-#include <map>
+#include <cstdlib>
+#include <cstring>
+#include <cstddef>
+#include <deque>
 #include <string>
-#include <stack>
 #include <exception>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 #include <assert.h>
 
+#include "NameIndex.h"
+#include "NativeImplStats.h"
+#include "NativeImplTimeline.h"
+#include "NativeImplTrace.h"
+
 // private opaque definitions
-struct ni_Module {
-	std::string name;
-	std::map<std::string, ni_ModuleMethodRef> methods;
-	std::map<std::string, ni_InterfaceRef> interfaces;
-	std::map<std::string, ni_ExceptionRef> exceptions;
-	ConstantsFunc constantsFunc = nullptr;
+// registered names aren't copied, they must stay valid for the life of the library (ie string literals)
+
+// registry entries in registration order: addresses are stable (refs are handed straight out), the ordinal is the index,
+// and the name index is (re)built on the first lookup after something was added
+template <typename T>
+struct NameTable {
+	std::deque<T> items;
+	NameIndex index;
+	bool indexDirty = false;
+
+	T* add(T&& item) {
+		items.push_back(std::move(item));
+		indexDirty = true;
+		return &items.back();
+	}
+	T* at(int ordinal) {
+		return (ordinal >= 0 && (size_t)ordinal < items.size()) ? &items[ordinal] : nullptr;
+	}
+	// (find builds it when needed, this is for tables that will be looked up from more than one thread)
+	void buildIndex() {
+		if (indexDirty) {
+			index.build(items.size(), [this](int i) { return items[i].name; });
+			indexDirty = false;
+		}
+	}
+	T* find(const char* name) {
+		buildIndex();
+		return at(index.find(name, [this](int i) { return items[i].name; }));
+	}
 };
 
 struct ni_ModuleMethod {
 	ni_ModuleRef _module = nullptr;
-	std::string name;
+	const char* name;
 	ModuleFunc func;
-};
-
-struct ni_Interface {
-	ni_ModuleRef _module = nullptr;
-	std::string name;
-	std::map<std::string, ni_InterfaceMethodRef> methods;
+	StatsSlot stats {};
+	int index = -1; // see ni_getRefIndex
 };
 
 struct ni_InterfaceMethod {
 	ni_InterfaceRef _iface = nullptr;
-	std::string name;
+	const char* name;
 	InterfaceFunc ifunc;
+	StatsSlot stats {};         // invoked by the client
+	StatsSlot callbackStats {}; // server calling the client's implementation
+	int index = -1;
+};
+
+struct ni_Interface {
+	ni_ModuleRef _module = nullptr;
+	const char* name;
+	NameTable<ni_InterfaceMethod> methods {};
+	int index = -1;
 };
 
 struct ni_Exception {
 	ni_ModuleRef _module = nullptr;
-	std::string name;
+	const char* name;
 	ExceptionBuilder buildAndThrow;
+	int index = -1;
+};
+
+struct StructLayout {
+	ni_ModuleRef _module = nullptr;
+	const char* name;
+	int typeId;
+	size_t size;
+	const ni_StructField* fields;
+	size_t fieldCount;
+};
+
+struct ni_Module {
+	const char* name;
+	NameTable<ni_ModuleMethod> methods {};
+	NameTable<ni_Interface> interfaces {};
+	NameTable<ni_Exception> exceptions {};
+	NameTable<StructLayout> structs {};
+	ConstantsFunc constantsFunc = nullptr;
+	int index = -1;
+};
+
+// an entry of the library's module table (ni_registerModuleDescriptors), until ni_getModule first names it
+// any thread's first lookup can be the one that registers it: state only changes under registrationLock,
+// and the release store of Registered is what publishes module (and everything its register function added) to the others
+struct DeferredModule {
+	enum State { Pending, Registering, Registered }; // (Registering only matters for a dependency cycle)
+	const char* name = nullptr;
+	const ni_ModuleDescriptor* descriptor = nullptr;
+	std::atomic<State> state = Pending;
+	ni_ModuleRef module = nullptr; // once registered (stays null if its register function didn't)
+	StatsSlot stats {};
+
+	DeferredModule(const char* name, const ni_ModuleDescriptor* descriptor) : name(name), descriptor(descriptor) {}
+	// (only ever moved into the table, before anything else can see it)
+	DeferredModule(DeferredModule&& other) : name(other.name), descriptor(other.descriptor), state(other.state.load(std::memory_order_relaxed)), module(other.module) {}
 };
 
 // exceptions
@@ -50,519 +126,609 @@ class WrongTypeException : public std::exception {
 	}
 };
 
-// stack types =======================
-class StackItem {
-public:
-	virtual void* ptrValue() { throw WrongTypeException(); }
-	virtual std::vector<void*> ptrArray() { throw WrongTypeException(); }
-
-	virtual size_t sizeTValue() { throw WrongTypeException(); }
-	virtual std::vector<size_t> sizeTArray() { throw WrongTypeException(); }
-
-	virtual bool boolValue() { throw WrongTypeException(); }
-	virtual std::vector<uint8_t> boolArray() { throw WrongTypeException(); } // using 'bool' doesn't allow .data access
-
-	virtual int8_t int8Value() { throw WrongTypeException(); }
-	virtual std::vector<int8_t> int8Array() { throw WrongTypeException(); }
-
-	virtual uint8_t uint8Value() { throw WrongTypeException(); }
-	virtual std::vector<uint8_t> uint8Array() { throw WrongTypeException(); }
-
-	virtual int16_t int16Value() { throw WrongTypeException(); }
-	virtual std::vector<int16_t> int16Array() { throw WrongTypeException(); }
-
-	virtual uint16_t uint16Value() { throw WrongTypeException(); }
-	virtual std::vector<uint16_t> uint16Array() { throw WrongTypeException(); }
-
-	virtual int32_t int32Value() { throw WrongTypeException(); }
-	virtual std::vector<int32_t> int32Array() { throw WrongTypeException(); }
-
-	virtual uint32_t uint32Value() { throw WrongTypeException(); }
-	virtual std::vector<uint32_t> uint32Array() { throw WrongTypeException(); }
-
-	virtual int64_t int64Value() { throw WrongTypeException(); }
-	virtual std::vector<int64_t> int64Array() { throw WrongTypeException(); }
-
-	virtual uint64_t uint64Value() { throw WrongTypeException(); }
-	virtual std::vector<uint64_t> uint64Array() { throw WrongTypeException(); }
-
-	virtual float floatValue() { throw WrongTypeException(); }
-	virtual std::vector<float> floatArray() { throw WrongTypeException(); }
+// type checking on pop is on by default for debug builds, define NI_STACK_TYPECHECK=1 to force it on for release as well
+// (with it off, a mismatched pop just reinterprets the slot - the generated code on both sides is expected to agree)
+#ifndef NI_STACK_TYPECHECK
+#ifdef NDEBUG
+#define NI_STACK_TYPECHECK 0
+#else
+#define NI_STACK_TYPECHECK 1
+#endif
+#endif
 
-	virtual double doubleValue() { throw WrongTypeException(); }
-	virtual std::vector<double> doubleArray() { throw WrongTypeException(); }
+// stack types =======================
+enum class ItemTag : uint8_t {
+	Null,
+	Ptr, PtrArray,
+	SizeT, SizeTArray,
+	Bool, BoolArray, // (BoolArray is never pushed - bool arrays go as BitArray, see ni_pushBoolArray)
+	Int8, Int8Array,
+	UInt8, UInt8Array,
+	Int16, Int16Array,
+	UInt16, UInt16Array,
+	Int32, Int32Array,
+	UInt32, UInt32Array,
+	Int64, Int64Array,
+	UInt64, UInt64Array,
+	Float, FloatArray,
+	Double, DoubleArray,
+	String, StringArray,
+	ClientFunc,
+	ServerFunc,
+	Instance,
+	Buffer,
+	Struct, StructArray,
+	BitArray
+};
 
-	virtual std::string stringValue() { throw WrongTypeException(); }
-	virtual std::vector<std::string> stringArray() { throw WrongTypeException(); }
+// the ...Array tags each come right after their scalar (so: the even ones from PtrArray to DoubleArray), plus strings, struct and bit arrays
+static inline bool hasArrayPayload(ItemTag tag) {
+	return (tag >= ItemTag::PtrArray && tag <= ItemTag::DoubleArray && (int)tag % 2 == 0) || tag == ItemTag::String || tag == ItemTag::StructArray || tag == ItemTag::BitArray;
+}
 
-	virtual int clientFuncId() { throw WrongTypeException(); }
-	virtual int serverFuncId() { throw WrongTypeException(); }
-	virtual int instanceId(bool* isClientId) { throw WrongTypeException(); }
+// how many uint64 words a bit array of count bits takes
+static inline size_t bitWords(size_t count) {
+	return count / 64 + (count % 64 != 0);
+}
 
-	virtual void buffer(int *id, bool* isClientId, ni_BufferDescriptor* descriptor) { throw WrongTypeException(); }
-};
+// variable-length payloads live in the arena, the slot only points at them
+// (for borrowed items, the payload record is in the arena but the data itself is still the pusher's memory)
+struct ArrayPayload {
+	void* data;
+	size_t count;
+	size_t elementSize; // 0 for a bit array: count is in bits then, packed into uint64 words
 
-class NullItem : public StackItem {
-public:
-	NullItem() {}
-	// should work for any reference type:
-	void* ptrValue() override {
-		return nullptr;
-	}
-	int instanceId(bool* isClientId) override {
-		*isClientId = false;
-		return 0;
-	}
-	void buffer(int* id, bool* isClientId, ni_BufferDescriptor* descriptor) override {
-		*id = 0;
-		*isClientId = false;
-		descriptor->start = nullptr;
+	size_t bytes() const {
+		return elementSize ? count * elementSize : bitWords(count) * sizeof(uint64_t);
 	}
 };
 
-class PtrItem : public StackItem {
-public:
-	void* value;
-	PtrItem(void* value) : value(value) {}
-	void* ptrValue() override {
-		return value;
+// one blob: all the bytes back to back (no terminators), string i being bytes[offsets[i] .. offsets[i + 1])
+// the pointer table (strs/lengths) is only built for the pops that hand one out, or is all there is for one pushed that way borrowed
+// (offsets null then, see stringBlob)
+struct StringArrayPayload {
+	const char* bytes;
+	const uint64_t* offsets; // count + 1 of them
+	size_t count;
+	const char** strs;
+	size_t* lengths;
+
+	const char* str(size_t i) const {
+		return offsets ? bytes + offsets[i] : strs[i];
+	}
+	size_t length(size_t i) const {
+		return offsets ? (size_t)(offsets[i + 1] - offsets[i]) : lengths[i];
+	}
+	size_t totalLength() const {
+		if (offsets) {
+			return (size_t)offsets[count];
+		}
+		size_t total = 0;
+		for (size_t i = 0; i < count; i++) {
+			total += lengths[i];
+		}
+		return total;
 	}
 };
 
-class PtrArray : public StackItem {
+// scalars are stored inline, everything else is a pointer into the arena
+// (structs too, unless they fit in 8 bytes)
+struct StackSlot {
+	ItemTag tag;
+	bool isClientId; // instances + buffers
+	bool borrowed;   // arrays + strings pushed with the ...Borrowed variants
+	int32_t id;      // instances, buffers, func vals, struct type ids
+	union {
+		void* ptr;
+		size_t sizeT;
+		bool b;
+		int8_t i8;
+		uint8_t u8;
+		int16_t i16;
+		uint16_t u16;
+		int32_t i32;
+		uint32_t u32;
+		int64_t i64;
+		uint64_t u64;
+		float f;
+		double d;
+		ArrayPayload* array;
+		StringArrayPayload* strArray;
+		ni_BufferDescriptor* descriptor;
+		uint8_t bytes[8];
+	};
+};
+static_assert(sizeof(StackSlot) == 16, "stack slots are meant to be 16 bytes");
+
+// bump allocator for array/string payloads
+// allocations never move (chunks are only ever added), so popped pointers stay good until the arena is reset past them
+class Arena {
+	static constexpr size_t DefaultChunkSize = 64 * 1024;
+	struct Chunk {
+		char* base;
+		size_t size;
+		size_t used;
+	};
+	std::vector<Chunk> chunks;
+	size_t current = 0;
 public:
-	std::vector<void*> values;
-	PtrArray(void** ptr, size_t count) {
-		values.assign(ptr, ptr + count);
+	struct Mark {
+		size_t chunk = 0;
+		size_t used = 0;
+	};
+	~Arena() {
+		for (auto& chunk : chunks) {
+			free(chunk.base);
+		}
 	}
-	std::vector<void*> ptrArray() override {
-		return values;
+	void* alloc(size_t size, size_t align = alignof(std::max_align_t)) {
+		if (!chunks.empty()) {
+			auto& chunk = chunks[current];
+			auto offset = (chunk.used + align - 1) & ~(align - 1);
+			if (offset + size <= chunk.size) {
+				chunk.used = offset + size;
+				return chunk.base + offset;
+			}
+		}
+		// doesn't fit - move to the next (empty) chunk, or add one big enough
+		auto next = chunks.empty() ? 0 : current + 1;
+		if (next >= chunks.size() || chunks[next].size < size) {
+			auto chunkSize = size > DefaultChunkSize ? size : DefaultChunkSize;
+			chunks.insert(chunks.begin() + next, Chunk{ (char*)malloc(chunkSize), chunkSize, 0 });
+		}
+		current = next;
+		chunks[current].used = size;
+		return chunks[current].base; // malloc alignment suffices for a fresh chunk
 	}
-};
-
-class SizeTItem : public StackItem {
-public:
-	size_t value;
-	SizeTItem(size_t value) : value(value) {}
-	size_t sizeTValue() override {
-		return value;
+	template <typename T>
+	T* allocArray(size_t count) {
+		return (T*)alloc(count * sizeof(T), alignof(T));
 	}
-};
-
-class SizeTArray : public StackItem {
-public:
-	std::vector<size_t> values;
-	SizeTArray(size_t* ptr, size_t count) {
-		values.assign(ptr, ptr + count);
+	Mark mark() const {
+		return chunks.empty() ? Mark{} : Mark{ current, chunks[current].used };
 	}
-	std::vector<size_t> sizeTArray() override {
-		return values;
+	void reset(Mark m) {
+		if (chunks.empty()) {
+			return;
+		}
+		for (auto i = m.chunk + 1; i < chunks.size(); i++) {
+			chunks[i].used = 0;
+		}
+		// don't hang on to one-off giants (a single huge array) past their frame
+		for (auto i = chunks.size(); i > m.chunk + 1; i--) {
+			if (chunks[i - 1].size > DefaultChunkSize) {
+				free(chunks[i - 1].base);
+				chunks.erase(chunks.begin() + (i - 1));
+			}
+		}
+		current = m.chunk;
+		chunks[current].used = m.used;
 	}
 };
 
-class BoolItem : public StackItem {
-public:
-	bool value;
-	BoolItem(bool value) : value(value) {}
-	bool boolValue() override {
-		return value;
-	}
-};
+// null methods for callback defaults (also assigned when client is shut down, to prevent dtors from calling back into client)
+static void nullIntMethod(int x) {}
+static void nullVoidMethod() {}
+static void nullMethodExec(ni_InterfaceMethodRef method, int id) {}
 
-class BoolArrayItem : public StackItem {
-public:
-	std::vector<uint8_t> values;		     // using std::vector<bool> doesn't allow .data access, lame
-	BoolArrayItem(bool* ptr, size_t count) {
-		values.assign(ptr, ptr + count);
-	}
-	std::vector<uint8_t> boolArray() override {
-		return values;
-	}
-};
+// private global stuff ============================
+static NameTable<ni_Module> modules;
+static NameTable<DeferredModule> deferredModules;
+static std::atomic<size_t> pendingModules = 0; // deferred ones not registered yet (once 0, none of the tables change again)
+static std::recursive_mutex registrationLock; // deferred registration, and reading the tables while it might be going on (recursive for dependencies)
+static std::vector<StructLayout*> structLayouts; // by type id
+static std::vector<const void*> refsByIndex[ni_RefStructType]; // the other kinds, by ni_getRefIndex
 
-// INT8 ====
+template <typename T>
+static T* indexRef(int kind, T* ref) {
+	ref->index = (int)refsByIndex[kind].size();
+	refsByIndex[kind].push_back(ref);
+	return ref;
+}
 
-class Int8Item : public StackItem {
-public:
-	int8_t x;
-	Int8Item(int8_t x) : x(x) {}
-	int8_t int8Value() override {
-		return x;
-	}
-};
+niClientFuncExec ni_clientFuncExec;
+niClientMethodExec ni_clientMethodExec;
+niClientResourceRelease ni_clientResourceRelease;
+niClientClearSafetyArea ni_clientClearSafetyArea;
+static niClientResourceReleaseBatch clientResourceReleaseBatch = nullptr; // optional, see ni_setClientResourceReleaseBatch
 
-class UInt8Item : public StackItem {
-public:
-	uint8_t x;
-	UInt8Item(uint8_t x) : x(x) {}
-	uint8_t uint8Value() override {
-		return x;
-	}
-};
+// pending client releases are handed over once this many have piled up, even in the middle of an invocation
+static constexpr size_t ReleaseBatchThreshold = 1024;
 
-class Int8ArrayItem : public StackItem {
-public:
-	std::vector<int8_t> values;
-	Int8ArrayItem(int8_t* ptr, size_t count) {
-		if (count > 0) {
-			values.assign(ptr, ptr + count);
-		}
-	}
-	std::vector<int8_t> int8Array() override {
-		return values;
+struct ThreadLocal {
+	std::vector<StackSlot> vstack;
+	Arena arena;
+	// arena floor for each invocation in progress on this thread (outermost first)
+	// payloads below the floor (ie the arguments) must survive until that invocation returns
+	std::vector<Arena::Mark> frames;
+	size_t borrowedCount = 0; // borrowed items currently on the stack
+	ni_ExceptionRef currentException = nullptr;
+	std::vector<int> pendingReleases; // client resource ids, waiting for the next batch release
+	std::vector<int> releasesInFlight; // the batch being handed over (swapped with the above, so both keep their capacity)
+	int serverSafetyAreaDepth = -1; // frame depth of the invocation that started using it, -1 when not in use (see ni_serverSafetyAreaInUse)
+
+	ThreadLocal() {
+		vstack.reserve(256);
 	}
-};
 
-class UInt8ArrayItem : public StackItem {
-public:
-	std::vector<uint8_t> values;
-	UInt8ArrayItem(uint8_t* ptr, size_t count) {
-		if (count > 0) {
-			values.assign(ptr, ptr + count);
+	// must come before any arena allocation for the item being pushed
+	inline void beginPush() {
+		if (vstack.empty()) {
+			// starting a fresh push sequence at this depth: whatever was popped since the floor was set has been consumed
+			arena.reset(frames.empty() ? Arena::Mark{} : frames.back());
 		}
 	}
-	std::vector<uint8_t> uint8Array() override {
-		return values;
-	}
-};
 
-// INT16 ====
-
-class Int16Item : public StackItem {
-public:
-	int16_t x;
-	Int16Item(int16_t x) : x(x) {}
-	int16_t int16Value() override {
-		return x;
+	inline StackSlot& pushSlot(ItemTag tag) {
+		vstack.emplace_back();
+		auto& slot = vstack.back();
+		slot.tag = tag;
+		return slot;
 	}
-};
 
-class UInt16Item : public StackItem {
-public:
-	uint16_t x;
-	UInt16Item(uint16_t x) : x(x) {}
-	uint16_t uint16Value() override {
-		return x;
+	inline StackSlot& push(ItemTag tag) {
+		beginPush();
+		return pushSlot(tag);
 	}
-};
 
-class Int16ArrayItem : public StackItem {
-public:
-	std::vector<int16_t> values;
-	Int16ArrayItem(int16_t* ptr, size_t count) {
-		if (count > 0) {
-			values.assign(ptr, ptr + count);
+	inline StackSlot pop() {
+		assert(!vstack.empty());
+		auto ret = vstack.back();
+		vstack.pop_back();
+		if (ret.borrowed) {
+			borrowedCount--;
 		}
+		return ret;
 	}
-	std::vector<int16_t> int16Array() override {
-		return values;
-	}
-};
 
-class UInt16ArrayItem : public StackItem {
-public:
-	std::vector<uint16_t> values;
-	UInt16ArrayItem(uint16_t* ptr, size_t count) {
-		if (count > 0) {
-			values.assign(ptr, ptr + count);
+	inline StackSlot pop([[maybe_unused]] ItemTag expected) {
+		auto ret = pop();
+#if NI_STACK_TYPECHECK
+		if (ret.tag != expected) {
+			throw WrongTypeException();
 		}
+#endif
+		return ret;
 	}
-	std::vector<uint16_t> uint16Array() override {
-		return values;
-	}
-};
-
-// INT32 ====
-
-class Int32Item : public StackItem {
-public:
-	int32_t x;
-	Int32Item(int32_t x) : x(x) {}
-	int32_t int32Value() override {
-		return x;
-	}
-};
-
-class UInt32Item : public StackItem {
-public:
-	uint32_t x;
-	UInt32Item(uint32_t x) : x(x) {}
-	uint32_t uint32Value() override {
-		return x;
-	}
-};
 
-class Int32ArrayItem : public StackItem {
-public:
-	std::vector<int32_t> values;
-	Int32ArrayItem(int32_t* ptr, size_t count) {
-		if (count > 0) {
-			values.assign(ptr, ptr + count);
+	// reference types (pointers, instances, buffers) accept null in place of the real thing
+	inline StackSlot popNullable([[maybe_unused]] ItemTag expected) {
+		auto ret = pop();
+#if NI_STACK_TYPECHECK
+		if (ret.tag != ItemTag::Null && ret.tag != expected) {
+			throw WrongTypeException();
 		}
+#endif
+		return ret;
 	}
-	std::vector<int32_t> int32Array() override {
-		return values;
-	}
-};
 
-class UInt32ArrayItem : public StackItem {
-public:
-	std::vector<uint32_t> values;
-	UInt32ArrayItem(uint32_t* ptr, size_t count) {
+	inline ArrayPayload* copyArray(const void* values, size_t count, size_t elementSize) {
+		auto payload = arena.allocArray<ArrayPayload>(1);
+		payload->count = count;
+		payload->elementSize = elementSize;
+		payload->data = nullptr;
 		if (count > 0) {
-			values.assign(ptr, ptr + count);
+			payload->data = arena.alloc(payload->bytes());
+			memcpy(payload->data, values, payload->bytes());
+			if (elementSize == 0 && count % 64 != 0) {
+				// (a bit array's unused bits, in case the pusher left anything there)
+				((uint64_t*)payload->data)[count / 64] &= ~uint64_t(0) >> (64 - count % 64);
+			}
 		}
+		return payload;
 	}
-	std::vector<uint32_t> uint32Array() override {
-		return values;
-	}
-};
-
-// INT64 ====
-
-class Int64Item : public StackItem {
-public:
-	int64_t x;
-	Int64Item(int64_t x) : x(x) {}
-	int64_t int64Value() override {
-		return x;
-	}
-};
 
-class UInt64Item : public StackItem {
-public:
-	uint64_t x;
-	UInt64Item(uint64_t x) : x(x) {}
-	uint64_t uint64Value() override {
-		return x;
+	inline ArrayPayload* copyString(const char* str, size_t length) {
+		// stored null-terminated, same as the std::string we used to hand out
+		auto payload = arena.allocArray<ArrayPayload>(1);
+		auto chars = arena.allocArray<char>(length + 1);
+		if (length > 0) {
+			memcpy(chars, str, length);
+		}
+		chars[length] = 0;
+		payload->data = chars;
+		payload->count = length;
+		payload->elementSize = 1;
+		return payload;
+	}
+
+	// a string array's payload record, offsets and bytes in one allocation (offsets[0] filled in, the rest up to the caller)
+	inline StringArrayPayload* allocStringArray(size_t count, size_t total) {
+		auto payload = (StringArrayPayload*)arena.alloc(sizeof(StringArrayPayload) + (count + 1) * sizeof(uint64_t) + total, alignof(StringArrayPayload));
+		auto offsets = (uint64_t*)(payload + 1);
+		offsets[0] = 0;
+		*payload = { (const char*)(offsets + count + 1), offsets, count, nullptr, nullptr };
+		return payload;
+	}
+
+	inline StringArrayPayload* copyStringArray(const char* const* strs, const size_t* lengths, size_t count) {
+		size_t total = 0;
+		for (size_t i = 0; i < count; i++) {
+			total += lengths[i];
+		}
+		auto payload = allocStringArray(count, total);
+		auto offsets = (uint64_t*)payload->offsets;
+		auto bytes = (char*)payload->bytes;
+		for (size_t i = 0; i < count; i++) {
+			if (lengths[i] > 0) {
+				memcpy(bytes + offsets[i], strs[i], lengths[i]);
+			}
+			offsets[i + 1] = offsets[i] + lengths[i];
+		}
+		return payload;
 	}
-};
 
-class Int64ArrayItem : public StackItem {
-public:
-	std::vector<int64_t> values;
-	Int64ArrayItem(int64_t* ptr, size_t count) {
+	inline StringArrayPayload* copyStringArrayBlob(const char* bytes, const uint64_t* offsets, size_t count) {
+		auto total = count > 0 ? (size_t)offsets[count] : 0;
+		auto payload = allocStringArray(count, total);
 		if (count > 0) {
-			values.assign(ptr, ptr + count);
+			memcpy((uint64_t*)payload->offsets + 1, offsets + 1, count * sizeof(uint64_t));
 		}
+		if (total > 0) {
+			memcpy((char*)payload->bytes, bytes, total);
+		}
+		return payload;
 	}
-	std::vector<int64_t> int64Array() override {
-		return values;
-	}
-};
 
-class UInt64ArrayItem : public StackItem {
-public:
-	std::vector<uint64_t> values;
-	UInt64ArrayItem(uint64_t* ptr, size_t count) {
-		if (count > 0) {
-			values.assign(ptr, ptr + count);
+	// what a pop builds on the way out (string tables and blobs, unpacked bools) lands above the floor, where the invocation's
+	// next push would take it back - so the floor moves up past it, keeping it until the invocation returns like the arguments
+	// (with no invocation in progress it's good until the next push, as everything popped there is)
+	inline void keepPopped() {
+		if (!frames.empty()) {
+			frames.back() = arena.mark();
 		}
 	}
-	std::vector<uint64_t> uint64Array() override {
-		return values;
-	}
-};
 
-class FloatItem : public StackItem {
-public:
-	float x;
-	FloatItem(float x) : x(x) {}
-	float floatValue() override {
-		return x;
+	// the pointer table, for the pops that hand one out
+	inline void stringTable(StringArrayPayload* payload) {
+		if (payload->strs) {
+			return;
+		}
+		payload->strs = arena.allocArray<const char*>(payload->count);
+		payload->lengths = arena.allocArray<size_t>(payload->count);
+		for (size_t i = 0; i < payload->count; i++) {
+			payload->strs[i] = payload->str(i);
+			payload->lengths[i] = payload->length(i);
+		}
+		keepPopped();
 	}
-};
 
-class FloatArrayItem : public StackItem {
-public:
-	std::vector<float> values;
-	FloatArrayItem(float* ptr, size_t count) {
-		values.assign(ptr, ptr + count);
-	}
-	std::vector<float> floatArray() override {
-		return values;
+	// ... and the blob, for the ones that hand out that (only missing when pushed borrowed as a pointer table)
+	inline void stringBlob(StringArrayPayload* payload) {
+		if (payload->offsets) {
+			return;
+		}
+		auto copy = copyStringArray(payload->strs, payload->lengths, payload->count);
+		payload->bytes = copy->bytes;
+		payload->offsets = copy->offsets;
+		keepPopped();
+	}
+
+	template <typename T>
+	inline void pushArray(ItemTag tag, const T* values, size_t count) {
+		beginPush();
+		pushSlot(tag).array = copyArray(values, count, sizeof(T));
+	}
+
+	// borrowed: just record where the pusher's data is, see materializeBorrowed() for when it does get copied
+	inline StackSlot& pushArrayBorrowed(ItemTag tag, const void* values, size_t count, size_t elementSize) {
+		beginPush();
+		auto payload = arena.allocArray<ArrayPayload>(1);
+		payload->data = (void*)values;
+		payload->count = count;
+		payload->elementSize = elementSize;
+		auto& slot = pushSlot(tag);
+		slot.array = payload;
+		slot.borrowed = true;
+		borrowedCount++;
+		return slot;
+	}
+
+	template <typename T>
+	inline void pushArrayBorrowed(ItemTag tag, const T* values, size_t count) {
+		pushArrayBorrowed(tag, values, count, sizeof(T));
+	}
+
+	// the pusher only guarantees borrowed memory until the invocation it was pushed for returns,
+	// so anything borrowed that is still sitting on the stack at that point (normally nothing) gets a copy of its own
+	void materializeBorrowed() {
+		for (auto& slot : vstack) {
+			if (!slot.borrowed) {
+				continue;
+			}
+			if (slot.tag == ItemTag::StringArray) {
+				auto payload = slot.strArray;
+				slot.strArray = payload->offsets
+					? copyStringArrayBlob(payload->bytes, payload->offsets, payload->count)
+					: copyStringArray(payload->strs, payload->lengths, payload->count);
+			}
+			else if (slot.tag == ItemTag::String) {
+				slot.array = copyString((const char*)slot.array->data, slot.array->count);
+			}
+			else {
+				slot.array = copyArray(slot.array->data, slot.array->count, slot.array->elementSize);
+			}
+			slot.borrowed = false;
+		}
+		borrowedCount = 0;
+	}
+
+	// what's on the stack right now, in bytes: the slots plus whatever they point at (for the profiler, see ProfileScope)
+	uint64_t stackBytes() const {
+		uint64_t total = vstack.size() * sizeof(StackSlot);
+		for (auto& slot : vstack) {
+			switch (slot.tag) {
+			case ItemTag::StringArray:
+				total += slot.strArray->totalLength();
+				break;
+			case ItemTag::Struct:
+				if (structLayouts[slot.id]->size > sizeof(StackSlot::bytes)) {
+					total += structLayouts[slot.id]->size;
+				}
+				break;
+			case ItemTag::Buffer:
+				total += sizeof(ni_BufferDescriptor); // the buffer itself doesn't cross, just its description
+				break;
+			default:
+				if (hasArrayPayload(slot.tag)) {
+					total += slot.array->bytes();
+				}
+				break;
+			}
+		}
+		return total;
 	}
-};
 
-class DoubleItem : public StackItem {
-public:
-	double x;
-	DoubleItem(double x) : x(x) {}
-	double doubleValue() override {
-		return x;
+	template <typename T>
+	inline void popArray(ItemTag tag, T** values, size_t* count) {
+		auto payload = pop(tag).array;
+		*values = (T*)payload->data;
+		*count = payload->count;
 	}
 };
+// todo: require formal threadInit() and allocate manually? is that more efficient?
+static thread_local ThreadLocal thlocal;
 
-class DoubleArrayItem : public StackItem {
-public:
-	std::vector<double> values;
-	DoubleArrayItem(double* ptr, size_t count) {
-		values.assign(ptr, ptr + count);
+// keeps the arguments of the current invocation alive (see ThreadLocal::frames)
+static inline void beginInvocationFrame() {
+	thlocal.frames.push_back(thlocal.arena.mark());
+}
+
+static inline void endInvocationFrame() {
+	if (thlocal.borrowedCount > 0) {
+		thlocal.materializeBorrowed();
 	}
-	std::vector<double> doubleArray() override {
-		return values;
+	// (while the frame's still on: a release handler calling back in is a nested entry, see expireServerSafetyArea)
+	if (!thlocal.pendingReleases.empty()) {
+		ni_flushClientResourceReleases();
 	}
-};
+	thlocal.frames.pop_back();
+}
 
-class StringItem : public StackItem {
-public:
-	std::string str;
-	StringItem(const char* raw, size_t length) {
-		if (length > 0) {
-			str.assign(raw, length);
-		}
-        // else keep empty
+struct InvocationFrame {
+	InvocationFrame() {
+		beginInvocationFrame();
 	}
-	std::string stringValue() override {
-		return str;
+	~InvocationFrame() {
+		endInvocationFrame();
 	}
 };
 
-class StringArrayItem : public StackItem {
-public:
-	std::vector<std::string> values;
-	StringArrayItem(const char** ptrs, size_t* lengths, size_t count) {
-		for (auto i = 0; i < count; i++) {
-			std::string str;
-			if (lengths[i] > 0) {
-				str.assign(ptrs[i], lengths[i]);
-			}
-            // else keep empty
-			values.push_back(str);
+// instrumented crossings: for the stats, timed (inclusive of anything nested), with the stack contents going in taken as the arguments,
+// and what's left on it coming out as the return values (each side pushes onto an empty stack, see ThreadLocal::beginPush)
+// and/or a begin/end pair on the timeline
+// only ever constructed behind a check of instrumentation, which is all a crossing costs with both off
+struct ProfileScope {
+	MethodStats* stats;
+	uint8_t flags; // as of entry, so that switching mid-crossing can't leave a begin without its end
+	uint64_t itemsIn = 0;
+	uint64_t bytesIn = 0;
+	std::chrono::steady_clock::time_point start;
+
+	ProfileScope(MethodStats* stats)
+		: stats(stats), flags(instrumentation.load(std::memory_order_relaxed))
+	{
+		if (flags & InstrumentStats) {
+			itemsIn = thlocal.vstack.size();
+			bytesIn = thlocal.stackBytes();
+		}
+		start = std::chrono::steady_clock::now();
+		if (flags & InstrumentTimeline) {
+			timelineBegin(stats, start);
 		}
 	}
-	std::vector<std::string> stringArray() override {
-		return values;
+	~ProfileScope() {
+		auto end = std::chrono::steady_clock::now();
+		if (flags & InstrumentTimeline) {
+			timelineEnd(stats, end);
+		}
+		if (flags & InstrumentStats) {
+			auto ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+			stats->record(ns, itemsIn, bytesIn, thlocal.vstack.size(), thlocal.stackBytes());
+		}
 	}
 };
 
-// client func val
-class ClientFuncItem : public StackItem {
-public:
-	int id;
-	ClientFuncItem(int id) : id(id) {}
-	int clientFuncId() override {
-		return id;
-	}
-};
+static inline MethodStats* moduleMethodStats(ni_ModuleMethodRef method) {
+	return method->stats.get("module", method->_module->name, nullptr, method->name);
+}
 
-// server func val
-class ServerFuncItem : public StackItem {
-public:
-	int id;
-	ServerFuncItem(int id) : id(id) {}
-	int serverFuncId() override {
-		return id;
-	}
-};
+static inline MethodStats* interfaceMethodStats(ni_InterfaceMethodRef method) {
+	return method->stats.get("interface", method->_iface->_module->name, method->_iface->name, method->name);
+}
 
-// client inst ID
-class InstanceItem : public StackItem {
-public:
-	int id;
-	bool isClientId;
-	InstanceItem(int id, bool isClientId) :
-		id(id),
-		isClientId(isClientId) {}
-	int instanceId(bool* isClientId) override {
-		*isClientId = this->isClientId;
-		return id;
+// function values are anonymous, so they're lumped together per direction
+static StatsSlot clientFuncStats;
+static StatsSlot serverFuncStats;
+
+// entry from the client: a new invocation means the client is done popping whatever the previous one returned,
+// so that's when the server's return protections (safety area) lapse - no separate clear crossing needed
+// only for an entry at the same depth as the invocation that started using it, or further out: a deeper one (a release handler
+// calling back in as that invocation ends, say) comes while its caller still has return values to pop. anything added since
+// came from the same depth or deeper, so it's all done with by then too
+// (batches expire once up front instead, since all their return values stay on the stack until the batch is over)
+static inline void expireServerSafetyArea() {
+	if (thlocal.serverSafetyAreaDepth >= 0 && (int)thlocal.frames.size() <= thlocal.serverSafetyAreaDepth) {
+		thlocal.serverSafetyAreaDepth = -1;
+		ni_clearServerSafetyArea();
 	}
-};
+}
 
-class BufferItem : public StackItem {
-public:
-	int id;
-	bool isClientId;
-	ni_BufferDescriptor descriptor;
-	BufferItem(int id, bool isClientId, ni_BufferDescriptor* descriptor)
-		: id(id), isClientId(isClientId)
-	{
-		this->descriptor = *descriptor;
+struct ClientEntryFrame {
+	ClientEntryFrame() {
+		expireServerSafetyArea(); // (before the frame goes on)
+		beginInvocationFrame();
 	}
-	void buffer(int* id, bool* isClientId, ni_BufferDescriptor* descriptor) override {
-		*id = this->id;
-		*isClientId = this->isClientId;
-		*descriptor = this->descriptor;
+	~ClientEntryFrame() {
+		endInvocationFrame();
 	}
 };
 
-// null methods for callback defaults (also assigned when client is shut down, to prevent dtors from calling back into client)
-static void nullIntMethod(int x) {}
-static void nullVoidMethod() {}
-static void nullMethodExec(ni_InterfaceMethodRef method, int id) {}
-
-// private global stuff ============================
-static std::map<std::string, ni_ModuleRef> modules;
+// the client-provided callbacks, wrapped below so that callbacks get frames just like invocations coming the other way
+static niClientFuncExec clientFuncExecImpl;
+static niClientMethodExec clientMethodExecImpl;
 
-niClientFuncExec ni_clientFuncExec;
-niClientMethodExec ni_clientMethodExec;
-niClientResourceRelease ni_clientResourceRelease;
-niClientClearSafetyArea ni_clientClearSafetyArea;
-
-struct ThreadLocal {
-	std::stack<std::unique_ptr<StackItem>> vstack;
-	ni_ExceptionRef currentException = nullptr;
+static void framedClientFuncExec(int id) {
+	InvocationFrame frame;
+	if (instrumentation.load(std::memory_order_relaxed)) {
+		ProfileScope scope(clientFuncStats.get("funcval", "(client)", nullptr, "(function values)"));
+		clientFuncExecImpl(id);
+		return;
+	}
+	clientFuncExecImpl(id);
+}
 
-	std::vector<void*> lastPtrArray;
-	std::vector<size_t> lastSizeTArray;
-	std::vector<uint8_t> lastBoolArray;
-	std::vector<int8_t> lastInt8Array;
-	std::vector<uint8_t> lastUInt8Array;
-	std::vector<int16_t> lastInt16Array;
-	std::vector<uint16_t> lastUInt16Array;
-	std::vector<int32_t> lastInt32Array;
-	std::vector<uint32_t> lastUInt32Array;
-	std::vector<int64_t> lastInt64Array;
-	std::vector<uint64_t> lastUInt64Array;
-	std::vector<float> lastFloatArray;
-	std::vector<double> lastDoubleArray;
-	std::string lastPoppedString; // pointers gotta point to something ...
-	std::vector<std::string> lastPoppedStringArray;
-	const char** lastPoppedStrs = nullptr;
-	size_t* lastPoppedStrLengths = nullptr;
-
-	inline void push(StackItem* item) {
-		vstack.push(std::unique_ptr<StackItem>(item));
-	}
-
-	inline std::unique_ptr<StackItem> pop() {
-		auto ret = std::move(vstack.top());
-		vstack.pop();
-		return ret;
+static void framedClientMethodExec(ni_InterfaceMethodRef method, int objID) {
+	InvocationFrame frame;
+	if (instrumentation.load(std::memory_order_relaxed)) {
+		ProfileScope scope(method->callbackStats.get("callback", method->_iface->_module->name, method->_iface->name, method->name));
+		clientMethodExecImpl(method, objID);
+		return;
 	}
-};
-// todo: require formal threadInit() and allocate manually? is that more efficient?
-static thread_local ThreadLocal thlocal;
+	clientMethodExecImpl(method, objID);
+}
 
 ni_ModuleRef ni_registerModule(const char *name)
 {
-	// make sure name doesn't already exist
-	auto found = modules.find(name);
-	if (found != modules.end()) {
-		printf("registerModule: module name [%s] already exists!\n", name);
-		return nullptr;
-	}
-	auto mod = new ni_Module{ name };
-	modules[name] = mod;
-	return mod;
+	// duplicate names are reported when the name index gets built
+	return indexRef(ni_RefModule, modules.add(ni_Module{ name }));
 }
 
 ni_ModuleMethodRef ni_registerModuleMethod(ni_ModuleRef m, const char *name, ModuleFunc func)
 {
-	auto found = m->methods.find(name);
-	if (found != m->methods.end()) {
-		printf("registerModuleMethod: method name [%s] already exists!\n", name);
-		return nullptr;
+	return indexRef(ni_RefModuleMethod, m->methods.add(ni_ModuleMethod{ m, name, func }));
+}
+
+void ni_registerModuleMethods(ni_ModuleRef m, const ni_ModuleMethodEntry* entries, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		indexRef(ni_RefModuleMethod, m->methods.add(ni_ModuleMethod{ m, entries[i].name, entries[i].func }));
 	}
-	auto method = new ni_ModuleMethod{ m, name, func };
-	m->methods[name] = method;
-	return method;
 }
 
 void ni_registerModuleConstants(ni_ModuleRef m, ConstantsFunc func) {
 	if (m->constantsFunc != nullptr) {
-		printf("Module %s ConstantsFunc already defined\n", m->name.c_str());
+		printf("Module %s ConstantsFunc already defined\n", m->name);
 	}
 	else {
 		m->constantsFunc = func;
@@ -571,37 +737,87 @@ void ni_registerModuleConstants(ni_ModuleRef m, ConstantsFunc func) {
 
 ni_InterfaceRef ni_registerInterface(ni_ModuleRef m, const char *name)
 {
-	auto found = m->interfaces.find(name);
-	if (found != m->interfaces.end()) {
-		printf("registerModuleInterface: interface name [%s] already exists!\n", name);
-		return nullptr;
-	}
-	auto iface = new ni_Interface{ m, name };
-	m->interfaces[name] = iface;
-	return iface;
+	return indexRef(ni_RefInterface, m->interfaces.add(ni_Interface{ m, name }));
 }
 
 ni_InterfaceMethodRef ni_registerInterfaceMethod(ni_InterfaceRef iface, const char *name, InterfaceFunc ifunc)
 {
-	auto found = iface->methods.find(name);
-	if (found != iface->methods.end()) {
-		printf("registerInterfaceMethod: iface method name [%s] already exists!\n", name);
-		return nullptr;
-	}
-	auto method = new ni_InterfaceMethod{ iface, name, ifunc };
-	iface->methods[name] = method;
-	return method;
+	return indexRef(ni_RefInterfaceMethod, iface->methods.add(ni_InterfaceMethod{ iface, name, ifunc }));
 }
 
 ni_ExceptionRef ni_registerException(ni_ModuleRef m, const char *name, ExceptionBuilder buildAndThrow) {
-	auto found = m->exceptions.find(name);
-	if (found != m->exceptions.end()) {
-		printf("registerException: method exception name [%s] already exists!\n", name);
-		return nullptr;
+	return indexRef(ni_RefException, m->exceptions.add(ni_Exception{ m, name, buildAndThrow }));
+}
+
+int ni_registerStruct(ni_ModuleRef m, const char* name, size_t size, const ni_StructField* fields, size_t fieldCount) {
+	auto typeId = (int)structLayouts.size();
+	structLayouts.push_back(m->structs.add(StructLayout{ m, name, typeId, size, fields, fieldCount }));
+	return typeId;
+}
+
+// (under registrationLock)
+static ni_ModuleRef registerDeferred(DeferredModule* deferred) {
+	if (deferred->state.load(std::memory_order_relaxed) != DeferredModule::Pending) {
+		return deferred->module;
+	}
+	deferred->state.store(DeferredModule::Registering, std::memory_order_relaxed);
+	if (auto dependencies = deferred->descriptor->dependencies) {
+		for (; *dependencies; dependencies++) {
+			if (auto dependency = deferredModules.find(*dependencies)) {
+				registerDeferred(dependency);
+			}
+			else {
+				printf("Module %s depends on %s, which isn't in the module table\n", deferred->name, *dependencies);
+			}
+		}
+	}
+	auto ordinal = (int)modules.items.size();
+	if (instrumentation.load(std::memory_order_relaxed)) {
+		ProfileScope scope(deferred->stats.get("register", deferred->name, nullptr, "__register"));
+		deferred->descriptor->registerFunc();
+	}
+	else {
+		deferred->descriptor->registerFunc();
+	}
+	deferred->module = modules.at(ordinal);
+	if (!deferred->module || strcmp(deferred->module->name, deferred->name) != 0) {
+		printf("Module %s: its register function didn't register it\n", deferred->name);
+		deferred->module = nullptr;
+	}
+	else {
+		// so that other threads can look things up in it without the lock
+		deferred->module->methods.buildIndex();
+		deferred->module->interfaces.buildIndex();
+		deferred->module->exceptions.buildIndex();
+		deferred->module->structs.buildIndex();
+		for (auto& iface : deferred->module->interfaces.items) {
+			iface.methods.buildIndex();
+		}
+	}
+	deferred->state.store(DeferredModule::Registered, std::memory_order_release);
+	pendingModules.fetch_sub(1, std::memory_order_release);
+	return deferred->module;
+}
+
+void ni_registerModuleDescriptors(const ni_ModuleDescriptor* descriptors, size_t count)
+{
+	std::lock_guard<std::recursive_mutex> lock(registrationLock);
+	for (size_t i = 0; i < count; i++) {
+		deferredModules.add(DeferredModule(descriptors[i].name, &descriptors[i]));
+	}
+	deferredModules.buildIndex(); // (ni_getModule reads it without the lock)
+	pendingModules += count;
+}
+
+void ni_registerAllModules()
+{
+	if (pendingModules.load(std::memory_order_acquire) == 0) {
+		return;
+	}
+	std::lock_guard<std::recursive_mutex> lock(registrationLock);
+	for (size_t i = 0; pendingModules > 0 && i < deferredModules.items.size(); i++) {
+		registerDeferred(&deferredModules.items[i]);
 	}
-	auto exception = new ni_Exception{ m, name, buildAndThrow };
-	m->exceptions[name] = exception;
-	return exception;
 }
 
 // client methods (some used by server as well) ===============================
@@ -613,15 +829,24 @@ int ni_nativeImplInit(
 	niClientClearSafetyArea clientClearSafetyArea
 	)
 {
-	::ni_clientFuncExec = clientFuncExec;
-	::ni_clientMethodExec = clientMethodExec;
+	clientFuncExecImpl = clientFuncExec;
+	clientMethodExecImpl = clientMethodExec;
+	::ni_clientFuncExec = &framedClientFuncExec;
+	::ni_clientMethodExec = &framedClientMethodExec;
 	::ni_clientResourceRelease = clientResourceRelease;
 	::ni_clientClearSafetyArea = clientClearSafetyArea;
 
+	traceStartDrain();
+
 	// library-specific registrations etc
 	return nativeLibraryInit();
 }
 
+void ni_setClientResourceReleaseBatch(niClientResourceReleaseBatch clientResourceReleaseBatch)
+{
+	::clientResourceReleaseBatch = clientResourceReleaseBatch;
+}
+
 void ni_nativeImplShutdown()
 {
 	printf("nativeImplShutdown\n");
@@ -631,51 +856,132 @@ void ni_nativeImplShutdown()
 	ni_clientMethodExec = &nullMethodExec;
 	ni_clientResourceRelease = &nullIntMethod;
 	ni_clientClearSafetyArea = &nullVoidMethod;
+	clientResourceReleaseBatch = nullptr;
 
 	printf(" - callbacks disabled\n");
 	fflush(stdout);
 
 	nativeLibraryShutdown();
+	traceStopDrain();
 }
 
 ni_ModuleRef ni_getModule(const char* name) {
-	auto found = modules.find(std::string(name));
-	if (found != modules.end()) {
-		return found->second;
+	// the table has every deferred module, registered or not (which spares rebuilding the other index after each registration)
+	if (auto deferred = deferredModules.find(name)) {
+		if (deferred->state.load(std::memory_order_acquire) == DeferredModule::Registered) {
+			return deferred->module;
+		}
+		std::lock_guard<std::recursive_mutex> lock(registrationLock);
+		return registerDeferred(deferred);
 	}
-	return nullptr;
+	std::lock_guard<std::recursive_mutex> lock(registrationLock);
+	return modules.find(name);
 }
 
 ni_ModuleMethodRef ni_getModuleMethod(ni_ModuleRef m, const char* name) {
-	auto found = m->methods.find(std::string(name));
-	if (found != m->methods.end()) {
-		return found->second;
-	}
-	return nullptr;
+	return m->methods.find(name);
 }
 
 ni_InterfaceRef ni_getInterface(ni_ModuleRef m, const char* name) {
-	auto found = m->interfaces.find(std::string(name));
-	if (found != m->interfaces.end()) {
-		return found->second;
-	}
-	return nullptr;
+	return m->interfaces.find(name);
 }
 
 ni_InterfaceMethodRef ni_getInterfaceMethod(ni_InterfaceRef iface, const char* name) {
-	auto found = iface->methods.find(std::string(name));
-	if (found != iface->methods.end()) {
-		return found->second;
-	}
-	return nullptr;
+	return iface->methods.find(name);
 }
 
 ni_ExceptionRef ni_getException(ni_ModuleRef m, const char* name) {
-	auto found = m->exceptions.find(std::string(name));
-	if (found != m->exceptions.end()) {
-		return found->second;
+	return m->exceptions.find(name);
+}
+
+bool ni_getRefNames(int kind, const void* ref, const char** module, const char** owner, const char** name) {
+	*owner = "";
+	switch (kind) {
+	case ni_RefModule:
+		*module = *name = ((ni_ModuleRef)ref)->name;
+		return true;
+	case ni_RefModuleMethod:
+		*module = ((ni_ModuleMethodRef)ref)->_module->name;
+		*name = ((ni_ModuleMethodRef)ref)->name;
+		return true;
+	case ni_RefInterface:
+		*module = ((ni_InterfaceRef)ref)->_module->name;
+		*name = ((ni_InterfaceRef)ref)->name;
+		return true;
+	case ni_RefInterfaceMethod:
+		*module = ((ni_InterfaceMethodRef)ref)->_iface->_module->name;
+		*owner = ((ni_InterfaceMethodRef)ref)->_iface->name;
+		*name = ((ni_InterfaceMethodRef)ref)->name;
+		return true;
+	case ni_RefException:
+		*module = ((ni_ExceptionRef)ref)->_module->name;
+		*name = ((ni_ExceptionRef)ref)->name;
+		return true;
+	case ni_RefStructType: {
+		auto typeId = (intptr_t)ref;
+		if (typeId < 0 || (size_t)typeId >= structLayouts.size()) {
+			return false;
+		}
+		*module = structLayouts[typeId]->_module->name;
+		*name = structLayouts[typeId]->name;
+		return true;
+	}
 	}
-	return nullptr;
+	return false;
+}
+
+int ni_getRefCount(int kind) {
+	ni_registerAllModules();
+	if (kind == ni_RefStructType) {
+		return (int)structLayouts.size();
+	}
+	return kind >= 0 && kind < ni_RefStructType ? (int)refsByIndex[kind].size() : 0;
+}
+
+int ni_getRefIndex(int kind, const void* ref) {
+	if (!ref) {
+		return -1;
+	}
+	switch (kind) {
+	case ni_RefModule: return ((ni_ModuleRef)ref)->index;
+	case ni_RefModuleMethod: return ((ni_ModuleMethodRef)ref)->index;
+	case ni_RefInterface: return ((ni_InterfaceRef)ref)->index;
+	case ni_RefInterfaceMethod: return ((ni_InterfaceMethodRef)ref)->index;
+	case ni_RefException: return ((ni_ExceptionRef)ref)->index;
+	case ni_RefStructType: return (int)(intptr_t)ref;
+	}
+	return -1;
+}
+
+const void* ni_getRefByIndex(int kind, int index) {
+	// (an index past the end may be one that registering the rest would give out, and the tables can't be read
+	// while another thread might be adding to them - so both wait for everything to be registered)
+	ni_registerAllModules();
+	if (kind == ni_RefStructType) {
+		return index >= 0 && (size_t)index < structLayouts.size() ? (const void*)(intptr_t)index : nullptr;
+	}
+	if (kind < 0 || kind >= ni_RefStructType || index < 0 || (size_t)index >= refsByIndex[kind].size()) {
+		return nullptr;
+	}
+	return refsByIndex[kind][index];
+}
+
+int ni_getModuleCount() {
+	ni_registerAllModules();
+	return (int)modules.items.size();
+}
+
+ni_ModuleRef ni_getModuleByOrdinal(int ordinal) {
+	ni_registerAllModules();
+	return modules.at(ordinal);
+}
+
+int ni_getModuleMethodCount(ni_ModuleRef m) {
+	return (int)m->methods.items.size();
+}
+
+ni_ModuleMethodRef ni_getModuleMethodByOrdinal(ni_ModuleRef m, int ordinal) {
+	return m->methods.at(ordinal);
 }
 
 void ni_pushModuleConstants(ni_ModuleRef m) {
@@ -683,393 +989,1390 @@ void ni_pushModuleConstants(ni_ModuleRef m) {
 }
 
 void ni_invokeModuleMethod(ni_ModuleMethodRef method) {
-	method->func();
+	ClientEntryFrame frame;
+	if (instrumentation.load(std::memory_order_relaxed)) {
+		ProfileScope scope(moduleMethodStats(method));
+		method->func();
+	}
+	else {
+		method->func();
+	}
 	assert(thlocal.currentException == nullptr); // this should never be used for methods potentially throwing exceptions!
 }
 
 ni_ExceptionRef ni_invokeModuleMethodWithExceptions(ni_ModuleMethodRef method) {
 	assert(thlocal.currentException == nullptr);
-	method->func();
+	ClientEntryFrame frame;
+	if (instrumentation.load(std::memory_order_relaxed)) {
+		ProfileScope scope(moduleMethodStats(method));
+		method->func();
+	}
+	else {
+		method->func();
+	}
 	auto ret = thlocal.currentException;
 	thlocal.currentException = nullptr;
 	return ret;
 }
 
+bool ni_beginDirectCall() {
+	if (instrumentation.load(std::memory_order_relaxed)) {
+		return false;
+	}
+	// (as ClientEntryFrame)
+	expireServerSafetyArea();
+	beginInvocationFrame();
+	return true;
+}
+
+void ni_endDirectCall() {
+	endInvocationFrame();
+}
+
+// batch decoding ==============================================
+
+// walks a batch buffer one record at a time, bounds-checked against the end
+struct BatchReader {
+	const uint8_t* pos;
+	const uint8_t* end;
+
+	static inline size_t padded(size_t n) {
+		return (n + 7) & ~size_t(7);
+	}
+
+	template <typename T>
+	inline const T* take(size_t count = 1) {
+		// count is client-supplied, so check it before multiplying
+		if (count > size_t(end - pos) / sizeof(T)) {
+			return nullptr;
+		}
+		auto bytes = padded(count * sizeof(T));
+		if (bytes > size_t(end - pos)) {
+			return nullptr;
+		}
+		auto ret = (const T*)pos;
+		pos += bytes;
+		return ret;
+	}
+};
+
+static size_t batchArrayElementSize(uint8_t type) {
+	switch (type) {
+	case ni_BatchPtrArray: return sizeof(void*);
+	case ni_BatchSizeTArray: return sizeof(size_t);
+	case ni_BatchBoolArray: return sizeof(bool);
+	case ni_BatchInt8Array: case ni_BatchUInt8Array: case ni_BatchString: return 1;
+	case ni_BatchInt16Array: case ni_BatchUInt16Array: return 2;
+	case ni_BatchInt32Array: case ni_BatchUInt32Array: case ni_BatchFloatArray: return 4;
+	case ni_BatchInt64Array: case ni_BatchUInt64Array: case ni_BatchDoubleArray: return 8;
+	default: return 0;
+	}
+}
+
+// skips over one argument, returning false if it's malformed
+static bool batchSkipArg(BatchReader& r) {
+	auto arg = r.take<ni_BatchArg>();
+	if (!arg) {
+		return false;
+	}
+	switch (arg->type) {
+	case ni_BatchNull:
+	case ni_BatchInstance:
+	case ni_BatchClientFunc:
+	case ni_BatchServerFunc:
+		return true;
+	case ni_BatchBuffer:
+		return r.take<ni_BufferDescriptor>() != nullptr;
+	case ni_BatchStruct:
+	case ni_BatchStructArray: {
+		if (arg->id < 0 || (size_t)arg->id >= structLayouts.size()) {
+			return false;
+		}
+		auto size = structLayouts[arg->id]->size;
+		if (arg->type == ni_BatchStruct) {
+			return r.take<uint8_t>(size) != nullptr;
+		}
+		auto count = r.take<uint64_t>();
+		return count && r.take<uint8_t>(*count > (size_t)-1 / size ? (size_t)-1 : *count * size) != nullptr;
+	}
+	case ni_BatchStringArray: {
+		auto count = r.take<uint64_t>();
+		if (!count) {
+			return false;
+		}
+		auto lengths = r.take<uint64_t>(*count);
+		if (!lengths) {
+			return false;
+		}
+		size_t total = 0;
+		for (size_t i = 0; i < *count; i++) {
+			if (lengths[i] > size_t(r.end - r.pos) - total) {
+				return false;
+			}
+			total += lengths[i];
+		}
+		return r.take<uint8_t>(total) != nullptr;
+	}
+	case ni_BatchBitArray: {
+		auto count = r.take<uint64_t>();
+		return count && r.take<uint64_t>(bitWords((size_t)*count)) != nullptr;
+	}
+	default:
+		if (arg->type <= ni_BatchDouble) {
+			return r.take<ni_BatchScalar>() != nullptr;
+		}
+		if (auto elementSize = batchArrayElementSize(arg->type)) {
+			auto count = r.take<uint64_t>();
+			return count && r.take<uint8_t>(*count > (size_t)-1 / elementSize ? (size_t)-1 : *count * elementSize) != nullptr;
+		}
+		return false;
+	}
+}
+
+static void pushStringArrayBorrowed(StringArrayPayload* payload); // (with the string array pushes below)
+
+// pushes one (already validated) argument
+static void batchPushArg(BatchReader& r) {
+	auto arg = r.take<ni_BatchArg>();
+	switch (arg->type) {
+	case ni_BatchNull: ni_pushNull(); return;
+	case ni_BatchInstance: ni_pushInstance(arg->id, arg->isClientId); return;
+	case ni_BatchClientFunc: ni_pushClientFunc(arg->id); return;
+	case ni_BatchServerFunc: ni_pushServerFunc(arg->id); return;
+	case ni_BatchBuffer:
+		ni_pushBuffer(arg->id, arg->isClientId, const_cast<ni_BufferDescriptor*>(r.take<ni_BufferDescriptor>()));
+		return;
+	case ni_BatchStruct: {
+		auto size = structLayouts[arg->id]->size;
+		ni_pushStruct(arg->id, r.take<uint8_t>(size), size);
+		return;
+	}
+	case ni_BatchStructArray: {
+		auto count = (size_t)*r.take<uint64_t>();
+		ni_pushStructArrayBorrowed(arg->id, r.take<uint8_t>(count * structLayouts[arg->id]->size), count);
+		return;
+	}
+	case ni_BatchStringArray: {
+		auto count = (size_t)*r.take<uint64_t>();
+		auto lengths = r.take<uint64_t>(count);
+		// the bytes are already a blob, only the offsets need working out - in the payload, after beginPush has had its say
+		// (it resets the arena when the stack's empty, so nothing for this item can be allocated before it)
+		thlocal.beginPush();
+		auto payload = thlocal.allocStringArray(count, 0);
+		auto offsets = (uint64_t*)payload->offsets;
+		for (size_t i = 0; i < count; i++) {
+			offsets[i + 1] = offsets[i] + lengths[i];
+		}
+		payload->bytes = (const char*)r.take<uint8_t>((size_t)offsets[count]);
+		pushStringArrayBorrowed(payload);
+		return;
+	}
+	case ni_BatchBitArray: {
+		auto count = (size_t)*r.take<uint64_t>();
+		ni_pushBitArrayBorrowed(r.take<uint64_t>(bitWords(count)), count);
+		return;
+	}
+	default:
+		break;
+	}
+	if (arg->type <= ni_BatchDouble) {
+		auto v = r.take<ni_BatchScalar>();
+		switch (arg->type) {
+		case ni_BatchPtr: ni_pushPtr(v->ptr); break;
+		case ni_BatchSizeT: ni_pushSizeT(v->sizeT); break;
+		case ni_BatchBool: ni_pushBool(v->b); break;
+		case ni_BatchInt8: ni_pushInt8(v->i8); break;
+		case ni_BatchUInt8: ni_pushUInt8(v->u8); break;
+		case ni_BatchInt16: ni_pushInt16(v->i16); break;
+		case ni_BatchUInt16: ni_pushUInt16(v->u16); break;
+		case ni_BatchInt32: ni_pushInt32(v->i32); break;
+		case ni_BatchUInt32: ni_pushUInt32(v->u32); break;
+		case ni_BatchInt64: ni_pushInt64(v->i64); break;
+		case ni_BatchUInt64: ni_pushUInt64(v->u64); break;
+		case ni_BatchFloat: ni_pushFloat(v->f); break;
+		case ni_BatchDouble: ni_pushDouble(v->d); break;
+		}
+		return;
+	}
+	auto count = (size_t)*r.take<uint64_t>();
+	auto data = r.take<uint8_t>(count * batchArrayElementSize(arg->type));
+	switch (arg->type) {
+	case ni_BatchPtrArray: ni_pushPtrArrayBorrowed((void* const*)data, count); break;
+	case ni_BatchSizeTArray: ni_pushSizeTArrayBorrowed((const size_t*)data, count); break;
+	case ni_BatchBoolArray: ni_pushBoolArrayBorrowed((const bool*)data, count); break;
+	case ni_BatchInt8Array: ni_pushInt8ArrayBorrowed((const int8_t*)data, count); break;
+	case ni_BatchUInt8Array: ni_pushUInt8ArrayBorrowed((const uint8_t*)data, count); break;
+	case ni_BatchInt16Array: ni_pushInt16ArrayBorrowed((const int16_t*)data, count); break;
+	case ni_BatchUInt16Array: ni_pushUInt16ArrayBorrowed((const uint16_t*)data, count); break;
+	case ni_BatchInt32Array: ni_pushInt32ArrayBorrowed((const int32_t*)data, count); break;
+	case ni_BatchUInt32Array: ni_pushUInt32ArrayBorrowed((const uint32_t*)data, count); break;
+	case ni_BatchInt64Array: ni_pushInt64ArrayBorrowed((const int64_t*)data, count); break;
+	case ni_BatchUInt64Array: ni_pushUInt64ArrayBorrowed((const uint64_t*)data, count); break;
+	case ni_BatchFloatArray: ni_pushFloatArrayBorrowed((const float*)data, count); break;
+	case ni_BatchDoubleArray: ni_pushDoubleArrayBorrowed((const double*)data, count); break;
+	case ni_BatchString: ni_pushStringBorrowed((const char*)data, count); break;
+	}
+}
+
+int ni_invokeBatch(const void* buffer, size_t length, ni_BatchResult* results, size_t maxResults) {
+	assert(thlocal.currentException == nullptr);
+	auto start = (const uint8_t*)buffer;
+	if ((uintptr_t)start % alignof(ni_BatchCommand) != 0) {
+		return -1;
+	}
+
+	// validate everything before running anything, a half-applied batch is worse than none
+	size_t numCommands = 0;
+	BatchReader r{ start, start + length };
+	while (r.pos < r.end) {
+		auto cmd = r.take<ni_BatchCommand>();
+		if (!cmd || !cmd->method) {
+			return -1;
+		}
+		for (uint32_t i = 0; i < cmd->argCount; i++) {
+			if (!batchSkipArg(r)) {
+				return -1;
+			}
+		}
+		numCommands++;
+	}
+	if (results && numCommands > maxResults) {
+		return -1;
+	}
+
+	expireServerSafetyArea();
+
+	int executed = 0;
+	r.pos = start;
+	while (r.pos < r.end) {
+		auto cmd = r.take<ni_BatchCommand>();
+		auto depthBefore = thlocal.vstack.size();
+		for (uint32_t i = 0; i < cmd->argCount; i++) {
+			batchPushArg(r);
+		}
+		ni_ExceptionRef exception;
+		{
+			InvocationFrame frame;
+			if (instrumentation.load(std::memory_order_relaxed)) {
+				ProfileScope scope(moduleMethodStats(cmd->method));
+				cmd->method->func();
+			}
+			else {
+				cmd->method->func();
+			}
+			exception = thlocal.currentException;
+			thlocal.currentException = nullptr;
+		}
+		if (results) {
+			auto depthAfter = thlocal.vstack.size();
+			results[executed] = { exception, (uint32_t)(depthAfter > depthBefore ? depthAfter - depthBefore : 0), 0 };
+		}
+		executed++;
+		if (exception) {
+			break;
+		}
+	}
+	return executed;
+}
+
+// stack transfer ==============================================
+
+// the stack lists each scalar type's array right after it, the batch layout has all the scalars and then all the arrays (same order)
+static inline uint8_t batchArgType(ItemTag tag) {
+	switch (tag) {
+	case ItemTag::Null: return ni_BatchNull;
+	case ItemTag::String: return ni_BatchString;
+	case ItemTag::StringArray: return ni_BatchStringArray;
+	case ItemTag::ClientFunc: return ni_BatchClientFunc;
+	case ItemTag::ServerFunc: return ni_BatchServerFunc;
+	case ItemTag::Instance: return ni_BatchInstance;
+	case ItemTag::Buffer: return ni_BatchBuffer;
+	case ItemTag::Struct: return ni_BatchStruct;
+	case ItemTag::StructArray: return ni_BatchStructArray;
+	case ItemTag::BitArray: return ni_BatchBitArray;
+	default:
+		break;
+	}
+	auto t = (int)tag;
+	return (uint8_t)(t % 2 == 1 ? ni_BatchPtr + t / 2 : ni_BatchPtrArray + (t / 2 - 1));
+}
+
+static size_t encodedSlotSize(const StackSlot& slot) {
+	auto size = sizeof(ni_BatchArg);
+	switch (slot.tag) {
+	case ItemTag::Null: case ItemTag::ClientFunc: case ItemTag::ServerFunc: case ItemTag::Instance:
+		return size;
+	case ItemTag::Buffer:
+		return size + sizeof(ni_BufferDescriptor);
+	case ItemTag::Struct:
+		return size + BatchReader::padded(structLayouts[slot.id]->size);
+	case ItemTag::StringArray: {
+		return size + sizeof(uint64_t) * (1 + slot.strArray->count) + BatchReader::padded(slot.strArray->totalLength());
+	}
+	default:
+		if (hasArrayPayload(slot.tag)) {
+			return size + sizeof(uint64_t) + BatchReader::padded(slot.array->bytes());
+		}
+		return size + sizeof(ni_BatchScalar);
+	}
+}
+
+// copies n bytes and zeroes the padding after them, so nothing uninitialized goes out
+static inline uint8_t* putPadded(uint8_t* pos, const void* data, size_t n) {
+	if (n > 0) {
+		memcpy(pos, data, n);
+	}
+	auto padded = BatchReader::padded(n);
+	memset(pos + n, 0, padded - n);
+	return pos + padded;
+}
+
+size_t ni_encodedStackSize() {
+	auto size = sizeof(ni_BatchCommand);
+	for (auto& slot : thlocal.vstack) {
+		size += encodedSlotSize(slot);
+	}
+	return size;
+}
+
+void ni_takeStack(void* buffer) {
+	auto pos = (uint8_t*)buffer;
+	*(ni_BatchCommand*)pos = { nullptr, (uint32_t)thlocal.vstack.size(), 0 };
+	pos += sizeof(ni_BatchCommand);
+	for (auto& slot : thlocal.vstack) {
+		*(ni_BatchArg*)pos = { batchArgType(slot.tag), (uint8_t)slot.isClientId, 0, slot.id };
+		pos += sizeof(ni_BatchArg);
+		switch (slot.tag) {
+		case ItemTag::Null: case ItemTag::ClientFunc: case ItemTag::ServerFunc: case ItemTag::Instance:
+			break;
+		case ItemTag::Buffer:
+			pos = putPadded(pos, slot.descriptor, sizeof(ni_BufferDescriptor));
+			break;
+		case ItemTag::Struct: {
+			auto size = structLayouts[slot.id]->size;
+			pos = putPadded(pos, size > sizeof(StackSlot::bytes) ? slot.ptr : slot.bytes, size);
+			break;
+		}
+		case ItemTag::StringArray: {
+			auto payload = slot.strArray;
+			*(uint64_t*)pos = payload->count;
+			pos += sizeof(uint64_t);
+			for (size_t i = 0; i < payload->count; i++) {
+				((uint64_t*)pos)[i] = payload->length(i);
+			}
+			pos += sizeof(uint64_t) * payload->count;
+			if (payload->offsets) {
+				pos = putPadded(pos, payload->bytes, payload->totalLength());
+				break;
+			}
+			auto chars = pos;
+			for (size_t i = 0; i < payload->count; i++) {
+				if (payload->lengths[i] > 0) {
+					memcpy(chars, payload->strs[i], payload->lengths[i]);
+				}
+				chars += payload->lengths[i];
+			}
+			auto total = (size_t)(chars - pos);
+			memset(chars, 0, BatchReader::padded(total) - total);
+			pos += BatchReader::padded(total);
+			break;
+		}
+		default:
+			if (hasArrayPayload(slot.tag)) {
+				*(uint64_t*)pos = slot.array->count;
+				pos = putPadded(pos + sizeof(uint64_t), slot.array->data, slot.array->bytes());
+			}
+			else {
+				pos = putPadded(pos, slot.bytes, sizeof(ni_BatchScalar));
+			}
+			break;
+		}
+	}
+	thlocal.vstack.clear();
+	thlocal.borrowedCount = 0;
+}
+
+bool ni_putStack(const void* buffer, size_t length) {
+	auto start = (const uint8_t*)buffer;
+	if ((uintptr_t)start % alignof(ni_BatchCommand) != 0) {
+		return false;
+	}
+	BatchReader r{ start, start + length };
+	auto cmd = r.take<ni_BatchCommand>();
+	if (!cmd) {
+		return false;
+	}
+	for (uint32_t i = 0; i < cmd->argCount; i++) {
+		if (!batchSkipArg(r)) {
+			return false;
+		}
+	}
+	if (r.pos != r.end) {
+		return false;
+	}
+	r.pos = start + sizeof(ni_BatchCommand);
+	for (uint32_t i = 0; i < cmd->argCount; i++) {
+		batchPushArg(r);
+	}
+	// (the args are pushed borrowed, straight out of the buffer - which the caller is free to reuse as soon as this returns)
+	thlocal.materializeBorrowed();
+	return true;
+}
+
 void ni_pushPtr(void* value)
 {
-	thlocal.push(new PtrItem(value));
+	thlocal.push(ItemTag::Ptr).ptr = value;
 }
 
 void* ni_popPtr()
 {
-	return thlocal.pop()->ptrValue();
+	auto slot = thlocal.popNullable(ItemTag::Ptr);
+	return slot.tag == ItemTag::Null ? nullptr : slot.ptr;
 }
 
 void ni_pushPtrArray(void** values, size_t count)
 {
-	thlocal.push(new PtrArray(values, count));
+	thlocal.pushArray(ItemTag::PtrArray, values, count);
+}
+
+void ni_pushPtrArrayBorrowed(void* const* values, size_t count)
+{
+	thlocal.pushArrayBorrowed(ItemTag::PtrArray, values, count);
 }
 
 void ni_popPtrArray(void*** values, size_t* count)
 {
-	thlocal.lastPtrArray = thlocal.pop()->ptrArray();
-	*values = thlocal.lastPtrArray.data();
-	*count = thlocal.lastPtrArray.size();
+	thlocal.popArray(ItemTag::PtrArray, values, count);
+}
+
+void ni_popPtrArrayView(void* const** values, size_t* count)
+{
+	thlocal.popArray(ItemTag::PtrArray, values, count);
 }
 
 void ni_pushSizeT(size_t value) {
-	thlocal.push(new SizeTItem(value));
+	thlocal.push(ItemTag::SizeT).sizeT = value;
 }
 
 size_t ni_popSizeT() {
-	return thlocal.pop()->sizeTValue();
+	return thlocal.pop(ItemTag::SizeT).sizeT;
 }
 
 void ni_pushSizeTArray(size_t* values, size_t count) {
-	thlocal.push(new SizeTArray(values, count));
+	thlocal.pushArray(ItemTag::SizeTArray, values, count);
+}
+
+void ni_pushSizeTArrayBorrowed(const size_t* values, size_t count) {
+	thlocal.pushArrayBorrowed(ItemTag::SizeTArray, values, count);
 }
 
 void ni_popSizeTArray(size_t** values, size_t* count) {
-	thlocal.lastSizeTArray = thlocal.pop()->sizeTArray();
-	*values = thlocal.lastSizeTArray.data();
-	*count = thlocal.lastSizeTArray.size();
+	thlocal.popArray(ItemTag::SizeTArray, values, count);
+}
+
+void ni_popSizeTArrayView(const size_t** values, size_t* count) {
+	thlocal.popArray(ItemTag::SizeTArray, values, count);
 }
 
 void ni_pushBool(bool value) {
-	thlocal.push(new BoolItem(value));
+	thlocal.push(ItemTag::Bool).b = value;
 }
 
 bool ni_popBool() {
-	return thlocal.pop()->boolValue();
+	return thlocal.pop(ItemTag::Bool).b;
 }
 
+// bool arrays cross as bit arrays (that's what the generated code pushes and pops), so these pack and unpack at the stack -
+// the borrowed push copies all the same, and the popped bools live in the arena like any other popped array
 void ni_pushBoolArray(bool* values, size_t count)
 {
-	thlocal.push(new BoolArrayItem(values, count));
+	ni_packBits(values, count, ni_pushBitArrayInPlace(count));
+}
+
+void ni_pushBoolArrayBorrowed(const bool* values, size_t count)
+{
+	ni_packBits(values, count, ni_pushBitArrayInPlace(count));
 }
 
 void ni_popBoolArray(bool** values, size_t* count)
 {
-	thlocal.lastBoolArray = thlocal.pop()->boolArray();
-	*((uint8_t**)values) = thlocal.lastBoolArray.data();
-	*count = thlocal.lastBoolArray.size();
+	auto payload = thlocal.pop(ItemTag::BitArray).array;
+	*values = thlocal.arena.allocArray<bool>(payload->count);
+	*count = payload->count;
+	ni_unpackBits((const uint64_t*)payload->data, payload->count, *values);
+	thlocal.keepPopped();
+}
+
+void ni_popBoolArrayView(const bool** values, size_t* count)
+{
+	ni_popBoolArray((bool**)values, count);
+}
+
+void ni_pushBitArray(const uint64_t* words, size_t count)
+{
+	thlocal.beginPush();
+	thlocal.pushSlot(ItemTag::BitArray).array = thlocal.copyArray(words, count, 0);
+}
+
+void ni_pushBitArrayBorrowed(const uint64_t* words, size_t count)
+{
+	thlocal.pushArrayBorrowed(ItemTag::BitArray, words, count, 0);
+}
+
+uint64_t* ni_pushBitArrayInPlace(size_t count)
+{
+	thlocal.beginPush();
+	auto payload = thlocal.arena.allocArray<ArrayPayload>(1);
+	*payload = { nullptr, count, 0 };
+	if (count > 0) {
+		payload->data = thlocal.arena.alloc(payload->bytes());
+		((uint64_t*)payload->data)[bitWords(count) - 1] = 0; // (so that a partly filled last word has the rest clear)
+	}
+	thlocal.pushSlot(ItemTag::BitArray).array = payload;
+	return (uint64_t*)payload->data;
+}
+
+void ni_popBitArray(uint64_t** words, size_t* count)
+{
+	thlocal.popArray(ItemTag::BitArray, words, count);
+}
+
+void ni_popBitArrayView(const uint64_t** words, size_t* count)
+{
+	thlocal.popArray(ItemTag::BitArray, words, count);
+}
+
+// 8 at a time: a multiply gathers the low bit of each of 8 bool bytes into the top byte, and another spreads a byte's bits back out
+// (bools being 0 or 1, little-endian)
+void ni_packBits(const bool* values, size_t count, uint64_t* words)
+{
+	size_t i = 0;
+	for (size_t w = 0; w < count / 64; w++) {
+		uint64_t word = 0;
+		for (int b = 0; b < 64; b += 8, i += 8) {
+			uint64_t eight;
+			memcpy(&eight, values + i, 8);
+			word |= ((eight * 0x0102040810204080ull) >> 56) << b;
+		}
+		words[w] = word;
+	}
+	if (i < count) {
+		uint64_t word = 0;
+		for (int b = 0; i < count; b++, i++) {
+			word |= (uint64_t)values[i] << b;
+		}
+		words[count / 64] = word;
+	}
+}
+
+void ni_unpackBits(const uint64_t* words, size_t count, bool* values)
+{
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		auto byte = (words[i / 64] >> (i % 64)) & 0xff;
+		auto eight = ((((byte * 0x0101010101010101ull) & 0x8040201008040201ull) + 0x7f7f7f7f7f7f7f7full) >> 7) & 0x0101010101010101ull;
+		memcpy(values + i, &eight, 8);
+	}
+	for (; i < count; i++) {
+		values[i] = (words[i / 64] >> (i % 64)) & 1;
+	}
 }
 
 // INT8 stuff ===============================
 
 void ni_pushInt8(int8_t x)
 {
-	thlocal.push(new Int8Item(x));
+	thlocal.push(ItemTag::Int8).i8 = x;
 }
 
 int8_t ni_popInt8()
 {
-	return thlocal.pop()->int8Value();
+	return thlocal.pop(ItemTag::Int8).i8;
 }
 
 void ni_pushInt8Array(int8_t* values, size_t count)
 {
-	thlocal.push(new Int8ArrayItem(values, count));
+	thlocal.pushArray(ItemTag::Int8Array, values, count);
+}
+
+void ni_pushInt8ArrayBorrowed(const int8_t* values, size_t count)
+{
+	thlocal.pushArrayBorrowed(ItemTag::Int8Array, values, count);
 }
 
 void ni_popInt8Array(int8_t** values, size_t* count)
 {
-	thlocal.lastInt8Array = thlocal.pop()->int8Array();
-	*values = thlocal.lastInt8Array.data();
-	*count = thlocal.lastInt8Array.size();
+	thlocal.popArray(ItemTag::Int8Array, values, count);
+}
+
+void ni_popInt8ArrayView(const int8_t** values, size_t* count)
+{
+	thlocal.popArray(ItemTag::Int8Array, values, count);
 }
 
 void ni_pushUInt8(uint8_t x)
 {
-	thlocal.push(new UInt8Item(x));
+	thlocal.push(ItemTag::UInt8).u8 = x;
 }
 
 uint8_t ni_popUInt8()
 {
-	return thlocal.pop()->uint8Value();
+	return thlocal.pop(ItemTag::UInt8).u8;
 }
 
 void ni_pushUInt8Array(uint8_t* values, size_t count)
 {
-	thlocal.push(new UInt8ArrayItem(values, count));
+	thlocal.pushArray(ItemTag::UInt8Array, values, count);
+}
+
+void ni_pushUInt8ArrayBorrowed(const uint8_t* values, size_t count)
+{
+	thlocal.pushArrayBorrowed(ItemTag::UInt8Array, values, count);
 }
 
 void ni_popUInt8Array(uint8_t** values, size_t* count)
 {
-	thlocal.lastUInt8Array = thlocal.pop()->uint8Array();
-	*values = thlocal.lastUInt8Array.data();
-	*count = thlocal.lastUInt8Array.size();
+	thlocal.popArray(ItemTag::UInt8Array, values, count);
+}
+
+void ni_popUInt8ArrayView(const uint8_t** values, size_t* count)
+{
+	thlocal.popArray(ItemTag::UInt8Array, values, count);
 }
 
 // INT16 stuff ===============================
 
 void ni_pushInt16(int16_t x)
 {
-	thlocal.push(new Int16Item(x));
+	thlocal.push(ItemTag::Int16).i16 = x;
 }
 
 int16_t ni_popInt16()
 {
-	return thlocal.pop()->int16Value();
+	return thlocal.pop(ItemTag::Int16).i16;
 }
 
 void ni_pushInt16Array(int16_t* values, size_t count)
 {
-	thlocal.push(new Int16ArrayItem(values, count));
+	thlocal.pushArray(ItemTag::Int16Array, values, count);
+}
+
+void ni_pushInt16ArrayBorrowed(const int16_t* values, size_t count)
+{
+	thlocal.pushArrayBorrowed(ItemTag::Int16Array, values, count);
 }
 
 void ni_popInt16Array(int16_t** values, size_t* count)
 {
-	thlocal.lastInt16Array = thlocal.pop()->int16Array();
-	*values = thlocal.lastInt16Array.data();
-	*count = thlocal.lastInt16Array.size();
+	thlocal.popArray(ItemTag::Int16Array, values, count);
+}
+
+void ni_popInt16ArrayView(const int16_t** values, size_t* count)
+{
+	thlocal.popArray(ItemTag::Int16Array, values, count);
 }
 
 void ni_pushUInt16(uint16_t x)
 {
-	thlocal.push(new UInt16Item(x));
+	thlocal.push(ItemTag::UInt16).u16 = x;
 }
 
 uint16_t ni_popUInt16()
 {
-	return thlocal.pop()->uint16Value();
+	return thlocal.pop(ItemTag::UInt16).u16;
 }
 
 void ni_pushUInt16Array(uint16_t* values, size_t count)
 {
-	thlocal.push(new UInt16ArrayItem(values, count));
+	thlocal.pushArray(ItemTag::UInt16Array, values, count);
+}
+
+void ni_pushUInt16ArrayBorrowed(const uint16_t* values, size_t count)
+{
+	thlocal.pushArrayBorrowed(ItemTag::UInt16Array, values, count);
 }
 
 void ni_popUInt16Array(uint16_t** values, size_t* count)
 {
-	thlocal.lastUInt16Array = thlocal.pop()->uint16Array();
-	*values = thlocal.lastUInt16Array.data();
-	*count = thlocal.lastUInt16Array.size();
+	thlocal.popArray(ItemTag::UInt16Array, values, count);
+}
+
+void ni_popUInt16ArrayView(const uint16_t** values, size_t* count)
+{
+	thlocal.popArray(ItemTag::UInt16Array, values, count);
 }
 
 // INT32 stuff ===============================
 
 void ni_pushInt32(int32_t x)
 {
-	thlocal.push(new Int32Item(x));
+	thlocal.push(ItemTag::Int32).i32 = x;
 }
 
 int32_t ni_popInt32()
 {
-	return thlocal.pop()->int32Value();
+	return thlocal.pop(ItemTag::Int32).i32;
 }
 
 void ni_pushInt32Array(int32_t* values, size_t count)
 {
-	thlocal.push(new Int32ArrayItem(values, count));
+	thlocal.pushArray(ItemTag::Int32Array, values, count);
+}
+
+void ni_pushInt32ArrayBorrowed(const int32_t* values, size_t count)
+{
+	thlocal.pushArrayBorrowed(ItemTag::Int32Array, values, count);
 }
 
 void ni_popInt32Array(int32_t** values, size_t* count)
 {
-	thlocal.lastInt32Array = thlocal.pop()->int32Array();
-	*values = thlocal.lastInt32Array.data();
-	*count = thlocal.lastInt32Array.size();
+	thlocal.popArray(ItemTag::Int32Array, values, count);
+}
+
+void ni_popInt32ArrayView(const int32_t** values, size_t* count)
+{
+	thlocal.popArray(ItemTag::Int32Array, values, count);
 }
 
 void ni_pushUInt32(uint32_t x)
 {
-	thlocal.push(new UInt32Item(x));
+	thlocal.push(ItemTag::UInt32).u32 = x;
 }
 
 uint32_t ni_popUInt32()
 {
-	return thlocal.pop()->uint32Value();
+	return thlocal.pop(ItemTag::UInt32).u32;
 }
 
 void ni_pushUInt32Array(uint32_t* values, size_t count)
 {
-	thlocal.push(new UInt32ArrayItem(values, count));
+	thlocal.pushArray(ItemTag::UInt32Array, values, count);
+}
+
+void ni_pushUInt32ArrayBorrowed(const uint32_t* values, size_t count)
+{
+	thlocal.pushArrayBorrowed(ItemTag::UInt32Array, values, count);
 }
 
 void ni_popUInt32Array(uint32_t** values, size_t* count)
 {
-	thlocal.lastUInt32Array = thlocal .pop()->uint32Array();
-	*values = thlocal.lastUInt32Array.data();
-	*count = thlocal.lastUInt32Array.size();
+	thlocal.popArray(ItemTag::UInt32Array, values, count);
+}
+
+void ni_popUInt32ArrayView(const uint32_t** values, size_t* count)
+{
+	thlocal.popArray(ItemTag::UInt32Array, values, count);
 }
 
 // INT64 stuff ===============================
 
 void ni_pushInt64(int64_t x)
 {
-	thlocal.push(new Int64Item(x));
+	thlocal.push(ItemTag::Int64).i64 = x;
 }
 
 int64_t ni_popInt64()
 {
-	return thlocal.pop()->int64Value();
+	return thlocal.pop(ItemTag::Int64).i64;
 }
 
 void ni_pushInt64Array(int64_t* values, size_t count)
 {
-	thlocal.push(new Int64ArrayItem(values, count));
+	thlocal.pushArray(ItemTag::Int64Array, values, count);
+}
+
+void ni_pushInt64ArrayBorrowed(const int64_t* values, size_t count)
+{
+	thlocal.pushArrayBorrowed(ItemTag::Int64Array, values, count);
 }
 
 void ni_popInt64Array(int64_t** values, size_t* count)
 {
-	thlocal.lastInt64Array = thlocal.pop()->int64Array();
-	*values = thlocal.lastInt64Array.data();
-	*count = thlocal.lastInt64Array.size();
+	thlocal.popArray(ItemTag::Int64Array, values, count);
+}
+
+void ni_popInt64ArrayView(const int64_t** values, size_t* count)
+{
+	thlocal.popArray(ItemTag::Int64Array, values, count);
 }
 
 void ni_pushUInt64(uint64_t x)
 {
-	thlocal.push(new UInt64Item(x));
+	thlocal.push(ItemTag::UInt64).u64 = x;
 }
 
 uint64_t ni_popUInt64()
 {
-	return thlocal.pop()->uint64Value();
+	return thlocal.pop(ItemTag::UInt64).u64;
 }
 
 void ni_pushUInt64Array(uint64_t* values, size_t count)
 {
-	thlocal.push(new UInt64ArrayItem(values, count));
+	thlocal.pushArray(ItemTag::UInt64Array, values, count);
+}
+
+void ni_pushUInt64ArrayBorrowed(const uint64_t* values, size_t count)
+{
+	thlocal.pushArrayBorrowed(ItemTag::UInt64Array, values, count);
 }
 
 void ni_popUInt64Array(uint64_t** values, size_t* count)
 {
-	thlocal.lastUInt64Array = thlocal.pop()->uint64Array();
-	*values = thlocal.lastUInt64Array.data();
-	*count = thlocal.lastUInt64Array.size();
+	thlocal.popArray(ItemTag::UInt64Array, values, count);
+}
+
+void ni_popUInt64ArrayView(const uint64_t** values, size_t* count)
+{
+	thlocal.popArray(ItemTag::UInt64Array, values, count);
 }
 
 // ==== end ints, sigh =======================================
 
 void ni_pushFloat(float x)
 {
-	thlocal.push(new FloatItem(x));
+	thlocal.push(ItemTag::Float).f = x;
 }
 
 float ni_popFloat()
 {
-	return thlocal.pop()->floatValue();
+	return thlocal.pop(ItemTag::Float).f;
 }
 
 void ni_pushFloatArray(float* values, size_t count)
 {
-	thlocal.push(new FloatArrayItem(values, count));
+	thlocal.pushArray(ItemTag::FloatArray, values, count);
+}
+
+void ni_pushFloatArrayBorrowed(const float* values, size_t count)
+{
+	thlocal.pushArrayBorrowed(ItemTag::FloatArray, values, count);
 }
 
 void ni_popFloatArray(float** values, size_t* count)
 {
-	thlocal.lastFloatArray = thlocal.pop()->floatArray();
-	*values = thlocal.lastFloatArray.data();
-	*count = thlocal.lastFloatArray.size();
+	thlocal.popArray(ItemTag::FloatArray, values, count);
+}
+
+void ni_popFloatArrayView(const float** values, size_t* count)
+{
+	thlocal.popArray(ItemTag::FloatArray, values, count);
 }
 
 void ni_pushDouble(double x)
 {
-	thlocal.push(new DoubleItem(x));
+	thlocal.push(ItemTag::Double).d = x;
 }
 
 double ni_popDouble()
 {
-	return thlocal.pop()->doubleValue();
+	return thlocal.pop(ItemTag::Double).d;
 }
 
 void ni_pushDoubleArray(double* values, size_t count)
 {
-	thlocal.push(new DoubleArrayItem(values, count));
+	thlocal.pushArray(ItemTag::DoubleArray, values, count);
+}
+
+void ni_pushDoubleArrayBorrowed(const double* values, size_t count)
+{
+	thlocal.pushArrayBorrowed(ItemTag::DoubleArray, values, count);
 }
 
 void ni_popDoubleArray(double** values, size_t* count)
 {
-	thlocal.lastDoubleArray = thlocal.pop()->doubleArray();
-	*values = thlocal.lastDoubleArray.data();
-	*count = thlocal.lastDoubleArray.size();
+	thlocal.popArray(ItemTag::DoubleArray, values, count);
+}
+
+void ni_popDoubleArrayView(const double** values, size_t* count)
+{
+	thlocal.popArray(ItemTag::DoubleArray, values, count);
 }
 
 void ni_pushString(const char* str, size_t length)
 {
-	thlocal.push(new StringItem(str, length));
+	thlocal.beginPush();
+	thlocal.pushSlot(ItemTag::String).array = thlocal.copyString(str, length);
+}
+
+void ni_pushStringBorrowed(const char* str, size_t length)
+{
+	thlocal.pushArrayBorrowed(ItemTag::String, str, length);
 }
 
 void ni_popString(const char** strPtr, size_t* length)
 {
-	thlocal.lastPoppedString = thlocal.pop()->stringValue();
-	*strPtr = thlocal.lastPoppedString.c_str();
-	*length = thlocal.lastPoppedString.size();
+	auto payload = thlocal.pop(ItemTag::String).array;
+	*strPtr = (const char*)payload->data;
+	*length = payload->count;
+}
+
+void ni_popStringView(const char** strPtr, size_t* length)
+{
+	auto payload = thlocal.pop(ItemTag::String).array;
+	*strPtr = (const char*)payload->data;
+	*length = payload->count;
+}
+
+// interned strings: kept for the life of the process, so that a stack slot can point straight at one (and they pop as-is)
+// the entries live in fixed-size pages that never move, so pushing by id takes no lock - only interning does
+static constexpr uint32_t InternPageBits = 10;
+static constexpr uint32_t InternPageSize = 1u << InternPageBits;
+static constexpr uint32_t InternMaxPages = ni_MaxInternedStrings / InternPageSize;
+static std::atomic<ArrayPayload*> internPages[InternMaxPages];
+static std::atomic<uint32_t> internCount = 0;
+static std::mutex internLock;
+static std::unordered_map<std::string_view, int> internIds; // keyed by the entries' own bytes
+
+static inline const ArrayPayload* internedString(int id)
+{
+	auto index = (uint32_t)id - 1; // (so 0 and negatives are out of range too)
+	if (index >= internCount.load(std::memory_order_acquire)) {
+		return nullptr;
+	}
+	return &internPages[index >> InternPageBits].load(std::memory_order_relaxed)[index & (InternPageSize - 1)];
+}
+
+int ni_internString(const char* str, size_t length)
+{
+	std::lock_guard<std::mutex> lock(internLock);
+	if (auto found = internIds.find(std::string_view(str, length)); found != internIds.end()) {
+		return found->second;
+	}
+	auto index = internCount.load(std::memory_order_relaxed);
+	auto page = index >> InternPageBits;
+	if (page >= InternMaxPages) {
+		printf("ni_internString: the table is full (%u strings)\n", index);
+		return 0;
+	}
+	if (!internPages[page].load(std::memory_order_relaxed)) {
+		internPages[page].store(new ArrayPayload[InternPageSize], std::memory_order_relaxed);
+	}
+	// null-terminated like any pushed string
+	auto chars = new char[length + 1];
+	if (length > 0) {
+		memcpy(chars, str, length);
+	}
+	chars[length] = 0;
+	internPages[page].load(std::memory_order_relaxed)[index & (InternPageSize - 1)] = ArrayPayload{ chars, length, 1 };
+	// publishes the entry (and its page) to ni_pushInternedString on other threads
+	internCount.store(index + 1, std::memory_order_release);
+	auto id = (int)index + 1;
+	internIds.emplace(std::string_view(chars, length), id);
+	return id;
+}
+
+bool ni_getInternedString(int id, const char** str, size_t* length)
+{
+	auto payload = internedString(id);
+	if (!payload) {
+		return false;
+	}
+	*str = (const char*)payload->data;
+	*length = payload->count;
+	return true;
+}
+
+bool ni_pushInternedString(int id)
+{
+	// (the id comes from the client, so it's checked in any build)
+	auto payload = internedString(id);
+	if (!payload) {
+		return false;
+	}
+	// not borrowed: nothing needs copying at the end of the invocation, the entry outlives it
+	auto& slot = thlocal.push(ItemTag::String);
+	slot.id = id;
+	slot.array = const_cast<ArrayPayload*>(payload);
+	return true;
+}
+
+int ni_popStringViewInterned(const char** strPtr, size_t* length)
+{
+	auto slot = thlocal.pop(ItemTag::String);
+	*strPtr = (const char*)slot.array->data;
+	*length = slot.array->count;
+	return slot.id;
 }
 
 void ni_pushStringArray(const char** strs, size_t* lengths, size_t count)
 {
-	thlocal.push(new StringArrayItem(strs, lengths, count));
+	thlocal.beginPush();
+	thlocal.pushSlot(ItemTag::StringArray).strArray = thlocal.copyStringArray(strs, lengths, count);
+}
+
+static void pushStringArrayBorrowed(StringArrayPayload* payload)
+{
+	auto& slot = thlocal.pushSlot(ItemTag::StringArray);
+	slot.strArray = payload;
+	slot.borrowed = true;
+	thlocal.borrowedCount++;
+}
+
+void ni_pushStringArrayBorrowed(const char* const* strs, const size_t* lengths, size_t count)
+{
+	thlocal.beginPush();
+	auto payload = thlocal.arena.allocArray<StringArrayPayload>(1);
+	*payload = { nullptr, nullptr, count, (const char**)strs, (size_t*)lengths };
+	pushStringArrayBorrowed(payload);
+}
+
+void ni_pushStringArrayBlob(const char* bytes, const uint64_t* offsets, size_t count)
+{
+	thlocal.beginPush();
+	thlocal.pushSlot(ItemTag::StringArray).strArray = thlocal.copyStringArrayBlob(bytes, offsets, count);
+}
+
+void ni_pushStringArrayBlobBorrowed(const char* bytes, const uint64_t* offsets, size_t count)
+{
+	static const uint64_t noOffsets[1] = { 0 };
+	thlocal.beginPush();
+	auto payload = thlocal.arena.allocArray<StringArrayPayload>(1);
+	*payload = { bytes, count > 0 ? offsets : noOffsets, count, nullptr, nullptr };
+	pushStringArrayBorrowed(payload);
+}
+
+char* ni_pushStringArrayBlobInPlace(size_t count, size_t totalLength, uint64_t** offsets)
+{
+	thlocal.beginPush();
+	auto payload = thlocal.allocStringArray(count, totalLength);
+	thlocal.pushSlot(ItemTag::StringArray).strArray = payload;
+	*offsets = (uint64_t*)payload->offsets;
+	return (char*)payload->bytes;
 }
 
 void ni_popStringArray(const char*** strs, size_t** lengths, size_t* count)
 {
-	thlocal.lastPoppedStringArray = thlocal.pop()->stringArray();
-	//
-	delete[] thlocal.lastPoppedStrs;
-	delete[] thlocal.lastPoppedStrLengths;
-	auto _count = thlocal.lastPoppedStringArray.size();
-	thlocal.lastPoppedStrs = new const char*[_count];
-	thlocal.lastPoppedStrLengths = new size_t[_count];
-	for (auto i = 0; i < _count; i++) {
-		thlocal.lastPoppedStrs[i] = thlocal.lastPoppedStringArray[i].data();
-		thlocal.lastPoppedStrLengths[i] = thlocal.lastPoppedStringArray[i].size();
+	auto payload = thlocal.pop(ItemTag::StringArray).strArray;
+	thlocal.stringTable(payload);
+	*strs = payload->strs;
+	*lengths = payload->lengths;
+	*count = payload->count;
+}
+
+void ni_popStringArrayView(const char* const** strs, const size_t** lengths, size_t* count)
+{
+	auto payload = thlocal.pop(ItemTag::StringArray).strArray;
+	thlocal.stringTable(payload);
+	*strs = payload->strs;
+	*lengths = payload->lengths;
+	*count = payload->count;
+}
+
+void ni_popStringArrayBlob(const char** bytes, const uint64_t** offsets, size_t* count)
+{
+	auto payload = thlocal.pop(ItemTag::StringArray).strArray;
+	thlocal.stringBlob(payload);
+	*bytes = payload->bytes;
+	*offsets = payload->offsets;
+	*count = payload->count;
+}
+
+// structs ================================
+
+int ni_getStructType(ni_ModuleRef m, const char* name)
+{
+	auto layout = m->structs.find(name);
+	return layout ? layout->typeId : -1;
+}
+
+bool ni_getStructLayout(int typeId, size_t* size, const ni_StructField** fields, size_t* fieldCount)
+{
+	if (typeId < 0 || (size_t)typeId >= structLayouts.size()) {
+		return false;
+	}
+	auto layout = structLayouts[typeId];
+	*size = layout->size;
+	*fields = layout->fields;
+	*fieldCount = layout->fieldCount;
+	return true;
+}
+
+static inline size_t checkedStructSize(int typeId, [[maybe_unused]] size_t size)
+{
+	assert(typeId >= 0 && (size_t)typeId < structLayouts.size());
+#if NI_STACK_TYPECHECK
+	if (typeId < 0 || (size_t)typeId >= structLayouts.size() || (size != (size_t)-1 && size != structLayouts[typeId]->size)) {
+		throw WrongTypeException();
+	}
+#endif
+	return structLayouts[typeId]->size;
+}
+
+static inline StackSlot popStructSlot(ItemTag tag, [[maybe_unused]] int typeId)
+{
+	auto slot = thlocal.pop(tag);
+#if NI_STACK_TYPECHECK
+	if (slot.id != typeId) {
+		throw WrongTypeException();
+	}
+#endif
+	return slot;
+}
+
+void ni_pushStruct(int typeId, const void* value, size_t size)
+{
+	size = checkedStructSize(typeId, size);
+	thlocal.beginPush();
+	void* storage = nullptr;
+	if (size > sizeof(StackSlot::bytes)) {
+		storage = thlocal.arena.alloc(size);
+		memcpy(storage, value, size);
+	}
+	auto& slot = thlocal.pushSlot(ItemTag::Struct);
+	slot.id = typeId;
+	if (storage) {
+		slot.ptr = storage;
+	}
+	else {
+		memcpy(slot.bytes, value, size);
+	}
+}
+
+void ni_popStruct(int typeId, void* value, size_t size)
+{
+	size = checkedStructSize(typeId, size);
+	auto slot = popStructSlot(ItemTag::Struct, typeId);
+	memcpy(value, size > sizeof(StackSlot::bytes) ? slot.ptr : slot.bytes, size);
+}
+
+void ni_pushStructArray(int typeId, const void* values, size_t count)
+{
+	auto size = checkedStructSize(typeId, (size_t)-1);
+	thlocal.beginPush();
+	auto payload = thlocal.copyArray(values, count, size);
+	auto& slot = thlocal.pushSlot(ItemTag::StructArray);
+	slot.id = typeId;
+	slot.array = payload;
+}
+
+void ni_pushStructArrayBorrowed(int typeId, const void* values, size_t count)
+{
+	auto size = checkedStructSize(typeId, (size_t)-1);
+	thlocal.pushArrayBorrowed(ItemTag::StructArray, values, count, size).id = typeId;
+}
+
+void ni_popStructArray(int typeId, void** values, size_t* count)
+{
+	auto payload = popStructSlot(ItemTag::StructArray, typeId).array;
+	*values = payload->data;
+	*count = payload->count;
+}
+
+void ni_popStructArrayView(int typeId, const void** values, size_t* count)
+{
+	auto payload = popStructSlot(ItemTag::StructArray, typeId).array;
+	*values = payload->data;
+	*count = payload->count;
+}
+
+// the flat (rank 0) form as the rank 1 it's equivalent to
+static ni_BufferDescriptor normalizedBuffer(const ni_BufferDescriptor& descriptor)
+{
+	if (descriptor.rank > 0) {
+		return descriptor;
+	}
+	auto ret = descriptor;
+	ret.rank = 1;
+	ret.reserved = 0;
+	ret.shape[0] = descriptor.totalCount;
+	ret.strides[0] = (uint64_t)descriptor.elementSize;
+	for (int i = 1; i < ni_BufferMaxRank; i++) {
+		ret.shape[i] = ret.strides[i] = 0;
+	}
+	return ret;
+}
+
+// totalCount/totalSize from the shape and strides
+static void measureBuffer(ni_BufferDescriptor* descriptor)
+{
+	uint64_t count = 1, last = 0;
+	for (int i = 0; i < descriptor->rank; i++) {
+		count *= descriptor->shape[i];
+		if (descriptor->shape[i] > 0) {
+			last += (descriptor->shape[i] - 1) * descriptor->strides[i];
+		}
+	}
+	descriptor->totalCount = (size_t)count;
+	descriptor->totalSize = count > 0 ? (size_t)(last + descriptor->elementSize) : 0;
+}
+
+bool ni_describeBuffer(ni_BufferDescriptor* descriptor, void* start, int elementSize, int rank, const uint64_t* shape)
+{
+	if (rank < 1 || rank > ni_BufferMaxRank) {
+		return false;
+	}
+	*descriptor = {};
+	descriptor->start = start;
+	descriptor->elementSize = elementSize;
+	descriptor->rank = rank;
+	uint64_t stride = (uint64_t)elementSize;
+	for (int i = rank - 1; i >= 0; i--) {
+		descriptor->shape[i] = shape[i];
+		descriptor->strides[i] = stride;
+		stride *= shape[i];
+	}
+	measureBuffer(descriptor);
+	return true;
+}
+
+bool ni_bufferRegion(const ni_BufferDescriptor* buffer, const uint64_t* begin, const uint64_t* extent, ni_BufferDescriptor* view)
+{
+	auto ret = normalizedBuffer(*buffer);
+	uint64_t offset = 0;
+	for (int i = 0; i < ret.rank; i++) {
+		if (begin[i] > ret.shape[i] || extent[i] > ret.shape[i] - begin[i]) {
+			return false;
+		}
+		offset += begin[i] * ret.strides[i];
+		ret.shape[i] = extent[i];
+	}
+	ret.start = (uint8_t*)ret.start + offset;
+	measureBuffer(&ret);
+	*view = ret;
+	return true;
+}
+
+bool ni_bufferSlice(const ni_BufferDescriptor* buffer, int dim, uint64_t index, ni_BufferDescriptor* view)
+{
+	auto ret = normalizedBuffer(*buffer);
+	if (ret.rank < 2 || dim < 0 || dim >= ret.rank || index >= ret.shape[dim]) {
+		return false;
+	}
+	ret.start = (uint8_t*)ret.start + index * ret.strides[dim];
+	for (int i = dim; i < ret.rank - 1; i++) {
+		ret.shape[i] = ret.shape[i + 1];
+		ret.strides[i] = ret.strides[i + 1];
+	}
+	ret.rank--;
+	ret.shape[ret.rank] = ret.strides[ret.rank] = 0;
+	measureBuffer(&ret);
+	*view = ret;
+	return true;
+}
+
+bool ni_bufferIsContiguous(const ni_BufferDescriptor* buffer)
+{
+	auto normalized = normalizedBuffer(*buffer);
+	uint64_t expected = (uint64_t)normalized.elementSize;
+	for (int i = normalized.rank - 1; i >= 0; i--) {
+		// (a dimension of 1 doesn't step anywhere, so its stride doesn't matter)
+		if (normalized.shape[i] != 1 && normalized.strides[i] != expected) {
+			return false;
+		}
+		expected *= normalized.shape[i];
 	}
-	*strs = thlocal.lastPoppedStrs;
-	*lengths = thlocal.lastPoppedStrLengths;
-	*count = _count;
+	return true;
 }
 
 void ni_pushBuffer(int id, bool isClientId, ni_BufferDescriptor* descriptor)
 {
-	thlocal.push(new BufferItem(id, isClientId, descriptor));
+	thlocal.beginPush();
+	auto copy = thlocal.arena.allocArray<ni_BufferDescriptor>(1);
+	*copy = normalizedBuffer(*descriptor);
+	auto& slot = thlocal.pushSlot(ItemTag::Buffer);
+	slot.id = id;
+	slot.isClientId = isClientId;
+	slot.descriptor = copy;
 }
 
 void ni_popBuffer(int* id, bool* isClientId, ni_BufferDescriptor* descriptor)
 {
-	thlocal.pop()->buffer(id, isClientId, descriptor);
+	auto slot = thlocal.popNullable(ItemTag::Buffer);
+	if (slot.tag == ItemTag::Null) {
+		*id = 0;
+		*isClientId = false;
+		*descriptor = {};
+	}
+	else {
+		*id = slot.id;
+		*isClientId = slot.isClientId;
+		*descriptor = *slot.descriptor;
+	}
 }
 
 void ni_pushClientFunc(int id)
 {
-	thlocal.push(new ClientFuncItem(id));
+	thlocal.push(ItemTag::ClientFunc).id = id;
 }
 
 void ni_pushServerFunc(int id)
 {
-	thlocal.push(new ServerFuncItem(id));
+	thlocal.push(ItemTag::ServerFunc).id = id;
 }
 
 int ni_popServerFunc() {
-	return thlocal.pop()->serverFuncId();
+	return thlocal.pop(ItemTag::ServerFunc).id;
 }
 
 void ni_invokeInterfaceMethod(ni_InterfaceMethodRef method, int serverID)
 {
-	method->ifunc(serverID);
+	ClientEntryFrame frame;
+	if (instrumentation.load(std::memory_order_relaxed)) {
+		ProfileScope scope(interfaceMethodStats(method));
+		method->ifunc(serverID);
+	}
+	else {
+		method->ifunc(serverID);
+	}
 	assert(thlocal.currentException == nullptr); // use below when exceptions are involved
 }
 
 ni_ExceptionRef ni_invokeInterfaceMethodWithExceptions(ni_InterfaceMethodRef method, int serverID) {
 	assert(thlocal.currentException == nullptr);
-	method->ifunc(serverID);
+	ClientEntryFrame frame;
+	if (instrumentation.load(std::memory_order_relaxed)) {
+		ProfileScope scope(interfaceMethodStats(method));
+		method->ifunc(serverID);
+	}
+	else {
+		method->ifunc(serverID);
+	}
 	auto ret = thlocal.currentException;
 	thlocal.currentException = nullptr;
 	return ret;
 }
 
+void ni_invokeServerFunc(int id)
+{
+	ClientEntryFrame frame;
+	if (instrumentation.load(std::memory_order_relaxed)) {
+		ProfileScope scope(serverFuncStats.get("funcval", "(server)", nullptr, "(function values)"));
+		ni_execServerFunc(id);
+		return;
+	}
+	ni_execServerFunc(id);
+}
+
+ni_ExceptionRef ni_invokeServerFuncWithExceptions(int id)
+{
+	ClientEntryFrame frame;
+	if (instrumentation.load(std::memory_order_relaxed)) {
+		ProfileScope scope(serverFuncStats.get("funcval", "(server)", nullptr, "(function values)"));
+		return ni_execServerFuncWithExceptions(id);
+	}
+	return ni_execServerFuncWithExceptions(id);
+}
+
 void ni_pushInstance(int id, bool isClientId)
 {
-	thlocal.push(new InstanceItem(id, isClientId));
+	auto& slot = thlocal.push(ItemTag::Instance);
+	slot.id = id;
+	slot.isClientId = isClientId;
 }
 
 int ni_popInstance(bool* isClientID) {
-	return thlocal.pop()->instanceId(isClientID);
+	auto slot = thlocal.popNullable(ItemTag::Instance);
+	if (slot.tag == ItemTag::Null) {
+		*isClientID = false;
+		return 0;
+	}
+	*isClientID = slot.isClientId;
+	return slot.id;
 }
 
 void ni_pushNull()
 {
-	thlocal.push(new NullItem());
+	thlocal.push(ItemTag::Null);
 }
 
 ni_ExceptionRef ni_getAndClearException() {
@@ -1084,13 +2387,55 @@ void ni_setException(ni_ExceptionRef e) {
 
 // visible to server only ====================
 int ni_popClientFunc() {
-	return thlocal.pop()->clientFuncId();
+	return thlocal.pop(ItemTag::ClientFunc).id;
+}
+
+void ni_serverSafetyAreaInUse() {
+	// (the depth the invocation now returning was entered at, its own frame being the innermost)
+	thlocal.serverSafetyAreaDepth = thlocal.frames.empty() ? 0 : (int)thlocal.frames.size() - 1;
 }
 
 void ni_clearClientSafetyArea() {
 	::ni_clientClearSafetyArea(); // ugh this confusing naming ...
 }
 
+void ni_releaseClientResource(int id) {
+	if (!clientResourceReleaseBatch) {
+		::ni_clientResourceRelease(id);
+		return;
+	}
+	thlocal.pendingReleases.push_back(id);
+	// outside of any invocation there's no frame end coming to flush it
+	if (thlocal.frames.empty() || thlocal.pendingReleases.size() >= ReleaseBatchThreshold) {
+		ni_flushClientResourceReleases();
+	}
+}
+
+void ni_flushClientResourceReleases() {
+	auto& pending = thlocal.pendingReleases;
+	if (pending.empty()) {
+		return;
+	}
+	if (!clientResourceReleaseBatch) {
+		// shut down (or never opted in) since these were queued
+		for (auto id : pending) {
+			::ni_clientResourceRelease(id);
+		}
+		pending.clear();
+		return;
+	}
+	// the client may well call back in while releasing (and so queue/flush more), so the batch is taken out of the queue first
+	auto& batch = thlocal.releasesInFlight;
+	if (!batch.empty()) {
+		return; // a flush further up this thread's call stack is in progress, and will pick these up when the client returns
+	}
+	while (!pending.empty()) {
+		batch.swap(pending);
+		clientResourceReleaseBatch(batch.data(), batch.size());
+		batch.clear();
+	}
+}
+
 void ni_processExceptions() {
 	if (thlocal.currentException != nullptr) {
 		auto e = thlocal.currentException;
@@ -1098,3 +2443,4 @@ void ni_processExceptions() {
 		e->buildAndThrow();
 	}
 }
+
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <stddef.h>
 
@@ -15,6 +16,7 @@ NIHANDLE(Exception);
 typedef void (*niClientFuncExec)(int id);
 typedef void (*niClientMethodExec)(ni_InterfaceMethodRef method, int objID);
 typedef void (*niClientResourceRelease)(int id);
+typedef void (*niClientResourceReleaseBatch)(const int* ids, size_t count);
 typedef void (*niClientClearSafetyArea)();
 
 // server registration methods (server-facing only, not visible through DLL)
@@ -24,12 +26,59 @@ extern "C" {
 	typedef void (*ConstantsFunc)();
 	typedef void (*ExceptionBuilder)(); // more of a 'pop and throw' than building, per se
 
+	// names aren't copied (string literals expected). ordinals are assigned in registration order, starting from 0
 	ni_ModuleRef ni_registerModule(const char *name);
 	ni_ModuleMethodRef ni_registerModuleMethod(ni_ModuleRef m, const char *name, ModuleFunc func);
+	struct ni_ModuleMethodEntry {
+		const char* name;
+		ModuleFunc func;
+	};
+	// registers a whole (typically constexpr) table at once, method ordinals follow the table order
+	void ni_registerModuleMethods(ni_ModuleRef m, const ni_ModuleMethodEntry* entries, size_t count);
 	void ni_registerModuleConstants(ni_ModuleRef m, ConstantsFunc func);
 	ni_InterfaceRef ni_registerInterface(ni_ModuleRef m, const char *name);
 	ni_InterfaceMethodRef ni_registerInterfaceMethod(ni_InterfaceRef iface, const char *name, InterfaceFunc ifunc);
 	ni_ExceptionRef ni_registerException(ni_ModuleRef m, const char *name, ExceptionBuilder builder);
+
+	// plain-old-data structs that cross as a single stack item (see ni_pushStruct)
+	// the layout is registered once, so both sides can check they agree on it (field types are the scalar ni_BatchArgType codes)
+	struct ni_StructField {
+		const char* name;
+		uint32_t offset;
+		uint8_t type;
+	};
+	// returns the struct's type id (dense, from 0). like names, the fields array isn't copied
+	int ni_registerStruct(ni_ModuleRef m, const char* name, size_t size, const ni_StructField* fields, size_t fieldCount);
+
+	// deferred registration: instead of registering every module up front, a library can hand over a table of them,
+	// and each is registered (the ones it depends on first) when ni_getModule first names it - so startup only pays for what's used
+	// register is what would otherwise have been called up front (making the ni_register... calls above for that one module),
+	// dependencies are the modules whose registrations it relies on (struct type ids, refs), null-terminated, or null for none
+	// while profiling or the timeline is on, each registration shows up there as <module>.__register (kind "register")
+	// the first lookup can come from any thread: registration is serialized, and a registered module is safe to look things up in concurrently
+	typedef int (*ModuleRegisterFunc)();
+	struct ni_ModuleDescriptor {
+		const char* name;
+		ModuleRegisterFunc registerFunc;
+		const char* const* dependencies;
+	};
+	// neither the table nor its strings are copied
+	void ni_registerModuleDescriptors(const ni_ModuleDescriptor* descriptors, size_t count);
+	// registers whatever hasn't been yet, in table order - everything that enumerates (module ordinals, ref counts/indices) does this first
+	void ni_registerAllModules();
+
+	// the registered names behind a handle, for tools working at the export boundary (capture/replay, see capture/Capture.h)
+	// owner is the interface for interface methods, "" otherwise. struct types are passed as (const void*)(intptr_t)typeId
+	enum ni_RefKind {
+		ni_RefModule, ni_RefModuleMethod, ni_RefInterface, ni_RefInterfaceMethod, ni_RefException, ni_RefStructType
+	};
+	bool ni_getRefNames(int kind, const void* ref, const char** module, const char** owner, const char** name);
+	// a dense numbering of each kind's handles (registration order, from 0), the same in any process that registered the same library -
+	// for carrying handles over to another one (see remote/Remote.h). struct types are already their own index
+	// (deferred modules are registered by the first ni_getRefCount, so two processes agree as long as neither looked anything up before it)
+	int ni_getRefCount(int kind);
+	int ni_getRefIndex(int kind, const void* ref);      // -1 for null
+	const void* ni_getRefByIndex(int kind, int index);  // null if out of range
 }
 
 // imported back from server (during linking process, against static server library)
@@ -40,6 +89,7 @@ extern "C" {
 	extern void ni_execServerFunc(int id);
 	extern ni_ExceptionRef ni_execServerFuncWithExceptions(int id);
 	extern void ni_releaseServerResource(int id);
+	extern void ni_releaseServerResources(const int* ids, size_t count);
 }
 
 // visible to both client and server
@@ -59,6 +109,9 @@ extern "C" {
 		niClientClearSafetyArea clientClearSafetyArea
 	);
 	void ni_nativeImplShutdown();
+	// optional: once set, client resource releases are queued per thread and handed over as id arrays -
+	// at the end of each invocation, or whenever the queue reaches a threshold (without it, each release is its own callback)
+	void ni_setClientResourceReleaseBatch(niClientResourceReleaseBatch clientResourceReleaseBatch);
 
 	ni_ModuleRef ni_getModule(const char* name);
 	ni_ModuleMethodRef ni_getModuleMethod(ni_ModuleRef m, const char* name);
@@ -67,88 +120,256 @@ extern "C" {
 	ni_ExceptionRef ni_getException(ni_ModuleRef m, const char* name);
 	void ni_pushModuleConstants(ni_ModuleRef m);
 
+	// by ordinal (see registration above) - O(1), and null when out of range. deferred modules are all registered first
+	int ni_getModuleCount();
+	ni_ModuleRef ni_getModuleByOrdinal(int ordinal);
+	int ni_getModuleMethodCount(ni_ModuleRef m);
+	ni_ModuleMethodRef ni_getModuleMethodByOrdinal(ni_ModuleRef m, int ordinal);
+
 	void ni_invokeModuleMethod(ni_ModuleMethodRef method);
 	ni_ExceptionRef ni_invokeModuleMethodWithExceptions(ni_ModuleMethodRef method);
 
+	// for the typed entry points that call straight into the implementation, no stack involved (see FastCallExport.h):
+	// the same frame around the call that an invocation gets. returns false (and there's nothing to end) while stats/timeline
+	// are on, the caller goes through the stack instead then, so that the call shows up in them
+	bool ni_beginDirectCall();
+	void ni_endDirectCall();
+
+	// client-side entry for executing server function values (wraps ni_execServerFunc in an invocation frame)
+	void ni_invokeServerFunc(int id);
+	ni_ExceptionRef ni_invokeServerFuncWithExceptions(int id);
+
+	// batched invocation: a single buffer holding a run of module method calls, each with its arguments in push order
+	// layout (native endianness, every record 8-byte aligned):
+	//   command := ni_BatchCommand, then argCount x (ni_BatchArg + payload)
+	//   payload by type: scalars = 8 bytes (ni_BatchScalar); Null/Instance/ClientFunc/ServerFunc = nothing (id is in the arg header);
+	//     arrays/String = uint64 count + elements (String = bytes, no terminator), padded to 8;
+	//     StringArray = uint64 count + uint64 lengths[count] + all the bytes back to back, padded to 8;
+	//     Buffer = ni_BufferDescriptor; Struct = the struct's bytes, padded to 8 (type id in the arg header's id);
+	//     StructArray = uint64 count + the elements back to back, padded to 8 (type id as for Struct);
+	//     BitArray = uint64 count (in bits) + the uint64 words they're packed into (see ni_pushBitArray)
+	// array/string payloads are pushed borrowed (straight out of the batch buffer) - except BoolArray, which is packed into a bit array
+	enum ni_BatchArgType : uint8_t {
+		ni_BatchNull, ni_BatchPtr, ni_BatchSizeT, ni_BatchBool,
+		ni_BatchInt8, ni_BatchUInt8, ni_BatchInt16, ni_BatchUInt16, ni_BatchInt32, ni_BatchUInt32,
+		ni_BatchInt64, ni_BatchUInt64, ni_BatchFloat, ni_BatchDouble,
+		ni_BatchPtrArray, ni_BatchSizeTArray, ni_BatchBoolArray,
+		ni_BatchInt8Array, ni_BatchUInt8Array, ni_BatchInt16Array, ni_BatchUInt16Array, ni_BatchInt32Array, ni_BatchUInt32Array,
+		ni_BatchInt64Array, ni_BatchUInt64Array, ni_BatchFloatArray, ni_BatchDoubleArray,
+		ni_BatchString, ni_BatchStringArray,
+		ni_BatchInstance, ni_BatchClientFunc, ni_BatchServerFunc, ni_BatchBuffer,
+		ni_BatchStruct, ni_BatchStructArray,
+		ni_BatchBitArray
+	};
+	struct ni_BatchCommand {
+		ni_ModuleMethodRef method;
+		uint32_t argCount;
+		uint32_t reserved;
+	};
+	struct ni_BatchArg {
+		uint8_t type;       // ni_BatchArgType
+		uint8_t isClientId; // Instance / Buffer
+		uint16_t reserved;
+		int32_t id;         // Instance / ClientFunc / ServerFunc / Buffer
+	};
+	union ni_BatchScalar {
+		void* ptr; size_t sizeT; bool b;
+		int8_t i8; uint8_t u8; int16_t i16; uint16_t u16; int32_t i32; uint32_t u32; int64_t i64; uint64_t u64;
+		float f; double d;
+	};
+	struct ni_BatchResult {
+		ni_ExceptionRef exception; // non-null if the command threw (and the batch stopped there)
+		uint32_t returnCount;      // stack items the command left behind
+		uint32_t reserved;
+	};
+	// runs the commands in order, stopping after the first one that throws
+	// return values stay on the stack (last command's on top), results[i].returnCount says how many belong to each command
+	// returns the number of commands run, or -1 (nothing run) if the buffer is malformed or 'results' is too small
+	int ni_invokeBatch(const void* buffer, size_t length, ni_BatchResult* results, size_t maxResults);
+
+	// this thread's whole stack in the batch layout above, as a single command (null method, argCount = the items, bottom of the stack first) -
+	// for carrying it to another process and back (see remote/Remote.h). buffer descriptors go as they are, start pointer and all
+	size_t ni_encodedStackSize();
+	// writes it to buffer (8-byte aligned, ni_encodedStackSize() bytes) and empties the stack
+	void ni_takeStack(void* buffer);
+	// pushes what's encoded in buffer (copied, the buffer can go once this returns), false (with nothing pushed) if malformed
+	bool ni_putStack(const void* buffer, size_t length);
+
+	// the ...View pops hand back read-only pointers into the stack's own storage, no copying -
+	// good until the current invocation returns (or until the next push, when popping return values)
+	// the ...Borrowed pushes don't copy either, the pusher's memory must stay put until the invocation it's meant for returns
+	// (anything still on the stack at that point gets copied then). popped borrowed strings aren't necessarily null-terminated
 	void ni_pushPtr(void* value);
 	void* ni_popPtr();
 	void ni_pushPtrArray(void** values, size_t count);
+	void ni_pushPtrArrayBorrowed(void* const* values, size_t count);
 	void ni_popPtrArray(void*** values, size_t* count);
+	void ni_popPtrArrayView(void* const** values, size_t* count);
 
 	void ni_pushSizeT(size_t value);
 	size_t ni_popSizeT();
 	void ni_pushSizeTArray(size_t* values, size_t count);
+	void ni_pushSizeTArrayBorrowed(const size_t* values, size_t count);
 	void ni_popSizeTArray(size_t** values, size_t* count);
+	void ni_popSizeTArrayView(const size_t** values, size_t* count);
 
 	void ni_pushBool(bool value);
 	bool ni_popBool();
+	// one bool per byte on the caller's side, but carried as a bit array (packed on push, unpacked into the arena on pop),
+	// so either end can use these or the bit array calls below
 	void ni_pushBoolArray(bool* values, size_t count);
+	void ni_pushBoolArrayBorrowed(const bool* values, size_t count);
 	void ni_popBoolArray(bool** values, size_t* count);
+	void ni_popBoolArrayView(const bool** values, size_t* count);
+	// bool arrays packed 64 to a uint64 word, bit i being bit (i % 64) of words[i / 64] - count is in bits, the unused bits
+	// of the last word are zero (the copying push clears them, the borrowed one expects them that way)
+	// the in-place push hands back the (count + 63) / 64 words for the caller to fill in, good until the next push or pop
+	void ni_pushBitArray(const uint64_t* words, size_t count);
+	void ni_pushBitArrayBorrowed(const uint64_t* words, size_t count);
+	uint64_t* ni_pushBitArrayInPlace(size_t count);
+	void ni_popBitArray(uint64_t** words, size_t* count);
+	void ni_popBitArrayView(const uint64_t** words, size_t* count);
+	// converting between the two, 8 bools at a time (words has room for (count + 63) / 64)
+	void ni_packBits(const bool* values, size_t count, uint64_t* words);
+	void ni_unpackBits(const uint64_t* words, size_t count, bool* values);
 
 	void ni_pushInt8(int8_t x);
 	int8_t ni_popInt8();
 	void ni_pushInt8Array(int8_t* values, size_t count);
+	void ni_pushInt8ArrayBorrowed(const int8_t* values, size_t count);
 	void ni_popInt8Array(int8_t** values, size_t* count);
+	void ni_popInt8ArrayView(const int8_t** values, size_t* count);
 
 	void ni_pushUInt8(uint8_t x);
 	uint8_t ni_popUInt8();
 	void ni_pushUInt8Array(uint8_t* values, size_t count);
+	void ni_pushUInt8ArrayBorrowed(const uint8_t* values, size_t count);
 	void ni_popUInt8Array(uint8_t** values, size_t* count);
+	void ni_popUInt8ArrayView(const uint8_t** values, size_t* count);
 
 	void ni_pushInt16(int16_t x);
 	int16_t ni_popInt16();
 	void ni_pushInt16Array(int16_t* values, size_t count);
+	void ni_pushInt16ArrayBorrowed(const int16_t* values, size_t count);
 	void ni_popInt16Array(int16_t** values, size_t* count);
+	void ni_popInt16ArrayView(const int16_t** values, size_t* count);
 
 	void ni_pushUInt16(uint16_t x);
 	uint16_t ni_popUInt16();
 	void ni_pushUInt16Array(uint16_t* values, size_t count);
+	void ni_pushUInt16ArrayBorrowed(const uint16_t* values, size_t count);
 	void ni_popUInt16Array(uint16_t** values, size_t* count);
+	void ni_popUInt16ArrayView(const uint16_t** values, size_t* count);
 
 	void ni_pushInt32(int32_t x);
 	int32_t ni_popInt32();
 	void ni_pushInt32Array(int32_t* values, size_t count);
+	void ni_pushInt32ArrayBorrowed(const int32_t* values, size_t count);
 	void ni_popInt32Array(int32_t** values, size_t* count);
+	void ni_popInt32ArrayView(const int32_t** values, size_t* count);
 
 	void ni_pushUInt32(uint32_t x);
 	uint32_t ni_popUInt32();
 	void ni_pushUInt32Array(uint32_t* values, size_t count);
+	void ni_pushUInt32ArrayBorrowed(const uint32_t* values, size_t count);
 	void ni_popUInt32Array(uint32_t** values, size_t* count);
+	void ni_popUInt32ArrayView(const uint32_t** values, size_t* count);
 
 	void ni_pushInt64(int64_t x);
 	int64_t ni_popInt64();
 	void ni_pushInt64Array(int64_t* values, size_t count);
+	void ni_pushInt64ArrayBorrowed(const int64_t* values, size_t count);
 	void ni_popInt64Array(int64_t** values, size_t* count);
+	void ni_popInt64ArrayView(const int64_t** values, size_t* count);
 
 	void ni_pushUInt64(uint64_t x);
 	uint64_t ni_popUInt64();
 	void ni_pushUInt64Array(uint64_t* values, size_t count);
+	void ni_pushUInt64ArrayBorrowed(const uint64_t* values, size_t count);
 	void ni_popUInt64Array(uint64_t** values, size_t* count);
+	void ni_popUInt64ArrayView(const uint64_t** values, size_t* count);
 
 	void ni_pushFloat(float x);
 	float ni_popFloat();
 	void ni_pushFloatArray(float* values, size_t count);
+	void ni_pushFloatArrayBorrowed(const float* values, size_t count);
 	void ni_popFloatArray(float** values, size_t* count);
+	void ni_popFloatArrayView(const float** values, size_t* count);
 
 	void ni_pushDouble(double x);
 	double ni_popDouble();
 	void ni_pushDoubleArray(double* values, size_t count);
+	void ni_pushDoubleArrayBorrowed(const double* values, size_t count);
 	void ni_popDoubleArray(double** values, size_t* count);
+	void ni_popDoubleArrayView(const double** values, size_t* count);
 
 	void ni_pushString(const char* str, size_t length);     // length is optional
-	void ni_popString(const char** strPtr, size_t* length); // result guaranteed until the next popString
+	void ni_pushStringBorrowed(const char* str, size_t length);
+	void ni_popString(const char** strPtr, size_t* length); // result (like all popped arrays) good until the invocation returns, or until the next push when popping return values
+	void ni_popStringView(const char** strPtr, size_t* length);
 	void ni_pushStringArray(const char** strs, size_t* lengths, size_t count);
+	void ni_pushStringArrayBorrowed(const char* const* strs, const size_t* lengths, size_t count);
 	void ni_popStringArray(const char*** strs, size_t** lengths, size_t* count);
-
+	void ni_popStringArrayView(const char* const** strs, const size_t** lengths, size_t* count);
+	// string arrays as they're kept: one blob of UTF-8 bytes (no terminators), string i being bytes[offsets[i] .. offsets[i + 1]),
+	// with offsets[0] = 0 (count + 1 offsets in all, null is fine for an empty array). the pointer-table forms above are built from / into this,
+	// and their strings aren't null-terminated either
+	void ni_pushStringArrayBlob(const char* bytes, const uint64_t* offsets, size_t count);
+	void ni_pushStringArrayBlobBorrowed(const char* bytes, const uint64_t* offsets, size_t count);
+	// pushes an uninitialized blob of totalLength bytes for the caller to fill in, offsets[1..count] included (offsets[0] is set)
+	char* ni_pushStringArrayBlobInPlace(size_t count, size_t totalLength, uint64_t** offsets);
+	void ni_popStringArrayBlob(const char** bytes, const uint64_t** offsets, size_t* count); // (a view, same lifetime as the others)
+
+	// interned strings, for the ones sent over and over (names, style classes, labels that flip between a few values):
+	// registered once (the same bytes always get the same id, from 1), then pushed by id, with no copying on either side.
+	// the item pops as a plain string, its bytes being the table's (null-terminated, good for the life of the process)
+	// ni_popStringViewInterned also says which id it was (0 for strings pushed any other way), so that the server can keep
+	// a converted copy of each (see StringArg in support/NativeImplServer.h). ids are per process, remote mode sends the bytes
+	// entries are never freed, and there's room for ni_MaxInternedStrings of them: past that ni_internString returns 0,
+	// and the client should just go on pushing that string the ordinary way - so intern a bounded set, not arbitrary text
+	enum { ni_MaxInternedStrings = 1 << 20 };
+	int ni_internString(const char* str, size_t length);
+	bool ni_getInternedString(int id, const char** str, size_t* length); // false for an unknown id
+	// false (and nothing pushed) for an id ni_internString didn't hand out - push the string some other way then
+	bool ni_pushInternedString(int id);
+	int ni_popStringViewInterned(const char** strPtr, size_t* length);
+
+	// POD structs by type id (from ni_getStructType). 'size' must match the registered layout, it's there as a sanity check
+	// a struct array crosses as one contiguous block of elements
+	int ni_getStructType(ni_ModuleRef m, const char* name); // -1 if there's no such struct
+	bool ni_getStructLayout(int typeId, size_t* size, const ni_StructField** fields, size_t* fieldCount);
+	void ni_pushStruct(int typeId, const void* value, size_t size);
+	void ni_popStruct(int typeId, void* value, size_t size);
+	void ni_pushStructArray(int typeId, const void* values, size_t count);
+	void ni_pushStructArrayBorrowed(int typeId, const void* values, size_t count);
+	void ni_popStructArray(int typeId, void** values, size_t* count);
+	void ni_popStructArrayView(int typeId, const void** values, size_t* count);
+
+	// a buffer, or a view into part of one: rank dimensions (outermost first) of shape[i] elements each,
+	// consecutive elements along dimension i being strides[i] bytes apart
+	// rank 0 is the original flat form (totalCount elements back to back), pushed descriptors are always normalized to rank 1+
+	enum { ni_BufferMaxRank = 4 };
 	struct ni_BufferDescriptor {
-		// TODO: provisions for multi-dimensional, indirect pointers, instead of contiguous, stride, etc?
-		void* start;
+		void* start;          // the view's first element
 		int elementSize;
-		size_t totalCount;
-		size_t totalSize;
+		size_t totalCount;    // elements in the view (the product of shape)
+		size_t totalSize;     // bytes from start through the end of the last element - all of it, for a contiguous one
+		int rank;
+		int reserved;
+		uint64_t shape[ni_BufferMaxRank];
+		uint64_t strides[ni_BufferMaxRank]; // in bytes
 	};
 	void ni_pushBuffer(int id, bool isClientId, ni_BufferDescriptor* descriptor);
 	void ni_popBuffer(int* id, bool* isClientId, ni_BufferDescriptor* descriptor);
+	// descriptor helpers, none of which touch the memory described - views share it with (and can't outlive) the buffer they're taken from
+	// contiguous row-major, false if rank is out of range
+	bool ni_describeBuffer(ni_BufferDescriptor* descriptor, void* start, int elementSize, int rank, const uint64_t* shape);
+	// the box [begin, begin + extent) along every dimension, keeping the rank (eg a range of an image's rows), false if out of bounds
+	bool ni_bufferRegion(const ni_BufferDescriptor* buffer, const uint64_t* begin, const uint64_t* extent, ni_BufferDescriptor* view);
+	// index along one dimension, dropping it (eg a column of a sample matrix: dim 1), false if out of bounds or rank 1
+	bool ni_bufferSlice(const ni_BufferDescriptor* buffer, int dim, uint64_t index, ni_BufferDescriptor* view);
+	// whether the elements are back to back in row-major order (ie can be treated as a flat array of totalCount)
+	bool ni_bufferIsContiguous(const ni_BufferDescriptor* buffer);
 
 	void ni_pushClientFunc(int id);
 	void ni_pushServerFunc(int id);
@@ -163,9 +384,8 @@ extern "C" {
 	void ni_invokeInterfaceMethod(ni_InterfaceMethodRef method, int serverID);
 	ni_ExceptionRef ni_invokeInterfaceMethodWithExceptions(ni_InterfaceMethodRef method, int serverID);
 
-	// TODO: get rid of the safety area flag, it was there so we could only conditionally clear the safety area,
-	// but I think all the ifs and checking (conditional setting of 'remotesafetyareadirty' or whatever) will end up
-	// being equivalent to simply clearing the remote safety area unconditionally at the end of every invocation returning (something containing) an interface reference
+	// TODO: get rid of the safety area flag, it was there so we could only conditionally clear the safety area
+	// (the server side no longer needs it: its protections lapse on their own when the client's next invocation begins, see ni_serverSafetyAreaInUse)
 	void ni_pushInstance(int id, bool isClientId);
 	int ni_popInstance(bool* isClientID);
 
@@ -178,7 +398,15 @@ extern "C" {
 	//   before the client has a chance to grab it off the stack and save it from a potentially fatal deref.
 	// the safety area protects until a return value (containing interface references) is fully grabbed
 	void ni_clearClientSafetyArea();
-	void ni_clearServerSafetyArea();
+	void ni_clearServerSafetyArea(); // still fine to call, but not needed anymore (see below)
+	// server: call when the safety area goes from empty to non-empty - it then gets cleared (via ni_clearServerSafetyArea)
+	// as soon as the client's next invocation at the same depth (or further out) begins on this thread, by which time the previous
+	// return values have been popped - not a deeper one, like a release handler calling back in before its caller has popped anything
+	void ni_serverSafetyAreaInUse();
+
+	// server proxies of client resources call this when they're destroyed (see ni_setClientResourceReleaseBatch)
+	void ni_releaseClientResource(int id);
+	void ni_flushClientResourceReleases();
 
 	void ni_dumpTables();
 
@@ -186,3 +414,61 @@ extern "C" {
 	ni_ExceptionRef ni_getAndClearException();
 	void ni_processExceptions(); // formerly buildAndThrow
 }
+
+// tracing (visible to both) ========================
+// trace points record a fixed-size event (id + two ints) into a per-thread ring buffer, a background thread drains those into a shared history,
+// and nothing gets formatted until someone asks for ni_dumpTrace()
+// NI_TRACE is gated twice: at compile time by NI_TRACE_MAX_LEVEL (trace points above it compile to nothing), and at run time by ni_traceLevel
+extern "C" {
+	enum ni_TraceLevel : uint8_t {
+		ni_TraceOff, ni_TraceError, ni_TraceWarn, ni_TraceInfo, ni_TraceDebug
+	};
+	// a and b per event as noted; the message for each lives in NativeImplTrace.cpp
+	enum ni_TraceEvent : uint16_t {
+		ni_TraceServerResourceReleased,     // a = id
+		ni_TraceServerResourceDeref,        // a = id, b = remaining refcount
+		ni_TraceServerResourceRefBumped,    // a = id, b = new refcount
+		ni_TraceServerResourceStaleRelease, // a = id
+		ni_TraceServerFuncValReleased,      // a = id
+		ni_TraceServerSafetyAreaCleared,    // a = number of resources let go
+		ni_TraceClientResourceSafePush,     // a = id
+		ni_TraceClientResourceReleased,     // a = id (server-side proxy destroyed)
+		ni_TraceEventCount
+	};
+	extern std::atomic<uint8_t> ni_traceLevel; // default: ni_TraceWarn
+	void ni_setTraceLevel(int level);
+	void ni_traceRecord(ni_TraceLevel level, ni_TraceEvent event, int32_t a, int32_t b);
+	// prints the retained history (most recent events, oldest first), and how many were dropped because a thread's ring was full
+	void ni_dumpTrace();
+}
+
+// profiling (visible to both) =====================
+// opt-in per-method stats for every crossing: module and interface method invocations, client callbacks and function values
+// (call counts, latency histograms, and the items/bytes that went across each way). when off, each crossing pays one branch
+extern "C" {
+	enum ni_StatsFormat {
+		ni_StatsText, ni_StatsJson
+	};
+	void ni_setProfiling(bool enabled);
+	// the report for everything called since the last reset (biggest total time first), NUL-terminated and truncated to fit the buffer
+	// returns the full length (without the NUL), so a call with a null buffer gives the size needed
+	size_t ni_getStats(int format, char* buffer, size_t bufferSize);
+	void ni_resetStats();
+
+	// timeline: the same crossings as begin/end events (with the nesting of callbacks within invocations), per thread,
+	// the most recent 32K events of each thread kept. turning it on starts a new recording
+	void ni_setTimeline(bool enabled);
+	// writes what's been recorded so far as a Chrome trace-event JSON file (chrome://tracing, ui.perfetto.dev); false if the file couldn't be written
+	bool ni_writeTimeline(const char* path);
+}
+
+#ifndef NI_TRACE_MAX_LEVEL
+#define NI_TRACE_MAX_LEVEL ni_TraceDebug
+#endif
+
+#define NI_TRACE(level, event, a, b) \
+	do { \
+		if ((level) <= NI_TRACE_MAX_LEVEL && (level) <= ni_traceLevel.load(std::memory_order_relaxed)) { \
+			ni_traceRecord(level, event, a, b); \
+		} \
+	} while (0)
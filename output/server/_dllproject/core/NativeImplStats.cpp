@@ -0,0 +1,200 @@
+#include "NativeImplCore.h"
+#include "NativeImplStats.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <vector>
+
+std::atomic<uint8_t> instrumentation = 0;
+
+// every stats record ever created (they live as long as the library does, resetting just zeroes them)
+static std::mutex statsLock;
+static std::vector<MethodStats*> allStats;
+
+MethodStats* StatsSlot::create(const char* kind, const char* moduleName, const char* ownerName, const char* methodName)
+{
+	std::lock_guard<std::mutex> guard(statsLock);
+	auto ret = stats.load(std::memory_order_acquire);
+	if (!ret) {
+		ret = new MethodStats();
+		ret->kind = kind;
+		ret->moduleName = moduleName;
+		ret->ownerName = ownerName;
+		ret->methodName = methodName;
+		allStats.push_back(ret);
+		stats.store(ret, std::memory_order_release);
+	}
+	return ret;
+}
+
+void MethodStats::reset()
+{
+	calls = 0;
+	totalNs = 0;
+	maxNs = 0;
+	itemsIn = 0;
+	itemsOut = 0;
+	bytesIn = 0;
+	bytesOut = 0;
+	for (auto& count : histogram) {
+		count = 0;
+	}
+}
+
+std::string MethodStats::qualifiedName() const
+{
+	std::string name = moduleName;
+	if (ownerName) {
+		name += ".";
+		name += ownerName;
+	}
+	name += ".";
+	name += methodName;
+	return name;
+}
+
+uint64_t MethodStats::quantile(double q) const
+{
+	auto total = calls.load();
+	if (total == 0) {
+		return 0;
+	}
+	auto rank = (uint64_t)(q * (double)(total - 1)) + 1;
+	uint64_t seen = 0;
+	for (int b = 0; b < NumBuckets; b++) {
+		seen += histogram[b].load(std::memory_order_relaxed);
+		if (seen >= rank) {
+			return bucketFloor(b);
+		}
+	}
+	return maxNs.load();
+}
+
+void ni_setProfiling(bool enabled)
+{
+	if (enabled) {
+		instrumentation.fetch_or(InstrumentStats);
+	}
+	else {
+		instrumentation.fetch_and((uint8_t)~InstrumentStats);
+	}
+}
+
+void ni_resetStats()
+{
+	std::lock_guard<std::mutex> guard(statsLock);
+	for (auto stats : allStats) {
+		stats->reset();
+	}
+}
+
+static void appendf(std::string& out, const char* format, ...)
+{
+	char buffer[512];
+	va_list args;
+	va_start(args, format);
+	auto length = vsnprintf(buffer, sizeof(buffer), format, args);
+	va_end(args);
+	out.append(buffer, std::min((size_t)length, sizeof(buffer) - 1));
+}
+
+static void appendJsonString(std::string& out, const char* str)
+{
+	out += '"';
+	for (auto p = str; *p; p++) {
+		if (*p == '"' || *p == '\\') {
+			out += '\\';
+		}
+		out += *p;
+	}
+	out += '"';
+}
+
+static void formatText(std::string& out, const std::vector<MethodStats*>& stats)
+{
+	appendf(out, "%-10s %-60s %10s %12s %10s %10s %10s %10s %10s %9s %9s %12s %12s\n",
+		"kind", "method", "calls", "total ms", "mean ns", "p50 ns", "p90 ns", "p99 ns", "max ns", "items in", "items out", "bytes in", "bytes out");
+	for (auto s : stats) {
+		auto calls = std::max<uint64_t>(s->calls.load(), 1); // (could have been reset since)
+		appendf(out, "%-10s %-60s %10" PRIu64 " %12.3f %10" PRIu64 " %10" PRIu64 " %10" PRIu64 " %10" PRIu64 " %10" PRIu64 " %9" PRIu64 " %9" PRIu64 " %12" PRIu64 " %12" PRIu64 "\n",
+			s->kind, s->qualifiedName().c_str(), calls, s->totalNs.load() / 1e6, s->totalNs.load() / calls,
+			s->quantile(0.5), s->quantile(0.9), s->quantile(0.99), s->maxNs.load(),
+			s->itemsIn.load(), s->itemsOut.load(), s->bytesIn.load(), s->bytesOut.load());
+	}
+}
+
+static void formatJson(std::string& out, const std::vector<MethodStats*>& stats)
+{
+	out += "{\"methods\":[";
+	for (size_t i = 0; i < stats.size(); i++) {
+		auto s = stats[i];
+		auto calls = std::max<uint64_t>(s->calls.load(), 1);
+		out += i > 0 ? ",{" : "{";
+		out += "\"kind\":";
+		appendJsonString(out, s->kind);
+		out += ",\"module\":";
+		appendJsonString(out, s->moduleName);
+		if (s->ownerName) {
+			out += ",\"owner\":";
+			appendJsonString(out, s->ownerName);
+		}
+		out += ",\"name\":";
+		appendJsonString(out, s->methodName);
+		appendf(out, ",\"calls\":%" PRIu64 ",\"totalNs\":%" PRIu64 ",\"meanNs\":%" PRIu64
+			",\"p50Ns\":%" PRIu64 ",\"p90Ns\":%" PRIu64 ",\"p99Ns\":%" PRIu64 ",\"p999Ns\":%" PRIu64 ",\"maxNs\":%" PRIu64
+			",\"itemsIn\":%" PRIu64 ",\"itemsOut\":%" PRIu64 ",\"bytesIn\":%" PRIu64 ",\"bytesOut\":%" PRIu64,
+			calls, s->totalNs.load(), s->totalNs.load() / calls,
+			s->quantile(0.5), s->quantile(0.9), s->quantile(0.99), s->quantile(0.999), s->maxNs.load(),
+			s->itemsIn.load(), s->itemsOut.load(), s->bytesIn.load(), s->bytesOut.load());
+		// non-empty buckets only, as [floor ns, count]
+		out += ",\"histogram\":[";
+		bool first = true;
+		for (int b = 0; b < MethodStats::NumBuckets; b++) {
+			auto count = s->histogram[b].load();
+			if (count > 0) {
+				appendf(out, "%s[%" PRIu64 ",%" PRIu64 "]", first ? "" : ",", MethodStats::bucketFloor(b), count);
+				first = false;
+			}
+		}
+		out += "]}";
+	}
+	out += "]}";
+}
+
+size_t ni_getStats(int format, char* buffer, size_t bufferSize)
+{
+	// biggest total cost first (sorted on a snapshot, calls may still be coming in)
+	std::vector<std::pair<uint64_t, MethodStats*>> byTotal;
+	{
+		std::lock_guard<std::mutex> guard(statsLock);
+		for (auto s : allStats) {
+			if (s->calls.load() > 0) {
+				byTotal.push_back({ s->totalNs.load(), s });
+			}
+		}
+	}
+	std::sort(byTotal.begin(), byTotal.end(), [](auto& a, auto& b) { return a.first > b.first; });
+	std::vector<MethodStats*> stats;
+	for (auto& entry : byTotal) {
+		stats.push_back(entry.second);
+	}
+
+	std::string out;
+	if (format == ni_StatsJson) {
+		formatJson(out, stats);
+	}
+	else {
+		formatText(out, stats);
+	}
+	if (buffer && bufferSize > 0) {
+		auto n = std::min(out.size(), bufferSize - 1);
+		memcpy(buffer, out.data(), n);
+		buffer[n] = 0;
+	}
+	return out.size();
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// core-private: per-method boundary statistics, collected while profiling is on (ni_setProfiling)
+// everything is an atomic counter, since the same method can be running on several threads at once
+
+// what gets recorded at each crossing - any bit set means crossings go through ProfileScope (NativeImplCore.cpp)
+enum InstrumentFlags : uint8_t {
+	InstrumentStats = 1,    // ni_setProfiling
+	InstrumentTimeline = 2, // ni_setTimeline
+};
+extern std::atomic<uint8_t> instrumentation;
+
+struct MethodStats {
+	// HDR-style log-linear latency buckets: exact below 8ns, then 8 sub-buckets per power of two (so within 12.5%)
+	static constexpr int SubBucketBits = 3;
+	static constexpr int SubBuckets = 1 << SubBucketBits;
+	static constexpr int NumBuckets = (64 - SubBucketBits + 1) * SubBuckets;
+
+	const char* kind;       // "module", "interface" (client -> server), "callback" (server -> client), "funcval", "register" (deferred modules)
+	const char* moduleName;
+	const char* ownerName;  // interface name, or null
+	const char* methodName;
+
+	std::atomic<uint64_t> calls = 0;
+	std::atomic<uint64_t> totalNs = 0;
+	std::atomic<uint64_t> maxNs = 0;
+	// what was on the stack going in (arguments) and coming out (return values), in items and bytes (slots + payloads)
+	std::atomic<uint64_t> itemsIn = 0;
+	std::atomic<uint64_t> itemsOut = 0;
+	std::atomic<uint64_t> bytesIn = 0;
+	std::atomic<uint64_t> bytesOut = 0;
+	std::atomic<uint64_t> histogram[NumBuckets] = {};
+
+	static inline int msbOf(uint64_t v) {
+#ifdef _MSC_VER
+		unsigned long index;
+		_BitScanReverse64(&index, v);
+		return (int)index;
+#else
+		return 63 - __builtin_clzll(v);
+#endif
+	}
+	static inline int bucketOf(uint64_t ns) {
+		if (ns < SubBuckets) {
+			return (int)ns;
+		}
+		int msb = msbOf(ns);
+		int sub = (int)(ns >> (msb - SubBucketBits)) & (SubBuckets - 1);
+		return (msb - SubBucketBits + 1) * SubBuckets + sub;
+	}
+	// smallest value landing in bucket b
+	static inline uint64_t bucketFloor(int b) {
+		if (b < SubBuckets) {
+			return (uint64_t)b;
+		}
+		int msb = b / SubBuckets + SubBucketBits - 1;
+		return (uint64_t)(SubBuckets + b % SubBuckets) << (msb - SubBucketBits);
+	}
+
+	void record(uint64_t ns, uint64_t itemsIn, uint64_t bytesIn, uint64_t itemsOut, uint64_t bytesOut) {
+		calls.fetch_add(1, std::memory_order_relaxed);
+		totalNs.fetch_add(ns, std::memory_order_relaxed);
+		this->itemsIn.fetch_add(itemsIn, std::memory_order_relaxed);
+		this->itemsOut.fetch_add(itemsOut, std::memory_order_relaxed);
+		this->bytesIn.fetch_add(bytesIn, std::memory_order_relaxed);
+		this->bytesOut.fetch_add(bytesOut, std::memory_order_relaxed);
+		histogram[bucketOf(ns)].fetch_add(1, std::memory_order_relaxed);
+		auto prevMax = maxNs.load(std::memory_order_relaxed);
+		while (ns > prevMax && !maxNs.compare_exchange_weak(prevMax, ns, std::memory_order_relaxed)) {}
+	}
+	void reset();
+	// module[.interface].method
+	std::string qualifiedName() const;
+	// latency at quantile q (0..1), as the floor of the bucket it falls in
+	uint64_t quantile(double q) const;
+};
+
+// a method's stats, created on its first instrumented call (also what timeline events point at, for the names) (so the thousands of never-called methods cost a pointer each)
+// copyable so that registry entries can still be moved into their tables - only ever copied before first use
+class StatsSlot {
+	std::atomic<MethodStats*> stats = nullptr;
+	MethodStats* create(const char* kind, const char* moduleName, const char* ownerName, const char* methodName);
+public:
+	StatsSlot() = default;
+	StatsSlot(const StatsSlot&) {}
+	StatsSlot& operator=(const StatsSlot&) { return *this; }
+
+	inline MethodStats* get(const char* kind, const char* moduleName, const char* ownerName, const char* methodName) {
+		auto ret = stats.load(std::memory_order_acquire);
+		return ret ? ret : create(kind, moduleName, ownerName, methodName);
+	}
+};
@@ -0,0 +1,181 @@
+#include "NativeImplCore.h"
+#include "NativeImplStats.h"
+#include "NativeImplTimeline.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdarg>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// a flight recorder: each thread keeps its most recent crossings in a ring of its own that only it writes to,
+// and ni_writeTimeline copies them out while they may still be getting written (anything overwritten mid-copy is discarded)
+
+struct TimelineEvent {
+	const MethodStats* what;
+	uint64_t time; // ns since timelineEpoch
+	uint32_t depth;
+	bool begin;
+};
+
+struct TimelineRing {
+	static constexpr uint64_t Size = 1 << 15; // per thread, ~768KB, allocated on the thread's first recorded crossing
+	// fields stored separately (as relaxed atomics) so that a concurrent copy is well-defined, if possibly torn - see readRing
+	struct Entry {
+		std::atomic<const MethodStats*> what;
+		std::atomic<uint64_t> time;
+		std::atomic<uint32_t> depthAndPhase; // depth << 1 | begin
+	};
+	Entry entries[Size];
+	std::atomic<uint64_t> head = 0; // total ever written, only the owning thread stores to it
+	std::atomic<bool> orphaned = false;
+	uint32_t thread;
+	uint32_t depth = 0; // owning thread only
+};
+
+static const auto timelineEpoch = std::chrono::steady_clock::now();
+static std::atomic<uint64_t> recordingStart = 0; // events from before the latest ni_setTimeline(true) aren't written out
+
+static std::mutex ringsLock;
+static std::vector<std::shared_ptr<TimelineRing>> rings;
+static std::atomic<uint32_t> nextTimelineThread = 1;
+
+struct TimelineThread {
+	std::shared_ptr<TimelineRing> ring;
+	~TimelineThread() {
+		if (ring) {
+			ring->orphaned = true;
+		}
+	}
+	TimelineRing& get() {
+		if (!ring) {
+			ring = std::make_shared<TimelineRing>();
+			ring->thread = nextTimelineThread++;
+			std::lock_guard<std::mutex> guard(ringsLock);
+			rings.push_back(ring);
+		}
+		return *ring;
+	}
+};
+static thread_local TimelineThread timelineThread;
+
+static inline uint64_t sinceEpoch(std::chrono::steady_clock::time_point when)
+{
+	return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(when - timelineEpoch).count();
+}
+
+static inline void record(TimelineRing& ring, const MethodStats* what, uint64_t time, uint32_t depth, bool begin)
+{
+	auto head = ring.head.load(std::memory_order_relaxed);
+	// (pairs with the fence in readRing: a reader seeing any of these stores also sees the head value that says this slot is being reused)
+	std::atomic_thread_fence(std::memory_order_release);
+	auto& entry = ring.entries[head % TimelineRing::Size];
+	entry.what.store(what, std::memory_order_relaxed);
+	entry.time.store(time, std::memory_order_relaxed);
+	entry.depthAndPhase.store(depth << 1 | (begin ? 1 : 0), std::memory_order_relaxed);
+	ring.head.store(head + 1, std::memory_order_release);
+}
+
+void timelineBegin(const MethodStats* what, std::chrono::steady_clock::time_point when)
+{
+	auto& ring = timelineThread.get();
+	record(ring, what, sinceEpoch(when), ring.depth++, true);
+}
+
+void timelineEnd(const MethodStats* what, std::chrono::steady_clock::time_point when)
+{
+	auto& ring = timelineThread.get();
+	record(ring, what, sinceEpoch(when), --ring.depth, false);
+}
+
+void ni_setTimeline(bool enabled)
+{
+	if (enabled) {
+		recordingStart = sinceEpoch(std::chrono::steady_clock::now());
+		instrumentation.fetch_or(InstrumentTimeline);
+	}
+	else {
+		instrumentation.fetch_and((uint8_t)~InstrumentTimeline);
+	}
+}
+
+// the ring's surviving events, oldest first
+static std::vector<TimelineEvent> readRing(TimelineRing& ring)
+{
+	auto head = ring.head.load(std::memory_order_acquire);
+	auto first = head > TimelineRing::Size ? head - TimelineRing::Size : 0;
+	std::vector<TimelineEvent> events;
+	events.reserve((size_t)(head - first));
+	for (auto i = first; i < head; i++) {
+		auto& entry = ring.entries[i % TimelineRing::Size];
+		auto depthAndPhase = entry.depthAndPhase.load(std::memory_order_relaxed);
+		events.push_back({ entry.what.load(std::memory_order_relaxed), entry.time.load(std::memory_order_relaxed), depthAndPhase >> 1, (depthAndPhase & 1) != 0 });
+	}
+	// whatever the owner wrote meanwhile may have overwritten the oldest of what was just copied
+	// (including the slot it may be in the middle of writing, hence the + 1)
+	std::atomic_thread_fence(std::memory_order_acquire);
+	auto headAfter = ring.head.load(std::memory_order_relaxed);
+	auto overwritten = headAfter + 1 > TimelineRing::Size ? headAfter + 1 - TimelineRing::Size : 0;
+	if (overwritten > first) {
+		events.erase(events.begin(), events.begin() + (size_t)std::min(overwritten - first, head - first));
+	}
+	return events;
+}
+
+static void appendEvent(std::string& out, const char* format, ...)
+{
+	char buffer[512];
+	va_list args;
+	va_start(args, format);
+	auto length = vsnprintf(buffer, sizeof(buffer), format, args);
+	va_end(args);
+	out += ",\n";
+	out.append(buffer, std::min((size_t)length, sizeof(buffer) - 1));
+}
+
+bool ni_writeTimeline(const char* path)
+{
+	std::vector<std::shared_ptr<TimelineRing>> snapshot;
+	{
+		std::lock_guard<std::mutex> guard(ringsLock);
+		snapshot = rings;
+		// exited threads get written out this one last time
+		rings.erase(std::remove_if(rings.begin(), rings.end(), [](auto& ring) { return ring->orphaned.load(); }), rings.end());
+	}
+	auto start = recordingStart.load();
+
+	// chrome://tracing / Perfetto "JSON trace event" format, timestamps in microseconds
+	std::string out = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"NativeImpl\"}}";
+	for (auto& ring : snapshot) {
+		appendEvent(out, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"thread %u\"}}", ring->thread, ring->thread);
+		// the oldest ends may belong to begins that have already been overwritten (or predate the recording), those are left out
+		// begins still open at the end (ie the crossings we're being called from) are written as-is, the viewers show them as unfinished
+		std::vector<uint32_t> open; // depths of the begins written so far that haven't ended
+		for (auto& ev : readRing(*ring)) {
+			if (ev.time < start) {
+				continue;
+			}
+			if (ev.begin) {
+				open.push_back(ev.depth);
+				// method names are identifiers, nothing to escape
+				appendEvent(out, "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"B\",\"ts\":%.3f,\"pid\":1,\"tid\":%u,\"args\":{\"depth\":%u}}",
+					ev.what->qualifiedName().c_str(), ev.what->kind, ev.time / 1e3, ring->thread, ev.depth);
+			}
+			else if (!open.empty() && open.back() == ev.depth) {
+				open.pop_back();
+				appendEvent(out, "{\"ph\":\"E\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}", ev.time / 1e3, ring->thread);
+			}
+		}
+	}
+	out += "\n]}\n";
+
+	auto f = fopen(path, "wb");
+	if (!f) {
+		return false;
+	}
+	auto ok = fwrite(out.data(), 1, out.size(), f) == out.size();
+	return fclose(f) == 0 && ok;
+}
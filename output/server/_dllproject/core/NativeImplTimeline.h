@@ -0,0 +1,10 @@
+#pragma once
+
+#include <chrono>
+
+struct MethodStats;
+
+// core-private: begin/end of an instrumented crossing, on the calling thread's timeline (see ProfileScope)
+// only called while the timeline is on (ni_setTimeline), and always in pairs
+void timelineBegin(const MethodStats* what, std::chrono::steady_clock::time_point when);
+void timelineEnd(const MethodStats* what, std::chrono::steady_clock::time_point when);
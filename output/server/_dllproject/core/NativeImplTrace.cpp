@@ -0,0 +1,191 @@
+#include "NativeImplCore.h"
+#include "NativeImplTrace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+std::atomic<uint8_t> ni_traceLevel = ni_TraceWarn;
+
+static const char* levelNames[] = { "off", "error", "warn", "info", "debug" };
+
+// by ni_TraceEvent
+static const char* eventFormats[ni_TraceEventCount] = {
+	"releasing server resource %d",
+	"server resource %d released, refcount still %d",
+	"bumped server resource %d refcount to %d",
+	"releaseServerResource(%d) - no such resource (stale id?)",
+	"server func val %d released",
+	"server safety area cleared (%d resources)",
+	"client resource %d safepush",
+	"client resource %d proxy destroyed, remote releasing",
+};
+
+struct TraceRecord {
+	uint64_t time; // ns since traceEpoch
+	int32_t a;
+	int32_t b;
+	uint32_t thread;
+	ni_TraceEvent event;
+	ni_TraceLevel level;
+};
+
+// single producer (the owning thread) / single consumer (whoever holds drainLock)
+struct TraceRing {
+	static constexpr uint64_t Size = 4096;
+	TraceRecord records[Size];
+	alignas(64) std::atomic<uint64_t> head = 0; // written by the producer
+	alignas(64) std::atomic<uint64_t> tail = 0; // written by the consumer
+	std::atomic<uint64_t> dropped = 0;
+	std::atomic<bool> orphaned = false; // owning thread has exited, ring goes once it's been drained
+	uint32_t thread;
+};
+
+static const auto traceEpoch = std::chrono::steady_clock::now();
+
+static std::mutex ringsLock;
+static std::vector<std::shared_ptr<TraceRing>> rings;
+static std::atomic<uint32_t> nextTraceThread = 1;
+
+// drained events, most recent HistorySize kept
+static constexpr size_t HistorySize = 1 << 16;
+static std::mutex drainLock;
+static std::vector<TraceRecord> history;
+static size_t historyNext = 0;
+static uint64_t historyDropped = 0; // from rings that have since gone away
+
+static std::thread drainThread;
+static std::mutex drainThreadLock;
+static std::condition_variable drainWake;
+static bool drainStop = false;
+
+struct TraceThread {
+	std::shared_ptr<TraceRing> ring;
+	~TraceThread() {
+		if (ring) {
+			ring->orphaned = true;
+		}
+	}
+	TraceRing& get() {
+		if (!ring) {
+			ring = std::make_shared<TraceRing>();
+			ring->thread = nextTraceThread++;
+			std::lock_guard<std::mutex> guard(ringsLock);
+			rings.push_back(ring);
+		}
+		return *ring;
+	}
+};
+static thread_local TraceThread traceThread;
+
+void ni_setTraceLevel(int level)
+{
+	ni_traceLevel = (uint8_t)std::clamp(level, (int)ni_TraceOff, (int)ni_TraceDebug);
+}
+
+void ni_traceRecord(ni_TraceLevel level, ni_TraceEvent event, int32_t a, int32_t b)
+{
+	auto& ring = traceThread.get();
+	auto head = ring.head.load(std::memory_order_relaxed);
+	if (head - ring.tail.load(std::memory_order_acquire) == TraceRing::Size) {
+		// full - never block the caller, the drain thread will catch up
+		ring.dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+	auto time = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - traceEpoch).count();
+	ring.records[head % TraceRing::Size] = { time, a, b, ring.thread, event, level };
+	ring.head.store(head + 1, std::memory_order_release);
+}
+
+// call with drainLock held
+static void drainRings()
+{
+	std::vector<std::shared_ptr<TraceRing>> snapshot;
+	{
+		std::lock_guard<std::mutex> guard(ringsLock);
+		snapshot = rings;
+	}
+	if (history.size() < HistorySize) {
+		history.resize(HistorySize);
+	}
+	for (auto& ring : snapshot) {
+		auto tail = ring->tail.load(std::memory_order_relaxed);
+		auto head = ring->head.load(std::memory_order_acquire);
+		for (; tail != head; tail++) {
+			history[historyNext++ % HistorySize] = ring->records[tail % TraceRing::Size];
+		}
+		ring->tail.store(tail, std::memory_order_release);
+	}
+	// forget rings of threads that are gone (checked after draining, anything they recorded has been taken by now)
+	std::lock_guard<std::mutex> guard(ringsLock);
+	rings.erase(std::remove_if(rings.begin(), rings.end(), [](auto& ring) {
+		if (ring->orphaned && ring->head.load() == ring->tail.load()) {
+			historyDropped += ring->dropped.load();
+			return true;
+		}
+		return false;
+	}), rings.end());
+}
+
+void traceStartDrain()
+{
+	std::lock_guard<std::mutex> guard(drainThreadLock);
+	if (drainThread.joinable()) {
+		return;
+	}
+	drainStop = false;
+	drainThread = std::thread([] {
+		std::unique_lock<std::mutex> lock(drainThreadLock);
+		while (!drainStop) {
+			drainWake.wait_for(lock, std::chrono::milliseconds(20));
+			std::lock_guard<std::mutex> guard(drainLock);
+			drainRings();
+		}
+	});
+}
+
+void traceStopDrain()
+{
+	{
+		std::lock_guard<std::mutex> guard(drainThreadLock);
+		if (!drainThread.joinable()) {
+			return;
+		}
+		drainStop = true;
+	}
+	drainWake.notify_one();
+	drainThread.join();
+}
+
+void ni_dumpTrace()
+{
+	std::lock_guard<std::mutex> guard(drainLock);
+	drainRings();
+
+	// rings are drained one after another, so the history is only in time order per thread
+	auto count = std::min(historyNext, HistorySize);
+	std::vector<TraceRecord> records(history.begin(), history.begin() + count);
+	std::stable_sort(records.begin(), records.end(), [](auto& x, auto& y) { return x.time < y.time; });
+
+	uint64_t dropped = historyDropped;
+	{
+		std::lock_guard<std::mutex> guard(ringsLock);
+		for (auto& ring : rings) {
+			dropped += ring->dropped.load();
+		}
+	}
+	printf("== trace (%zu events, %llu older ones not kept, %llu dropped):\n",
+		count, (unsigned long long)(historyNext - count), (unsigned long long)dropped);
+	for (auto& rec : records) {
+		printf("[%12.3f ms] thread %u %-5s: ", rec.time / 1e6, rec.thread, levelNames[rec.level]);
+		printf(rec.event < ni_TraceEventCount ? eventFormats[rec.event] : "unknown event %d/%d", rec.a, rec.b);
+		printf("\n");
+	}
+	fflush(stdout);
+}
@@ -0,0 +1,6 @@
+#pragma once
+
+// core-private: the background drain thread runs between ni_nativeImplInit and ni_nativeImplShutdown
+// (outside of that, events still get recorded, and are drained on the next ni_dumpTrace)
+void traceStartDrain();
+void traceStopDrain();
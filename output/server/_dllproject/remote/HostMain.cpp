@@ -0,0 +1,9 @@
+#include "../DirectExport.h"
+
+// QtTestingHost: the process the server library runs in, in out-of-process mode (see Remote.h)
+// started by the client with the shared memory on an inherited fd, not meant to be run by hand
+
+int main(int argc, char** argv)
+{
+    return remoteHostMain(argc, argv);
+}
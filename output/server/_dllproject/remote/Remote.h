@@ -0,0 +1,52 @@
+#pragma once
+
+#include "../core/NativeImplCore.h"
+
+#include <atomic>
+
+// out-of-process mode: the server library running in a host process of its own (QtTestingHost), so that a crash in there
+// can't take the client down with it. started with NI_REMOTE_HOST=<path to QtTestingHost> in the environment (see nativeImplInit)
+// the client side keeps its own stack, lookups and registrations (the same library is loaded on both sides, registering the same way),
+// so pushes and pops stay local - only the invocations go across, each carrying the stack with it, and the callbacks come back the same way
+// (over shared memory, see RemoteChannel.h). Linux only for now
+//
+// differences from in-process:
+// - client buffers are copied into shared memory for the length of each call they go along on, and copied back after it
+//   (a server holding onto one past the call sees a stale copy) - server buffers live in shared memory, and cross as they are
+//   the copies share a scratch of NI_REMOTE_SCRATCH_MB (default 64): a batch that doesn't fit returns -1 (nothing run), and a call
+//   or callback return has no answer to give, so it goes the way of a lost host (below)
+// - server -> client callbacks have to come from the thread serving the client (the host's main thread), others are dropped with a message
+// - the stats/timeline/trace of the server side are the host's (and not visible from the client)
+// - if the host goes away in the middle of a call, there's no answer to return: the host-lost handler runs, and then the client exits
+
+namespace Remote {
+	extern std::atomic<bool> active;
+
+	inline bool connected() {
+		return active.load(std::memory_order_relaxed);
+	}
+
+	// client side - after the local ni_nativeImplInit. false (with the reason printed) if the host couldn't be started
+	bool start(const char* hostPath);
+	void stop();
+	// status is the host's, as from waitpid
+	void setHostLostHandler(void (*handler)(int status));
+	void setClientResourceReleaseBatch(niClientResourceReleaseBatch clientResourceReleaseBatch);
+
+	void invokeModuleMethod(ni_ModuleMethodRef method);
+	ni_ExceptionRef invokeModuleMethodWithExceptions(ni_ModuleMethodRef method);
+	void invokeInterfaceMethod(ni_InterfaceMethodRef method, int serverID);
+	ni_ExceptionRef invokeInterfaceMethodWithExceptions(ni_InterfaceMethodRef method, int serverID);
+	void execServerFunc(int id);
+	ni_ExceptionRef execServerFuncWithExceptions(int id);
+	void pushModuleConstants(ni_ModuleRef m);
+	int invokeBatch(const void* buffer, size_t length, ni_BatchResult* results, size_t maxResults);
+	void releaseServerResources(const int* ids, size_t count);
+	void clearServerSafetyArea();
+	void dumpTables();
+
+	// host side: the host process's main, given the command line start() ran it with - returns the exit code
+	int hostMain(int argc, char** argv);
+	// whether this is that command line (for executables that double as their own host, like the bench)
+	bool isHostCommandLine(int argc, char** argv);
+}
@@ -0,0 +1,285 @@
+#include "RemoteChannel.h"
+
+#ifdef __linux__
+
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <thread>
+
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace Remote {
+	static constexpr uint64_t HeaderSize = 4096;
+	static constexpr uint64_t RingCapacity = 1 << 20;
+	static constexpr uint64_t SectionAlign = 2 << 20; // (so the heap could be backed by huge pages)
+	static_assert(sizeof(RegionHeader) <= HeaderSize, "region header outgrew its page");
+
+	static inline uint64_t alignUp(uint64_t n, uint64_t to) {
+		return (n + to - 1) / to * to;
+	}
+
+	static inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+		__builtin_ia32_pause();
+#elif defined(__aarch64__)
+		asm volatile("yield");
+#endif
+	}
+
+	// the words are in memory mapped by both processes, so these are the shared (non-_PRIVATE) futex ops
+	// false if it timed out
+	static bool futexWait(std::atomic<uint32_t>& word, uint32_t expected, int timeoutMs) {
+		timespec timeout{ timeoutMs / 1000, (timeoutMs % 1000) * 1000000L };
+		auto ret = syscall(SYS_futex, (uint32_t*)&word, FUTEX_WAIT, expected, &timeout, nullptr, 0);
+		return !(ret == -1 && errno == ETIMEDOUT);
+	}
+
+	static void futexWake(std::atomic<uint32_t>& word) {
+		syscall(SYS_futex, (uint32_t*)&word, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+	}
+
+	static inline void bump(std::atomic<uint32_t>& seq, std::atomic<uint32_t>& waiters) {
+		seq.fetch_add(1);
+		if (waiters.load() != 0) {
+			futexWake(seq);
+		}
+	}
+
+	uint64_t spinNanoseconds() {
+		// (no spinning on a single cpu, the other side can't get anywhere while this one spins)
+		static const uint64_t ns = [] {
+			auto env = getenv("NI_REMOTE_SPIN_US");
+			return (env ? strtoull(env, nullptr, 10) : std::thread::hardware_concurrency() > 1 ? 50 : 0) * 1000;
+		}();
+		return ns;
+	}
+
+	// spins for a while, then sleeps on seq (woken by the other side's bump) until ready()
+	// the sleeps time out every so often to check on the other side, false once that's found gone
+	template <typename Ready>
+	static bool waitUntil(std::atomic<uint32_t>& seq, std::atomic<uint32_t>& waiters, Ready&& ready, bool (*peerAlive)(), bool& peerGone) {
+		if (ready()) {
+			return true;
+		}
+		if (peerGone) {
+			return false;
+		}
+		auto spinUntil = std::chrono::steady_clock::now() + std::chrono::nanoseconds(spinNanoseconds());
+		for (uint32_t i = 1; ; i++) {
+			cpuRelax();
+			if (ready()) {
+				return true;
+			}
+			if (i % 64 == 0 && std::chrono::steady_clock::now() >= spinUntil) {
+				break;
+			}
+		}
+		while (true) {
+			// (announcing the waiter before the last look, so that a bump after that look is sure to wake it)
+			waiters.fetch_add(1);
+			auto expected = seq.load();
+			if (ready()) {
+				waiters.fetch_sub(1);
+				return true;
+			}
+			auto woken = futexWait(seq, expected, 100);
+			waiters.fetch_sub(1);
+			if (ready()) {
+				return true;
+			}
+			if (!woken && peerAlive && !peerAlive()) {
+				peerGone = true;
+				return false;
+			}
+		}
+	}
+
+	Channel::~Channel() {
+		if (base) {
+			munmap(base, header->size);
+		}
+		if (fd >= 0) {
+			close(fd);
+		}
+	}
+
+	bool Channel::create(size_t heapSize, size_t scratchSize) {
+		uint64_t offsets[2];
+		auto end = HeaderSize;
+		for (auto& offset : offsets) {
+			offset = end;
+			end += RingCapacity;
+		}
+		auto scratchOffset = alignUp(end, SectionAlign);
+		auto heapOffset = alignUp(scratchOffset + scratchSize, SectionAlign);
+		auto size = heapOffset + alignUp(heapSize, SectionAlign);
+
+		fd = (int)syscall(SYS_memfd_create, "ni-remote", 1u /* MFD_CLOEXEC */);
+		if (fd < 0 || ftruncate(fd, (off_t)size) != 0) {
+			perror("ni remote: shared memory");
+			return false;
+		}
+		auto mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		if (mapped == MAP_FAILED) {
+			perror("ni remote: mmap");
+			return false;
+		}
+		base = (uint8_t*)mapped;
+		header = new (base) RegionHeader{};
+		memcpy(header->magic, Magic, sizeof(Magic));
+		header->version = Version;
+		header->size = size;
+		for (int i = 0; i < 2; i++) {
+			header->rings[i].offset = offsets[i];
+			header->rings[i].capacity = RingCapacity;
+		}
+		header->clientPid = (int32_t)getpid();
+		header->scratchOffset = scratchOffset;
+		header->scratchSize = heapOffset - scratchOffset;
+		header->heapOffset = heapOffset;
+		header->heapSize = size - heapOffset;
+		for (int kind = 0; kind <= ni_RefStructType; kind++) {
+			header->refCounts[kind] = (uint32_t)ni_getRefCount(kind);
+		}
+		return true;
+	}
+
+	bool Channel::attach(int inherited) {
+		fd = inherited;
+		struct stat info;
+		if (fstat(fd, &info) != 0 || (uint64_t)info.st_size < HeaderSize) {
+			fprintf(stderr, "ni remote: no shared memory on fd %d\n", fd);
+			return false;
+		}
+		auto size = (size_t)info.st_size;
+		auto mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		if (mapped == MAP_FAILED) {
+			perror("ni remote: mmap");
+			return false;
+		}
+		base = (uint8_t*)mapped;
+		header = (RegionHeader*)base;
+		if (memcmp(header->magic, Magic, sizeof(Magic)) != 0 || header->version != Version || header->size != size) {
+			fprintf(stderr, "ni remote: shared memory from a different version\n");
+			munmap(base, size);
+			base = nullptr;
+			return false;
+		}
+		return true;
+	}
+
+	bool Channel::send(RingIndex index, const FrameHeader& frameHeader, const void* prefix, size_t prefixLength, const void* payload, size_t payloadLength) {
+		auto& ring = header->rings[index];
+		auto data = base + ring.offset;
+		std::lock_guard<std::mutex> guard(sendLock[index]);
+		auto head = ring.head.load(std::memory_order_relaxed);
+		auto publish = [&] {
+			ring.head.store(head);
+			bump(ring.dataSeq, ring.dataWaiters);
+		};
+		auto space = [&] {
+			return ring.capacity - (head - ring.tail.load(std::memory_order_acquire));
+		};
+		auto put = [&](const void* src, size_t length) {
+			auto bytes = (const uint8_t*)src;
+			while (length > 0) {
+				if (space() == 0) {
+					// full: let the reader at what's there so far, and wait for it to make room
+					publish();
+					if (!waitUntil(ring.spaceSeq, ring.spaceWaiters, [&] { return space() > 0; }, peerAlive, peerGone)) {
+						return false;
+					}
+				}
+				auto at = head & (ring.capacity - 1);
+				auto n = std::min<uint64_t>({ length, space(), ring.capacity - at });
+				memcpy(data + at, bytes, n);
+				head += n;
+				bytes += n;
+				length -= n;
+			}
+			return true;
+		};
+		auto h = frameHeader;
+		h.length = prefixLength + payloadLength;
+		if (!put(&h, sizeof(h)) || !put(prefix, prefixLength) || !put(payload, payloadLength)) {
+			return false;
+		}
+		publish();
+		return true;
+	}
+
+	void Channel::setHostState(HostState state) {
+		header->hostState.store(state);
+		futexWake(header->hostState);
+	}
+
+	HostState Channel::awaitHostState() {
+		while (true) {
+			auto state = header->hostState.load();
+			if (state != HostStarting) {
+				return (HostState)state;
+			}
+			if (!futexWait(header->hostState, state, 100) && peerAlive && !peerAlive()) {
+				peerGone = true;
+				return HostFailed;
+			}
+		}
+	}
+
+	bool Channel::receive(RingIndex index, Frame& frame) {
+		auto& ring = header->rings[index];
+		auto data = base + ring.offset;
+		auto tail = ring.tail.load(std::memory_order_relaxed);
+		auto release = [&] {
+			ring.tail.store(tail);
+			bump(ring.spaceSeq, ring.spaceWaiters);
+		};
+		auto available = [&] {
+			return ring.head.load(std::memory_order_acquire) - tail;
+		};
+		auto take = [&](void* dst, size_t length) {
+			auto bytes = (uint8_t*)dst;
+			while (length > 0) {
+				if (available() == 0) {
+					release();
+					if (!waitUntil(ring.dataSeq, ring.dataWaiters, [&] { return available() > 0; }, peerAlive, peerGone)) {
+						return false;
+					}
+				}
+				auto at = tail & (ring.capacity - 1);
+				auto n = std::min<uint64_t>({ length, available(), ring.capacity - at });
+				memcpy(bytes, data + at, n);
+				tail += n;
+				bytes += n;
+				length -= n;
+			}
+			return true;
+		};
+		if (!take(&frame.header, sizeof(frame.header))) {
+			return false;
+		}
+		if (frame.header.length % 8 != 0) {
+			fprintf(stderr, "ni remote: corrupt frame\n");
+			peerGone = true;
+			return false;
+		}
+		frame.payload.resize(frame.header.length / 8);
+		if (!take(frame.payload.data(), frame.header.length)) {
+			return false;
+		}
+		release();
+		return true;
+	}
+}
+
+#endif // __linux__
@@ -0,0 +1,183 @@
+#pragma once
+
+#include "../core/NativeImplCore.h"
+#include "../capture/CaptureFormat.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// the memory the client and host processes share (one memfd, mapped by both - at different addresses, so nothing in it holds a pointer):
+//   header | ring to the host | ring to the client | client scratch | host heap
+// each ring carries frames one way, single producer / single consumer (each side's sends are serialized by a lock, see Channel::send),
+// with the consumer spinning for a while before it sleeps on a futex in the ring (see Ring)
+// the scratch holds copies of client buffers for the length of a call, the heap holds the host's ServerBuffer blocks (see BufferPool::setSource),
+// so that both of those can cross as offsets into here rather than by value
+
+namespace Remote {
+	constexpr char Magic[8] = { 'N', 'I', 'R', 'E', 'M', 'O', 'T', 'E' };
+	constexpr uint32_t Version = 1;
+
+	enum class FrameKind : uint32_t {
+		// client -> host
+		Invoke,                 // ref = module method index, flags = WithExceptions
+		InvokeInterface,        // ref = interface method index, id = server id, flags = WithExceptions
+		ExecServerFunc,         // id, flags = WithExceptions
+		ModuleConstants,        // ref = module index
+		Batch,                  // id = maxResults, flags = HasResults, payload = the batch, its methods as indices
+		Shutdown,               // (all of the above are answered with a Return)
+		ReleaseServerResources, // payload = int32 ids (one-way, as are the next two)
+		ClearServerSafetyArea,
+		DumpTables,
+		CallbackReturn,         // answers FuncExec/MethodExec: ref = exception index or -1, payload = the stack
+		// host -> client
+		Return,                 // ref = exception index or -1, payload = the stack (a Batch's is preceded by its BatchReturn)
+		FuncExec,               // id = function id, payload = the stack
+		MethodExec,             // ref = interface method index, id = object id, payload = the stack
+		ReleaseClientResources, // payload = int32 ids (one-way, as is the next one)
+		ClearClientSafetyArea,
+	};
+	enum FrameFlags : uint32_t {
+		WithExceptions = 1,
+		HasResults = 2,
+	};
+	struct FrameHeader {
+		FrameKind kind;
+		uint32_t flags;
+		int32_t ref;
+		int32_t id;
+		uint64_t length; // payload bytes following (a multiple of 8)
+	};
+	// at the front of a Batch's Return: the count invokeBatch returned, then that many results (exceptions as indices)
+	struct BatchReturn {
+		int64_t executed;
+	};
+	struct BatchReturnResult {
+		int32_t exception;
+		uint32_t returnCount;
+	};
+
+	// head/tail count every byte ever written/read, so the fill is head - tail and the position is that modulo the capacity
+	// the seq words are what the waiting side sleeps on: bumped by the other side after it moves head (data) or tail (space),
+	// and only woken through when the waiters count says someone's asleep
+	struct Ring {
+		alignas(64) std::atomic<uint64_t> head;
+		alignas(64) std::atomic<uint64_t> tail;
+		alignas(64) std::atomic<uint32_t> dataSeq;
+		std::atomic<uint32_t> dataWaiters;
+		std::atomic<uint32_t> spaceSeq;
+		std::atomic<uint32_t> spaceWaiters;
+		uint64_t offset;   // of the data, from the start of the region
+		uint64_t capacity; // a power of two
+	};
+	static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free,
+		"shared memory atomics must be lock-free (ie address-free)");
+
+	enum HostState : uint32_t {
+		HostStarting, HostReady, HostFailed
+	};
+	enum RingIndex {
+		ToHost, ToClient
+	};
+
+	struct RegionHeader {
+		char magic[8];
+		uint32_t version;
+		uint32_t refCounts[ni_RefStructType + 1]; // the client's registrations, which the host's have to match (ie it's the same library)
+		uint64_t size;
+		Ring rings[2];
+		uint64_t scratchOffset, scratchSize;
+		uint64_t heapOffset, heapSize;
+		std::atomic<uint32_t> hostState; // also a futex word, for the client waiting on the host to start
+		int32_t clientPid;               // (for the host to tell its parent's gone)
+	};
+
+	struct Frame {
+		FrameHeader header;
+		std::vector<uint64_t> payload; // (8-byte aligned, for ni_putStack)
+		const void* data() const { return payload.data(); }
+	};
+
+	class Channel {
+		int fd = -1;
+		std::mutex sendLock[2];
+		bool (*peerAlive)() = nullptr;
+		bool peerGone = false;
+
+	public:
+		uint8_t* base = nullptr;
+		RegionHeader* header = nullptr;
+
+		~Channel();
+		// the client's side: a new region, of heapSize bytes of host heap and scratchSize of client scratch (both rounded up)
+		// plus the rest (the memory is only committed as it's touched)
+		bool create(size_t heapSize, size_t scratchSize);
+		// the host's side, on the fd inherited from the client
+		bool attach(int fd);
+		int handle() const { return fd; }
+		// checked whenever a wait times out, the waits give up (returning false) once it says the other side is gone
+		void setPeerAlive(bool (*alive)()) { peerAlive = alive; }
+		bool gone() const { return peerGone; }
+
+		// any thread. the payload goes in two parts (either can be empty), a frame bigger than the ring goes across in pieces as the reader makes room
+		bool send(RingIndex ring, const FrameHeader& header, const void* prefix, size_t prefixLength, const void* payload, size_t payloadLength);
+		// one thread at a time
+		bool receive(RingIndex ring, Frame& frame);
+
+		// the host's side says how its startup went, the client's side waits to hear (HostFailed if the host died first)
+		void setHostState(HostState state);
+		HostState awaitHostState();
+
+		bool contains(const void* p) const {
+			return p >= base && p < base + header->size;
+		}
+		uint64_t offsetOf(const void* p) const {
+			return (uint64_t)((const uint8_t*)p - base);
+		}
+	};
+
+	// spin time before sleeping, from NI_REMOTE_SPIN_US (default 50us, none on a single cpu)
+	uint64_t spinNanoseconds();
+
+	// the commands and buffer descriptors inside an encoded stack or batch, handed to onCommand()/fix() one at a time
+	// (so each side can translate the method refs and start pointers), false if it's malformed
+	template <typename OnCommand, typename Fix>
+	bool walkFrame(void* encoded, size_t length, OnCommand&& onCommand, Fix&& fix);
+
+	template <typename Fix>
+	bool fixBuffers(void* encoded, size_t length, Fix&& fix) {
+		return walkFrame(encoded, length, [](ni_BatchCommand&) {}, fix);
+	}
+
+	// this thread's stack into out, with its buffer descriptors passed through fix()
+	template <typename Fix>
+	void encodeStack(std::vector<uint64_t>& out, Fix&& fix) {
+		auto size = ni_encodedStackSize();
+		out.resize(size / 8);
+		ni_takeStack(out.data());
+		fixBuffers(out.data(), size, fix);
+	}
+
+	// a descriptor's start, crossing as an offset into the region - the descriptor's reserved field says which it is
+	constexpr int StartIsOffset = 1;
+}
+
+template <typename OnCommand, typename Fix>
+bool Remote::walkFrame(void* encoded, size_t length, OnCommand&& onCommand, Fix&& fix) {
+	auto end = (uint8_t*)encoded + length;
+	return Capture::walkBatch(encoded, length, onCommand,
+		[&](ni_BatchArg& arg) {
+			// (walkBatch bounds-checks the payload only after this, a short one is left for it to reject)
+			auto descriptor = (ni_BufferDescriptor*)(&arg + 1);
+			if (arg.type == ni_BatchBuffer && (uint8_t*)(descriptor + 1) <= end) {
+				fix(arg, *descriptor);
+			}
+		},
+		[](int typeId) {
+			size_t size;
+			const ni_StructField* fields;
+			size_t fieldCount;
+			return ni_getStructLayout(typeId, &size, &fields, &fieldCount) ? size : (size_t)0;
+		});
+}
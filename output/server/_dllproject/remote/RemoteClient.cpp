@@ -0,0 +1,454 @@
+#include "Remote.h"
+#include "RemoteChannel.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace Remote {
+	std::atomic<bool> active{ false };
+}
+
+#ifdef __linux__
+
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+
+namespace Remote {
+	static constexpr int HostFd = 3; // where the host finds the shared memory (see hostMain)
+
+	// a client buffer's copy in the scratch, copied back once the call it went along on returns
+	struct ScratchCopy {
+		void* original;
+		uint64_t offset; // from the start of the region
+		size_t size;
+	};
+
+	static struct Client {
+		std::unique_ptr<Channel> channel;
+		pid_t host = -1;
+		int hostStatus = 0;
+		// one call at a time (the callbacks it makes come in on the calling thread, and can make calls of their own)
+		std::recursive_mutex callLock;
+		std::vector<uint64_t> out;
+		Frame in;
+		uint64_t scratchUsed = 0;
+		std::vector<ScratchCopy> copies;
+		bool scratchFull = false; // (see fixOutgoing)
+		void (*hostLost)(int status) = nullptr;
+		niClientResourceReleaseBatch releaseBatch = nullptr;
+	} client;
+
+	static bool hostAlive() {
+		int status;
+		auto ret = waitpid(client.host, &status, WNOHANG);
+		if (ret == client.host) {
+			client.hostStatus = status;
+			return false;
+		}
+		return ret == 0;
+	}
+
+	// nothing sensible to return to whoever's waiting on the host
+	[[noreturn]] static void lost() {
+		auto status = client.hostStatus;
+		if (WIFSIGNALED(status)) {
+			fprintf(stderr, "ni remote: the host died (signal %d)\n", WTERMSIG(status));
+		}
+		else {
+			fprintf(stderr, "ni remote: the host went away (exit status %d)\n", WEXITSTATUS(status));
+		}
+		if (client.hostLost) {
+			client.hostLost(status);
+		}
+		// (not exit(): the static destructors would be running with calls still in progress)
+		fflush(nullptr);
+		_exit(EXIT_FAILURE);
+	}
+
+	static size_t heapSize() {
+		auto env = getenv("NI_REMOTE_HEAP_MB");
+		return (env ? strtoull(env, nullptr, 10) : 1024) << 20;
+	}
+
+	static size_t scratchSize() {
+		auto env = getenv("NI_REMOTE_SCRATCH_MB");
+		return (env ? strtoull(env, nullptr, 10) : 64) << 20;
+	}
+
+	// buffers on their way to the host: server buffers (already in the region) as their offsets,
+	// client ones copied into the scratch first (once per call, however many times they go across)
+	// one that doesn't fit is left null, and client.scratchFull set for the caller to fail what it was sending (see takeScratchFull)
+	static void fixOutgoing(ni_BatchArg&, ni_BufferDescriptor& descriptor) {
+		descriptor.reserved = 0;
+		if (!descriptor.start) {
+			return;
+		}
+		auto& channel = *client.channel;
+		uint64_t offset;
+		if (channel.contains(descriptor.start)) {
+			offset = channel.offsetOf(descriptor.start);
+		}
+		else {
+			auto size = (size_t)descriptor.totalSize;
+			ScratchCopy* found = nullptr;
+			for (auto& copy : client.copies) {
+				if (copy.original == descriptor.start && copy.size == size) {
+					found = &copy;
+					break;
+				}
+			}
+			if (!found) {
+				auto& header = *channel.header;
+				auto at = (client.scratchUsed + 63) & ~(uint64_t)63;
+				if (at + size > header.scratchSize) {
+					fprintf(stderr, "ni remote: a client buffer of %zu bytes doesn't fit in the scratch (%llu MB, see NI_REMOTE_SCRATCH_MB)\n",
+						size, (unsigned long long)(header.scratchSize >> 20));
+					client.scratchFull = true;
+					descriptor.start = nullptr;
+					return;
+				}
+				client.copies.push_back({ descriptor.start, header.scratchOffset + at, size });
+				found = &client.copies.back();
+				memcpy(channel.base + found->offset, descriptor.start, size);
+				client.scratchUsed = at + size;
+			}
+			offset = found->offset;
+		}
+		descriptor.start = (void*)(uintptr_t)offset;
+		descriptor.reserved = StartIsOffset;
+	}
+
+	// ... and on their way back: the client's own memory for its copies, the mapping for the rest
+	static void fixIncoming(ni_BatchArg&, ni_BufferDescriptor& descriptor) {
+		auto offset = (uint64_t)(uintptr_t)descriptor.start;
+		auto& channel = *client.channel;
+		if (descriptor.reserved != StartIsOffset || offset >= channel.header->size) {
+			descriptor.reserved = 0;
+			descriptor.start = nullptr;
+			return;
+		}
+		descriptor.reserved = 0;
+		for (auto& copy : client.copies) {
+			if (offset >= copy.offset && offset < copy.offset + copy.size) {
+				descriptor.start = (uint8_t*)copy.original + (offset - copy.offset);
+				return;
+			}
+		}
+		descriptor.start = channel.base + offset;
+	}
+
+	// for when the host can't be carried on with
+	[[noreturn]] static void abandon() {
+		kill(client.host, SIGKILL);
+		waitpid(client.host, &client.hostStatus, 0);
+		lost();
+	}
+
+	// a host that talks nonsense is as good as gone
+	[[noreturn]] static void corrupt() {
+		fprintf(stderr, "ni remote: corrupt frame from the host\n");
+		abandon();
+	}
+
+	// whether fixOutgoing ran out of scratch for what's being sent (clearing it for the next)
+	static bool takeScratchFull() {
+		auto full = client.scratchFull;
+		client.scratchFull = false;
+		return full;
+	}
+
+	// a call (or callback return) that can't go across as it is: there's no answer to give whoever's waiting on it
+	// (a batch can fail instead, see invokeBatch)
+	static void checkScratch() {
+		if (takeScratchFull()) {
+			abandon();
+		}
+	}
+
+	static void putIncoming(Frame& frame, size_t at) {
+		auto stack = (uint8_t*)frame.payload.data() + at;
+		auto length = (size_t)frame.header.length - at;
+		if (!fixBuffers(stack, length, fixIncoming) || !ni_putStack(stack, length)) {
+			corrupt();
+		}
+	}
+
+	static void send(const FrameHeader& header, const void* prefix = nullptr, size_t prefixLength = 0) {
+		if (!client.channel->send(ToHost, header, prefix, prefixLength, client.out.data(), client.out.size() * 8)) {
+			lost();
+		}
+	}
+
+	static void serveCallback() {
+		auto header = client.in.header;
+		putIncoming(client.in, 0);
+		if (header.kind == FrameKind::FuncExec) {
+			ni_clientFuncExec(header.id);
+		}
+		else if (auto method = (ni_InterfaceMethodRef)ni_getRefByIndex(ni_RefInterfaceMethod, header.ref)) {
+			ni_clientMethodExec(method, header.id);
+		}
+		auto exception = ni_getAndClearException();
+		encodeStack(client.out, fixOutgoing);
+		checkScratch();
+		send({ FrameKind::CallbackReturn, 0, ni_getRefIndex(ni_RefException, exception), 0, 0 });
+	}
+
+	static void releaseClientResources() {
+		// (copied out, the release callbacks are free to make calls of their own)
+		auto count = (size_t)client.in.header.id;
+		if (count > client.in.header.length / sizeof(int)) {
+			corrupt();
+		}
+		std::vector<int> ids((const int*)client.in.data(), (const int*)client.in.data() + count);
+		if (client.releaseBatch) {
+			client.releaseBatch(ids.data(), count);
+		}
+		else {
+			for (auto id : ids) {
+				ni_clientResourceRelease(id);
+			}
+		}
+	}
+
+	// whatever the host sends until the Return of the call in progress (null if the host's gone)
+	static Frame* awaitReturn() {
+		while (client.channel->receive(ToClient, client.in)) {
+			switch (client.in.header.kind) {
+			case FrameKind::Return:
+				return &client.in;
+			case FrameKind::FuncExec:
+			case FrameKind::MethodExec:
+				serveCallback();
+				break;
+			case FrameKind::ReleaseClientResources:
+				releaseClientResources();
+				break;
+			case FrameKind::ClearClientSafetyArea:
+				ni_clientClearSafetyArea();
+				break;
+			default:
+				corrupt();
+			}
+		}
+		return nullptr;
+	}
+
+	// scratch copies made since the marks are copied back, the returned stack put (from 'at' in the payload), and the copies dropped
+	static void finishCall(Frame& reply, size_t at, uint64_t scratchMark, size_t copiesMark) {
+		auto base = client.channel->base;
+		for (auto i = copiesMark; i < client.copies.size(); i++) {
+			auto& copy = client.copies[i];
+			memcpy(copy.original, base + copy.offset, copy.size);
+		}
+		putIncoming(reply, at);
+		client.copies.resize(copiesMark);
+		client.scratchUsed = scratchMark;
+	}
+
+	static ni_ExceptionRef call(FrameKind kind, uint32_t flags, int32_t ref, int32_t id) {
+		std::lock_guard<std::recursive_mutex> guard(client.callLock);
+		auto scratchMark = client.scratchUsed;
+		auto copiesMark = client.copies.size();
+		encodeStack(client.out, fixOutgoing);
+		checkScratch();
+		send({ kind, flags, ref, id, 0 });
+		auto reply = awaitReturn();
+		if (!reply) {
+			lost();
+		}
+		auto exception = (ni_ExceptionRef)ni_getRefByIndex(ni_RefException, reply->header.ref);
+		finishCall(*reply, 0, scratchMark, copiesMark);
+		return exception;
+	}
+
+	bool start(const char* hostPath) {
+		auto channel = std::make_unique<Channel>();
+		if (!channel->create(heapSize(), scratchSize())) {
+			return false;
+		}
+		// (the memfd is close-on-exec, the dup2 onto HostFd isn't - unless it's already there, when dup2 does nothing)
+		auto fd = channel->handle();
+		auto moved = -1;
+		if (fd == HostFd) {
+			fd = moved = fcntl(fd, F_DUPFD_CLOEXEC, HostFd + 1);
+		}
+		posix_spawn_file_actions_t actions;
+		posix_spawn_file_actions_init(&actions);
+		posix_spawn_file_actions_adddup2(&actions, fd, HostFd);
+		char fdArg[16];
+		snprintf(fdArg, sizeof(fdArg), "%d", HostFd);
+		char* argv[] = { (char*)hostPath, (char*)"--ni-remote", fdArg, nullptr };
+		auto err = posix_spawn(&client.host, hostPath, &actions, nullptr, argv, environ);
+		posix_spawn_file_actions_destroy(&actions);
+		if (moved >= 0) {
+			close(moved);
+		}
+		if (err != 0) {
+			fprintf(stderr, "ni remote: couldn't start %s: %s\n", hostPath, strerror(err));
+			return false;
+		}
+		channel->setPeerAlive(&hostAlive);
+		if (channel->awaitHostState() != HostReady) {
+			fprintf(stderr, "ni remote: the host (%s) failed to start\n", hostPath);
+			if (!channel->gone()) {
+				waitpid(client.host, &client.hostStatus, 0);
+			}
+			return false;
+		}
+		client.channel = std::move(channel);
+		active = true;
+		return true;
+	}
+
+	void stop() {
+		if (!connected()) {
+			return;
+		}
+		{
+			std::lock_guard<std::recursive_mutex> guard(client.callLock);
+			client.out.clear();
+			// (a host that's already gone is fine here)
+			if (client.channel->send(ToHost, { FrameKind::Shutdown, 0, -1, 0, 0 }, nullptr, 0, nullptr, 0)) {
+				awaitReturn();
+			}
+			active = false;
+		}
+		if (!client.channel->gone()) {
+			waitpid(client.host, &client.hostStatus, 0);
+		}
+		client.channel.reset();
+	}
+
+	void setHostLostHandler(void (*handler)(int status)) {
+		client.hostLost = handler;
+	}
+
+	void setClientResourceReleaseBatch(niClientResourceReleaseBatch clientResourceReleaseBatch) {
+		client.releaseBatch = clientResourceReleaseBatch;
+	}
+
+	void invokeModuleMethod(ni_ModuleMethodRef method) {
+		call(FrameKind::Invoke, 0, ni_getRefIndex(ni_RefModuleMethod, method), 0);
+	}
+
+	ni_ExceptionRef invokeModuleMethodWithExceptions(ni_ModuleMethodRef method) {
+		return call(FrameKind::Invoke, WithExceptions, ni_getRefIndex(ni_RefModuleMethod, method), 0);
+	}
+
+	void invokeInterfaceMethod(ni_InterfaceMethodRef method, int serverID) {
+		call(FrameKind::InvokeInterface, 0, ni_getRefIndex(ni_RefInterfaceMethod, method), serverID);
+	}
+
+	ni_ExceptionRef invokeInterfaceMethodWithExceptions(ni_InterfaceMethodRef method, int serverID) {
+		return call(FrameKind::InvokeInterface, WithExceptions, ni_getRefIndex(ni_RefInterfaceMethod, method), serverID);
+	}
+
+	void execServerFunc(int id) {
+		call(FrameKind::ExecServerFunc, 0, -1, id);
+	}
+
+	ni_ExceptionRef execServerFuncWithExceptions(int id) {
+		return call(FrameKind::ExecServerFunc, WithExceptions, -1, id);
+	}
+
+	void pushModuleConstants(ni_ModuleRef m) {
+		call(FrameKind::ModuleConstants, 0, ni_getRefIndex(ni_RefModule, m), 0);
+	}
+
+	int invokeBatch(const void* buffer, size_t length, ni_BatchResult* results, size_t maxResults) {
+		if (length % 8 != 0) {
+			return -1;
+		}
+		std::lock_guard<std::recursive_mutex> guard(client.callLock);
+		auto scratchMark = client.scratchUsed;
+		auto copiesMark = client.copies.size();
+		// (a copy, to turn the method refs into indices and the buffers into offsets)
+		client.out.resize(length / 8);
+		memcpy(client.out.data(), buffer, length);
+		auto valid = walkFrame(client.out.data(), length,
+			[](ni_BatchCommand& command) {
+				command.method = (ni_ModuleMethodRef)(intptr_t)ni_getRefIndex(ni_RefModuleMethod, command.method);
+			},
+			fixOutgoing);
+		if (takeScratchFull() || !valid) {
+			client.copies.resize(copiesMark);
+			client.scratchUsed = scratchMark;
+			return -1;
+		}
+		send({ FrameKind::Batch, results ? (uint32_t)HasResults : 0u, -1, (int32_t)maxResults, 0 });
+		auto reply = awaitReturn();
+		if (!reply) {
+			lost();
+		}
+		auto prefix = (const uint8_t*)reply->data();
+		auto executed = reply->header.length >= sizeof(BatchReturn) ? ((const BatchReturn*)prefix)->executed : -2;
+		size_t at = sizeof(BatchReturn);
+		if (executed < -1 || (executed > 0 && results && ((uint64_t)executed > maxResults
+			|| reply->header.length < at + (size_t)executed * sizeof(BatchReturnResult))))
+		{
+			corrupt();
+		}
+		if (results && executed > 0) {
+			auto returned = (const BatchReturnResult*)(prefix + at);
+			for (int64_t i = 0; i < executed; i++) {
+				results[i].exception = (ni_ExceptionRef)ni_getRefByIndex(ni_RefException, returned[i].exception);
+				results[i].returnCount = returned[i].returnCount;
+			}
+			at += (size_t)executed * sizeof(BatchReturnResult);
+		}
+		finishCall(*reply, at, scratchMark, copiesMark);
+		return (int)executed;
+	}
+
+	// one-way, so no call lock (these come from finalizer threads too)
+	void releaseServerResources(const int* ids, size_t count) {
+		static const int32_t padding = 0;
+		client.channel->send(ToHost, { FrameKind::ReleaseServerResources, 0, -1, (int32_t)count, 0 },
+			ids, count * sizeof(int), &padding, count % 2 ? sizeof(padding) : 0);
+	}
+
+	void clearServerSafetyArea() {
+		client.channel->send(ToHost, { FrameKind::ClearServerSafetyArea, 0, -1, 0, 0 }, nullptr, 0, nullptr, 0);
+	}
+
+	void dumpTables() {
+		client.channel->send(ToHost, { FrameKind::DumpTables, 0, -1, 0, 0 }, nullptr, 0, nullptr, 0);
+	}
+}
+
+#else
+
+namespace Remote {
+	bool start(const char*) {
+		fprintf(stderr, "ni remote: out-of-process mode is Linux only\n");
+		return false;
+	}
+	void stop() {}
+	void setHostLostHandler(void (*)(int)) {}
+	void setClientResourceReleaseBatch(niClientResourceReleaseBatch) {}
+	// (never connected, so none of these get called)
+	void invokeModuleMethod(ni_ModuleMethodRef) {}
+	ni_ExceptionRef invokeModuleMethodWithExceptions(ni_ModuleMethodRef) { return nullptr; }
+	void invokeInterfaceMethod(ni_InterfaceMethodRef, int) {}
+	ni_ExceptionRef invokeInterfaceMethodWithExceptions(ni_InterfaceMethodRef, int) { return nullptr; }
+	void execServerFunc(int) {}
+	ni_ExceptionRef execServerFuncWithExceptions(int) { return nullptr; }
+	void pushModuleConstants(ni_ModuleRef) {}
+	int invokeBatch(const void*, size_t, ni_BatchResult*, size_t) { return -1; }
+	void releaseServerResources(const int*, size_t) {}
+	void clearServerSafetyArea() {}
+	void dumpTables() {}
+}
+
+#endif // __linux__
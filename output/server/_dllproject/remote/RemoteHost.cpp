@@ -0,0 +1,324 @@
+#include "Remote.h"
+#include "RemoteChannel.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef __linux__
+
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <signal.h>
+#include <sys/prctl.h>
+#include <unistd.h>
+
+#include "../../cpp/QtTestingImpl/support/BufferPool.h"
+
+namespace Remote {
+	struct Host {
+		Channel channel;
+		pid_t client = -1;
+		std::thread::id servingThread;
+		std::vector<uint64_t> out;
+		Frame in;
+		bool shutdown = false;
+		// the heap section's free ranges, offset -> size (first fit, coalesced on free)
+		std::mutex heapLock;
+		std::map<uint64_t, uint64_t> heapFree;
+	};
+	// never destroyed: ServerBuffers still around at exit are released (into the heap) from other files' static destructors
+	static Host& host = *new Host();
+
+	// ServerBuffer blocks, from the heap section so that they can cross as offsets (see BufferPool::setSource)
+	static void* heapAllocate(size_t size) {
+		std::lock_guard<std::mutex> guard(host.heapLock);
+		for (auto it = host.heapFree.begin(); it != host.heapFree.end(); it++) {
+			if (it->second >= size) {
+				auto offset = it->first;
+				auto remaining = it->second - size;
+				host.heapFree.erase(it);
+				if (remaining > 0) {
+					host.heapFree[offset + size] = remaining;
+				}
+				return host.channel.base + offset;
+			}
+		}
+		return nullptr;
+	}
+
+	static void heapRelease(void* start, size_t size) {
+		std::lock_guard<std::mutex> guard(host.heapLock);
+		auto offset = host.channel.offsetOf(start);
+		auto next = host.heapFree.lower_bound(offset);
+		if (next != host.heapFree.end() && offset + size == next->first) {
+			size += next->second;
+			next = host.heapFree.erase(next);
+		}
+		if (next != host.heapFree.begin()) {
+			auto prev = std::prev(next);
+			if (prev->first + prev->second == offset) {
+				prev->second += size;
+				return;
+			}
+		}
+		host.heapFree[offset] = size;
+	}
+
+	static const BufferPool::Source heapSource{ &heapAllocate, &heapRelease };
+
+	// buffers on their way to the client have to be in the region (ie ServerBuffers, or the client's own coming back)
+	static void fixOutgoing(ni_BatchArg&, ni_BufferDescriptor& descriptor) {
+		descriptor.reserved = 0;
+		if (!descriptor.start) {
+			return;
+		}
+		if (!host.channel.contains(descriptor.start)) {
+			fprintf(stderr, "ni remote: a buffer outside of shared memory goes back to the client as null\n");
+			descriptor.start = nullptr;
+			return;
+		}
+		descriptor.start = (void*)(uintptr_t)host.channel.offsetOf(descriptor.start);
+		descriptor.reserved = StartIsOffset;
+	}
+
+	static void fixIncoming(ni_BatchArg&, ni_BufferDescriptor& descriptor) {
+		auto offset = (uint64_t)(uintptr_t)descriptor.start;
+		auto valid = descriptor.reserved == StartIsOffset && offset < host.channel.header->size;
+		descriptor.reserved = 0;
+		descriptor.start = valid ? host.channel.base + offset : nullptr;
+	}
+
+	// a client that talks nonsense isn't worth serving
+	[[noreturn]] static void corrupt() {
+		fprintf(stderr, "ni remote: corrupt frame from the client\n");
+		_exit(EXIT_FAILURE);
+	}
+
+	static void putIncoming() {
+		auto stack = host.in.payload.data();
+		auto length = (size_t)host.in.header.length;
+		if (!fixBuffers(stack, length, fixIncoming) || !ni_putStack(stack, length)) {
+			corrupt();
+		}
+	}
+
+	static void send(FrameKind kind, int32_t ref, int32_t id, const void* prefix = nullptr, size_t prefixLength = 0) {
+		encodeStack(host.out, fixOutgoing);
+		// (nobody to tell if the client's gone - the serve loop finds out on its next receive)
+		host.channel.send(ToClient, { kind, 0, ref, id, 0 }, prefix, prefixLength, host.out.data(), host.out.size() * 8);
+	}
+
+	static void reply(ni_ExceptionRef exception) {
+		send(FrameKind::Return, ni_getRefIndex(ni_RefException, exception), 0);
+	}
+
+	static void runBatch() {
+		// (the batch's arrays are pushed borrowed, so the payload has to outlive any frames received during it)
+		auto header = host.in.header;
+		auto batch = std::move(host.in.payload);
+		auto valid = walkFrame(batch.data(), header.length,
+			[](ni_BatchCommand& command) {
+				command.method = (ni_ModuleMethodRef)ni_getRefByIndex(ni_RefModuleMethod, (int)(intptr_t)command.method);
+			},
+			fixIncoming);
+		std::vector<ni_BatchResult> results((header.flags & HasResults) ? (size_t)header.id : 0);
+		BatchReturn ret{ -1 };
+		if (valid) {
+			ret.executed = ni_invokeBatch(batch.data(), header.length, (header.flags & HasResults) ? results.data() : nullptr, results.size());
+		}
+		std::vector<uint8_t> prefix((uint8_t*)&ret, (uint8_t*)(&ret + 1));
+		if ((header.flags & HasResults) && ret.executed > 0) {
+			for (int64_t i = 0; i < ret.executed; i++) {
+				BatchReturnResult result{ ni_getRefIndex(ni_RefException, results[i].exception), results[i].returnCount };
+				prefix.insert(prefix.end(), (uint8_t*)&result, (uint8_t*)(&result + 1));
+			}
+		}
+		send(FrameKind::Return, -1, 0, prefix.data(), prefix.size());
+	}
+
+	// serves the client until a CallbackReturn (when awaiting one: returned, its stack not yet put)
+	// or until it shuts the host down or goes away (null)
+	static Frame* serve(bool awaitingCallback) {
+		while (!host.shutdown && host.channel.receive(ToHost, host.in)) {
+			auto header = host.in.header;
+			auto withExceptions = (header.flags & WithExceptions) != 0;
+			switch (header.kind) {
+			case FrameKind::Invoke: {
+				auto method = (ni_ModuleMethodRef)ni_getRefByIndex(ni_RefModuleMethod, header.ref);
+				if (!method) {
+					corrupt();
+				}
+				putIncoming();
+				if (withExceptions) {
+					reply(ni_invokeModuleMethodWithExceptions(method));
+				}
+				else {
+					ni_invokeModuleMethod(method);
+					reply(nullptr);
+				}
+				break;
+			}
+			case FrameKind::InvokeInterface: {
+				auto method = (ni_InterfaceMethodRef)ni_getRefByIndex(ni_RefInterfaceMethod, header.ref);
+				if (!method) {
+					corrupt();
+				}
+				putIncoming();
+				if (withExceptions) {
+					reply(ni_invokeInterfaceMethodWithExceptions(method, header.id));
+				}
+				else {
+					ni_invokeInterfaceMethod(method, header.id);
+					reply(nullptr);
+				}
+				break;
+			}
+			case FrameKind::ExecServerFunc:
+				putIncoming();
+				if (withExceptions) {
+					reply(ni_invokeServerFuncWithExceptions(header.id));
+				}
+				else {
+					ni_invokeServerFunc(header.id);
+					reply(nullptr);
+				}
+				break;
+			case FrameKind::ModuleConstants:
+				putIncoming();
+				ni_pushModuleConstants((ni_ModuleRef)ni_getRefByIndex(ni_RefModule, header.ref));
+				reply(nullptr);
+				break;
+			case FrameKind::Batch:
+				runBatch();
+				break;
+			case FrameKind::Shutdown:
+				ni_nativeImplShutdown();
+				host.out.clear();
+				host.channel.send(ToClient, { FrameKind::Return, 0, -1, 0, 0 }, nullptr, 0, nullptr, 0);
+				host.shutdown = true;
+				break;
+			case FrameKind::ReleaseServerResources: {
+				auto count = (size_t)header.id;
+				if (count > header.length / sizeof(int)) {
+					corrupt();
+				}
+				ni_releaseServerResources((const int*)host.in.data(), count);
+				break;
+			}
+			case FrameKind::ClearServerSafetyArea:
+				ni_clearServerSafetyArea();
+				break;
+			case FrameKind::DumpTables:
+				ni_dumpTables();
+				break;
+			case FrameKind::CallbackReturn:
+				if (!awaitingCallback) {
+					corrupt();
+				}
+				return &host.in;
+			default:
+				corrupt();
+			}
+		}
+		return nullptr;
+	}
+
+	// the client's callbacks, as the library on this side sees them: over to the client and back
+	static void callback(FrameKind kind, int32_t ref, int32_t id) {
+		if (std::this_thread::get_id() != host.servingThread) {
+			fprintf(stderr, "ni remote: a callback to the client from a thread other than the host's main one was dropped\n");
+			return;
+		}
+		send(kind, ref, id);
+		auto returned = serve(true);
+		if (!returned) {
+			// (shut down or gone in the middle of it, either way there's no one to return to)
+			_exit(host.shutdown ? EXIT_SUCCESS : EXIT_FAILURE);
+		}
+		putIncoming();
+		if (auto exception = (ni_ExceptionRef)ni_getRefByIndex(ni_RefException, returned->header.ref)) {
+			ni_setException(exception);
+		}
+	}
+
+	static void funcExec(int id) {
+		callback(FrameKind::FuncExec, -1, id);
+	}
+
+	static void methodExec(ni_InterfaceMethodRef method, int objID) {
+		callback(FrameKind::MethodExec, ni_getRefIndex(ni_RefInterfaceMethod, method), objID);
+	}
+
+	// one-way, from any thread (the client gets to them during its next call)
+	static void resourceReleaseBatch(const int* ids, size_t count) {
+		static const int32_t padding = 0;
+		host.channel.send(ToClient, { FrameKind::ReleaseClientResources, 0, -1, (int32_t)count, 0 },
+			ids, count * sizeof(int), &padding, count % 2 ? sizeof(padding) : 0);
+	}
+
+	static void resourceRelease(int id) {
+		resourceReleaseBatch(&id, 1);
+	}
+
+	static void clearSafetyArea() {
+		host.channel.send(ToClient, { FrameKind::ClearClientSafetyArea, 0, -1, 0, 0 }, nullptr, 0, nullptr, 0);
+	}
+
+	bool isHostCommandLine(int argc, char** argv) {
+		return argc >= 3 && strcmp(argv[1], "--ni-remote") == 0;
+	}
+
+	int hostMain(int argc, char** argv) {
+		if (!isHostCommandLine(argc, argv)) {
+			fprintf(stderr, "usage: %s --ni-remote <fd> (started by the client, see NI_REMOTE_HOST)\n", argc > 0 ? argv[0] : "host");
+			return 2;
+		}
+		if (!host.channel.attach(atoi(argv[2]))) {
+			return 1;
+		}
+		// not outliving the client: killed along with it from here on, and if it's already gone, done
+		host.client = host.channel.header->clientPid;
+		prctl(PR_SET_PDEATHSIG, SIGKILL);
+		if (getppid() != host.client) {
+			return 1;
+		}
+		host.channel.setPeerAlive([] { return getppid() == host.client; });
+
+		ni_nativeImplInit(&funcExec, &methodExec, &resourceRelease, &clearSafetyArea);
+		ni_setClientResourceReleaseBatch(&resourceReleaseBatch);
+		for (int kind = 0; kind <= ni_RefStructType; kind++) {
+			if ((uint32_t)ni_getRefCount(kind) != host.channel.header->refCounts[kind]) {
+				fprintf(stderr, "ni remote: the host's library doesn't match the client's (registrations differ)\n");
+				host.channel.setHostState(HostFailed);
+				return 1;
+			}
+		}
+		host.heapFree[host.channel.header->heapOffset] = host.channel.header->heapSize;
+		BufferPool::setSource(&heapSource);
+		host.servingThread = std::this_thread::get_id();
+		host.channel.setHostState(HostReady);
+
+		serve(false);
+		return host.shutdown ? 0 : 1;
+	}
+}
+
+#else
+
+namespace Remote {
+	bool isHostCommandLine(int argc, char** argv) {
+		return argc >= 3 && strcmp(argv[1], "--ni-remote") == 0;
+	}
+
+	int hostMain(int, char**) {
+		fprintf(stderr, "ni remote: out-of-process mode is Linux only\n");
+		return 1;
+	}
+}
+
+#endif // __linux__
@@ -0,0 +1,131 @@
+// QtTestingStartup: time-to-first-window, measured the way a client gets there - loads the library, creates the application
+// and a MainWindow, shows it and lets it paint, with each step timed from the start of main
+// usage: QtTestingStartup [--eager] [--stats] [--timeline <path>]
+//   --eager: registers every module right after init (what nativeLibraryInit used to do), for comparing against the deferred default
+//   --stats / --timeline: the usual instrumentation, on from before the first lookup - registrations show up as <module>.__register
+// runs under the offscreen platform unless QT_QPA_PLATFORM says otherwise. one startup per run, repeat the process for a spread
+
+#include "../DirectExport.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#ifdef QT_CORE_LIB
+#include <QCoreApplication>
+#endif
+
+// nothing here hands the library anything of the client's, so there's nothing for it to call back into
+static void clientFuncExec(int id) {}
+static void clientMethodExec(ni_InterfaceMethodRef method, int objID) {}
+static void clientResourceRelease(int id) {}
+static void clientClearSafetyArea() {}
+
+using Clock = std::chrono::steady_clock;
+static Clock::time_point start;
+static Clock::time_point last;
+
+static void step(const char* name) {
+	auto now = Clock::now();
+	printf("%-28s %10.3f ms %10.3f ms since start\n", name,
+		std::chrono::duration<double, std::milli>(now - last).count(), std::chrono::duration<double, std::milli>(now - start).count());
+	last = now;
+}
+
+static ni_ModuleMethodRef method(const char* module, const char* name) {
+	auto m = getModule(module);
+	auto ret = m ? getModuleMethod(m, name) : nullptr;
+	if (!ret) {
+		fprintf(stderr, "QtTestingStartup: no %s.%s in the library\n", module, name);
+		exit(1);
+	}
+	return ret;
+}
+
+int main(int argc, char** argv) {
+	start = last = Clock::now();
+
+	bool eager = false;
+	bool stats = false;
+	const char* timelinePath = nullptr;
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "--eager")) {
+			eager = true;
+		}
+		else if (!strcmp(argv[i], "--stats")) {
+			stats = true;
+		}
+		else if (!strcmp(argv[i], "--timeline") && i + 1 < argc) {
+			timelinePath = argv[++i];
+		}
+		else {
+			fprintf(stderr, "usage: QtTestingStartup [--eager] [--stats] [--timeline <path>]\n");
+			return 2;
+		}
+	}
+
+	if (!getenv("QT_QPA_PLATFORM")) {
+#ifdef _WIN32
+		_putenv_s("QT_QPA_PLATFORM", "offscreen");
+#else
+		setenv("QT_QPA_PLATFORM", "offscreen", 1);
+#endif
+	}
+
+	nativeImplInit(&clientFuncExec, &clientMethodExec, &clientResourceRelease, &clientClearSafetyArea);
+	setProfiling(stats);
+	if (timelinePath) {
+		setTimeline(true);
+	}
+	step("nativeImplInit");
+
+	if (eager) {
+		// (enumerating registers everything that's still deferred)
+		auto count = getModuleCount();
+		step("register all modules");
+		printf("(%d modules)\n", count);
+	}
+
+	// the lookups are part of it, they're where deferred registration happens
+	const char* args[] = { argv[0] };
+	size_t argLengths[] = { strlen(argv[0]) };
+	pushStringArray(args, argLengths, 1);
+	invokeModuleMethod(method("Application", "create"));
+	auto app = popPtr();
+	step("Application.create");
+
+	pushNull(); // no signal handler
+	invokeModuleMethod(method("MainWindow", "create"));
+	auto window = popPtr();
+	step("MainWindow.create");
+
+	pushPtr(window);
+	invokeModuleMethod(method("Widget", "Handle_show"));
+	step("Widget.Handle_show");
+
+#ifdef QT_CORE_LIB
+	// the expose and first paint
+	QCoreApplication::processEvents();
+	step("first paint");
+#endif
+	printf("time to first window: %.3f ms\n", std::chrono::duration<double, std::milli>(last - start).count());
+
+	if (stats) {
+		std::vector<char> buffer(getStats(ni_StatsText, nullptr, 0) + 1);
+		getStats(ni_StatsText, buffer.data(), buffer.size());
+		printf("%s", buffer.data());
+	}
+	if (timelinePath && !writeTimeline(timelinePath)) {
+		fprintf(stderr, "QtTestingStartup: couldn't write %s\n", timelinePath);
+	}
+	fflush(stdout);
+
+	pushPtr(window);
+	invokeModuleMethod(method("MainWindow", "Handle_dispose"));
+	pushPtr(app);
+	invokeModuleMethod(method("Application", "Handle_dispose"));
+	nativeImplShutdown();
+	return 0;
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+// minimal in-tree benchmark harness
+// cases register themselves with BENCH_CASE, main() runs every case whose name contains the filter
+// usage: nibench [filter] [--json <path>] - the json is Google Benchmark's format, for tracking results across releases
+
+struct BenchCase {
+	const char* name;
+	void (*func)();
+};
+
+std::vector<BenchCase>& benchCases();
+
+struct BenchRegistrar {
+	BenchRegistrar(const char* name, void (*func)()) {
+		benchCases().push_back({ name, func });
+	}
+};
+
+#define BENCH_CASE(name) \
+	static void name(); \
+	static BenchRegistrar name##__registrar(#name, &name); \
+	static void name()
+
+void benchReport(const char* name, double nsPerOp, uint64_t iterations);
+
+// the stub client's callbacks do nothing, unless a case puts something of its own here (and clears it again when done)
+// (ni_InterfaceMethodRef spelled out, this header goes with either the core's or the server's view of it)
+struct ni_InterfaceMethod;
+struct BenchClient {
+	void (*funcExec)(int id) = nullptr;
+	void (*methodExec)(ni_InterfaceMethod* method, int objID) = nullptr;
+};
+extern BenchClient benchClient;
+
+// keeps the optimizer from discarding a result
+template <typename T>
+inline void benchKeep(T const& value) {
+	asm volatile("" : : "r,m"(value) : "memory");
+}
+
+using BenchClock = std::chrono::steady_clock;
+
+inline double benchNanos(BenchClock::time_point start, BenchClock::time_point end) {
+	return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
+
+// runs op() in growing batches until a batch takes ~0.2s, then reports that batch's ns/op
+template <typename F>
+void benchLoop(const char* name, F&& op) {
+	for (uint64_t iterations = 1;; iterations *= 4) {
+		auto start = BenchClock::now();
+		for (uint64_t i = 0; i < iterations; i++) {
+			op();
+		}
+		auto ns = benchNanos(start, BenchClock::now());
+		if (ns > 2e8 || iterations >= (1ull << 40)) {
+			benchReport(name, ns / iterations, iterations);
+			return;
+		}
+	}
+}
+
+// for things that only happen once per process (startup)
+template <typename F>
+void benchOnce(const char* name, F&& op) {
+	auto start = BenchClock::now();
+	op();
+	benchReport(name, benchNanos(start, BenchClock::now()), 1);
+}
+
+// op(threadIndex) on numThreads threads at once, opsPerThread times each
+// reports wall-clock ns per op across all threads (so perfect scaling halves it with each doubling of threads)
+template <typename F>
+void benchThreads(const char* name, int numThreads, uint64_t opsPerThread, F&& op) {
+	std::atomic<int> ready = 0;
+	std::atomic<bool> go = false;
+	std::vector<std::thread> threads;
+	for (int t = 0; t < numThreads; t++) {
+		threads.emplace_back([&, t] {
+			ready++;
+			while (!go.load(std::memory_order_acquire)) {
+				std::this_thread::yield();
+			}
+			for (uint64_t i = 0; i < opsPerThread; i++) {
+				op(t);
+			}
+		});
+	}
+	while (ready.load() < numThreads) {
+		std::this_thread::yield();
+	}
+	auto start = BenchClock::now();
+	go.store(true, std::memory_order_release);
+	for (auto& thread : threads) {
+		thread.join();
+	}
+	auto ops = opsPerThread * numThreads;
+	benchReport(name, benchNanos(start, BenchClock::now()) / ops, ops);
+}
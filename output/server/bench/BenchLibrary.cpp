@@ -0,0 +1,120 @@
+#include "BenchLibrary.h"
+
+#include "NativeImplCore.h"
+
+#include <deque>
+#include <string>
+#include <utility>
+
+namespace BenchLibrary {
+	static std::vector<Module> registered;
+
+	const std::vector<Module>& modules() {
+		return registered;
+	}
+
+	// registered names aren't copied by the core, so they're kept here for the life of the process
+	static const char* keepName(std::string name) {
+		static std::deque<std::string> names;
+		return names.emplace_back(std::move(name)).c_str();
+	}
+
+	static void nop() {}
+
+	template <int N>
+	static void sumArgs() {
+		int32_t sum = 0;
+		for (int i = 0; i < N; i++) {
+			sum += ni_popInt32();
+		}
+		ni_pushInt32(sum);
+	}
+
+	static void sumArray() {
+		const int32_t* values;
+		size_t count;
+		ni_popInt32ArrayView(&values, &count);
+		int32_t sum = 0;
+		for (size_t i = 0; i < count; i++) {
+			sum += values[i];
+		}
+		ni_pushInt32(sum);
+	}
+
+	static void callBack() {
+		ni_clientFuncExec(ni_popInt32());
+	}
+
+	template <int... N>
+	static void registerCalls(std::integer_sequence<int, N...>) {
+		auto m = ni_registerModule("BenchCalls");
+		(ni_registerModuleMethod(m, keepName("args" + std::to_string(N)), &sumArgs<N>), ...);
+		ni_registerModuleMethod(m, "sumArray", &sumArray);
+		ni_registerModuleMethod(m, "callBack", &callBack);
+		ni_registerModuleMethod(m, "returnClientObject", &returnClientObject);
+	}
+	static void nopInterface(int) {}
+
+	static void describe() {
+		for (int i = 0; i < NumModules; i++) {
+			Module m;
+			m.name = keepName("BenchModule" + std::to_string(i));
+			auto numMethods = 4 + (i * 37) % 60;
+			for (int j = 0; j < numMethods; j++) {
+				m.methods.push_back(keepName(j < 2 ? (j == 0 ? "create" : "createNoHandler") : "Handle_method" + std::to_string(j)));
+			}
+			if (i % 2 == 0) {
+				Interface iface{ "SignalHandler", {} };
+				for (int j = 0; j < 6 + i % 20; j++) {
+					iface.methods.push_back(keepName("signal" + std::to_string(j)));
+				}
+				m.interfaces.push_back(iface);
+			}
+			if (i % 7 == 0) {
+				m.exceptions.push_back("BenchException");
+			}
+			registered.push_back(m);
+		}
+	}
+}
+
+using namespace BenchLibrary;
+
+// same calls the generated __register() functions make
+template <int I>
+static int registerModule() {
+	auto& desc = registered[I];
+	std::vector<ni_ModuleMethodEntry> entries;
+	for (auto name : desc.methods) {
+		entries.push_back({ name, &nop });
+	}
+	auto m = ni_registerModule(desc.name);
+	ni_registerModuleMethods(m, entries.data(), entries.size());
+	for (auto& iface : desc.interfaces) {
+		auto ifaceRef = ni_registerInterface(m, iface.name);
+		for (auto name : iface.methods) {
+			ni_registerInterfaceMethod(ifaceRef, name, &nopInterface);
+		}
+	}
+	for (auto name : desc.exceptions) {
+		ni_registerException(m, name, &nop);
+	}
+	return 0;
+}
+
+// like generated/Library.cpp's module table, with everything depending on the first module (as they do on Common there)
+template <int... I>
+static void registerModuleTable(std::integer_sequence<int, I...>) {
+	static const char* const dependencies[] = { registered[0].name, nullptr };
+	static const ni_ModuleDescriptor table[] = { { registered[I].name, &registerModule<I>, I > 0 ? dependencies : nullptr }... };
+	ni_registerModuleDescriptors(table, sizeof(table) / sizeof(table[0]));
+}
+
+extern "C" int nativeLibraryInit() {
+	describe();
+	registerModuleTable(std::make_integer_sequence<int, NumModules>());
+	registerCalls(std::make_integer_sequence<int, MaxCallArgs + 1>());
+	return 0;
+}
+
+extern "C" void nativeLibraryShutdown() {}
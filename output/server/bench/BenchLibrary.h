@@ -0,0 +1,28 @@
+#pragma once
+
+#include <vector>
+
+// stand-in for generated/Library.cpp: roughly the same shape (module count, methods per module, signal handler interfaces)
+// but with made-up names, and every method a no-op
+namespace BenchLibrary {
+	struct Interface {
+		const char* name;
+		std::vector<const char*> methods;
+	};
+	struct Module {
+		const char* name;
+		std::vector<const char*> methods;
+		std::vector<Interface> interfaces;
+		std::vector<const char*> exceptions;
+	};
+	// nativeLibraryInit's module table, in table order - registered on first lookup, as generated/Library.cpp's are
+	constexpr int NumModules = 54;
+	const std::vector<Module>& modules();
+
+	// plus, outside of the above (registered up front), a module for the round trip cases: "BenchCalls", whose methods "args0" to "args8"
+	// pop that many int32s and push their sum, "sumArray" does the same for an int32 array,
+	// and "callBack" pops a client function id and calls it (no args)
+	constexpr int MaxCallArgs = 8;
+	// also "returnClientObject", which is this (in CallbackBench.cpp, which has the server support layer's view of things)
+	void returnClientObject();
+}
@@ -0,0 +1,118 @@
+#include "Bench.h"
+#include "BenchLibrary.h"
+
+#include "NativeImplCore.h"
+#include "../_dllproject/remote/Remote.h"
+
+#include <cstring>
+#include <ctime>
+#include <string>
+
+std::vector<BenchCase>& benchCases() {
+	static std::vector<BenchCase> cases;
+	return cases;
+}
+
+struct BenchResult {
+	std::string name;
+	double nsPerOp;
+	uint64_t iterations;
+};
+static std::vector<BenchResult> results;
+
+void benchReport(const char* name, double nsPerOp, uint64_t iterations) {
+	printf("%-48s %14.1f ns/op %14llu iterations\n", name, nsPerOp, (unsigned long long)iterations);
+	fflush(stdout);
+	results.push_back({ name, nsPerOp, iterations });
+}
+
+static std::string jsonString(const std::string& str) {
+	std::string ret = "\"";
+	for (auto c : str) {
+		if (c == '"' || c == '\\') {
+			ret += '\\';
+		}
+		ret += c;
+	}
+	return ret + "\"";
+}
+
+// Google Benchmark's --benchmark_format=json layout, so its compare.py (and anything else that reads it) works on these
+// (only wall-clock time is measured, cpu_time repeats it)
+static bool writeJson(const char* path, const char* executable) {
+	auto f = fopen(path, "wb");
+	if (!f) {
+		return false;
+	}
+	char date[64];
+	auto now = time(nullptr);
+	strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", localtime(&now));
+#ifdef NDEBUG
+	auto buildType = "release";
+#else
+	auto buildType = "debug";
+#endif
+	fprintf(f, "{\n  \"context\": {\n    \"date\": %s,\n    \"executable\": %s,\n    \"num_cpus\": %u,\n    \"library_build_type\": \"%s\"\n  },\n  \"benchmarks\": [",
+		jsonString(date).c_str(), jsonString(executable).c_str(), std::thread::hardware_concurrency(), buildType);
+	for (size_t i = 0; i < results.size(); i++) {
+		auto& r = results[i];
+		auto name = jsonString(r.name);
+		fprintf(f, "%s\n    {\"name\": %s, \"run_name\": %s, \"run_type\": \"iteration\", \"iterations\": %llu, \"real_time\": %.3f, \"cpu_time\": %.3f, \"time_unit\": \"ns\"}",
+			i > 0 ? "," : "", name.c_str(), name.c_str(), (unsigned long long)r.iterations, r.nsPerOp, r.nsPerOp);
+	}
+	fprintf(f, "\n  ]\n}\n");
+	return fclose(f) == 0;
+}
+
+// stub client side
+BenchClient benchClient;
+
+static void clientFuncExec(int id) {
+	if (benchClient.funcExec) {
+		benchClient.funcExec(id);
+	}
+}
+static void clientMethodExec(ni_InterfaceMethodRef method, int objID) {
+	if (benchClient.methodExec) {
+		benchClient.methodExec(method, objID);
+	}
+}
+static void clientResourceRelease(int) {}
+static void clientClearSafetyArea() {}
+
+int main(int argc, char** argv) {
+	// started as the host of RemoteBench.cpp's out-of-process cases
+	if (Remote::isHostCommandLine(argc, argv)) {
+		return Remote::hostMain(argc, argv);
+	}
+
+	const char* filter = "";
+	const char* jsonPath = nullptr;
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "--json") && i + 1 < argc) {
+			jsonPath = argv[++i];
+		}
+		else {
+			filter = argv[i];
+		}
+	}
+
+	// library registration happens in here, so it's measured on its own
+	benchOnce("startup/nativeImplInit", [] {
+		ni_nativeImplInit(&clientFuncExec, &clientMethodExec, &clientResourceRelease, &clientClearSafetyArea);
+	});
+
+	for (auto& c : benchCases()) {
+		if (strstr(c.name, filter)) {
+			c.func();
+		}
+	}
+
+	ni_nativeImplShutdown();
+
+	if (jsonPath && !writeJson(jsonPath, argv[0])) {
+		fprintf(stderr, "couldn't write %s\n", jsonPath);
+		return 1;
+	}
+	return 0;
+}
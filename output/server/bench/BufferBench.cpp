@@ -0,0 +1,28 @@
+#include "Bench.h"
+
+#include "NativeImplServer.h"
+
+#include <cstring>
+
+// a per-frame buffer's life: created, filled (the first touch of each page is where fresh memory costs), and released
+// pooled (the default) against malloc-like allocation every time
+
+static const size_t frameSizes[] = { 64 * 1024, 1024 * 1024, 32 * 1024 * 1024 };
+
+BENCH_CASE(server_buffer) {
+	char name[64];
+	for (auto size : frameSizes) {
+		for (auto reuse : { BufferPool::Reuse::Pooled, BufferPool::Reuse::None }) {
+			auto pooled = reuse == BufferPool::Reuse::Pooled;
+			snprintf(name, sizeof(name), "buffer/create+fill+release %zuKB (%s)", size / 1024, pooled ? "pooled" : "no reuse");
+			benchLoop(name, [&] {
+				ServerBuffer<uint8_t> buffer({ (int)size }, reuse);
+				size_t length;
+				memset(buffer.getSpan(&length), 1, size);
+			});
+		}
+	}
+	auto stats = BufferPool::stats();
+	printf("(buffer pool: %llu acquired, %llu reused, %zu bytes cached)\n", (unsigned long long)stats.acquired, (unsigned long long)stats.reused, stats.cachedBytes);
+	BufferPool::trim();
+}
@@ -0,0 +1,55 @@
+#include "Bench.h"
+#include "BenchLibrary.h"
+
+#include "NativeImplCore.h"
+
+#include <string>
+
+// round trips: the client invoking a module method with 0-8 args (BenchCalls.argsN, see BenchLibrary.h)
+// (the other direction is in CallbackBench.cpp)
+
+BENCH_CASE(invoke_args) {
+	char name[64];
+	auto m = ni_getModule("BenchCalls");
+	for (int n = 0; n <= BenchLibrary::MaxCallArgs; n++) {
+		auto method = ni_getModuleMethod(m, ("args" + std::to_string(n)).c_str());
+		snprintf(name, sizeof(name), "invoke/module method, %d int32 args", n);
+		benchLoop(name, [&] {
+			for (int i = 0; i < n; i++) {
+				ni_pushInt32(i);
+			}
+			ni_invokeModuleMethod(method);
+			benchKeep(ni_popInt32());
+		});
+	}
+	// methods declared as throwing go through the exception-checking entry point instead
+	for (int n : { 1, 4, 8 }) {
+		auto method = ni_getModuleMethod(m, ("args" + std::to_string(n)).c_str());
+		snprintf(name, sizeof(name), "invoke/module method, %d int32 args + exceptions", n);
+		benchLoop(name, [&] {
+			for (int i = 0; i < n; i++) {
+				ni_pushInt32(i);
+			}
+			benchKeep(ni_invokeModuleMethodWithExceptions(method));
+			benchKeep(ni_popInt32());
+		});
+	}
+}
+
+// what a @fastcall export does instead (see _dllproject/FastCallExport.h): the same frame around the call, the arguments
+// and result straight through. called through a pointer, as the client would
+static int32_t sum4(int32_t a, int32_t b, int32_t c, int32_t d) {
+	return a + b + c + d;
+}
+
+BENCH_CASE(invoke_direct) {
+	static int32_t (*volatile direct)(int32_t, int32_t, int32_t, int32_t) = &sum4;
+	benchLoop("invoke/direct call, 4 int32 args", [&] {
+		int32_t ret = 0;
+		if (ni_beginDirectCall()) {
+			ret = direct(0, 1, 2, 3);
+			ni_endDirectCall();
+		}
+		benchKeep(ret);
+	});
+}
@@ -0,0 +1,96 @@
+#include "Bench.h"
+#include "BenchLibrary.h"
+
+#include "NativeImplServer.h"
+
+#include <cstdlib>
+
+// round trips the other way: the server calling an interface method on a client object, with the stub client on the other end
+
+// client-side lookups, not in the server's view of the core (CoreStuff.h)
+extern "C" ni_ModuleRef ni_getModule(const char* name);
+extern "C" ni_InterfaceRef ni_getInterface(ni_ModuleRef m, const char* name);
+extern "C" ni_InterfaceMethodRef ni_getInterfaceMethod(ni_InterfaceRef iface, const char* name);
+extern "C" ni_ModuleMethodRef ni_getModuleMethod(ni_ModuleRef m, const char* name);
+extern "C" void ni_invokeModuleMethod(ni_ModuleMethodRef method);
+extern "C" void ni_setClientResourceReleaseBatch(void (*clientResourceReleaseBatch)(const int* ids, size_t count));
+
+// what the generated client-side interface method dispatch does with the args it's handed
+static void popTwoArgs(ni_InterfaceMethodRef, int) {
+	benchKeep(ni_popInt32());
+	const char* str;
+	size_t length;
+	ni_popStringView(&str, &length);
+	benchKeep(str);
+}
+
+BENCH_CASE(client_object_invoke) {
+	// any registered interface method will do, the stub client doesn't look at it
+	auto m = ni_getModule(BenchLibrary::modules()[0].name);
+	auto& iface = BenchLibrary::modules()[0].interfaces[0];
+	auto method = ni_getInterfaceMethod(ni_getInterface(m, iface.name), iface.methods[0]);
+	ClientObject obj(1);
+
+	benchLoop("callback/invokeMethod, no args", [&] {
+		obj.invokeMethod(method);
+	});
+	benchLoop("callback/invokeMethodWithExceptions, no args", [&] {
+		obj.invokeMethodWithExceptions(method);
+	});
+	benchClient.methodExec = &popTwoArgs;
+	benchLoop("callback/invokeMethod, int32 + string args", [&] {
+		ni_pushString("valueChanged", 12);
+		ni_pushInt32(42);
+		obj.invokeMethod(method);
+	});
+	benchClient.methodExec = nullptr;
+}
+
+// returns a client object that nothing on this side holds on to, so only the safety area keeps its proxy alive until the client
+// has popped it - and drops another one along the way, so the invocation ends by handing the client a release
+void BenchLibrary::returnClientObject() {
+	auto returned = std::make_shared<ClientObject>(ni_popInt32());
+	std::make_shared<ClientObject>(ni_popInt32()); // (its release is queued until the invocation ends)
+	returned->push(returned, true);
+}
+
+static ni_ModuleMethodRef callInMethod;
+static int returnedId;
+static bool returnedReleased;
+
+// the client's release handler, which is free to make calls of its own
+static void releaseAndCallIn(const int* ids, size_t count) {
+	for (size_t i = 0; i < count; i++) {
+		returnedReleased = returnedReleased || ids[i] == returnedId;
+	}
+	ni_pushInt32(0);
+	ni_invokeModuleMethod(callInMethod);
+	benchKeep(ni_popInt32());
+}
+
+BENCH_CASE(client_release_callin) {
+	auto m = ni_getModule("BenchCalls");
+	auto method = ni_getModuleMethod(m, "returnClientObject");
+	callInMethod = ni_getModuleMethod(m, "args1");
+	ni_setClientResourceReleaseBatch(&releaseAndCallIn);
+
+	// the release handler's call comes before the client has popped the returned object: it mustn't have been released by then
+	returnedId = 1;
+	returnedReleased = false;
+	ni_pushInt32(2);
+	ni_pushInt32(returnedId);
+	ni_invokeModuleMethod(method);
+	bool isClientId;
+	if (ni_popInstance(&isClientId) != returnedId || returnedReleased) {
+		fprintf(stderr, "callback/release handler calling in: the returned client object was released before it was popped\n");
+		exit(1);
+	}
+
+	benchLoop("callback/return a client object, release handler calling in", [&] {
+		ni_pushInt32(2);
+		ni_pushInt32(returnedId);
+		ni_invokeModuleMethod(method);
+		benchKeep(ni_popInstance(&isClientId));
+	});
+	ni_setClientResourceReleaseBatch(nullptr);
+}
@@ -0,0 +1,171 @@
+#include "Bench.h"
+
+#include "NativeImplCore.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// a push and the matching pop of each stack item type, on the calling thread's stack with no invocation in between
+// (the marshaling cost alone - the round trip cases are in CallBench.cpp)
+
+template <typename T>
+static void scalarCase(const char* name, void (*push)(T), T (*pop)()) {
+	T value{};
+	benchLoop(name, [&] {
+		push(value);
+		benchKeep(pop());
+	});
+}
+
+BENCH_CASE(marshal_scalar) {
+	scalarCase("marshal/ptr push+pop", &ni_pushPtr, &ni_popPtr);
+	scalarCase("marshal/size_t push+pop", &ni_pushSizeT, &ni_popSizeT);
+	scalarCase("marshal/bool push+pop", &ni_pushBool, &ni_popBool);
+	scalarCase("marshal/int8 push+pop", &ni_pushInt8, &ni_popInt8);
+	scalarCase("marshal/uint8 push+pop", &ni_pushUInt8, &ni_popUInt8);
+	scalarCase("marshal/int16 push+pop", &ni_pushInt16, &ni_popInt16);
+	scalarCase("marshal/uint16 push+pop", &ni_pushUInt16, &ni_popUInt16);
+	scalarCase("marshal/int32 push+pop", &ni_pushInt32, &ni_popInt32);
+	scalarCase("marshal/uint32 push+pop", &ni_pushUInt32, &ni_popUInt32);
+	scalarCase("marshal/int64 push+pop", &ni_pushInt64, &ni_popInt64);
+	scalarCase("marshal/uint64 push+pop", &ni_pushUInt64, &ni_popUInt64);
+	scalarCase("marshal/float push+pop", &ni_pushFloat, &ni_popFloat);
+	scalarCase("marshal/double push+pop", &ni_pushDouble, &ni_popDouble);
+}
+
+static const size_t arrayCounts[] = { 16, 4096 };
+
+// copied and borrowed pushes, each popped the way the generated code would (a copy / a view)
+template <typename T>
+static void arrayCases(const char* type, void (*push)(T*, size_t), void (*pushBorrowed)(const T*, size_t),
+	void (*pop)(T**, size_t*), void (*popView)(const T**, size_t*))
+{
+	char name[64];
+	for (auto count : arrayCounts) {
+		std::vector<T> values(count);
+		T* popped;
+		const T* viewed;
+		size_t poppedCount;
+		snprintf(name, sizeof(name), "marshal/%s[%zu] push+pop", type, count);
+		benchLoop(name, [&] {
+			push(values.data(), count);
+			pop(&popped, &poppedCount);
+			benchKeep(popped);
+		});
+		snprintf(name, sizeof(name), "marshal/%s[%zu] pushBorrowed+popView", type, count);
+		benchLoop(name, [&] {
+			pushBorrowed(values.data(), count);
+			popView(&viewed, &poppedCount);
+			benchKeep(viewed);
+		});
+	}
+}
+
+// (std::vector<bool> has no data(), so bools get a plain array of their own)
+static void boolArrayCases() {
+	char name[64];
+	for (auto count : arrayCounts) {
+		std::unique_ptr<bool[]> values(new bool[count]());
+		bool* popped;
+		const bool* viewed;
+		size_t poppedCount;
+		snprintf(name, sizeof(name), "marshal/bool[%zu] push+pop", count);
+		benchLoop(name, [&] {
+			ni_pushBoolArray(values.get(), count);
+			ni_popBoolArray(&popped, &poppedCount);
+			benchKeep(popped);
+		});
+		snprintf(name, sizeof(name), "marshal/bool[%zu] pushBorrowed+popView", count);
+		benchLoop(name, [&] {
+			ni_pushBoolArrayBorrowed(values.get(), count);
+			ni_popBoolArrayView(&viewed, &poppedCount);
+			benchKeep(viewed);
+		});
+		// the same bools bit-packed, as they cross from the generated code: as is, and packed/unpacked on either side
+		std::vector<uint64_t> words((count + 63) / 64);
+		const uint64_t* viewedWords;
+		snprintf(name, sizeof(name), "marshal/bits[%zu] push+popView", count);
+		benchLoop(name, [&] {
+			ni_pushBitArray(words.data(), count);
+			ni_popBitArrayView(&viewedWords, &poppedCount);
+			benchKeep(viewedWords);
+		});
+		snprintf(name, sizeof(name), "marshal/bits[%zu] pack+push+popView+unpack", count);
+		benchLoop(name, [&] {
+			ni_packBits(values.get(), count, ni_pushBitArrayInPlace(count));
+			ni_popBitArrayView(&viewedWords, &poppedCount);
+			ni_unpackBits(viewedWords, poppedCount, values.get());
+			benchKeep(values.get());
+		});
+	}
+}
+
+BENCH_CASE(marshal_array) {
+	arrayCases<void*>("ptr", &ni_pushPtrArray, &ni_pushPtrArrayBorrowed, &ni_popPtrArray, &ni_popPtrArrayView);
+	arrayCases<size_t>("size_t", &ni_pushSizeTArray, &ni_pushSizeTArrayBorrowed, &ni_popSizeTArray, &ni_popSizeTArrayView);
+	boolArrayCases();
+	arrayCases<int8_t>("int8", &ni_pushInt8Array, &ni_pushInt8ArrayBorrowed, &ni_popInt8Array, &ni_popInt8ArrayView);
+	arrayCases<uint8_t>("uint8", &ni_pushUInt8Array, &ni_pushUInt8ArrayBorrowed, &ni_popUInt8Array, &ni_popUInt8ArrayView);
+	arrayCases<int16_t>("int16", &ni_pushInt16Array, &ni_pushInt16ArrayBorrowed, &ni_popInt16Array, &ni_popInt16ArrayView);
+	arrayCases<uint16_t>("uint16", &ni_pushUInt16Array, &ni_pushUInt16ArrayBorrowed, &ni_popUInt16Array, &ni_popUInt16ArrayView);
+	arrayCases<int32_t>("int32", &ni_pushInt32Array, &ni_pushInt32ArrayBorrowed, &ni_popInt32Array, &ni_popInt32ArrayView);
+	arrayCases<uint32_t>("uint32", &ni_pushUInt32Array, &ni_pushUInt32ArrayBorrowed, &ni_popUInt32Array, &ni_popUInt32ArrayView);
+	arrayCases<int64_t>("int64", &ni_pushInt64Array, &ni_pushInt64ArrayBorrowed, &ni_popInt64Array, &ni_popInt64ArrayView);
+	arrayCases<uint64_t>("uint64", &ni_pushUInt64Array, &ni_pushUInt64ArrayBorrowed, &ni_popUInt64Array, &ni_popUInt64ArrayView);
+	arrayCases<float>("float", &ni_pushFloatArray, &ni_pushFloatArrayBorrowed, &ni_popFloatArray, &ni_popFloatArrayView);
+	arrayCases<double>("double", &ni_pushDoubleArray, &ni_pushDoubleArrayBorrowed, &ni_popDoubleArray, &ni_popDoubleArrayView);
+}
+
+static const size_t stringLengths[] = { 8, 256, 64 * 1024 };
+
+BENCH_CASE(marshal_string) {
+	char name[64];
+	for (auto length : stringLengths) {
+		std::string str(length, 'x');
+		const char* popped;
+		size_t poppedLength;
+		snprintf(name, sizeof(name), "marshal/string(%zu) push+pop", length);
+		benchLoop(name, [&] {
+			ni_pushString(str.data(), str.size());
+			ni_popString(&popped, &poppedLength);
+			benchKeep(popped);
+		});
+		snprintf(name, sizeof(name), "marshal/string(%zu) pushBorrowed+popView", length);
+		benchLoop(name, [&] {
+			ni_pushStringBorrowed(str.data(), str.size());
+			ni_popStringView(&popped, &poppedLength);
+			benchKeep(popped);
+		});
+		auto id = ni_internString(str.data(), str.size());
+		snprintf(name, sizeof(name), "marshal/string(%zu) pushInterned+popView", length);
+		benchLoop(name, [&] {
+			ni_pushInternedString(id);
+			benchKeep(ni_popStringViewInterned(&popped, &poppedLength));
+		});
+	}
+
+	// 16 short strings, about what a list model row or a file dialog filter list carries
+	std::vector<std::string> strings(16, std::string(16, 'x'));
+	std::vector<const char*> strs;
+	std::vector<size_t> lengths;
+	for (auto& str : strings) {
+		strs.push_back(str.data());
+		lengths.push_back(str.size());
+	}
+	const char** popped;
+	const char* const* viewed;
+	size_t* poppedLengths;
+	const size_t* viewedLengths;
+	size_t count;
+	benchLoop("marshal/string[16] push+pop", [&] {
+		ni_pushStringArray(strs.data(), lengths.data(), strs.size());
+		ni_popStringArray(&popped, &poppedLengths, &count);
+		benchKeep(popped);
+	});
+	benchLoop("marshal/string[16] pushBorrowed+popView", [&] {
+		ni_pushStringArrayBorrowed(strs.data(), lengths.data(), strs.size());
+		ni_popStringArrayView(&viewed, &viewedLengths, &count);
+		benchKeep(viewed);
+	});
+}
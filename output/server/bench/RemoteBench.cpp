@@ -0,0 +1,91 @@
+#include "Bench.h"
+#include "BenchLibrary.h"
+
+#include "NativeImplCore.h"
+#include "../_dllproject/remote/Remote.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// the same round trips in-process and out-of-process (see remote/Remote.h), the host being this executable run again
+// (main() hands over to Remote::hostMain when it's started as one)
+
+static void nopFunc(int) {}
+
+BENCH_CASE(remote_round_trip) {
+#ifdef __linux__
+	auto m = ni_getModule("BenchCalls");
+	auto args0 = ni_getModuleMethod(m, "args0");
+	auto args4 = ni_getModuleMethod(m, "args4");
+	auto sumArray = ni_getModuleMethod(m, "sumArray");
+	auto callBack = ni_getModuleMethod(m, "callBack");
+	std::vector<int32_t> array(1024, 1);
+	benchClient.funcExec = &nopFunc;
+
+	char name[96];
+	for (auto remote : { false, true }) {
+		if (remote && !Remote::start("/proc/self/exe")) {
+			break;
+		}
+		auto invoke = [remote](ni_ModuleMethodRef method) {
+			remote ? Remote::invokeModuleMethod(method) : ni_invokeModuleMethod(method);
+		};
+		auto mode = remote ? "out-of-process" : "in-process";
+		snprintf(name, sizeof(name), "remote/%s, no args", mode);
+		benchLoop(name, [&] {
+			invoke(args0);
+			benchKeep(ni_popInt32());
+		});
+		snprintf(name, sizeof(name), "remote/%s, 4 int32 args", mode);
+		benchLoop(name, [&] {
+			for (int i = 0; i < 4; i++) {
+				ni_pushInt32(i);
+			}
+			invoke(args4);
+			benchKeep(ni_popInt32());
+		});
+		snprintf(name, sizeof(name), "remote/%s, 4KB int32 array arg", mode);
+		benchLoop(name, [&] {
+			ni_pushInt32ArrayBorrowed(array.data(), array.size());
+			invoke(sumArray);
+			benchKeep(ni_popInt32());
+		});
+		snprintf(name, sizeof(name), "remote/%s, with a callback", mode);
+		benchLoop(name, [&] {
+			ni_pushInt32(1);
+			invoke(callBack);
+		});
+	}
+	Remote::stop();
+	benchClient.funcExec = nullptr;
+#endif
+}
+
+// a client buffer bigger than the scratch fails the batch it goes along on (-1, nothing run) rather than going across as null,
+// and the calls after it go through as usual (a check only, there's nothing worth timing)
+BENCH_CASE(remote_scratch_overflow) {
+#ifdef __linux__
+	if (!Remote::start("/proc/self/exe")) {
+		return;
+	}
+	auto args0 = ni_getModuleMethod(ni_getModule("BenchCalls"), "args0");
+	uint64_t shape[] = { (65 << 20) / sizeof(uint64_t) };
+	std::vector<uint64_t> big(shape[0]);
+	struct {
+		ni_BatchCommand command;
+		ni_BatchArg arg;
+		ni_BufferDescriptor descriptor;
+	} batch{ { args0, 1, 0 }, { ni_BatchBuffer, 1, 0, 1 }, {} };
+	ni_describeBuffer(&batch.descriptor, big.data(), sizeof(uint64_t), 1, shape);
+	auto executed = Remote::invokeBatch(&batch, sizeof(batch), nullptr, 0);
+	Remote::invokeModuleMethod(args0);
+	auto after = ni_popInt32();
+	Remote::stop();
+	if (executed != -1 || after != 0) {
+		fprintf(stderr, "remote/scratch overflow: an oversized client buffer didn't fail its batch\n");
+		exit(1);
+	}
+#endif
+}
@@ -0,0 +1,209 @@
+#include "Bench.h"
+
+#include "NativeImplServer.h"
+#include "ResourceTable.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+// server resource table: lookups and churn at increasing numbers of live resources
+// (the old std::map<int, shared_ptr> registry is run alongside for comparison)
+
+static const size_t liveCounts[] = { 1000, 64 * 1024, 1024 * 1024 };
+
+// random probe order, fixed up front so the loop itself is just the lookup
+static std::vector<int> shuffledIds(const std::vector<int>& ids) {
+	std::vector<int> probes(ids);
+	std::shuffle(probes.begin(), probes.end(), std::mt19937(1234));
+	return probes;
+}
+
+BENCH_CASE(resource_lookup) {
+	char name[64];
+	// the real thing: pushed ServerObjects, resolved the way the interface-method wrappers do
+	// (grown in place from one size to the next, and never released - releasing logs every call)
+	std::vector<std::shared_ptr<ServerObject>> objects;
+	std::vector<int> ids;
+	for (auto live : liveCounts) {
+		while (ids.size() < live) {
+			auto obj = std::make_shared<ServerObject>();
+			obj->push(obj, false);
+			bool isClientId;
+			ids.push_back(ni_popInstance(&isClientId));
+			objects.push_back(obj);
+		}
+		auto probes = shuffledIds(ids);
+		size_t next = 0;
+		snprintf(name, sizeof(name), "resource/getByID (%zu live)", live);
+		benchLoop(name, [&] {
+			benchKeep(ServerObject::getByID(probes[next]).get());
+			next = (next + 1) % probes.size();
+		});
+		// same slots one generation on (as after a release and reuse): has to come back null
+		snprintf(name, sizeof(name), "resource/getByID stale (%zu live)", live);
+		benchLoop(name, [&] {
+			benchKeep(ServerObject::getByID(probes[next] + (1 << ResourceTable<ServerResource>::IndexBits)).get());
+			next = (next + 1) % probes.size();
+		});
+
+		std::map<int, std::shared_ptr<ServerResource>> baseline;
+		for (size_t i = 0; i < ids.size(); i++) {
+			baseline[ids[i]] = objects[i];
+		}
+		snprintf(name, sizeof(name), "resource/std::map baseline (%zu live)", live);
+		benchLoop(name, [&] {
+			benchKeep(std::dynamic_pointer_cast<ServerObject>(baseline[probes[next]]).get());
+			next = (next + 1) % probes.size();
+		});
+	}
+}
+
+BENCH_CASE(resource_churn) {
+	char name[64];
+	for (auto live : liveCounts) {
+		// release a random live resource and add a new one in its place, keeping the live count steady
+		ResourceTable<ServerResource> table;
+		std::vector<int> ids;
+		for (size_t i = 0; i < live; i++) {
+			ids.push_back(table.add(std::make_shared<ServerObject>()));
+		}
+		auto replacement = std::make_shared<ServerObject>();
+		std::mt19937 rng(5678);
+		snprintf(name, sizeof(name), "resource/churn remove+add (%zu live)", live);
+		benchLoop(name, [&] {
+			auto& id = ids[rng() % ids.size()];
+			table.remove(id);
+			id = table.add(replacement);
+		});
+
+		std::map<int, std::shared_ptr<ServerResource>> baseline;
+		int nextId = 1;
+		for (auto& id : ids) {
+			id = nextId++;
+			baseline[id] = replacement;
+		}
+		snprintf(name, sizeof(name), "resource/std::map churn (%zu live)", live);
+		benchLoop(name, [&] {
+			auto& id = ids[rng() % ids.size()];
+			baseline.erase(id);
+			id = nextId++;
+			baseline[id] = replacement;
+		});
+	}
+}
+
+// client-side pop, not in the server's view of the core (CoreStuff.h)
+extern "C" int ni_popServerFunc();
+
+// worker threads hitting the (global, sharded) registry at once
+static const int threadCounts[] = { 1, 2, 4, 8 };
+
+BENCH_CASE(resource_threads) {
+	char name[64];
+	for (auto numThreads : threadCounts) {
+		// steady state churn: every thread replaces the oldest of its own 1024 live resources, and looks one up
+		ResourceTable<ServerResource> table;
+		auto item = std::make_shared<ServerObject>();
+		std::vector<std::vector<int>> rings(numThreads);
+		for (auto& ring : rings) {
+			for (int i = 0; i < 1024; i++) {
+				ring.push_back(table.add(item));
+			}
+		}
+		std::vector<size_t> cursors(numThreads * 16); // one per cache line
+		snprintf(name, sizeof(name), "resource/threads churn+get (%d threads)", numThreads);
+		benchThreads(name, numThreads, 1 << 20, [&](int t) {
+			auto& ring = rings[t];
+			auto& cursor = cursors[t * 16];
+			auto& id = ring[cursor++ & 1023];
+			table.remove(id);
+			id = table.add(item);
+			benchKeep(table.get(ring[(cursor * 7) & 1023]).get());
+		});
+	}
+	for (auto numThreads : threadCounts) {
+		// the real path: func vals created and pushed by the workers themselves, then resolved back (never released - that logs)
+		snprintf(name, sizeof(name), "resource/threads pushServerFuncVal (%d threads)", numThreads);
+		benchThreads(name, numThreads, 1 << 16, [](int) {
+			pushServerFuncVal([] {}, 0);
+			benchKeep(ServerFuncVal::getById(ni_popServerFunc()).get());
+		});
+	}
+}
+
+// the full lifetime of a returned object on the real path: pushed (and so registered) by the server,
+// popped by the client, and released again once the client's done with it
+BENCH_CASE(resource_push_release) {
+	auto obj = std::make_shared<ServerObject>();
+	benchLoop("resource/ServerObject push+release", [&] {
+		obj->push(obj, true);
+		bool isClientId;
+		ni_releaseServerResource(ni_popInstance(&isClientId));
+	});
+	// a second push of a live resource only bumps its count (and the extra ref is released again)
+	obj->push(obj, true);
+	bool isClientId;
+	auto id = ni_popInstance(&isClientId);
+	benchLoop("resource/ServerObject push+release (already live)", [&] {
+		obj->push(obj, true);
+		ni_popInstance(&isClientId);
+		ni_releaseServerResource(id);
+	});
+	ni_releaseServerResource(id);
+}
+
+// one resource pushed and released by every worker at once, so its refcount keeps going 0 -> 1 -> 0: each push has to hand
+// back an id that resolves (for as long as that ref's held), and once they're all released it's out of the table
+// (a check as much as a timing - run it under TSan too)
+BENCH_CASE(resource_threads_push_release) {
+	char name[96];
+	for (auto numThreads : threadCounts) {
+		auto obj = std::make_shared<ServerObject>();
+		std::atomic<int> unresolved = 0;
+		std::atomic<int> lastId = 0;
+		snprintf(name, sizeof(name), "resource/threads same ServerObject push+release (%d threads)", numThreads);
+		benchThreads(name, numThreads, 1 << 16, [&](int) {
+			obj->push(obj, true);
+			bool isClientId;
+			auto id = ni_popInstance(&isClientId);
+			if (ServerResource::getResourceById(id) != obj) {
+				unresolved++;
+			}
+			lastId.store(id, std::memory_order_relaxed);
+			ni_releaseServerResource(id);
+		});
+		if (unresolved > 0 || ServerResource::getResourceById(lastId)) {
+			fprintf(stderr, "%s: %d pushed ids didn't resolve, or the resource outlived its last release\n", name, unresolved.load());
+			exit(1);
+		}
+	}
+}
+
+// keyed func vals (signal handler lambdas, mostly) are looked up before anything is created
+BENCH_CASE(funcval_create) {
+	auto wrapper = [] {};
+	benchLoop("funcval/create (no key)", [&] {
+		benchKeep(ServerFuncVal::create(wrapper, 0).get());
+	});
+	// the one with this key has to be live for the dedupe to find it
+	pushServerFuncVal(wrapper, 12345);
+	auto id = ni_popServerFunc();
+	benchLoop("funcval/create (key, deduped)", [&] {
+		benchKeep(ServerFuncVal::create(wrapper, 12345).get());
+	});
+	size_t key = 1 << 20;
+	benchLoop("funcval/create (key, new)", [&] {
+		benchKeep(ServerFuncVal::create(wrapper, key++).get());
+	});
+	benchLoop("funcval/pushServerFuncVal (key, deduped)", [&] {
+		pushServerFuncVal(wrapper, 12345);
+		ni_releaseServerResource(ni_popServerFunc());
+	});
+	ni_releaseServerResource(id);
+}
@@ -0,0 +1,70 @@
+#include "Bench.h"
+#include "BenchLibrary.h"
+
+#include "NativeImplCore.h"
+
+// what a client does at startup: resolve every module, method, interface and exception by name
+static size_t resolveAllByName() {
+	size_t found = 0;
+	for (auto& desc : BenchLibrary::modules()) {
+		auto m = ni_getModule(desc.name);
+		found += m != nullptr;
+		for (auto name : desc.methods) {
+			found += ni_getModuleMethod(m, name) != nullptr;
+		}
+		for (auto& iface : desc.interfaces) {
+			auto ifaceRef = ni_getInterface(m, iface.name);
+			found += ifaceRef != nullptr;
+			for (auto name : iface.methods) {
+				found += ni_getInterfaceMethod(ifaceRef, name) != nullptr;
+			}
+		}
+		for (auto name : desc.exceptions) {
+			found += ni_getException(m, name) != nullptr;
+		}
+	}
+	return found;
+}
+
+static size_t resolveAllByOrdinal() {
+	size_t found = 0;
+	auto numModules = ni_getModuleCount();
+	for (int i = 0; i < numModules; i++) {
+		auto m = ni_getModuleByOrdinal(i);
+		auto numMethods = ni_getModuleMethodCount(m);
+		for (int j = 0; j < numMethods; j++) {
+			found += ni_getModuleMethodByOrdinal(m, j) != nullptr;
+		}
+	}
+	return found;
+}
+
+// nativeImplInit only takes the module table now, registration happens on first lookup (so this case has to come first,
+// before anything else has looked the modules up)
+BENCH_CASE(startup_deferred) {
+	auto& modules = BenchLibrary::modules();
+	// the dependency (module 0) and then the one asked for
+	benchOnce("startup/first getModule (registers 2)", [&] { benchKeep(ni_getModule(modules[27].name)); });
+	benchOnce("startup/first getModule (registers 1)", [&] { benchKeep(ni_getModule(modules[28].name)); });
+	// everything else, what nativeImplInit used to do up front
+	benchOnce("startup/registerAllModules", [] { ni_registerAllModules(); });
+}
+
+BENCH_CASE(startup_resolve) {
+	// the first pass also builds the name indexes
+	size_t found = 0;
+	benchOnce("startup/resolveAllByName (cold)", [&] { found = resolveAllByName(); });
+	benchKeep(found);
+	benchLoop("startup/resolveAllByName", [] { benchKeep(resolveAllByName()); });
+	benchLoop("startup/resolveAllByOrdinal", [] { benchKeep(resolveAllByOrdinal()); });
+}
+
+BENCH_CASE(lookup_single) {
+	auto& desc = BenchLibrary::modules()[27];
+	auto m = ni_getModule(desc.name);
+	auto methodName = desc.methods.back();
+	benchLoop("lookup/getModule", [&] { benchKeep(ni_getModule(desc.name)); });
+	benchLoop("lookup/getModuleMethod", [&] { benchKeep(ni_getModuleMethod(m, methodName)); });
+	benchLoop("lookup/getModuleMethod (missing)", [&] { benchKeep(ni_getModuleMethod(m, "Handle_noSuchMethod")); });
+	benchLoop("lookup/getModuleMethodByOrdinal", [&] { benchKeep(ni_getModuleMethodByOrdinal(m, 17)); });
+}
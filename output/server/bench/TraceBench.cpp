@@ -0,0 +1,19 @@
+#include "Bench.h"
+
+#include "NativeImplCore.h"
+
+// cost of a trace point on the hot paths: gated off (the default for debug-level events), and recording
+// (recording outruns the drain thread here, so most of those land as drops - which is the no-blocking path production would see under a flood)
+
+BENCH_CASE(trace) {
+	int32_t i = 0;
+	benchLoop("trace/debug event, level warn (off)", [&] {
+		NI_TRACE(ni_TraceDebug, ni_TraceServerResourceReleased, i++, 0);
+	});
+	ni_setTraceLevel(ni_TraceDebug);
+	benchLoop("trace/debug event, level debug (recorded)", [&] {
+		NI_TRACE(ni_TraceDebug, ni_TraceServerResourceReleased, i++, 0);
+	});
+	ni_setTraceLevel(ni_TraceWarn);
+	benchKeep(i);
+}
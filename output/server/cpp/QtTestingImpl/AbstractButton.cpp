@@ -50,7 +50,7 @@ namespace AbstractButton
         THIS->setShortcut(KeySequence::fromDeferred(seq));
     }
 
-    void Handle_setText(HandleRef _this, std::string text) {
-        THIS->setText(QString::fromStdString(text));
+    void Handle_setText(HandleRef _this, StringArg text) {
+        THIS->setText(toQString(text));
     }
 }
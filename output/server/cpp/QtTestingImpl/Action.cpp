@@ -4,6 +4,7 @@
 #include <QAction>
 
 #include "util/SignalStuff.h"
+#include "util/convert.h"
 
 #include "IconInternal.h"
 #include "KeySequenceInternal.h"
@@ -122,12 +123,12 @@ namespace Action
         THIS->setStatusTip(QString::fromStdString(tip));
     }
 
-    void Handle_setText(HandleRef _this, std::string text) {
-        THIS->setText(QString::fromStdString(text));
+    void Handle_setText(HandleRef _this, StringArg text) {
+        THIS->setText(toQString(text));
     }
 
-    void Handle_setToolTip(HandleRef _this, std::string tip) {
-        THIS->setToolTip(QString::fromStdString(tip));
+    void Handle_setToolTip(HandleRef _this, StringArg tip) {
+        THIS->setToolTip(toQString(tip));
     }
 
     void Handle_setVisible(HandleRef _this, bool visible) {
@@ -163,7 +163,7 @@ namespace ComboBox
         THIS->addItem(Icon::fromDeferred(icon), QString::fromStdString(text), Variant::fromDeferred(userData));
     }
 
-    void Handle_addItems(HandleRef _this, std::vector<std::string> texts) {
+    void Handle_addItems(HandleRef _this, StringArrayView texts) {
         THIS->addItems(toQStringList(texts));
     }
 
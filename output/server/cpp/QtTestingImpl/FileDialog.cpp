@@ -127,7 +127,7 @@ namespace FileDialog
         THIS->setOptions((QFileDialog::Options)opts);
     }
 
-    void Handle_setSupportedSchemes(HandleRef _this, std::vector<std::string> schemes) {
+    void Handle_setSupportedSchemes(HandleRef _this, StringArrayView schemes) {
         THIS->setSupportedSchemes(toQStringList(schemes));
     }
 
@@ -139,20 +139,12 @@ namespace FileDialog
         THIS->setNameFilter(QString::fromStdString(filter));
     }
 
-    void Handle_setNameFilters(HandleRef _this, std::vector<std::string> filters) {
-        QStringList qFilters;
-        for (auto &filter: filters) {
-            qFilters.append(QString::fromStdString(filter));
-        }
-        THIS->setNameFilters(qFilters);
+    void Handle_setNameFilters(HandleRef _this, StringArrayView filters) {
+        THIS->setNameFilters(toQStringList(filters));
     }
 
-    void Handle_setMimeTypeFilters(HandleRef _this, std::vector<std::string> filters) {
-        QStringList qFilters;
-        for (auto &filter: filters) {
-            qFilters.append(QString::fromStdString(filter));
-        }
-        THIS->setMimeTypeFilters(qFilters);
+    void Handle_setMimeTypeFilters(HandleRef _this, StringArrayView filters) {
+        THIS->setMimeTypeFilters(toQStringList(filters));
     }
 
     void Handle_setDirectory(HandleRef _this, std::string dir) {
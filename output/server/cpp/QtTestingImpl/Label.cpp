@@ -99,8 +99,8 @@ namespace Label
         return THIS->selectedText().toStdString();
     }
 
-    void Handle_setText(HandleRef _this, std::string text) {
-        THIS->setText(QString::fromStdString(text));
+    void Handle_setText(HandleRef _this, StringArg text) {
+        THIS->setText(toQString(text));
     }
 
     void Handle_setTextFormat(HandleRef _this, TextFormat format) {
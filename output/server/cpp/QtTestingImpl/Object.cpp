@@ -2,12 +2,14 @@
 
 #include <QObject>
 
+#include "util/convert.h"
+
 #define THIS ((QObject*)_this)
 
 namespace Object
 {
-    void Handle_setObjectName(HandleRef _this, std::string name) {
-        THIS->setObjectName(QString::fromStdString(name));
+    void Handle_setObjectName(HandleRef _this, StringArg name) {
+        THIS->setObjectName(toQString(name));
     }
 
     void Handle_dumpObjectTree(HandleRef _this) {
@@ -170,12 +170,8 @@ namespace PaintResources
         _this->qStroker.setDashPattern(Pen::toQtStyle(style));
     }
 
-    void PainterPathStroker_setDashPattern(PainterPathStrokerRef _this, std::vector<double> dashPattern) {
-        QList<qreal> qPattern;
-        for (auto &x : dashPattern) {
-            qPattern.push_back(x);
-        }
-        _this->qStroker.setDashPattern(qPattern);
+    void PainterPathStroker_setDashPattern(PainterPathStrokerRef _this, std::span<const double> dashPattern) {
+        _this->qStroker.setDashPattern(QList<qreal>(dashPattern.begin(), dashPattern.end()));
     }
 
     PainterPathRef PainterPathStroker_createStroke(PainterPathStrokerRef _this, PainterPathRef path) {
@@ -82,19 +82,15 @@ namespace Painter
         THIS->drawEllipse(toQPoint(center), rx, ry);
     }
 
-    void Handle_drawPolyline(HandleRef _this, std::vector<PointF> points) {
-        std::vector<QPointF> qPoints;
-        for (auto &p : points) {
-            qPoints.push_back(toQPointF(p));
-        }
-        THIS->drawPolyline(qPoints.data(), (int)qPoints.size());
-    }
-
-    void Handle_drawPolyline(HandleRef _this, std::vector<Point> points) {
-        std::vector<QPoint> qPoints;
-        for (auto &p : points) {
-            qPoints.push_back(toQPoint(p));
-        }
-        THIS->drawPolyline(qPoints.data(), (int)qPoints.size());
+    // our point structs are laid out exactly like Qt's, so the (possibly large) point lists can be handed over as-is
+    static_assert(sizeof(PointF) == sizeof(QPointF) && std::is_same_v<qreal, double>, "PointF/QPointF layout mismatch");
+    static_assert(sizeof(Point) == sizeof(QPoint), "Point/QPoint layout mismatch");
+
+    void Handle_drawPolyline(HandleRef _this, std::span<const PointF> points) {
+        THIS->drawPolyline(reinterpret_cast<const QPointF*>(points.data()), (int)points.size());
+    }
+
+    void Handle_drawPolyline(HandleRef _this, std::span<const Point> points) {
+        THIS->drawPolyline(reinterpret_cast<const QPoint*>(points.data()), (int)points.size());
     }
 }
@@ -242,16 +242,16 @@ namespace Widget
         THIS->setStatusTip(QString::fromStdString(tip));
     }
 
-    void Handle_setStyleSheet(HandleRef _this, std::string styles) {
-        THIS->setStyleSheet(QString::fromStdString(styles));
+    void Handle_setStyleSheet(HandleRef _this, StringArg styles) {
+        THIS->setStyleSheet(toQString(styles));
     }
 
     void Handle_setTabletTracking(HandleRef _this, bool state) {
         THIS->setTabletTracking(state);
     }
 
-    void Handle_setToolTip(HandleRef _this, std::string tip) {
-        THIS->setToolTip(QString::fromStdString(tip));
+    void Handle_setToolTip(HandleRef _this, StringArg tip) {
+        THIS->setToolTip(toQString(tip));
     }
 
     void Handle_setToolTipDuration(HandleRef _this, int32_t duration) {
@@ -298,8 +298,8 @@ namespace Widget
         THIS->setWindowOpacity(opacity);
     }
 
-    void Handle_setWindowTitle(HandleRef _this, std::string title) {
-        THIS->setWindowTitle(QString::fromStdString(title));
+    void Handle_setWindowTitle(HandleRef _this, StringArg title) {
+        THIS->setWindowTitle(toQString(title));
     }
 
     int32_t Handle_x(HandleRef _this) {
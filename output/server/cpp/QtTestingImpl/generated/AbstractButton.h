@@ -66,5 +66,5 @@ namespace AbstractButton
     void Handle_setIcon(HandleRef _this, std::shared_ptr<Icon::Deferred::Base> icon);
     void Handle_setIconSize(HandleRef _this, Common::Size size);
     void Handle_setShortcut(HandleRef _this, std::shared_ptr<KeySequence::Deferred::Base> seq);
-    void Handle_setText(HandleRef _this, std::string text);
+    void Handle_setText(HandleRef _this, StringArg text);
 }
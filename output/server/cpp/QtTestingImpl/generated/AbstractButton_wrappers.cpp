@@ -262,23 +262,26 @@ namespace AbstractButton
 
     void Handle_setText__wrapper() {
         auto _this = Handle__pop();
-        auto text = popStringInternal();
+        auto text = popStringArg();
         Handle_setText(_this, text);
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "Handle_setAutoExclusive", &Handle_setAutoExclusive__wrapper },
+            { "Handle_setAutoRepeat", &Handle_setAutoRepeat__wrapper },
+            { "Handle_setAutoRepeatDelay", &Handle_setAutoRepeatDelay__wrapper },
+            { "Handle_setAutoRepeatInterval", &Handle_setAutoRepeatInterval__wrapper },
+            { "Handle_setCheckable", &Handle_setCheckable__wrapper },
+            { "Handle_setChecked", &Handle_setChecked__wrapper },
+            { "Handle_setDown", &Handle_setDown__wrapper },
+            { "Handle_setIcon", &Handle_setIcon__wrapper },
+            { "Handle_setIconSize", &Handle_setIconSize__wrapper },
+            { "Handle_setShortcut", &Handle_setShortcut__wrapper },
+            { "Handle_setText", &Handle_setText__wrapper },
+        };
         auto m = ni_registerModule("AbstractButton");
-        ni_registerModuleMethod(m, "Handle_setAutoExclusive", &Handle_setAutoExclusive__wrapper);
-        ni_registerModuleMethod(m, "Handle_setAutoRepeat", &Handle_setAutoRepeat__wrapper);
-        ni_registerModuleMethod(m, "Handle_setAutoRepeatDelay", &Handle_setAutoRepeatDelay__wrapper);
-        ni_registerModuleMethod(m, "Handle_setAutoRepeatInterval", &Handle_setAutoRepeatInterval__wrapper);
-        ni_registerModuleMethod(m, "Handle_setCheckable", &Handle_setCheckable__wrapper);
-        ni_registerModuleMethod(m, "Handle_setChecked", &Handle_setChecked__wrapper);
-        ni_registerModuleMethod(m, "Handle_setDown", &Handle_setDown__wrapper);
-        ni_registerModuleMethod(m, "Handle_setIcon", &Handle_setIcon__wrapper);
-        ni_registerModuleMethod(m, "Handle_setIconSize", &Handle_setIconSize__wrapper);
-        ni_registerModuleMethod(m, "Handle_setShortcut", &Handle_setShortcut__wrapper);
-        ni_registerModuleMethod(m, "Handle_setText", &Handle_setText__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         auto signalHandler = ni_registerInterface(m, "SignalHandler");
         signalHandler_destroyed = ni_registerInterfaceMethod(signalHandler, "destroyed", &SignalHandler_destroyed__wrapper);
         signalHandler_objectNameChanged = ni_registerInterfaceMethod(signalHandler, "objectNameChanged", &SignalHandler_objectNameChanged__wrapper);
@@ -21,9 +21,9 @@ namespace AbstractItemModel
     }
 
     std::vector<PersistentModelIndex::HandleRef> __PersistentModelIndex_Handle_Array__pop() {
-        PersistentModelIndex::HandleRef *values;
+        PersistentModelIndex::HandleRef const *values;
         size_t count;
-        ni_popPtrArray((void***)&values, &count);
+        ni_popPtrArrayView((void* const**)&values, &count);
         return std::vector<PersistentModelIndex::HandleRef>(values, values + count);
     }
     void __ItemDataRole_Array__push(std::vector<ItemDataRole> values, bool isReturn) {
@@ -35,8 +35,9 @@ namespace AbstractItemModel
     }
 
     std::vector<ItemDataRole> __ItemDataRole_Array__pop() {
-        auto intValues = popInt8ArrayInternal();
+        auto intValues = popInt8ArrayView();
         std::vector<ItemDataRole> __ret;
+        __ret.reserve(intValues.size());
         for (auto i = intValues.begin(); i != intValues.end(); i++) {
             __ret.push_back((ItemDataRole)*i);
         }
@@ -455,9 +456,12 @@ namespace AbstractItemModel
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "Handle_index", &Handle_index__wrapper },
+            { "Handle_index_overload1", &Handle_index_overload1__wrapper },
+        };
         auto m = ni_registerModule("AbstractItemModel");
-        ni_registerModuleMethod(m, "Handle_index", &Handle_index__wrapper);
-        ni_registerModuleMethod(m, "Handle_index_overload1", &Handle_index_overload1__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         auto signalHandler = ni_registerInterface(m, "SignalHandler");
         signalHandler_destroyed = ni_registerInterfaceMethod(signalHandler, "destroyed", &SignalHandler_destroyed__wrapper);
         signalHandler_objectNameChanged = ni_registerInterfaceMethod(signalHandler, "objectNameChanged", &SignalHandler_objectNameChanged__wrapper);
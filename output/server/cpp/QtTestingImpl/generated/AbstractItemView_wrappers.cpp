@@ -386,24 +386,27 @@ namespace AbstractItemView
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "Handle_setAlternatingRowColors", &Handle_setAlternatingRowColors__wrapper },
+            { "Handle_setAutoScroll", &Handle_setAutoScroll__wrapper },
+            { "Handle_setAutoScrollMargin", &Handle_setAutoScrollMargin__wrapper },
+            { "Handle_setDefaultDropAction", &Handle_setDefaultDropAction__wrapper },
+            { "Handle_setDragDropMode", &Handle_setDragDropMode__wrapper },
+            { "Handle_setDragDropOverwriteMode", &Handle_setDragDropOverwriteMode__wrapper },
+            { "Handle_setDragEnabled", &Handle_setDragEnabled__wrapper },
+            { "Handle_setEditTriggers", &Handle_setEditTriggers__wrapper },
+            { "Handle_setHorizontalScrollMode", &Handle_setHorizontalScrollMode__wrapper },
+            { "Handle_setIconSize", &Handle_setIconSize__wrapper },
+            { "Handle_setSelectionBehavior", &Handle_setSelectionBehavior__wrapper },
+            { "Handle_setSelectionMode", &Handle_setSelectionMode__wrapper },
+            { "Handle_setDropIndicatorShown", &Handle_setDropIndicatorShown__wrapper },
+            { "Handle_setTabKeyNavigation", &Handle_setTabKeyNavigation__wrapper },
+            { "Handle_setTextElideMode", &Handle_setTextElideMode__wrapper },
+            { "Handle_setVerticalScrollMode", &Handle_setVerticalScrollMode__wrapper },
+            { "Handle_setModel", &Handle_setModel__wrapper },
+        };
         auto m = ni_registerModule("AbstractItemView");
-        ni_registerModuleMethod(m, "Handle_setAlternatingRowColors", &Handle_setAlternatingRowColors__wrapper);
-        ni_registerModuleMethod(m, "Handle_setAutoScroll", &Handle_setAutoScroll__wrapper);
-        ni_registerModuleMethod(m, "Handle_setAutoScrollMargin", &Handle_setAutoScrollMargin__wrapper);
-        ni_registerModuleMethod(m, "Handle_setDefaultDropAction", &Handle_setDefaultDropAction__wrapper);
-        ni_registerModuleMethod(m, "Handle_setDragDropMode", &Handle_setDragDropMode__wrapper);
-        ni_registerModuleMethod(m, "Handle_setDragDropOverwriteMode", &Handle_setDragDropOverwriteMode__wrapper);
-        ni_registerModuleMethod(m, "Handle_setDragEnabled", &Handle_setDragEnabled__wrapper);
-        ni_registerModuleMethod(m, "Handle_setEditTriggers", &Handle_setEditTriggers__wrapper);
-        ni_registerModuleMethod(m, "Handle_setHorizontalScrollMode", &Handle_setHorizontalScrollMode__wrapper);
-        ni_registerModuleMethod(m, "Handle_setIconSize", &Handle_setIconSize__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSelectionBehavior", &Handle_setSelectionBehavior__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSelectionMode", &Handle_setSelectionMode__wrapper);
-        ni_registerModuleMethod(m, "Handle_setDropIndicatorShown", &Handle_setDropIndicatorShown__wrapper);
-        ni_registerModuleMethod(m, "Handle_setTabKeyNavigation", &Handle_setTabKeyNavigation__wrapper);
-        ni_registerModuleMethod(m, "Handle_setTextElideMode", &Handle_setTextElideMode__wrapper);
-        ni_registerModuleMethod(m, "Handle_setVerticalScrollMode", &Handle_setVerticalScrollMode__wrapper);
-        ni_registerModuleMethod(m, "Handle_setModel", &Handle_setModel__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         auto signalHandler = ni_registerInterface(m, "SignalHandler");
         signalHandler_destroyed = ni_registerInterfaceMethod(signalHandler, "destroyed", &SignalHandler_destroyed__wrapper);
         signalHandler_objectNameChanged = ni_registerInterfaceMethod(signalHandler, "objectNameChanged", &SignalHandler_objectNameChanged__wrapper);
@@ -31,8 +31,9 @@ namespace AbstractListModel
     }
 
     std::vector<ItemDataRole> __ItemDataRole_Array__pop() {
-        auto intValues = popInt8ArrayInternal();
+        auto intValues = popInt8ArrayView();
         std::vector<ItemDataRole> __ret;
+        __ret.reserve(intValues.size());
         for (auto i = intValues.begin(); i != intValues.end(); i++) {
             __ret.push_back((ItemDataRole)*i);
         }
@@ -43,9 +44,9 @@ namespace AbstractListModel
     }
 
     std::vector<PersistentModelIndex::HandleRef> __PersistentModelIndex_Handle_Array__pop() {
-        PersistentModelIndex::HandleRef *values;
+        PersistentModelIndex::HandleRef const *values;
         size_t count;
-        ni_popPtrArray((void***)&values, &count);
+        ni_popPtrArrayView((void* const**)&values, &count);
         return std::vector<PersistentModelIndex::HandleRef>(values, values + count);
     }
     ni_InterfaceMethodRef signalHandler_destroyed;
@@ -679,18 +680,21 @@ namespace AbstractListModel
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "createSubclassed", &createSubclassed__wrapper },
+            { "Handle_getInteriorHandle", &Handle_getInteriorHandle__wrapper },
+            { "Handle_dispose", &Handle_dispose__wrapper },
+            { "Interior_emitDataChanged", &Interior_emitDataChanged__wrapper },
+            { "Interior_emitHeaderDataChanged", &Interior_emitHeaderDataChanged__wrapper },
+            { "Interior_beginInsertRows", &Interior_beginInsertRows__wrapper },
+            { "Interior_endInsertRows", &Interior_endInsertRows__wrapper },
+            { "Interior_beginRemoveRows", &Interior_beginRemoveRows__wrapper },
+            { "Interior_endRemoveRows", &Interior_endRemoveRows__wrapper },
+            { "Interior_beginResetModel", &Interior_beginResetModel__wrapper },
+            { "Interior_endResetModel", &Interior_endResetModel__wrapper },
+        };
         auto m = ni_registerModule("AbstractListModel");
-        ni_registerModuleMethod(m, "createSubclassed", &createSubclassed__wrapper);
-        ni_registerModuleMethod(m, "Handle_getInteriorHandle", &Handle_getInteriorHandle__wrapper);
-        ni_registerModuleMethod(m, "Handle_dispose", &Handle_dispose__wrapper);
-        ni_registerModuleMethod(m, "Interior_emitDataChanged", &Interior_emitDataChanged__wrapper);
-        ni_registerModuleMethod(m, "Interior_emitHeaderDataChanged", &Interior_emitHeaderDataChanged__wrapper);
-        ni_registerModuleMethod(m, "Interior_beginInsertRows", &Interior_beginInsertRows__wrapper);
-        ni_registerModuleMethod(m, "Interior_endInsertRows", &Interior_endInsertRows__wrapper);
-        ni_registerModuleMethod(m, "Interior_beginRemoveRows", &Interior_beginRemoveRows__wrapper);
-        ni_registerModuleMethod(m, "Interior_endRemoveRows", &Interior_endRemoveRows__wrapper);
-        ni_registerModuleMethod(m, "Interior_beginResetModel", &Interior_beginResetModel__wrapper);
-        ni_registerModuleMethod(m, "Interior_endResetModel", &Interior_endResetModel__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         auto signalHandler = ni_registerInterface(m, "SignalHandler");
         signalHandler_destroyed = ni_registerInterfaceMethod(signalHandler, "destroyed", &SignalHandler_destroyed__wrapper);
         signalHandler_objectNameChanged = ni_registerInterfaceMethod(signalHandler, "objectNameChanged", &SignalHandler_objectNameChanged__wrapper);
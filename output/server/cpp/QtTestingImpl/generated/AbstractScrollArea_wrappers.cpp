@@ -193,11 +193,14 @@ namespace AbstractScrollArea
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "Handle_setHorizontalScrollBarPolicy", &Handle_setHorizontalScrollBarPolicy__wrapper },
+            { "Handle_setSizeAdjustPolicy", &Handle_setSizeAdjustPolicy__wrapper },
+            { "Handle_setVerticalScrollBarPolicy", &Handle_setVerticalScrollBarPolicy__wrapper },
+            { "Handle_dispose", &Handle_dispose__wrapper },
+        };
         auto m = ni_registerModule("AbstractScrollArea");
-        ni_registerModuleMethod(m, "Handle_setHorizontalScrollBarPolicy", &Handle_setHorizontalScrollBarPolicy__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSizeAdjustPolicy", &Handle_setSizeAdjustPolicy__wrapper);
-        ni_registerModuleMethod(m, "Handle_setVerticalScrollBarPolicy", &Handle_setVerticalScrollBarPolicy__wrapper);
-        ni_registerModuleMethod(m, "Handle_dispose", &Handle_dispose__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         auto signalHandler = ni_registerInterface(m, "SignalHandler");
         signalHandler_destroyed = ni_registerInterfaceMethod(signalHandler, "destroyed", &SignalHandler_destroyed__wrapper);
         signalHandler_objectNameChanged = ni_registerInterfaceMethod(signalHandler, "objectNameChanged", &SignalHandler_objectNameChanged__wrapper);
@@ -313,20 +313,23 @@ namespace AbstractSlider
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "Handle_setInvertedAppearance", &Handle_setInvertedAppearance__wrapper },
+            { "Handle_setInvertedControls", &Handle_setInvertedControls__wrapper },
+            { "Handle_setMaximum", &Handle_setMaximum__wrapper },
+            { "Handle_setMinimum", &Handle_setMinimum__wrapper },
+            { "Handle_setOrientation", &Handle_setOrientation__wrapper },
+            { "Handle_setPageStep", &Handle_setPageStep__wrapper },
+            { "Handle_setSingleStep", &Handle_setSingleStep__wrapper },
+            { "Handle_setSliderDown", &Handle_setSliderDown__wrapper },
+            { "Handle_setSliderPosition", &Handle_setSliderPosition__wrapper },
+            { "Handle_setTracking", &Handle_setTracking__wrapper },
+            { "Handle_setValue", &Handle_setValue__wrapper },
+            { "Handle_setRange", &Handle_setRange__wrapper },
+            { "Handle_dispose", &Handle_dispose__wrapper },
+        };
         auto m = ni_registerModule("AbstractSlider");
-        ni_registerModuleMethod(m, "Handle_setInvertedAppearance", &Handle_setInvertedAppearance__wrapper);
-        ni_registerModuleMethod(m, "Handle_setInvertedControls", &Handle_setInvertedControls__wrapper);
-        ni_registerModuleMethod(m, "Handle_setMaximum", &Handle_setMaximum__wrapper);
-        ni_registerModuleMethod(m, "Handle_setMinimum", &Handle_setMinimum__wrapper);
-        ni_registerModuleMethod(m, "Handle_setOrientation", &Handle_setOrientation__wrapper);
-        ni_registerModuleMethod(m, "Handle_setPageStep", &Handle_setPageStep__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSingleStep", &Handle_setSingleStep__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSliderDown", &Handle_setSliderDown__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSliderPosition", &Handle_setSliderPosition__wrapper);
-        ni_registerModuleMethod(m, "Handle_setTracking", &Handle_setTracking__wrapper);
-        ni_registerModuleMethod(m, "Handle_setValue", &Handle_setValue__wrapper);
-        ni_registerModuleMethod(m, "Handle_setRange", &Handle_setRange__wrapper);
-        ni_registerModuleMethod(m, "Handle_dispose", &Handle_dispose__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         auto signalHandler = ni_registerInterface(m, "SignalHandler");
         signalHandler_destroyed = ni_registerInterfaceMethod(signalHandler, "destroyed", &SignalHandler_destroyed__wrapper);
         signalHandler_objectNameChanged = ni_registerInterfaceMethod(signalHandler, "objectNameChanged", &SignalHandler_objectNameChanged__wrapper);
@@ -82,8 +82,8 @@ namespace Action
     void Handle_setShortcutContext(HandleRef _this, Enums::ShortcutContext context);
     void Handle_setShortcutVisibleInContextMenu(HandleRef _this, bool visible);
     void Handle_setStatusTip(HandleRef _this, std::string tip);
-    void Handle_setText(HandleRef _this, std::string text);
-    void Handle_setToolTip(HandleRef _this, std::string tip);
+    void Handle_setText(HandleRef _this, StringArg text);
+    void Handle_setToolTip(HandleRef _this, StringArg tip);
     void Handle_setVisible(HandleRef _this, bool visible);
     void Handle_setWhatsThis(HandleRef _this, std::string text);
     void Handle_setSeparator(HandleRef _this, bool state);
@@ -291,13 +291,13 @@ namespace Action
 
     void Handle_setText__wrapper() {
         auto _this = Handle__pop();
-        auto text = popStringInternal();
+        auto text = popStringArg();
         Handle_setText(_this, text);
     }
 
     void Handle_setToolTip__wrapper() {
         auto _this = Handle__pop();
-        auto tip = popStringInternal();
+        auto tip = popStringArg();
         Handle_setToolTip(_this, tip);
     }
 
@@ -337,28 +337,31 @@ namespace Action
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "create", &create__wrapper },
+            { "Handle_setAutoRepeat", &Handle_setAutoRepeat__wrapper },
+            { "Handle_setCheckable", &Handle_setCheckable__wrapper },
+            { "Handle_setChecked", &Handle_setChecked__wrapper },
+            { "Handle_setEnabled", &Handle_setEnabled__wrapper },
+            { "Handle_setIcon", &Handle_setIcon__wrapper },
+            { "Handle_setIconText", &Handle_setIconText__wrapper },
+            { "Handle_setIconVisibleInMenu", &Handle_setIconVisibleInMenu__wrapper },
+            { "Handle_setMenuRole", &Handle_setMenuRole__wrapper },
+            { "Handle_setPriority", &Handle_setPriority__wrapper },
+            { "Handle_setShortcut", &Handle_setShortcut__wrapper },
+            { "Handle_setShortcutContext", &Handle_setShortcutContext__wrapper },
+            { "Handle_setShortcutVisibleInContextMenu", &Handle_setShortcutVisibleInContextMenu__wrapper },
+            { "Handle_setStatusTip", &Handle_setStatusTip__wrapper },
+            { "Handle_setText", &Handle_setText__wrapper },
+            { "Handle_setToolTip", &Handle_setToolTip__wrapper },
+            { "Handle_setVisible", &Handle_setVisible__wrapper },
+            { "Handle_setWhatsThis", &Handle_setWhatsThis__wrapper },
+            { "Handle_setSeparator", &Handle_setSeparator__wrapper },
+            { "Handle_setSignalMask", &Handle_setSignalMask__wrapper },
+            { "Handle_dispose", &Handle_dispose__wrapper },
+        };
         auto m = ni_registerModule("Action");
-        ni_registerModuleMethod(m, "create", &create__wrapper);
-        ni_registerModuleMethod(m, "Handle_setAutoRepeat", &Handle_setAutoRepeat__wrapper);
-        ni_registerModuleMethod(m, "Handle_setCheckable", &Handle_setCheckable__wrapper);
-        ni_registerModuleMethod(m, "Handle_setChecked", &Handle_setChecked__wrapper);
-        ni_registerModuleMethod(m, "Handle_setEnabled", &Handle_setEnabled__wrapper);
-        ni_registerModuleMethod(m, "Handle_setIcon", &Handle_setIcon__wrapper);
-        ni_registerModuleMethod(m, "Handle_setIconText", &Handle_setIconText__wrapper);
-        ni_registerModuleMethod(m, "Handle_setIconVisibleInMenu", &Handle_setIconVisibleInMenu__wrapper);
-        ni_registerModuleMethod(m, "Handle_setMenuRole", &Handle_setMenuRole__wrapper);
-        ni_registerModuleMethod(m, "Handle_setPriority", &Handle_setPriority__wrapper);
-        ni_registerModuleMethod(m, "Handle_setShortcut", &Handle_setShortcut__wrapper);
-        ni_registerModuleMethod(m, "Handle_setShortcutContext", &Handle_setShortcutContext__wrapper);
-        ni_registerModuleMethod(m, "Handle_setShortcutVisibleInContextMenu", &Handle_setShortcutVisibleInContextMenu__wrapper);
-        ni_registerModuleMethod(m, "Handle_setStatusTip", &Handle_setStatusTip__wrapper);
-        ni_registerModuleMethod(m, "Handle_setText", &Handle_setText__wrapper);
-        ni_registerModuleMethod(m, "Handle_setToolTip", &Handle_setToolTip__wrapper);
-        ni_registerModuleMethod(m, "Handle_setVisible", &Handle_setVisible__wrapper);
-        ni_registerModuleMethod(m, "Handle_setWhatsThis", &Handle_setWhatsThis__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSeparator", &Handle_setSeparator__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSignalMask", &Handle_setSignalMask__wrapper);
-        ni_registerModuleMethod(m, "Handle_dispose", &Handle_dispose__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         auto signalHandler = ni_registerInterface(m, "SignalHandler");
         signalHandler_destroyed = ni_registerInterfaceMethod(signalHandler, "destroyed", &SignalHandler_destroyed__wrapper);
         signalHandler_objectNameChanged = ni_registerInterfaceMethod(signalHandler, "objectNameChanged", &SignalHandler_objectNameChanged__wrapper);
@@ -74,15 +74,18 @@ namespace Application
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "setStyle", &setStyle__wrapper },
+            { "exec", &exec__wrapper },
+            { "quit", &quit__wrapper },
+            { "availableStyles", &availableStyles__wrapper },
+            { "create", &create__wrapper },
+            { "executeOnMainThread", &executeOnMainThread__wrapper },
+            { "Handle_setQuitOnLastWindowClosed", &Handle_setQuitOnLastWindowClosed__wrapper },
+            { "Handle_dispose", &Handle_dispose__wrapper },
+        };
         auto m = ni_registerModule("Application");
-        ni_registerModuleMethod(m, "setStyle", &setStyle__wrapper);
-        ni_registerModuleMethod(m, "exec", &exec__wrapper);
-        ni_registerModuleMethod(m, "quit", &quit__wrapper);
-        ni_registerModuleMethod(m, "availableStyles", &availableStyles__wrapper);
-        ni_registerModuleMethod(m, "create", &create__wrapper);
-        ni_registerModuleMethod(m, "executeOnMainThread", &executeOnMainThread__wrapper);
-        ni_registerModuleMethod(m, "Handle_setQuitOnLastWindowClosed", &Handle_setQuitOnLastWindowClosed__wrapper);
-        ni_registerModuleMethod(m, "Handle_dispose", &Handle_dispose__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         return 0; // = OK
     }
 }
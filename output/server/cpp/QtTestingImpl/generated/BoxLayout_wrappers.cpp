@@ -203,19 +203,22 @@ namespace BoxLayout
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "create", &create__wrapper },
+            { "createNoHandler", &createNoHandler__wrapper },
+            { "Handle_setDirection", &Handle_setDirection__wrapper },
+            { "Handle_addSpacing", &Handle_addSpacing__wrapper },
+            { "Handle_addStretch", &Handle_addStretch__wrapper },
+            { "Handle_addWidget", &Handle_addWidget__wrapper },
+            { "Handle_addWidget_overload1", &Handle_addWidget_overload1__wrapper },
+            { "Handle_addWidget_overload2", &Handle_addWidget_overload2__wrapper },
+            { "Handle_addLayout", &Handle_addLayout__wrapper },
+            { "Handle_addLayout_overload1", &Handle_addLayout_overload1__wrapper },
+            { "Handle_setSignalMask", &Handle_setSignalMask__wrapper },
+            { "Handle_dispose", &Handle_dispose__wrapper },
+        };
         auto m = ni_registerModule("BoxLayout");
-        ni_registerModuleMethod(m, "create", &create__wrapper);
-        ni_registerModuleMethod(m, "createNoHandler", &createNoHandler__wrapper);
-        ni_registerModuleMethod(m, "Handle_setDirection", &Handle_setDirection__wrapper);
-        ni_registerModuleMethod(m, "Handle_addSpacing", &Handle_addSpacing__wrapper);
-        ni_registerModuleMethod(m, "Handle_addStretch", &Handle_addStretch__wrapper);
-        ni_registerModuleMethod(m, "Handle_addWidget", &Handle_addWidget__wrapper);
-        ni_registerModuleMethod(m, "Handle_addWidget_overload1", &Handle_addWidget_overload1__wrapper);
-        ni_registerModuleMethod(m, "Handle_addWidget_overload2", &Handle_addWidget_overload2__wrapper);
-        ni_registerModuleMethod(m, "Handle_addLayout", &Handle_addLayout__wrapper);
-        ni_registerModuleMethod(m, "Handle_addLayout_overload1", &Handle_addLayout_overload1__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSignalMask", &Handle_setSignalMask__wrapper);
-        ni_registerModuleMethod(m, "Handle_dispose", &Handle_dispose__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         auto signalHandler = ni_registerInterface(m, "SignalHandler");
         signalHandler_destroyed = ni_registerInterfaceMethod(signalHandler, "destroyed", &SignalHandler_destroyed__wrapper);
         signalHandler_objectNameChanged = ni_registerInterfaceMethod(signalHandler, "objectNameChanged", &SignalHandler_objectNameChanged__wrapper);
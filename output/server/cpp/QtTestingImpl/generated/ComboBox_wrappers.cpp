@@ -379,7 +379,7 @@ namespace ComboBox
 
     void Handle_addItems__wrapper() {
         auto _this = Handle__pop();
-        auto texts = popStringArrayInternal();
+        auto texts = popStringArrayView();
         Handle_addItems(_this, texts);
     }
 
@@ -406,31 +406,34 @@ namespace ComboBox
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "create", &create__wrapper },
+            { "Handle_count", &Handle_count__wrapper },
+            { "Handle_currentData", &Handle_currentData__wrapper },
+            { "Handle_currentData_overload1", &Handle_currentData_overload1__wrapper },
+            { "Handle_setCurrentIndex", &Handle_setCurrentIndex__wrapper },
+            { "Handle_setCurrentText", &Handle_setCurrentText__wrapper },
+            { "Handle_setDuplicatesEnabled", &Handle_setDuplicatesEnabled__wrapper },
+            { "Handle_setEditable", &Handle_setEditable__wrapper },
+            { "Handle_setFrame", &Handle_setFrame__wrapper },
+            { "Handle_setIconSize", &Handle_setIconSize__wrapper },
+            { "Handle_setInsertPolicy", &Handle_setInsertPolicy__wrapper },
+            { "Handle_setMaxCount", &Handle_setMaxCount__wrapper },
+            { "Handle_setMaxVisibleItems", &Handle_setMaxVisibleItems__wrapper },
+            { "Handle_setMinimumContentsLength", &Handle_setMinimumContentsLength__wrapper },
+            { "Handle_setModelColumn", &Handle_setModelColumn__wrapper },
+            { "Handle_setPlaceholderText", &Handle_setPlaceholderText__wrapper },
+            { "Handle_setSizeAdjustPolicy", &Handle_setSizeAdjustPolicy__wrapper },
+            { "Handle_clear", &Handle_clear__wrapper },
+            { "Handle_addItem", &Handle_addItem__wrapper },
+            { "Handle_addItem_overload1", &Handle_addItem_overload1__wrapper },
+            { "Handle_addItems", &Handle_addItems__wrapper },
+            { "Handle_setModel", &Handle_setModel__wrapper },
+            { "Handle_setSignalMask", &Handle_setSignalMask__wrapper },
+            { "Handle_dispose", &Handle_dispose__wrapper },
+        };
         auto m = ni_registerModule("ComboBox");
-        ni_registerModuleMethod(m, "create", &create__wrapper);
-        ni_registerModuleMethod(m, "Handle_count", &Handle_count__wrapper);
-        ni_registerModuleMethod(m, "Handle_currentData", &Handle_currentData__wrapper);
-        ni_registerModuleMethod(m, "Handle_currentData_overload1", &Handle_currentData_overload1__wrapper);
-        ni_registerModuleMethod(m, "Handle_setCurrentIndex", &Handle_setCurrentIndex__wrapper);
-        ni_registerModuleMethod(m, "Handle_setCurrentText", &Handle_setCurrentText__wrapper);
-        ni_registerModuleMethod(m, "Handle_setDuplicatesEnabled", &Handle_setDuplicatesEnabled__wrapper);
-        ni_registerModuleMethod(m, "Handle_setEditable", &Handle_setEditable__wrapper);
-        ni_registerModuleMethod(m, "Handle_setFrame", &Handle_setFrame__wrapper);
-        ni_registerModuleMethod(m, "Handle_setIconSize", &Handle_setIconSize__wrapper);
-        ni_registerModuleMethod(m, "Handle_setInsertPolicy", &Handle_setInsertPolicy__wrapper);
-        ni_registerModuleMethod(m, "Handle_setMaxCount", &Handle_setMaxCount__wrapper);
-        ni_registerModuleMethod(m, "Handle_setMaxVisibleItems", &Handle_setMaxVisibleItems__wrapper);
-        ni_registerModuleMethod(m, "Handle_setMinimumContentsLength", &Handle_setMinimumContentsLength__wrapper);
-        ni_registerModuleMethod(m, "Handle_setModelColumn", &Handle_setModelColumn__wrapper);
-        ni_registerModuleMethod(m, "Handle_setPlaceholderText", &Handle_setPlaceholderText__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSizeAdjustPolicy", &Handle_setSizeAdjustPolicy__wrapper);
-        ni_registerModuleMethod(m, "Handle_clear", &Handle_clear__wrapper);
-        ni_registerModuleMethod(m, "Handle_addItem", &Handle_addItem__wrapper);
-        ni_registerModuleMethod(m, "Handle_addItem_overload1", &Handle_addItem_overload1__wrapper);
-        ni_registerModuleMethod(m, "Handle_addItems", &Handle_addItems__wrapper);
-        ni_registerModuleMethod(m, "Handle_setModel", &Handle_setModel__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSignalMask", &Handle_setSignalMask__wrapper);
-        ni_registerModuleMethod(m, "Handle_dispose", &Handle_dispose__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         auto signalHandler = ni_registerInterface(m, "SignalHandler");
         signalHandler_destroyed = ni_registerInterfaceMethod(signalHandler, "destroyed", &SignalHandler_destroyed__wrapper);
         signalHandler_objectNameChanged = ni_registerInterfaceMethod(signalHandler, "objectNameChanged", &SignalHandler_objectNameChanged__wrapper);
@@ -2,69 +2,101 @@
 #include "Common_wrappers.h"
 #include "Common.h"
 
+#include <cstddef>
+
 namespace Common
 {
+    int Point__typeId;
+
     void Point__push(Point value, bool isReturn) {
-        ni_pushInt32(value.y);
-        ni_pushInt32(value.x);
+        ni_pushStruct(Point__typeId, &value, sizeof(Point));
     }
 
     Point Point__pop() {
-        auto x = ni_popInt32();
-        auto y = ni_popInt32();
-        return Point { x, y };
+        Point value;
+        ni_popStruct(Point__typeId, &value, sizeof(Point));
+        return value;
     }
+
+    int PointF__typeId;
+
     void PointF__push(PointF value, bool isReturn) {
-        ni_pushDouble(value.y);
-        ni_pushDouble(value.x);
+        ni_pushStruct(PointF__typeId, &value, sizeof(PointF));
     }
 
     PointF PointF__pop() {
-        auto x = ni_popDouble();
-        auto y = ni_popDouble();
-        return PointF { x, y };
+        PointF value;
+        ni_popStruct(PointF__typeId, &value, sizeof(PointF));
+        return value;
     }
+
+    int Size__typeId;
+
     void Size__push(Size value, bool isReturn) {
-        ni_pushInt32(value.height);
-        ni_pushInt32(value.width);
+        ni_pushStruct(Size__typeId, &value, sizeof(Size));
     }
 
     Size Size__pop() {
-        auto width = ni_popInt32();
-        auto height = ni_popInt32();
-        return Size { width, height };
+        Size value;
+        ni_popStruct(Size__typeId, &value, sizeof(Size));
+        return value;
     }
+
+    int Rect__typeId;
+
     void Rect__push(Rect value, bool isReturn) {
-        ni_pushInt32(value.height);
-        ni_pushInt32(value.width);
-        ni_pushInt32(value.y);
-        ni_pushInt32(value.x);
+        ni_pushStruct(Rect__typeId, &value, sizeof(Rect));
     }
 
     Rect Rect__pop() {
-        auto x = ni_popInt32();
-        auto y = ni_popInt32();
-        auto width = ni_popInt32();
-        auto height = ni_popInt32();
-        return Rect { x, y, width, height };
+        Rect value;
+        ni_popStruct(Rect__typeId, &value, sizeof(Rect));
+        return value;
     }
+
+    int RectF__typeId;
+
     void RectF__push(RectF value, bool isReturn) {
-        ni_pushDouble(value.height);
-        ni_pushDouble(value.width);
-        ni_pushDouble(value.y);
-        ni_pushDouble(value.x);
+        ni_pushStruct(RectF__typeId, &value, sizeof(RectF));
     }
 
     RectF RectF__pop() {
-        auto x = ni_popDouble();
-        auto y = ni_popDouble();
-        auto width = ni_popDouble();
-        auto height = ni_popDouble();
-        return RectF { x, y, width, height };
+        RectF value;
+        ni_popStruct(RectF__typeId, &value, sizeof(RectF));
+        return value;
     }
 
     int __register() {
         auto m = ni_registerModule("Common");
+        static constexpr ni_StructField Point__fields[] = {
+            { "x", offsetof(Point, x), ni_BatchInt32 },
+            { "y", offsetof(Point, y), ni_BatchInt32 },
+        };
+        Point__typeId = ni_registerStruct(m, "Point", sizeof(Point), Point__fields, sizeof(Point__fields) / sizeof(Point__fields[0]));
+        static constexpr ni_StructField PointF__fields[] = {
+            { "x", offsetof(PointF, x), ni_BatchDouble },
+            { "y", offsetof(PointF, y), ni_BatchDouble },
+        };
+        PointF__typeId = ni_registerStruct(m, "PointF", sizeof(PointF), PointF__fields, sizeof(PointF__fields) / sizeof(PointF__fields[0]));
+        static constexpr ni_StructField Size__fields[] = {
+            { "width", offsetof(Size, width), ni_BatchInt32 },
+            { "height", offsetof(Size, height), ni_BatchInt32 },
+        };
+        Size__typeId = ni_registerStruct(m, "Size", sizeof(Size), Size__fields, sizeof(Size__fields) / sizeof(Size__fields[0]));
+        static constexpr ni_StructField Rect__fields[] = {
+            { "x", offsetof(Rect, x), ni_BatchInt32 },
+            { "y", offsetof(Rect, y), ni_BatchInt32 },
+            { "width", offsetof(Rect, width), ni_BatchInt32 },
+            { "height", offsetof(Rect, height), ni_BatchInt32 },
+        };
+        Rect__typeId = ni_registerStruct(m, "Rect", sizeof(Rect), Rect__fields, sizeof(Rect__fields) / sizeof(Rect__fields[0]));
+        static constexpr ni_StructField RectF__fields[] = {
+            { "x", offsetof(RectF, x), ni_BatchDouble },
+            { "y", offsetof(RectF, y), ni_BatchDouble },
+            { "width", offsetof(RectF, width), ni_BatchDouble },
+            { "height", offsetof(RectF, height), ni_BatchDouble },
+        };
+        RectF__typeId = ni_registerStruct(m, "RectF", sizeof(RectF), RectF__fields, sizeof(RectF__fields) / sizeof(RectF__fields[0]));
         return 0; // = OK
     }
 }
@@ -4,18 +4,23 @@
 namespace Common
 {
 
+    extern int Point__typeId;
     void Point__push(Point value, bool isReturn);
     Point Point__pop();
 
+    extern int PointF__typeId;
     void PointF__push(PointF value, bool isReturn);
     PointF PointF__pop();
 
+    extern int Size__typeId;
     void Size__push(Size value, bool isReturn);
     Size Size__pop();
 
+    extern int Rect__typeId;
     void Rect__push(Rect value, bool isReturn);
     Rect Rect__pop();
 
+    extern int RectF__typeId;
     void RectF__push(RectF value, bool isReturn);
     RectF RectF__pop();
 
@@ -236,16 +236,19 @@ namespace Dialog
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "create", &create__wrapper },
+            { "Handle_setModal", &Handle_setModal__wrapper },
+            { "Handle_setSizeGripEnabled", &Handle_setSizeGripEnabled__wrapper },
+            { "Handle_setParentDialogFlags", &Handle_setParentDialogFlags__wrapper },
+            { "Handle_accept", &Handle_accept__wrapper },
+            { "Handle_reject", &Handle_reject__wrapper },
+            { "Handle_exec", &Handle_exec__wrapper },
+            { "Handle_setSignalMask", &Handle_setSignalMask__wrapper },
+            { "Handle_dispose", &Handle_dispose__wrapper },
+        };
         auto m = ni_registerModule("Dialog");
-        ni_registerModuleMethod(m, "create", &create__wrapper);
-        ni_registerModuleMethod(m, "Handle_setModal", &Handle_setModal__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSizeGripEnabled", &Handle_setSizeGripEnabled__wrapper);
-        ni_registerModuleMethod(m, "Handle_setParentDialogFlags", &Handle_setParentDialogFlags__wrapper);
-        ni_registerModuleMethod(m, "Handle_accept", &Handle_accept__wrapper);
-        ni_registerModuleMethod(m, "Handle_reject", &Handle_reject__wrapper);
-        ni_registerModuleMethod(m, "Handle_exec", &Handle_exec__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSignalMask", &Handle_setSignalMask__wrapper);
-        ni_registerModuleMethod(m, "Handle_dispose", &Handle_dispose__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         auto signalHandler = ni_registerInterface(m, "SignalHandler");
         signalHandler_destroyed = ni_registerInterfaceMethod(signalHandler, "destroyed", &SignalHandler_destroyed__wrapper);
         signalHandler_objectNameChanged = ni_registerInterfaceMethod(signalHandler, "objectNameChanged", &SignalHandler_objectNameChanged__wrapper);
@@ -26,9 +26,12 @@ namespace DockWidget
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "Handle_nothingYet", &Handle_nothingYet__wrapper },
+            { "Handle_dispose", &Handle_dispose__wrapper },
+        };
         auto m = ni_registerModule("DockWidget");
-        ni_registerModuleMethod(m, "Handle_nothingYet", &Handle_nothingYet__wrapper);
-        ni_registerModuleMethod(m, "Handle_dispose", &Handle_dispose__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         return 0; // = OK
     }
 }
@@ -0,0 +1,63 @@
+#include "FastCall.h"
+
+#include "Widget.h"
+#include "ModelIndex.h"
+#include "Painter.h"
+#include "ProgressBar.h"
+#include "AbstractSlider.h"
+
+namespace FastCall
+{
+    // Widget
+    void Widget_Handle_setGeometry_overload1(void* _this, int32_t x, int32_t y, int32_t width, int32_t height) {
+        Widget::Handle_setGeometry((Widget::HandleRef)_this, x, y, width, height);
+    }
+
+    void Widget_Handle_update(void* _this) {
+        Widget::Handle_update((Widget::HandleRef)_this);
+    }
+
+    // ModelIndex
+    int32_t ModelIndex_Handle_row(void* _this) {
+        return ModelIndex::Handle_row((ModelIndex::HandleRef)_this);
+    }
+
+    int32_t ModelIndex_Handle_column(void* _this) {
+        return ModelIndex::Handle_column((ModelIndex::HandleRef)_this);
+    }
+
+    // Painter
+    void Painter_Handle_fillRect(void* _this, int32_t rect_x, int32_t rect_y, int32_t rect_width, int32_t rect_height, void* brush) {
+        Painter::Handle_fillRect((Painter::HandleRef)_this, Common::Rect{ rect_x, rect_y, rect_width, rect_height }, (PaintResources::BrushRef)brush);
+    }
+
+    void Painter_Handle_fillRect_overload1(void* _this, int32_t rect_x, int32_t rect_y, int32_t rect_width, int32_t rect_height, void* color) {
+        Painter::Handle_fillRect((Painter::HandleRef)_this, Common::Rect{ rect_x, rect_y, rect_width, rect_height }, (PaintResources::ColorRef)color);
+    }
+
+    // ProgressBar
+    void ProgressBar_Handle_setValue(void* _this, int32_t value) {
+        ProgressBar::Handle_setValue((ProgressBar::HandleRef)_this, value);
+    }
+
+    // AbstractSlider
+    void AbstractSlider_Handle_setMaximum(void* _this, int32_t value) {
+        AbstractSlider::Handle_setMaximum((AbstractSlider::HandleRef)_this, value);
+    }
+
+    void AbstractSlider_Handle_setMinimum(void* _this, int32_t value) {
+        AbstractSlider::Handle_setMinimum((AbstractSlider::HandleRef)_this, value);
+    }
+
+    void AbstractSlider_Handle_setSliderPosition(void* _this, int32_t pos) {
+        AbstractSlider::Handle_setSliderPosition((AbstractSlider::HandleRef)_this, pos);
+    }
+
+    void AbstractSlider_Handle_setValue(void* _this, int32_t value) {
+        AbstractSlider::Handle_setValue((AbstractSlider::HandleRef)_this, value);
+    }
+
+    void AbstractSlider_Handle_setRange(void* _this, int32_t min, int32_t max) {
+        AbstractSlider::Handle_setRange((AbstractSlider::HandleRef)_this, min, max);
+    }
+}
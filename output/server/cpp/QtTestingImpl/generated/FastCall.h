@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+
+// the @fastcall methods, as plain calls: handles as void*, struct arguments spread out into their fields
+// (nothing but <cstdint> here, so that the exports in _dllproject/FastCallExport.cpp can include it next to the core's own header)
+namespace FastCall
+{
+    // Widget
+    void Widget_Handle_setGeometry_overload1(void* _this, int32_t x, int32_t y, int32_t width, int32_t height);
+    void Widget_Handle_update(void* _this);
+
+    // ModelIndex
+    int32_t ModelIndex_Handle_row(void* _this);
+    int32_t ModelIndex_Handle_column(void* _this);
+
+    // Painter
+    void Painter_Handle_fillRect(void* _this, int32_t rect_x, int32_t rect_y, int32_t rect_width, int32_t rect_height, void* brush);
+    void Painter_Handle_fillRect_overload1(void* _this, int32_t rect_x, int32_t rect_y, int32_t rect_width, int32_t rect_height, void* color);
+
+    // ProgressBar
+    void ProgressBar_Handle_setValue(void* _this, int32_t value);
+
+    // AbstractSlider
+    void AbstractSlider_Handle_setMaximum(void* _this, int32_t value);
+    void AbstractSlider_Handle_setMinimum(void* _this, int32_t value);
+    void AbstractSlider_Handle_setSliderPosition(void* _this, int32_t pos);
+    void AbstractSlider_Handle_setValue(void* _this, int32_t value);
+    void AbstractSlider_Handle_setRange(void* _this, int32_t min, int32_t max);
+}
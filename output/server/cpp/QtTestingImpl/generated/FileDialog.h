@@ -105,11 +105,11 @@ namespace FileDialog
     void Handle_setDefaultSuffix(HandleRef _this, std::string suffix);
     void Handle_setFileMode(HandleRef _this, FileMode mode);
     void Handle_setOptions(HandleRef _this, Options opts);
-    void Handle_setSupportedSchemes(HandleRef _this, std::vector<std::string> schemes);
+    void Handle_setSupportedSchemes(HandleRef _this, StringArrayView schemes);
     void Handle_setViewMode(HandleRef _this, ViewMode mode);
     void Handle_setNameFilter(HandleRef _this, std::string filter);
-    void Handle_setNameFilters(HandleRef _this, std::vector<std::string> filters);
-    void Handle_setMimeTypeFilters(HandleRef _this, std::vector<std::string> filters);
+    void Handle_setNameFilters(HandleRef _this, StringArrayView filters);
+    void Handle_setMimeTypeFilters(HandleRef _this, StringArrayView filters);
     void Handle_setDirectory(HandleRef _this, std::string dir);
     void Handle_selectFile(HandleRef _this, std::string file);
     std::vector<std::string> Handle_selectedFiles(HandleRef _this);
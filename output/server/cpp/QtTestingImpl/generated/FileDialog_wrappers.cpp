@@ -354,7 +354,7 @@ namespace FileDialog
 
     void Handle_setSupportedSchemes__wrapper() {
         auto _this = Handle__pop();
-        auto schemes = popStringArrayInternal();
+        auto schemes = popStringArrayView();
         Handle_setSupportedSchemes(_this, schemes);
     }
 
@@ -372,13 +372,13 @@ namespace FileDialog
 
     void Handle_setNameFilters__wrapper() {
         auto _this = Handle__pop();
-        auto filters = popStringArrayInternal();
+        auto filters = popStringArrayView();
         Handle_setNameFilters(_this, filters);
     }
 
     void Handle_setMimeTypeFilters__wrapper() {
         auto _this = Handle__pop();
-        auto filters = popStringArrayInternal();
+        auto filters = popStringArrayView();
         Handle_setMimeTypeFilters(_this, filters);
     }
 
@@ -417,22 +417,25 @@ namespace FileDialog
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "create", &create__wrapper },
+            { "Handle_setAcceptMode", &Handle_setAcceptMode__wrapper },
+            { "Handle_setDefaultSuffix", &Handle_setDefaultSuffix__wrapper },
+            { "Handle_setFileMode", &Handle_setFileMode__wrapper },
+            { "Handle_setOptions", &Handle_setOptions__wrapper },
+            { "Handle_setSupportedSchemes", &Handle_setSupportedSchemes__wrapper },
+            { "Handle_setViewMode", &Handle_setViewMode__wrapper },
+            { "Handle_setNameFilter", &Handle_setNameFilter__wrapper },
+            { "Handle_setNameFilters", &Handle_setNameFilters__wrapper },
+            { "Handle_setMimeTypeFilters", &Handle_setMimeTypeFilters__wrapper },
+            { "Handle_setDirectory", &Handle_setDirectory__wrapper },
+            { "Handle_selectFile", &Handle_selectFile__wrapper },
+            { "Handle_selectedFiles", &Handle_selectedFiles__wrapper },
+            { "Handle_setSignalMask", &Handle_setSignalMask__wrapper },
+            { "Handle_dispose", &Handle_dispose__wrapper },
+        };
         auto m = ni_registerModule("FileDialog");
-        ni_registerModuleMethod(m, "create", &create__wrapper);
-        ni_registerModuleMethod(m, "Handle_setAcceptMode", &Handle_setAcceptMode__wrapper);
-        ni_registerModuleMethod(m, "Handle_setDefaultSuffix", &Handle_setDefaultSuffix__wrapper);
-        ni_registerModuleMethod(m, "Handle_setFileMode", &Handle_setFileMode__wrapper);
-        ni_registerModuleMethod(m, "Handle_setOptions", &Handle_setOptions__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSupportedSchemes", &Handle_setSupportedSchemes__wrapper);
-        ni_registerModuleMethod(m, "Handle_setViewMode", &Handle_setViewMode__wrapper);
-        ni_registerModuleMethod(m, "Handle_setNameFilter", &Handle_setNameFilter__wrapper);
-        ni_registerModuleMethod(m, "Handle_setNameFilters", &Handle_setNameFilters__wrapper);
-        ni_registerModuleMethod(m, "Handle_setMimeTypeFilters", &Handle_setMimeTypeFilters__wrapper);
-        ni_registerModuleMethod(m, "Handle_setDirectory", &Handle_setDirectory__wrapper);
-        ni_registerModuleMethod(m, "Handle_selectFile", &Handle_selectFile__wrapper);
-        ni_registerModuleMethod(m, "Handle_selectedFiles", &Handle_selectedFiles__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSignalMask", &Handle_setSignalMask__wrapper);
-        ni_registerModuleMethod(m, "Handle_dispose", &Handle_dispose__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         auto signalHandler = ni_registerInterface(m, "SignalHandler");
         signalHandler_destroyed = ni_registerInterfaceMethod(signalHandler, "destroyed", &SignalHandler_destroyed__wrapper);
         signalHandler_objectNameChanged = ni_registerInterfaceMethod(signalHandler, "objectNameChanged", &SignalHandler_objectNameChanged__wrapper);
@@ -228,17 +228,20 @@ namespace Frame
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "create", &create__wrapper },
+            { "Handle_setFrameRect", &Handle_setFrameRect__wrapper },
+            { "Handle_setFrameShadow", &Handle_setFrameShadow__wrapper },
+            { "Handle_setFrameShape", &Handle_setFrameShape__wrapper },
+            { "Handle_frameWidth", &Handle_frameWidth__wrapper },
+            { "Handle_setLineWidth", &Handle_setLineWidth__wrapper },
+            { "Handle_setMidLineWidth", &Handle_setMidLineWidth__wrapper },
+            { "Handle_setFrameStyle", &Handle_setFrameStyle__wrapper },
+            { "Handle_setSignalMask", &Handle_setSignalMask__wrapper },
+            { "Handle_dispose", &Handle_dispose__wrapper },
+        };
         auto m = ni_registerModule("Frame");
-        ni_registerModuleMethod(m, "create", &create__wrapper);
-        ni_registerModuleMethod(m, "Handle_setFrameRect", &Handle_setFrameRect__wrapper);
-        ni_registerModuleMethod(m, "Handle_setFrameShadow", &Handle_setFrameShadow__wrapper);
-        ni_registerModuleMethod(m, "Handle_setFrameShape", &Handle_setFrameShape__wrapper);
-        ni_registerModuleMethod(m, "Handle_frameWidth", &Handle_frameWidth__wrapper);
-        ni_registerModuleMethod(m, "Handle_setLineWidth", &Handle_setLineWidth__wrapper);
-        ni_registerModuleMethod(m, "Handle_setMidLineWidth", &Handle_setMidLineWidth__wrapper);
-        ni_registerModuleMethod(m, "Handle_setFrameStyle", &Handle_setFrameStyle__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSignalMask", &Handle_setSignalMask__wrapper);
-        ni_registerModuleMethod(m, "Handle_dispose", &Handle_dispose__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         auto signalHandler = ni_registerInterface(m, "SignalHandler");
         signalHandler_destroyed = ni_registerInterfaceMethod(signalHandler, "destroyed", &SignalHandler_destroyed__wrapper);
         signalHandler_objectNameChanged = ni_registerInterfaceMethod(signalHandler, "objectNameChanged", &SignalHandler_objectNameChanged__wrapper);
@@ -253,24 +253,27 @@ namespace GridLayout
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "create", &create__wrapper },
+            { "Handle_setHorizontalSpacing", &Handle_setHorizontalSpacing__wrapper },
+            { "Handle_setVerticalSpacing", &Handle_setVerticalSpacing__wrapper },
+            { "Handle_addWidget", &Handle_addWidget__wrapper },
+            { "Handle_addWidget_overload1", &Handle_addWidget_overload1__wrapper },
+            { "Handle_addWidget_overload2", &Handle_addWidget_overload2__wrapper },
+            { "Handle_addWidget_overload3", &Handle_addWidget_overload3__wrapper },
+            { "Handle_addLayout", &Handle_addLayout__wrapper },
+            { "Handle_addLayout_overload1", &Handle_addLayout_overload1__wrapper },
+            { "Handle_addLayout_overload2", &Handle_addLayout_overload2__wrapper },
+            { "Handle_addLayout_overload3", &Handle_addLayout_overload3__wrapper },
+            { "Handle_setRowMinimumHeight", &Handle_setRowMinimumHeight__wrapper },
+            { "Handle_setRowStretch", &Handle_setRowStretch__wrapper },
+            { "Handle_setColumnMinimumWidth", &Handle_setColumnMinimumWidth__wrapper },
+            { "Handle_setColumnStretch", &Handle_setColumnStretch__wrapper },
+            { "Handle_setSignalMask", &Handle_setSignalMask__wrapper },
+            { "Handle_dispose", &Handle_dispose__wrapper },
+        };
         auto m = ni_registerModule("GridLayout");
-        ni_registerModuleMethod(m, "create", &create__wrapper);
-        ni_registerModuleMethod(m, "Handle_setHorizontalSpacing", &Handle_setHorizontalSpacing__wrapper);
-        ni_registerModuleMethod(m, "Handle_setVerticalSpacing", &Handle_setVerticalSpacing__wrapper);
-        ni_registerModuleMethod(m, "Handle_addWidget", &Handle_addWidget__wrapper);
-        ni_registerModuleMethod(m, "Handle_addWidget_overload1", &Handle_addWidget_overload1__wrapper);
-        ni_registerModuleMethod(m, "Handle_addWidget_overload2", &Handle_addWidget_overload2__wrapper);
-        ni_registerModuleMethod(m, "Handle_addWidget_overload3", &Handle_addWidget_overload3__wrapper);
-        ni_registerModuleMethod(m, "Handle_addLayout", &Handle_addLayout__wrapper);
-        ni_registerModuleMethod(m, "Handle_addLayout_overload1", &Handle_addLayout_overload1__wrapper);
-        ni_registerModuleMethod(m, "Handle_addLayout_overload2", &Handle_addLayout_overload2__wrapper);
-        ni_registerModuleMethod(m, "Handle_addLayout_overload3", &Handle_addLayout_overload3__wrapper);
-        ni_registerModuleMethod(m, "Handle_setRowMinimumHeight", &Handle_setRowMinimumHeight__wrapper);
-        ni_registerModuleMethod(m, "Handle_setRowStretch", &Handle_setRowStretch__wrapper);
-        ni_registerModuleMethod(m, "Handle_setColumnMinimumWidth", &Handle_setColumnMinimumWidth__wrapper);
-        ni_registerModuleMethod(m, "Handle_setColumnStretch", &Handle_setColumnStretch__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSignalMask", &Handle_setSignalMask__wrapper);
-        ni_registerModuleMethod(m, "Handle_dispose", &Handle_dispose__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         auto signalHandler = ni_registerInterface(m, "SignalHandler");
         signalHandler_destroyed = ni_registerInterfaceMethod(signalHandler, "destroyed", &SignalHandler_destroyed__wrapper);
         signalHandler_objectNameChanged = ni_registerInterfaceMethod(signalHandler, "objectNameChanged", &SignalHandler_objectNameChanged__wrapper);
@@ -227,15 +227,18 @@ namespace GroupBox
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "create", &create__wrapper },
+            { "Handle_setAlignment", &Handle_setAlignment__wrapper },
+            { "Handle_setCheckable", &Handle_setCheckable__wrapper },
+            { "Handle_setChecked", &Handle_setChecked__wrapper },
+            { "Handle_setFlat", &Handle_setFlat__wrapper },
+            { "Handle_setTitle", &Handle_setTitle__wrapper },
+            { "Handle_setSignalMask", &Handle_setSignalMask__wrapper },
+            { "Handle_dispose", &Handle_dispose__wrapper },
+        };
         auto m = ni_registerModule("GroupBox");
-        ni_registerModuleMethod(m, "create", &create__wrapper);
-        ni_registerModuleMethod(m, "Handle_setAlignment", &Handle_setAlignment__wrapper);
-        ni_registerModuleMethod(m, "Handle_setCheckable", &Handle_setCheckable__wrapper);
-        ni_registerModuleMethod(m, "Handle_setChecked", &Handle_setChecked__wrapper);
-        ni_registerModuleMethod(m, "Handle_setFlat", &Handle_setFlat__wrapper);
-        ni_registerModuleMethod(m, "Handle_setTitle", &Handle_setTitle__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSignalMask", &Handle_setSignalMask__wrapper);
-        ni_registerModuleMethod(m, "Handle_dispose", &Handle_dispose__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         auto signalHandler = ni_registerInterface(m, "SignalHandler");
         signalHandler_destroyed = ni_registerInterfaceMethod(signalHandler, "destroyed", &SignalHandler_destroyed__wrapper);
         signalHandler_objectNameChanged = ni_registerInterfaceMethod(signalHandler, "objectNameChanged", &SignalHandler_objectNameChanged__wrapper);
@@ -63,7 +63,7 @@ namespace Label
     void Handle_setPixmap(HandleRef _this, std::shared_ptr<Pixmap::Deferred::Base> pixmap);
     void Handle_setScaledContents(HandleRef _this, bool state);
     std::string Handle_selectedText(HandleRef _this);
-    void Handle_setText(HandleRef _this, std::string text);
+    void Handle_setText(HandleRef _this, StringArg text);
     void Handle_setTextFormat(HandleRef _this, Enums::TextFormat format);
     void Handle_setTextInteractionFlags(HandleRef _this, Enums::TextInteractionFlags interactionFlags);
     void Handle_setWordWrap(HandleRef _this, bool state);
@@ -231,7 +231,7 @@ namespace Label
 
     void Handle_setText__wrapper() {
         auto _this = Handle__pop();
-        auto text = popStringInternal();
+        auto text = popStringArg();
         Handle_setText(_this, text);
     }
 
@@ -274,23 +274,26 @@ namespace Label
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "create", &create__wrapper },
+            { "createNoHandler", &createNoHandler__wrapper },
+            { "Handle_setAlignment", &Handle_setAlignment__wrapper },
+            { "Handle_hasSelectedText", &Handle_hasSelectedText__wrapper },
+            { "Handle_setIndent", &Handle_setIndent__wrapper },
+            { "Handle_setMargin", &Handle_setMargin__wrapper },
+            { "Handle_setOpenExternalLinks", &Handle_setOpenExternalLinks__wrapper },
+            { "Handle_setPixmap", &Handle_setPixmap__wrapper },
+            { "Handle_setScaledContents", &Handle_setScaledContents__wrapper },
+            { "Handle_selectedText", &Handle_selectedText__wrapper },
+            { "Handle_setText", &Handle_setText__wrapper },
+            { "Handle_setTextFormat", &Handle_setTextFormat__wrapper },
+            { "Handle_setTextInteractionFlags", &Handle_setTextInteractionFlags__wrapper },
+            { "Handle_setWordWrap", &Handle_setWordWrap__wrapper },
+            { "Handle_setSignalMask", &Handle_setSignalMask__wrapper },
+            { "Handle_dispose", &Handle_dispose__wrapper },
+        };
         auto m = ni_registerModule("Label");
-        ni_registerModuleMethod(m, "create", &create__wrapper);
-        ni_registerModuleMethod(m, "createNoHandler", &createNoHandler__wrapper);
-        ni_registerModuleMethod(m, "Handle_setAlignment", &Handle_setAlignment__wrapper);
-        ni_registerModuleMethod(m, "Handle_hasSelectedText", &Handle_hasSelectedText__wrapper);
-        ni_registerModuleMethod(m, "Handle_setIndent", &Handle_setIndent__wrapper);
-        ni_registerModuleMethod(m, "Handle_setMargin", &Handle_setMargin__wrapper);
-        ni_registerModuleMethod(m, "Handle_setOpenExternalLinks", &Handle_setOpenExternalLinks__wrapper);
-        ni_registerModuleMethod(m, "Handle_setPixmap", &Handle_setPixmap__wrapper);
-        ni_registerModuleMethod(m, "Handle_setScaledContents", &Handle_setScaledContents__wrapper);
-        ni_registerModuleMethod(m, "Handle_selectedText", &Handle_selectedText__wrapper);
-        ni_registerModuleMethod(m, "Handle_setText", &Handle_setText__wrapper);
-        ni_registerModuleMethod(m, "Handle_setTextFormat", &Handle_setTextFormat__wrapper);
-        ni_registerModuleMethod(m, "Handle_setTextInteractionFlags", &Handle_setTextInteractionFlags__wrapper);
-        ni_registerModuleMethod(m, "Handle_setWordWrap", &Handle_setWordWrap__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSignalMask", &Handle_setSignalMask__wrapper);
-        ni_registerModuleMethod(m, "Handle_dispose", &Handle_dispose__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         auto signalHandler = ni_registerInterface(m, "SignalHandler");
         signalHandler_destroyed = ni_registerInterfaceMethod(signalHandler, "destroyed", &SignalHandler_destroyed__wrapper);
         signalHandler_objectNameChanged = ni_registerInterfaceMethod(signalHandler, "objectNameChanged", &SignalHandler_objectNameChanged__wrapper);
@@ -164,15 +164,18 @@ namespace Layout
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "Handle_setEnabled", &Handle_setEnabled__wrapper },
+            { "Handle_setSpacing", &Handle_setSpacing__wrapper },
+            { "Handle_setContentsMargins", &Handle_setContentsMargins__wrapper },
+            { "Handle_setSizeConstraint", &Handle_setSizeConstraint__wrapper },
+            { "Handle_removeAll", &Handle_removeAll__wrapper },
+            { "Handle_activate", &Handle_activate__wrapper },
+            { "Handle_update", &Handle_update__wrapper },
+            { "Handle_dispose", &Handle_dispose__wrapper },
+        };
         auto m = ni_registerModule("Layout");
-        ni_registerModuleMethod(m, "Handle_setEnabled", &Handle_setEnabled__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSpacing", &Handle_setSpacing__wrapper);
-        ni_registerModuleMethod(m, "Handle_setContentsMargins", &Handle_setContentsMargins__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSizeConstraint", &Handle_setSizeConstraint__wrapper);
-        ni_registerModuleMethod(m, "Handle_removeAll", &Handle_removeAll__wrapper);
-        ni_registerModuleMethod(m, "Handle_activate", &Handle_activate__wrapper);
-        ni_registerModuleMethod(m, "Handle_update", &Handle_update__wrapper);
-        ni_registerModuleMethod(m, "Handle_dispose", &Handle_dispose__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         auto signalHandler = ni_registerInterface(m, "SignalHandler");
         signalHandler_destroyed = ni_registerInterfaceMethod(signalHandler, "destroyed", &SignalHandler_destroyed__wrapper);
         signalHandler_objectNameChanged = ni_registerInterfaceMethod(signalHandler, "objectNameChanged", &SignalHandler_objectNameChanged__wrapper);
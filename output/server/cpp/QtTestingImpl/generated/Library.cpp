@@ -53,61 +53,109 @@
 #include "Timer_wrappers.h"
 #include "TreeView_wrappers.h"
 
+// the modules register on first lookup rather than all up front (see ni_registerModuleDescriptors), each after the modules
+// whose wrappers its own wrappers use
+static const char* const Layout__dependencies[] = { "Object", nullptr };
+static const char* const PaintResources__dependencies[] = { "Common", nullptr };
+static const char* const Painter__dependencies[] = { "Common", "PaintResources", "Enums", nullptr };
+static const char* const KeySequence__dependencies[] = { "Enums", nullptr };
+static const char* const Action__dependencies[] = { "Object", "KeySequence", "Icon", "Enums", nullptr };
+static const char* const Widget__dependencies[] = { "Object", "Common", "Layout", "Painter", "Icon", "Enums", "Action", "Region", "Cursor", "SizePolicy", nullptr };
+static const char* const BoxLayout__dependencies[] = { "Common", "Widget", "Layout", "Enums", "Object", nullptr };
+static const char* const Variant__dependencies[] = { "Icon", "PaintResources", nullptr };
+static const char* const AbstractItemModel__dependencies[] = { "Object", "Enums", "ModelIndex", "PersistentModelIndex", nullptr };
+static const char* const ComboBox__dependencies[] = { "Object", "Common", "Enums", "Widget", "Variant", "AbstractItemModel", "Icon", nullptr };
+static const char* const Dialog__dependencies[] = { "Object", "Common", "Icon", "Widget", nullptr };
+static const char* const FileDialog__dependencies[] = { "Object", "Common", "Icon", "Dialog", "Widget", nullptr };
+static const char* const GridLayout__dependencies[] = { "Common", "Widget", "Layout", "Enums", "Object", nullptr };
+static const char* const GroupBox__dependencies[] = { "Object", "Common", "Icon", "Enums", "Widget", nullptr };
+static const char* const Frame__dependencies[] = { "Object", "Common", "Icon", "Widget", nullptr };
+static const char* const Label__dependencies[] = { "Object", "Common", "Frame", "Icon", "Enums", "Pixmap", nullptr };
+static const char* const LineEdit__dependencies[] = { "Object", "Widget", "Common", "Icon", "Enums", nullptr };
+static const char* const AbstractListModel__dependencies[] = { "Object", "Enums", "AbstractItemModel", "Variant", "ModelIndex", "PersistentModelIndex", nullptr };
+static const char* const AbstractScrollArea__dependencies[] = { "Object", "Common", "Icon", "Frame", nullptr };
+static const char* const AbstractItemView__dependencies[] = { "Object", "Common", "Enums", "Icon", "AbstractScrollArea", "AbstractItemModel", "ModelIndex", nullptr };
+static const char* const ListView__dependencies[] = { "Object", "Common", "Enums", "Icon", "AbstractListModel", "ModelIndex", "AbstractItemView", nullptr };
+static const char* const Menu__dependencies[] = { "Object", "Common", "Widget", "Action", "Icon", nullptr };
+static const char* const MenuBar__dependencies[] = { "Object", "Common", "Icon", "Widget", "Menu", "Action", nullptr };
+static const char* const DockWidget__dependencies[] = { "Widget", nullptr };
+static const char* const ToolBar__dependencies[] = { "Object", "Common", "Icon", "Enums", "Widget", "Action", nullptr };
+static const char* const StatusBar__dependencies[] = { "Object", "Common", "Icon", "Widget", nullptr };
+static const char* const TabWidget__dependencies[] = { "Object", "Common", "Icon", "Enums", "Widget", nullptr };
+static const char* const MainWindow__dependencies[] = { "Object", "Common", "Widget", "Layout", "MenuBar", "Icon", "DockWidget", "Enums", "ToolBar", "StatusBar", "TabWidget", nullptr };
+static const char* const AbstractButton__dependencies[] = { "Object", "Common", "KeySequence", "Widget", "Icon", nullptr };
+static const char* const MessageBox__dependencies[] = { "Object", "Common", "Icon", "Enums", "Dialog", "AbstractButton", "Widget", nullptr };
+static const char* const PlainTextEdit__dependencies[] = { "Object", "Common", "Icon", "Enums", "AbstractScrollArea", "TextOption", nullptr };
+static const char* const ProgressBar__dependencies[] = { "Object", "Common", "Enums", "Icon", "Widget", nullptr };
+static const char* const PushButton__dependencies[] = { "Object", "Common", "Icon", "AbstractButton", nullptr };
+static const char* const RadioButton__dependencies[] = { "Object", "Common", "Icon", "AbstractButton", nullptr };
+static const char* const ScrollArea__dependencies[] = { "Object", "Common", "Icon", "Enums", "Widget", "AbstractScrollArea", nullptr };
+static const char* const AbstractSlider__dependencies[] = { "Object", "Widget", "Common", "Icon", "Enums", nullptr };
+static const char* const Slider__dependencies[] = { "Object", "Common", "Icon", "AbstractSlider", nullptr };
+static const char* const AbstractProxyModel__dependencies[] = { "Object", "Enums", "AbstractItemModel", "ModelIndex", "PersistentModelIndex", nullptr };
+static const char* const SortFilterProxyModel__dependencies[] = { "Object", "Enums", "AbstractItemModel", "AbstractProxyModel", "RegularExpression", "ModelIndex", "PersistentModelIndex", nullptr };
+static const char* const Timer__dependencies[] = { "Object", "Enums", nullptr };
+static const char* const TreeView__dependencies[] = { "Object", "Common", "Icon", "Enums", "AbstractItemView", "ModelIndex", nullptr };
+
+static constexpr ni_ModuleDescriptor moduleTable[] = {
+    { "Application", &::Application::__register, nullptr },
+    { "Common", &::Common::__register, nullptr },
+    { "Object", &::Object::__register, nullptr },
+    { "Layout", &::Layout::__register, Layout__dependencies },
+    { "PaintResources", &::PaintResources::__register, PaintResources__dependencies },
+    { "Enums", &::Enums::__register, nullptr },
+    { "Painter", &::Painter::__register, Painter__dependencies },
+    { "Icon", &::Icon::__register, nullptr },
+    { "KeySequence", &::KeySequence::__register, KeySequence__dependencies },
+    { "Action", &::Action::__register, Action__dependencies },
+    { "Region", &::Region::__register, nullptr },
+    { "Cursor", &::Cursor::__register, nullptr },
+    { "SizePolicy", &::SizePolicy::__register, nullptr },
+    { "Widget", &::Widget::__register, Widget__dependencies },
+    { "BoxLayout", &::BoxLayout::__register, BoxLayout__dependencies },
+    { "Variant", &::Variant::__register, Variant__dependencies },
+    { "ModelIndex", &::ModelIndex::__register, nullptr },
+    { "PersistentModelIndex", &::PersistentModelIndex::__register, nullptr },
+    { "AbstractItemModel", &::AbstractItemModel::__register, AbstractItemModel__dependencies },
+    { "ComboBox", &::ComboBox::__register, ComboBox__dependencies },
+    { "Dialog", &::Dialog::__register, Dialog__dependencies },
+    { "FileDialog", &::FileDialog::__register, FileDialog__dependencies },
+    { "GridLayout", &::GridLayout::__register, GridLayout__dependencies },
+    { "GroupBox", &::GroupBox::__register, GroupBox__dependencies },
+    { "Frame", &::Frame::__register, Frame__dependencies },
+    { "Pixmap", &::Pixmap::__register, nullptr },
+    { "Label", &::Label::__register, Label__dependencies },
+    { "LineEdit", &::LineEdit::__register, LineEdit__dependencies },
+    { "AbstractListModel", &::AbstractListModel::__register, AbstractListModel__dependencies },
+    { "AbstractScrollArea", &::AbstractScrollArea::__register, AbstractScrollArea__dependencies },
+    { "AbstractItemView", &::AbstractItemView::__register, AbstractItemView__dependencies },
+    { "ListView", &::ListView::__register, ListView__dependencies },
+    { "Menu", &::Menu::__register, Menu__dependencies },
+    { "MenuBar", &::MenuBar::__register, MenuBar__dependencies },
+    { "DockWidget", &::DockWidget::__register, DockWidget__dependencies },
+    { "ToolBar", &::ToolBar::__register, ToolBar__dependencies },
+    { "StatusBar", &::StatusBar::__register, StatusBar__dependencies },
+    { "TabWidget", &::TabWidget::__register, TabWidget__dependencies },
+    { "MainWindow", &::MainWindow::__register, MainWindow__dependencies },
+    { "AbstractButton", &::AbstractButton::__register, AbstractButton__dependencies },
+    { "MessageBox", &::MessageBox::__register, MessageBox__dependencies },
+    { "TextOption", &::TextOption::__register, nullptr },
+    { "PlainTextEdit", &::PlainTextEdit::__register, PlainTextEdit__dependencies },
+    { "ProgressBar", &::ProgressBar::__register, ProgressBar__dependencies },
+    { "PushButton", &::PushButton::__register, PushButton__dependencies },
+    { "RadioButton", &::RadioButton::__register, RadioButton__dependencies },
+    { "ScrollArea", &::ScrollArea::__register, ScrollArea__dependencies },
+    { "AbstractSlider", &::AbstractSlider::__register, AbstractSlider__dependencies },
+    { "Slider", &::Slider::__register, Slider__dependencies },
+    { "AbstractProxyModel", &::AbstractProxyModel::__register, AbstractProxyModel__dependencies },
+    { "RegularExpression", &::RegularExpression::__register, nullptr },
+    { "SortFilterProxyModel", &::SortFilterProxyModel::__register, SortFilterProxyModel__dependencies },
+    { "Timer", &::Timer::__register, Timer__dependencies },
+    { "TreeView", &::TreeView::__register, TreeView__dependencies },
+};
+
 extern "C" int nativeLibraryInit() {
-    ::Application::__register();
-    ::Common::__register();
-    ::Object::__register();
-    ::Layout::__register();
-    ::PaintResources::__register();
-    ::Enums::__register();
-    ::Painter::__register();
-    ::Icon::__register();
-    ::KeySequence::__register();
-    ::Action::__register();
-    ::Region::__register();
-    ::Cursor::__register();
-    ::SizePolicy::__register();
-    ::Widget::__register();
-    ::BoxLayout::__register();
-    ::Variant::__register();
-    ::ModelIndex::__register();
-    ::PersistentModelIndex::__register();
-    ::AbstractItemModel::__register();
-    ::ComboBox::__register();
-    ::Dialog::__register();
-    ::FileDialog::__register();
-    ::GridLayout::__register();
-    ::GroupBox::__register();
-    ::Frame::__register();
-    ::Pixmap::__register();
-    ::Label::__register();
-    ::LineEdit::__register();
-    ::AbstractListModel::__register();
-    ::AbstractScrollArea::__register();
-    ::AbstractItemView::__register();
-    ::ListView::__register();
-    ::Menu::__register();
-    ::MenuBar::__register();
-    ::DockWidget::__register();
-    ::ToolBar::__register();
-    ::StatusBar::__register();
-    ::TabWidget::__register();
-    ::MainWindow::__register();
-    ::AbstractButton::__register();
-    ::MessageBox::__register();
-    ::TextOption::__register();
-    ::PlainTextEdit::__register();
-    ::ProgressBar::__register();
-    ::PushButton::__register();
-    ::RadioButton::__register();
-    ::ScrollArea::__register();
-    ::AbstractSlider::__register();
-    ::Slider::__register();
-    ::AbstractProxyModel::__register();
-    ::RegularExpression::__register();
-    ::SortFilterProxyModel::__register();
-    ::Timer::__register();
-    ::TreeView::__register();
+    ni_registerModuleDescriptors(moduleTable, sizeof(moduleTable) / sizeof(moduleTable[0]));
     // should we do module inits here as well?
     // currently they are manually done on the C# side inside the <module>.Init methods (which perform registration first) - and those are individually called by Library.Init, which first calls nativeImplInit
     return 0;
@@ -372,30 +372,33 @@ namespace LineEdit
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "create", &create__wrapper },
+            { "Handle_hasAcceptableInput", &Handle_hasAcceptableInput__wrapper },
+            { "Handle_setAlignment", &Handle_setAlignment__wrapper },
+            { "Handle_setClearButtonEnabled", &Handle_setClearButtonEnabled__wrapper },
+            { "Handle_setCursorMoveStyle", &Handle_setCursorMoveStyle__wrapper },
+            { "Handle_setCursorPosition", &Handle_setCursorPosition__wrapper },
+            { "Handle_displayText", &Handle_displayText__wrapper },
+            { "Handle_setDragEnabled", &Handle_setDragEnabled__wrapper },
+            { "Handle_setEchoMode", &Handle_setEchoMode__wrapper },
+            { "Handle_setFrame", &Handle_setFrame__wrapper },
+            { "Handle_hasSelectedText", &Handle_hasSelectedText__wrapper },
+            { "Handle_setInputMask", &Handle_setInputMask__wrapper },
+            { "Handle_setMaxLength", &Handle_setMaxLength__wrapper },
+            { "Handle_isModified", &Handle_isModified__wrapper },
+            { "Handle_setModified", &Handle_setModified__wrapper },
+            { "Handle_setPlaceholderText", &Handle_setPlaceholderText__wrapper },
+            { "Handle_setReadOnly", &Handle_setReadOnly__wrapper },
+            { "Handle_isRedoAvailable", &Handle_isRedoAvailable__wrapper },
+            { "Handle_selectedText", &Handle_selectedText__wrapper },
+            { "Handle_setText", &Handle_setText__wrapper },
+            { "Handle_isUndoAvailable", &Handle_isUndoAvailable__wrapper },
+            { "Handle_setSignalMask", &Handle_setSignalMask__wrapper },
+            { "Handle_dispose", &Handle_dispose__wrapper },
+        };
         auto m = ni_registerModule("LineEdit");
-        ni_registerModuleMethod(m, "create", &create__wrapper);
-        ni_registerModuleMethod(m, "Handle_hasAcceptableInput", &Handle_hasAcceptableInput__wrapper);
-        ni_registerModuleMethod(m, "Handle_setAlignment", &Handle_setAlignment__wrapper);
-        ni_registerModuleMethod(m, "Handle_setClearButtonEnabled", &Handle_setClearButtonEnabled__wrapper);
-        ni_registerModuleMethod(m, "Handle_setCursorMoveStyle", &Handle_setCursorMoveStyle__wrapper);
-        ni_registerModuleMethod(m, "Handle_setCursorPosition", &Handle_setCursorPosition__wrapper);
-        ni_registerModuleMethod(m, "Handle_displayText", &Handle_displayText__wrapper);
-        ni_registerModuleMethod(m, "Handle_setDragEnabled", &Handle_setDragEnabled__wrapper);
-        ni_registerModuleMethod(m, "Handle_setEchoMode", &Handle_setEchoMode__wrapper);
-        ni_registerModuleMethod(m, "Handle_setFrame", &Handle_setFrame__wrapper);
-        ni_registerModuleMethod(m, "Handle_hasSelectedText", &Handle_hasSelectedText__wrapper);
-        ni_registerModuleMethod(m, "Handle_setInputMask", &Handle_setInputMask__wrapper);
-        ni_registerModuleMethod(m, "Handle_setMaxLength", &Handle_setMaxLength__wrapper);
-        ni_registerModuleMethod(m, "Handle_isModified", &Handle_isModified__wrapper);
-        ni_registerModuleMethod(m, "Handle_setModified", &Handle_setModified__wrapper);
-        ni_registerModuleMethod(m, "Handle_setPlaceholderText", &Handle_setPlaceholderText__wrapper);
-        ni_registerModuleMethod(m, "Handle_setReadOnly", &Handle_setReadOnly__wrapper);
-        ni_registerModuleMethod(m, "Handle_isRedoAvailable", &Handle_isRedoAvailable__wrapper);
-        ni_registerModuleMethod(m, "Handle_selectedText", &Handle_selectedText__wrapper);
-        ni_registerModuleMethod(m, "Handle_setText", &Handle_setText__wrapper);
-        ni_registerModuleMethod(m, "Handle_isUndoAvailable", &Handle_isUndoAvailable__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSignalMask", &Handle_setSignalMask__wrapper);
-        ni_registerModuleMethod(m, "Handle_dispose", &Handle_dispose__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         auto signalHandler = ni_registerInterface(m, "SignalHandler");
         signalHandler_destroyed = ni_registerInterfaceMethod(signalHandler, "destroyed", &SignalHandler_destroyed__wrapper);
         signalHandler_objectNameChanged = ni_registerInterfaceMethod(signalHandler, "objectNameChanged", &SignalHandler_objectNameChanged__wrapper);
@@ -30,9 +30,9 @@ namespace ListView
     }
 
     std::vector<ModelIndex::HandleRef> __ModelIndex_Handle_Array__pop() {
-        ModelIndex::HandleRef *values;
+        ModelIndex::HandleRef const *values;
         size_t count;
-        ni_popPtrArray((void***)&values, &count);
+        ni_popPtrArrayView((void* const**)&values, &count);
         return std::vector<ModelIndex::HandleRef>(values, values + count);
     }
     ni_InterfaceMethodRef signalHandler_destroyed;
@@ -407,24 +407,27 @@ namespace ListView
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "create", &create__wrapper },
+            { "Handle_setBatchSize", &Handle_setBatchSize__wrapper },
+            { "Handle_setFlow", &Handle_setFlow__wrapper },
+            { "Handle_setGridSize", &Handle_setGridSize__wrapper },
+            { "Handle_setWrapping", &Handle_setWrapping__wrapper },
+            { "Handle_setItemAlignment", &Handle_setItemAlignment__wrapper },
+            { "Handle_setLayoutMode", &Handle_setLayoutMode__wrapper },
+            { "Handle_setModelColumn", &Handle_setModelColumn__wrapper },
+            { "Handle_setMovement", &Handle_setMovement__wrapper },
+            { "Handle_setResizeMode", &Handle_setResizeMode__wrapper },
+            { "Handle_setSelectionRectVisible", &Handle_setSelectionRectVisible__wrapper },
+            { "Handle_setSpacing", &Handle_setSpacing__wrapper },
+            { "Handle_setUniformItemSizes", &Handle_setUniformItemSizes__wrapper },
+            { "Handle_setViewMode", &Handle_setViewMode__wrapper },
+            { "Handle_setWordWrap", &Handle_setWordWrap__wrapper },
+            { "Handle_setSignalMask", &Handle_setSignalMask__wrapper },
+            { "Handle_dispose", &Handle_dispose__wrapper },
+        };
         auto m = ni_registerModule("ListView");
-        ni_registerModuleMethod(m, "create", &create__wrapper);
-        ni_registerModuleMethod(m, "Handle_setBatchSize", &Handle_setBatchSize__wrapper);
-        ni_registerModuleMethod(m, "Handle_setFlow", &Handle_setFlow__wrapper);
-        ni_registerModuleMethod(m, "Handle_setGridSize", &Handle_setGridSize__wrapper);
-        ni_registerModuleMethod(m, "Handle_setWrapping", &Handle_setWrapping__wrapper);
-        ni_registerModuleMethod(m, "Handle_setItemAlignment", &Handle_setItemAlignment__wrapper);
-        ni_registerModuleMethod(m, "Handle_setLayoutMode", &Handle_setLayoutMode__wrapper);
-        ni_registerModuleMethod(m, "Handle_setModelColumn", &Handle_setModelColumn__wrapper);
-        ni_registerModuleMethod(m, "Handle_setMovement", &Handle_setMovement__wrapper);
-        ni_registerModuleMethod(m, "Handle_setResizeMode", &Handle_setResizeMode__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSelectionRectVisible", &Handle_setSelectionRectVisible__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSpacing", &Handle_setSpacing__wrapper);
-        ni_registerModuleMethod(m, "Handle_setUniformItemSizes", &Handle_setUniformItemSizes__wrapper);
-        ni_registerModuleMethod(m, "Handle_setViewMode", &Handle_setViewMode__wrapper);
-        ni_registerModuleMethod(m, "Handle_setWordWrap", &Handle_setWordWrap__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSignalMask", &Handle_setSignalMask__wrapper);
-        ni_registerModuleMethod(m, "Handle_dispose", &Handle_dispose__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         auto signalHandler = ni_registerInterface(m, "SignalHandler");
         signalHandler_destroyed = ni_registerInterfaceMethod(signalHandler, "destroyed", &SignalHandler_destroyed__wrapper);
         signalHandler_objectNameChanged = ni_registerInterfaceMethod(signalHandler, "objectNameChanged", &SignalHandler_objectNameChanged__wrapper);
@@ -316,22 +316,25 @@ namespace MainWindow
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "create", &create__wrapper },
+            { "Handle_setAnimated", &Handle_setAnimated__wrapper },
+            { "Handle_setDockNestingEnabled", &Handle_setDockNestingEnabled__wrapper },
+            { "Handle_setDockOptions", &Handle_setDockOptions__wrapper },
+            { "Handle_setDocumentMode", &Handle_setDocumentMode__wrapper },
+            { "Handle_setIconSize", &Handle_setIconSize__wrapper },
+            { "Handle_setTabShape", &Handle_setTabShape__wrapper },
+            { "Handle_setToolButtonStyle", &Handle_setToolButtonStyle__wrapper },
+            { "Handle_setUnifiedTitleAndToolBarOnMac", &Handle_setUnifiedTitleAndToolBarOnMac__wrapper },
+            { "Handle_setCentralWidget", &Handle_setCentralWidget__wrapper },
+            { "Handle_setMenuBar", &Handle_setMenuBar__wrapper },
+            { "Handle_setStatusBar", &Handle_setStatusBar__wrapper },
+            { "Handle_addToolBar", &Handle_addToolBar__wrapper },
+            { "Handle_setSignalMask", &Handle_setSignalMask__wrapper },
+            { "Handle_dispose", &Handle_dispose__wrapper },
+        };
         auto m = ni_registerModule("MainWindow");
-        ni_registerModuleMethod(m, "create", &create__wrapper);
-        ni_registerModuleMethod(m, "Handle_setAnimated", &Handle_setAnimated__wrapper);
-        ni_registerModuleMethod(m, "Handle_setDockNestingEnabled", &Handle_setDockNestingEnabled__wrapper);
-        ni_registerModuleMethod(m, "Handle_setDockOptions", &Handle_setDockOptions__wrapper);
-        ni_registerModuleMethod(m, "Handle_setDocumentMode", &Handle_setDocumentMode__wrapper);
-        ni_registerModuleMethod(m, "Handle_setIconSize", &Handle_setIconSize__wrapper);
-        ni_registerModuleMethod(m, "Handle_setTabShape", &Handle_setTabShape__wrapper);
-        ni_registerModuleMethod(m, "Handle_setToolButtonStyle", &Handle_setToolButtonStyle__wrapper);
-        ni_registerModuleMethod(m, "Handle_setUnifiedTitleAndToolBarOnMac", &Handle_setUnifiedTitleAndToolBarOnMac__wrapper);
-        ni_registerModuleMethod(m, "Handle_setCentralWidget", &Handle_setCentralWidget__wrapper);
-        ni_registerModuleMethod(m, "Handle_setMenuBar", &Handle_setMenuBar__wrapper);
-        ni_registerModuleMethod(m, "Handle_setStatusBar", &Handle_setStatusBar__wrapper);
-        ni_registerModuleMethod(m, "Handle_addToolBar", &Handle_addToolBar__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSignalMask", &Handle_setSignalMask__wrapper);
-        ni_registerModuleMethod(m, "Handle_dispose", &Handle_dispose__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         auto signalHandler = ni_registerInterface(m, "SignalHandler");
         signalHandler_destroyed = ni_registerInterfaceMethod(signalHandler, "destroyed", &SignalHandler_destroyed__wrapper);
         signalHandler_objectNameChanged = ni_registerInterfaceMethod(signalHandler, "objectNameChanged", &SignalHandler_objectNameChanged__wrapper);
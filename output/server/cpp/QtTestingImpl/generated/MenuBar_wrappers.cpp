@@ -223,14 +223,17 @@ namespace MenuBar
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "create", &create__wrapper },
+            { "Handle_setDefaultUp", &Handle_setDefaultUp__wrapper },
+            { "Handle_setNativeMenuBar", &Handle_setNativeMenuBar__wrapper },
+            { "Handle_clear", &Handle_clear__wrapper },
+            { "Handle_addMenu", &Handle_addMenu__wrapper },
+            { "Handle_setSignalMask", &Handle_setSignalMask__wrapper },
+            { "Handle_dispose", &Handle_dispose__wrapper },
+        };
         auto m = ni_registerModule("MenuBar");
-        ni_registerModuleMethod(m, "create", &create__wrapper);
-        ni_registerModuleMethod(m, "Handle_setDefaultUp", &Handle_setDefaultUp__wrapper);
-        ni_registerModuleMethod(m, "Handle_setNativeMenuBar", &Handle_setNativeMenuBar__wrapper);
-        ni_registerModuleMethod(m, "Handle_clear", &Handle_clear__wrapper);
-        ni_registerModuleMethod(m, "Handle_addMenu", &Handle_addMenu__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSignalMask", &Handle_setSignalMask__wrapper);
-        ni_registerModuleMethod(m, "Handle_dispose", &Handle_dispose__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         auto signalHandler = ni_registerInterface(m, "SignalHandler");
         signalHandler_destroyed = ni_registerInterfaceMethod(signalHandler, "destroyed", &SignalHandler_destroyed__wrapper);
         signalHandler_objectNameChanged = ni_registerInterfaceMethod(signalHandler, "objectNameChanged", &SignalHandler_objectNameChanged__wrapper);
@@ -263,18 +263,21 @@ namespace Menu
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "create", &create__wrapper },
+            { "Handle_setIcon", &Handle_setIcon__wrapper },
+            { "Handle_setSeparatorsCollapsible", &Handle_setSeparatorsCollapsible__wrapper },
+            { "Handle_setTearOffEnabled", &Handle_setTearOffEnabled__wrapper },
+            { "Handle_setTitle", &Handle_setTitle__wrapper },
+            { "Handle_setToolTipsVisible", &Handle_setToolTipsVisible__wrapper },
+            { "Handle_clear", &Handle_clear__wrapper },
+            { "Handle_addSeparator", &Handle_addSeparator__wrapper },
+            { "Handle_popup", &Handle_popup__wrapper },
+            { "Handle_setSignalMask", &Handle_setSignalMask__wrapper },
+            { "Handle_dispose", &Handle_dispose__wrapper },
+        };
         auto m = ni_registerModule("Menu");
-        ni_registerModuleMethod(m, "create", &create__wrapper);
-        ni_registerModuleMethod(m, "Handle_setIcon", &Handle_setIcon__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSeparatorsCollapsible", &Handle_setSeparatorsCollapsible__wrapper);
-        ni_registerModuleMethod(m, "Handle_setTearOffEnabled", &Handle_setTearOffEnabled__wrapper);
-        ni_registerModuleMethod(m, "Handle_setTitle", &Handle_setTitle__wrapper);
-        ni_registerModuleMethod(m, "Handle_setToolTipsVisible", &Handle_setToolTipsVisible__wrapper);
-        ni_registerModuleMethod(m, "Handle_clear", &Handle_clear__wrapper);
-        ni_registerModuleMethod(m, "Handle_addSeparator", &Handle_addSeparator__wrapper);
-        ni_registerModuleMethod(m, "Handle_popup", &Handle_popup__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSignalMask", &Handle_setSignalMask__wrapper);
-        ni_registerModuleMethod(m, "Handle_dispose", &Handle_dispose__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         auto signalHandler = ni_registerInterface(m, "SignalHandler");
         signalHandler_destroyed = ni_registerInterfaceMethod(signalHandler, "destroyed", &SignalHandler_destroyed__wrapper);
         signalHandler_objectNameChanged = ni_registerInterfaceMethod(signalHandler, "objectNameChanged", &SignalHandler_objectNameChanged__wrapper);
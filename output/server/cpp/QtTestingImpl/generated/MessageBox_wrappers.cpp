@@ -308,19 +308,22 @@ namespace MessageBox
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "create", &create__wrapper },
+            { "Handle_setDetailedText", &Handle_setDetailedText__wrapper },
+            { "Handle_setIcon", &Handle_setIcon__wrapper },
+            { "Handle_setInformativeText", &Handle_setInformativeText__wrapper },
+            { "Handle_setOptions", &Handle_setOptions__wrapper },
+            { "Handle_setStandardButtons", &Handle_setStandardButtons__wrapper },
+            { "Handle_setText", &Handle_setText__wrapper },
+            { "Handle_setTextFormat", &Handle_setTextFormat__wrapper },
+            { "Handle_setTextInteractionFlags", &Handle_setTextInteractionFlags__wrapper },
+            { "Handle_setDefaultButton", &Handle_setDefaultButton__wrapper },
+            { "Handle_setSignalMask", &Handle_setSignalMask__wrapper },
+            { "Handle_dispose", &Handle_dispose__wrapper },
+        };
         auto m = ni_registerModule("MessageBox");
-        ni_registerModuleMethod(m, "create", &create__wrapper);
-        ni_registerModuleMethod(m, "Handle_setDetailedText", &Handle_setDetailedText__wrapper);
-        ni_registerModuleMethod(m, "Handle_setIcon", &Handle_setIcon__wrapper);
-        ni_registerModuleMethod(m, "Handle_setInformativeText", &Handle_setInformativeText__wrapper);
-        ni_registerModuleMethod(m, "Handle_setOptions", &Handle_setOptions__wrapper);
-        ni_registerModuleMethod(m, "Handle_setStandardButtons", &Handle_setStandardButtons__wrapper);
-        ni_registerModuleMethod(m, "Handle_setText", &Handle_setText__wrapper);
-        ni_registerModuleMethod(m, "Handle_setTextFormat", &Handle_setTextFormat__wrapper);
-        ni_registerModuleMethod(m, "Handle_setTextInteractionFlags", &Handle_setTextInteractionFlags__wrapper);
-        ni_registerModuleMethod(m, "Handle_setDefaultButton", &Handle_setDefaultButton__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSignalMask", &Handle_setSignalMask__wrapper);
-        ni_registerModuleMethod(m, "Handle_dispose", &Handle_dispose__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         auto signalHandler = ni_registerInterface(m, "SignalHandler");
         signalHandler_destroyed = ni_registerInterfaceMethod(signalHandler, "destroyed", &SignalHandler_destroyed__wrapper);
         signalHandler_objectNameChanged = ni_registerInterfaceMethod(signalHandler, "objectNameChanged", &SignalHandler_objectNameChanged__wrapper);
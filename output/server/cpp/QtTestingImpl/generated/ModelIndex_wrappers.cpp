@@ -94,12 +94,15 @@ namespace ModelIndex
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "Handle_isValid", &Handle_isValid__wrapper },
+            { "Handle_row", &Handle_row__wrapper },
+            { "Handle_column", &Handle_column__wrapper },
+            { "Handle_dispose", &Handle_dispose__wrapper },
+            { "OwnedHandle_dispose", &OwnedHandle_dispose__wrapper },
+        };
         auto m = ni_registerModule("ModelIndex");
-        ni_registerModuleMethod(m, "Handle_isValid", &Handle_isValid__wrapper);
-        ni_registerModuleMethod(m, "Handle_row", &Handle_row__wrapper);
-        ni_registerModuleMethod(m, "Handle_column", &Handle_column__wrapper);
-        ni_registerModuleMethod(m, "Handle_dispose", &Handle_dispose__wrapper);
-        ni_registerModuleMethod(m, "OwnedHandle_dispose", &OwnedHandle_dispose__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         return 0; // = OK
     }
 }
@@ -29,7 +29,7 @@ namespace Object
         virtual void objectNameChanged(std::string objectName) = 0;
     };
 
-    void Handle_setObjectName(HandleRef _this, std::string name);
+    void Handle_setObjectName(HandleRef _this, StringArg name);
     void Handle_dumpObjectTree(HandleRef _this);
     void Handle_dispose(HandleRef _this);
 }
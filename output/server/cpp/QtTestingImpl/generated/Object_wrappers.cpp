@@ -107,7 +107,7 @@ namespace Object
 
     void Handle_setObjectName__wrapper() {
         auto _this = Handle__pop();
-        auto name = popStringInternal();
+        auto name = popStringArg();
         Handle_setObjectName(_this, name);
     }
 
@@ -122,10 +122,13 @@ namespace Object
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "Handle_setObjectName", &Handle_setObjectName__wrapper },
+            { "Handle_dumpObjectTree", &Handle_dumpObjectTree__wrapper },
+            { "Handle_dispose", &Handle_dispose__wrapper },
+        };
         auto m = ni_registerModule("Object");
-        ni_registerModuleMethod(m, "Handle_setObjectName", &Handle_setObjectName__wrapper);
-        ni_registerModuleMethod(m, "Handle_dumpObjectTree", &Handle_dumpObjectTree__wrapper);
-        ni_registerModuleMethod(m, "Handle_dispose", &Handle_dispose__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         auto signalHandler = ni_registerInterface(m, "SignalHandler");
         signalHandler_destroyed = ni_registerInterfaceMethod(signalHandler, "destroyed", &SignalHandler_destroyed__wrapper);
         signalHandler_objectNameChanged = ni_registerInterfaceMethod(signalHandler, "objectNameChanged", &SignalHandler_objectNameChanged__wrapper);
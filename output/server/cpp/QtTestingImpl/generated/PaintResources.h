@@ -217,7 +217,7 @@ namespace PaintResources
     void PainterPathStroker_setJoinStyle(PainterPathStrokerRef _this, Pen::JoinStyle style);
     void PainterPathStroker_setCapStyle(PainterPathStrokerRef _this, Pen::CapStyle style);
     void PainterPathStroker_setDashPattern(PainterPathStrokerRef _this, Pen::Style style);
-    void PainterPathStroker_setDashPattern(PainterPathStrokerRef _this, std::vector<double> dashPattern);
+    void PainterPathStroker_setDashPattern(PainterPathStrokerRef _this, std::span<const double> dashPattern);
     PainterPathRef PainterPathStroker_createStroke(PainterPathStrokerRef _this, PainterPathRef path);
 
     ColorRef Handle_createColor(HandleRef _this, Color::Constant name);
@@ -315,7 +315,7 @@ namespace PaintResources
 
     void PainterPathStroker_setDashPattern_overload1__wrapper() {
         auto _this = PainterPathStroker__pop();
-        auto dashPattern = popDoubleArrayInternal();
+        auto dashPattern = popDoubleArrayView();
         PainterPathStroker_setDashPattern(_this, dashPattern);
     }
 
@@ -491,46 +491,49 @@ namespace PaintResources
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "create", &create__wrapper },
+            { "Gradient_setColorAt", &Gradient_setColorAt__wrapper },
+            { "Pen_setBrush", &Pen_setBrush__wrapper },
+            { "Pen_setWidth", &Pen_setWidth__wrapper },
+            { "Pen_setWidth_overload1", &Pen_setWidth_overload1__wrapper },
+            { "PainterPath_moveTo", &PainterPath_moveTo__wrapper },
+            { "PainterPath_moveTo_overload1", &PainterPath_moveTo_overload1__wrapper },
+            { "PainterPath_lineto", &PainterPath_lineto__wrapper },
+            { "PainterPath_lineTo_overload1", &PainterPath_lineTo_overload1__wrapper },
+            { "PainterPath_cubicTo", &PainterPath_cubicTo__wrapper },
+            { "PainterPath_cubicTo_overload1", &PainterPath_cubicTo_overload1__wrapper },
+            { "PainterPathStroker_setWidth", &PainterPathStroker_setWidth__wrapper },
+            { "PainterPathStroker_setJoinStyle", &PainterPathStroker_setJoinStyle__wrapper },
+            { "PainterPathStroker_setCapStyle", &PainterPathStroker_setCapStyle__wrapper },
+            { "PainterPathStroker_setDashPattern", &PainterPathStroker_setDashPattern__wrapper },
+            { "PainterPathStroker_setDashPattern_overload1", &PainterPathStroker_setDashPattern_overload1__wrapper },
+            { "PainterPathStroker_createStroke", &PainterPathStroker_createStroke__wrapper },
+            { "Handle_createColor", &Handle_createColor__wrapper },
+            { "Handle_createColor_overload1", &Handle_createColor_overload1__wrapper },
+            { "Handle_createColor_overload2", &Handle_createColor_overload2__wrapper },
+            { "Handle_createColor_overload3", &Handle_createColor_overload3__wrapper },
+            { "Handle_createColor_overload4", &Handle_createColor_overload4__wrapper },
+            { "Handle_createRadialGradient", &Handle_createRadialGradient__wrapper },
+            { "Handle_createLinearGradient", &Handle_createLinearGradient__wrapper },
+            { "Handle_createLinearGradient_overload1", &Handle_createLinearGradient_overload1__wrapper },
+            { "Handle_createBrush", &Handle_createBrush__wrapper },
+            { "Handle_createBrush_overload1", &Handle_createBrush_overload1__wrapper },
+            { "Handle_createBrush_overload2", &Handle_createBrush_overload2__wrapper },
+            { "Handle_createPen", &Handle_createPen__wrapper },
+            { "Handle_createPen_overload1", &Handle_createPen_overload1__wrapper },
+            { "Handle_createPen_overload2", &Handle_createPen_overload2__wrapper },
+            { "Handle_createPen_overload3", &Handle_createPen_overload3__wrapper },
+            { "Handle_createFont", &Handle_createFont__wrapper },
+            { "Handle_createFont_overload1", &Handle_createFont_overload1__wrapper },
+            { "Handle_createFont_overload2", &Handle_createFont_overload2__wrapper },
+            { "Handle_createPainterPath", &Handle_createPainterPath__wrapper },
+            { "Handle_createPainterPathStroker", &Handle_createPainterPathStroker__wrapper },
+            { "Handle_createStrokeInternal", &Handle_createStrokeInternal__wrapper },
+            { "Handle_dispose", &Handle_dispose__wrapper },
+        };
         auto m = ni_registerModule("PaintResources");
-        ni_registerModuleMethod(m, "create", &create__wrapper);
-        ni_registerModuleMethod(m, "Gradient_setColorAt", &Gradient_setColorAt__wrapper);
-        ni_registerModuleMethod(m, "Pen_setBrush", &Pen_setBrush__wrapper);
-        ni_registerModuleMethod(m, "Pen_setWidth", &Pen_setWidth__wrapper);
-        ni_registerModuleMethod(m, "Pen_setWidth_overload1", &Pen_setWidth_overload1__wrapper);
-        ni_registerModuleMethod(m, "PainterPath_moveTo", &PainterPath_moveTo__wrapper);
-        ni_registerModuleMethod(m, "PainterPath_moveTo_overload1", &PainterPath_moveTo_overload1__wrapper);
-        ni_registerModuleMethod(m, "PainterPath_lineto", &PainterPath_lineto__wrapper);
-        ni_registerModuleMethod(m, "PainterPath_lineTo_overload1", &PainterPath_lineTo_overload1__wrapper);
-        ni_registerModuleMethod(m, "PainterPath_cubicTo", &PainterPath_cubicTo__wrapper);
-        ni_registerModuleMethod(m, "PainterPath_cubicTo_overload1", &PainterPath_cubicTo_overload1__wrapper);
-        ni_registerModuleMethod(m, "PainterPathStroker_setWidth", &PainterPathStroker_setWidth__wrapper);
-        ni_registerModuleMethod(m, "PainterPathStroker_setJoinStyle", &PainterPathStroker_setJoinStyle__wrapper);
-        ni_registerModuleMethod(m, "PainterPathStroker_setCapStyle", &PainterPathStroker_setCapStyle__wrapper);
-        ni_registerModuleMethod(m, "PainterPathStroker_setDashPattern", &PainterPathStroker_setDashPattern__wrapper);
-        ni_registerModuleMethod(m, "PainterPathStroker_setDashPattern_overload1", &PainterPathStroker_setDashPattern_overload1__wrapper);
-        ni_registerModuleMethod(m, "PainterPathStroker_createStroke", &PainterPathStroker_createStroke__wrapper);
-        ni_registerModuleMethod(m, "Handle_createColor", &Handle_createColor__wrapper);
-        ni_registerModuleMethod(m, "Handle_createColor_overload1", &Handle_createColor_overload1__wrapper);
-        ni_registerModuleMethod(m, "Handle_createColor_overload2", &Handle_createColor_overload2__wrapper);
-        ni_registerModuleMethod(m, "Handle_createColor_overload3", &Handle_createColor_overload3__wrapper);
-        ni_registerModuleMethod(m, "Handle_createColor_overload4", &Handle_createColor_overload4__wrapper);
-        ni_registerModuleMethod(m, "Handle_createRadialGradient", &Handle_createRadialGradient__wrapper);
-        ni_registerModuleMethod(m, "Handle_createLinearGradient", &Handle_createLinearGradient__wrapper);
-        ni_registerModuleMethod(m, "Handle_createLinearGradient_overload1", &Handle_createLinearGradient_overload1__wrapper);
-        ni_registerModuleMethod(m, "Handle_createBrush", &Handle_createBrush__wrapper);
-        ni_registerModuleMethod(m, "Handle_createBrush_overload1", &Handle_createBrush_overload1__wrapper);
-        ni_registerModuleMethod(m, "Handle_createBrush_overload2", &Handle_createBrush_overload2__wrapper);
-        ni_registerModuleMethod(m, "Handle_createPen", &Handle_createPen__wrapper);
-        ni_registerModuleMethod(m, "Handle_createPen_overload1", &Handle_createPen_overload1__wrapper);
-        ni_registerModuleMethod(m, "Handle_createPen_overload2", &Handle_createPen_overload2__wrapper);
-        ni_registerModuleMethod(m, "Handle_createPen_overload3", &Handle_createPen_overload3__wrapper);
-        ni_registerModuleMethod(m, "Handle_createFont", &Handle_createFont__wrapper);
-        ni_registerModuleMethod(m, "Handle_createFont_overload1", &Handle_createFont_overload1__wrapper);
-        ni_registerModuleMethod(m, "Handle_createFont_overload2", &Handle_createFont_overload2__wrapper);
-        ni_registerModuleMethod(m, "Handle_createPainterPath", &Handle_createPainterPath__wrapper);
-        ni_registerModuleMethod(m, "Handle_createPainterPathStroker", &Handle_createPainterPathStroker__wrapper);
-        ni_registerModuleMethod(m, "Handle_createStrokeInternal", &Handle_createStrokeInternal__wrapper);
-        ni_registerModuleMethod(m, "Handle_dispose", &Handle_dispose__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         return 0; // = OK
     }
 }
@@ -60,6 +60,6 @@ namespace Painter
     void Handle_drawEllipse(HandleRef _this, int32_t x, int32_t y, int32_t width, int32_t height);
     void Handle_drawEllipse(HandleRef _this, Common::PointF center, double rx, double ry);
     void Handle_drawEllipse(HandleRef _this, Common::Point center, int32_t rx, int32_t ry);
-    void Handle_drawPolyline(HandleRef _this, std::vector<Common::PointF> points);
-    void Handle_drawPolyline(HandleRef _this, std::vector<Common::Point> points);
+    void Handle_drawPolyline(HandleRef _this, std::span<const Common::PointF> points);
+    void Handle_drawPolyline(HandleRef _this, std::span<const Common::Point> points);
 }
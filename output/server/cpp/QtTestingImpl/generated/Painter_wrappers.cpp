@@ -13,53 +13,37 @@ using namespace ::Enums;
 
 namespace Painter
 {
-    // built-in array type: std::vector<int32_t>
+    // POD struct array, crosses as one contiguous block
     void __Point_Array__push(std::vector<Point> values, bool isReturn) {
-        std::vector<int32_t> y_values;
-        std::vector<int32_t> x_values;
-        for (auto v = values.begin(); v != values.end(); v++) {
-            y_values.push_back(v->y);
-            x_values.push_back(v->x);
-        }
-        pushInt32ArrayInternal(y_values);
-        pushInt32ArrayInternal(x_values);
+        ni_pushStructArray(Point__typeId, values.data(), values.size());
+    }
+
+    std::span<const Point> __Point_Array__popView() {
+        const void* values;
+        size_t count;
+        ni_popStructArrayView(Point__typeId, &values, &count);
+        return { (const Point*)values, count };
     }
 
     std::vector<Point> __Point_Array__pop() {
-        auto x_values = popInt32ArrayInternal();
-        auto y_values = popInt32ArrayInternal();
-        std::vector<Point> __ret;
-        for (auto i = 0; i < x_values.size(); i++) {
-            Point __value;
-            __value.x = x_values[i];
-            __value.y = y_values[i];
-            __ret.push_back(__value);
-        }
-        return __ret;
-    }
-    // built-in array type: std::vector<double>
+        auto values = __Point_Array__popView();
+        return std::vector<Point>(values.begin(), values.end());
+    }
+    // POD struct array, crosses as one contiguous block
     void __PointF_Array__push(std::vector<PointF> values, bool isReturn) {
-        std::vector<double> y_values;
-        std::vector<double> x_values;
-        for (auto v = values.begin(); v != values.end(); v++) {
-            y_values.push_back(v->y);
-            x_values.push_back(v->x);
-        }
-        pushDoubleArrayInternal(y_values);
-        pushDoubleArrayInternal(x_values);
+        ni_pushStructArray(PointF__typeId, values.data(), values.size());
+    }
+
+    std::span<const PointF> __PointF_Array__popView() {
+        const void* values;
+        size_t count;
+        ni_popStructArrayView(PointF__typeId, &values, &count);
+        return { (const PointF*)values, count };
     }
 
     std::vector<PointF> __PointF_Array__pop() {
-        auto x_values = popDoubleArrayInternal();
-        auto y_values = popDoubleArrayInternal();
-        std::vector<PointF> __ret;
-        for (auto i = 0; i < x_values.size(); i++) {
-            PointF __value;
-            __value.x = x_values[i];
-            __value.y = y_values[i];
-            __ret.push_back(__value);
-        }
-        return __ret;
+        auto values = __PointF_Array__popView();
+        return std::vector<PointF>(values.begin(), values.end());
     }
     void RenderHint__push(RenderHint value) {
         ni_pushInt32((int32_t)value);
@@ -212,38 +196,41 @@ namespace Painter
 
     void Handle_drawPolyline__wrapper() {
         auto _this = Handle__pop();
-        auto points = __PointF_Array__pop();
+        auto points = __PointF_Array__popView();
         Handle_drawPolyline(_this, points);
     }
 
     void Handle_drawPolyline_overload1__wrapper() {
         auto _this = Handle__pop();
-        auto points = __Point_Array__pop();
+        auto points = __Point_Array__popView();
         Handle_drawPolyline(_this, points);
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "Handle_setRenderHint", &Handle_setRenderHint__wrapper },
+            { "Handle_setRenderHints", &Handle_setRenderHints__wrapper },
+            { "Handle_setPen", &Handle_setPen__wrapper },
+            { "Handle_setBrush", &Handle_setBrush__wrapper },
+            { "Handle_setFont", &Handle_setFont__wrapper },
+            { "Handle_drawText", &Handle_drawText__wrapper },
+            { "Handle_fillPath", &Handle_fillPath__wrapper },
+            { "Handle_strokePath", &Handle_strokePath__wrapper },
+            { "Handle_fillRect", &Handle_fillRect__wrapper },
+            { "Handle_fillRect_overload1", &Handle_fillRect_overload1__wrapper },
+            { "Handle_drawRect", &Handle_drawRect__wrapper },
+            { "Handle_drawRect_overload1", &Handle_drawRect_overload1__wrapper },
+            { "Handle_drawRect_overload2", &Handle_drawRect_overload2__wrapper },
+            { "Handle_drawEllipse", &Handle_drawEllipse__wrapper },
+            { "Handle_drawEllipse_overload1", &Handle_drawEllipse_overload1__wrapper },
+            { "Handle_drawEllipse_overload2", &Handle_drawEllipse_overload2__wrapper },
+            { "Handle_drawEllipse_overload3", &Handle_drawEllipse_overload3__wrapper },
+            { "Handle_drawEllipse_overload4", &Handle_drawEllipse_overload4__wrapper },
+            { "Handle_drawPolyline", &Handle_drawPolyline__wrapper },
+            { "Handle_drawPolyline_overload1", &Handle_drawPolyline_overload1__wrapper },
+        };
         auto m = ni_registerModule("Painter");
-        ni_registerModuleMethod(m, "Handle_setRenderHint", &Handle_setRenderHint__wrapper);
-        ni_registerModuleMethod(m, "Handle_setRenderHints", &Handle_setRenderHints__wrapper);
-        ni_registerModuleMethod(m, "Handle_setPen", &Handle_setPen__wrapper);
-        ni_registerModuleMethod(m, "Handle_setBrush", &Handle_setBrush__wrapper);
-        ni_registerModuleMethod(m, "Handle_setFont", &Handle_setFont__wrapper);
-        ni_registerModuleMethod(m, "Handle_drawText", &Handle_drawText__wrapper);
-        ni_registerModuleMethod(m, "Handle_fillPath", &Handle_fillPath__wrapper);
-        ni_registerModuleMethod(m, "Handle_strokePath", &Handle_strokePath__wrapper);
-        ni_registerModuleMethod(m, "Handle_fillRect", &Handle_fillRect__wrapper);
-        ni_registerModuleMethod(m, "Handle_fillRect_overload1", &Handle_fillRect_overload1__wrapper);
-        ni_registerModuleMethod(m, "Handle_drawRect", &Handle_drawRect__wrapper);
-        ni_registerModuleMethod(m, "Handle_drawRect_overload1", &Handle_drawRect_overload1__wrapper);
-        ni_registerModuleMethod(m, "Handle_drawRect_overload2", &Handle_drawRect_overload2__wrapper);
-        ni_registerModuleMethod(m, "Handle_drawEllipse", &Handle_drawEllipse__wrapper);
-        ni_registerModuleMethod(m, "Handle_drawEllipse_overload1", &Handle_drawEllipse_overload1__wrapper);
-        ni_registerModuleMethod(m, "Handle_drawEllipse_overload2", &Handle_drawEllipse_overload2__wrapper);
-        ni_registerModuleMethod(m, "Handle_drawEllipse_overload3", &Handle_drawEllipse_overload3__wrapper);
-        ni_registerModuleMethod(m, "Handle_drawEllipse_overload4", &Handle_drawEllipse_overload4__wrapper);
-        ni_registerModuleMethod(m, "Handle_drawPolyline", &Handle_drawPolyline__wrapper);
-        ni_registerModuleMethod(m, "Handle_drawPolyline_overload1", &Handle_drawPolyline_overload1__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         return 0; // = OK
     }
 }
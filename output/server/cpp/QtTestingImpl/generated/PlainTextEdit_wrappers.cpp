@@ -388,27 +388,30 @@ namespace PlainTextEdit
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "create", &create__wrapper },
+            { "Handle_setBackgroundVisible", &Handle_setBackgroundVisible__wrapper },
+            { "Handle_blockCount", &Handle_blockCount__wrapper },
+            { "Handle_setCenterOnScroll", &Handle_setCenterOnScroll__wrapper },
+            { "Handle_setCursorWidth", &Handle_setCursorWidth__wrapper },
+            { "Handle_setDocumentTitle", &Handle_setDocumentTitle__wrapper },
+            { "Handle_setLineWrapMode", &Handle_setLineWrapMode__wrapper },
+            { "Handle_setMaximumBlockCount", &Handle_setMaximumBlockCount__wrapper },
+            { "Handle_setOverwriteMode", &Handle_setOverwriteMode__wrapper },
+            { "Handle_setPlaceholderText", &Handle_setPlaceholderText__wrapper },
+            { "Handle_setPlainText", &Handle_setPlainText__wrapper },
+            { "Handle_setReadOnly", &Handle_setReadOnly__wrapper },
+            { "Handle_setTabChangesFocus", &Handle_setTabChangesFocus__wrapper },
+            { "Handle_setTabStopDistance", &Handle_setTabStopDistance__wrapper },
+            { "Handle_setTextInteractionFlags", &Handle_setTextInteractionFlags__wrapper },
+            { "Handle_setUndoRedoEnabled", &Handle_setUndoRedoEnabled__wrapper },
+            { "Handle_setWordWrapMode", &Handle_setWordWrapMode__wrapper },
+            { "Handle_toPlainText", &Handle_toPlainText__wrapper },
+            { "Handle_setSignalMask", &Handle_setSignalMask__wrapper },
+            { "Handle_dispose", &Handle_dispose__wrapper },
+        };
         auto m = ni_registerModule("PlainTextEdit");
-        ni_registerModuleMethod(m, "create", &create__wrapper);
-        ni_registerModuleMethod(m, "Handle_setBackgroundVisible", &Handle_setBackgroundVisible__wrapper);
-        ni_registerModuleMethod(m, "Handle_blockCount", &Handle_blockCount__wrapper);
-        ni_registerModuleMethod(m, "Handle_setCenterOnScroll", &Handle_setCenterOnScroll__wrapper);
-        ni_registerModuleMethod(m, "Handle_setCursorWidth", &Handle_setCursorWidth__wrapper);
-        ni_registerModuleMethod(m, "Handle_setDocumentTitle", &Handle_setDocumentTitle__wrapper);
-        ni_registerModuleMethod(m, "Handle_setLineWrapMode", &Handle_setLineWrapMode__wrapper);
-        ni_registerModuleMethod(m, "Handle_setMaximumBlockCount", &Handle_setMaximumBlockCount__wrapper);
-        ni_registerModuleMethod(m, "Handle_setOverwriteMode", &Handle_setOverwriteMode__wrapper);
-        ni_registerModuleMethod(m, "Handle_setPlaceholderText", &Handle_setPlaceholderText__wrapper);
-        ni_registerModuleMethod(m, "Handle_setPlainText", &Handle_setPlainText__wrapper);
-        ni_registerModuleMethod(m, "Handle_setReadOnly", &Handle_setReadOnly__wrapper);
-        ni_registerModuleMethod(m, "Handle_setTabChangesFocus", &Handle_setTabChangesFocus__wrapper);
-        ni_registerModuleMethod(m, "Handle_setTabStopDistance", &Handle_setTabStopDistance__wrapper);
-        ni_registerModuleMethod(m, "Handle_setTextInteractionFlags", &Handle_setTextInteractionFlags__wrapper);
-        ni_registerModuleMethod(m, "Handle_setUndoRedoEnabled", &Handle_setUndoRedoEnabled__wrapper);
-        ni_registerModuleMethod(m, "Handle_setWordWrapMode", &Handle_setWordWrapMode__wrapper);
-        ni_registerModuleMethod(m, "Handle_toPlainText", &Handle_toPlainText__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSignalMask", &Handle_setSignalMask__wrapper);
-        ni_registerModuleMethod(m, "Handle_dispose", &Handle_dispose__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         auto signalHandler = ni_registerInterface(m, "SignalHandler");
         signalHandler_destroyed = ni_registerInterfaceMethod(signalHandler, "destroyed", &SignalHandler_destroyed__wrapper);
         signalHandler_objectNameChanged = ni_registerInterfaceMethod(signalHandler, "objectNameChanged", &SignalHandler_objectNameChanged__wrapper);
@@ -259,21 +259,24 @@ namespace ProgressBar
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "create", &create__wrapper },
+            { "Handle_setAlignment", &Handle_setAlignment__wrapper },
+            { "Handle_setFormat", &Handle_setFormat__wrapper },
+            { "Handle_setInvertedAppearance", &Handle_setInvertedAppearance__wrapper },
+            { "Handle_setMaximum", &Handle_setMaximum__wrapper },
+            { "Handle_setMinimum", &Handle_setMinimum__wrapper },
+            { "Handle_setOrientation", &Handle_setOrientation__wrapper },
+            { "Handle_text", &Handle_text__wrapper },
+            { "Handle_setTextDirection", &Handle_setTextDirection__wrapper },
+            { "Handle_setTextVisible", &Handle_setTextVisible__wrapper },
+            { "Handle_setValue", &Handle_setValue__wrapper },
+            { "Handle_setRange", &Handle_setRange__wrapper },
+            { "Handle_setSignalMask", &Handle_setSignalMask__wrapper },
+            { "Handle_dispose", &Handle_dispose__wrapper },
+        };
         auto m = ni_registerModule("ProgressBar");
-        ni_registerModuleMethod(m, "create", &create__wrapper);
-        ni_registerModuleMethod(m, "Handle_setAlignment", &Handle_setAlignment__wrapper);
-        ni_registerModuleMethod(m, "Handle_setFormat", &Handle_setFormat__wrapper);
-        ni_registerModuleMethod(m, "Handle_setInvertedAppearance", &Handle_setInvertedAppearance__wrapper);
-        ni_registerModuleMethod(m, "Handle_setMaximum", &Handle_setMaximum__wrapper);
-        ni_registerModuleMethod(m, "Handle_setMinimum", &Handle_setMinimum__wrapper);
-        ni_registerModuleMethod(m, "Handle_setOrientation", &Handle_setOrientation__wrapper);
-        ni_registerModuleMethod(m, "Handle_text", &Handle_text__wrapper);
-        ni_registerModuleMethod(m, "Handle_setTextDirection", &Handle_setTextDirection__wrapper);
-        ni_registerModuleMethod(m, "Handle_setTextVisible", &Handle_setTextVisible__wrapper);
-        ni_registerModuleMethod(m, "Handle_setValue", &Handle_setValue__wrapper);
-        ni_registerModuleMethod(m, "Handle_setRange", &Handle_setRange__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSignalMask", &Handle_setSignalMask__wrapper);
-        ni_registerModuleMethod(m, "Handle_dispose", &Handle_dispose__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         auto signalHandler = ni_registerInterface(m, "SignalHandler");
         signalHandler_destroyed = ni_registerInterfaceMethod(signalHandler, "destroyed", &SignalHandler_destroyed__wrapper);
         signalHandler_objectNameChanged = ni_registerInterfaceMethod(signalHandler, "objectNameChanged", &SignalHandler_objectNameChanged__wrapper);
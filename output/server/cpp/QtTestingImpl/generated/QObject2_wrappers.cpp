@@ -27,9 +27,12 @@ namespace QObject2
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "Handle_onDestroyed", &Handle_onDestroyed__wrapper },
+            { "Handle_dispose", &Handle_dispose__wrapper },
+        };
         auto m = ni_registerModule("QObject2");
-        ni_registerModuleMethod(m, "Handle_onDestroyed", &Handle_onDestroyed__wrapper);
-        ni_registerModuleMethod(m, "Handle_dispose", &Handle_dispose__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         return 0; // = OK
     }
 }
@@ -59,9 +59,12 @@ namespace Region
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "Handle_dispose", &Handle_dispose__wrapper },
+            { "OwnedHandle_dispose", &OwnedHandle_dispose__wrapper },
+        };
         auto m = ni_registerModule("Region");
-        ni_registerModuleMethod(m, "Handle_dispose", &Handle_dispose__wrapper);
-        ni_registerModuleMethod(m, "OwnedHandle_dispose", &OwnedHandle_dispose__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         return 0; // = OK
     }
 }
@@ -194,13 +194,16 @@ namespace ScrollArea
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "create", &create__wrapper },
+            { "Handle_setAlignment", &Handle_setAlignment__wrapper },
+            { "Handle_setWidgetResizable", &Handle_setWidgetResizable__wrapper },
+            { "Handle_setWidget", &Handle_setWidget__wrapper },
+            { "Handle_setSignalMask", &Handle_setSignalMask__wrapper },
+            { "Handle_dispose", &Handle_dispose__wrapper },
+        };
         auto m = ni_registerModule("ScrollArea");
-        ni_registerModuleMethod(m, "create", &create__wrapper);
-        ni_registerModuleMethod(m, "Handle_setAlignment", &Handle_setAlignment__wrapper);
-        ni_registerModuleMethod(m, "Handle_setWidgetResizable", &Handle_setWidgetResizable__wrapper);
-        ni_registerModuleMethod(m, "Handle_setWidget", &Handle_setWidget__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSignalMask", &Handle_setSignalMask__wrapper);
-        ni_registerModuleMethod(m, "Handle_dispose", &Handle_dispose__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         auto signalHandler = ni_registerInterface(m, "SignalHandler");
         signalHandler_destroyed = ni_registerInterfaceMethod(signalHandler, "destroyed", &SignalHandler_destroyed__wrapper);
         signalHandler_objectNameChanged = ni_registerInterfaceMethod(signalHandler, "objectNameChanged", &SignalHandler_objectNameChanged__wrapper);
@@ -30,9 +30,9 @@ namespace SortFilterProxyModel
     }
 
     std::vector<PersistentModelIndex::HandleRef> __PersistentModelIndex_Handle_Array__pop() {
-        PersistentModelIndex::HandleRef *values;
+        PersistentModelIndex::HandleRef const *values;
         size_t count;
-        ni_popPtrArray((void***)&values, &count);
+        ni_popPtrArrayView((void* const**)&values, &count);
         return std::vector<PersistentModelIndex::HandleRef>(values, values + count);
     }
     void __ItemDataRole_Array__push(std::vector<ItemDataRole> values, bool isReturn) {
@@ -44,8 +44,9 @@ namespace SortFilterProxyModel
     }
 
     std::vector<ItemDataRole> __ItemDataRole_Array__pop() {
-        auto intValues = popInt8ArrayInternal();
+        auto intValues = popInt8ArrayView();
         std::vector<ItemDataRole> __ret;
+        __ret.reserve(intValues.size());
         for (auto i = intValues.begin(); i != intValues.end(); i++) {
             __ret.push_back((ItemDataRole)*i);
         }
@@ -611,20 +612,23 @@ namespace SortFilterProxyModel
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "create", &create__wrapper },
+            { "Handle_setAutoAcceptChildRows", &Handle_setAutoAcceptChildRows__wrapper },
+            { "Handle_setDynamicSortFilter", &Handle_setDynamicSortFilter__wrapper },
+            { "Handle_setFilterCaseSensitivity", &Handle_setFilterCaseSensitivity__wrapper },
+            { "Handle_setFilterKeyColumn", &Handle_setFilterKeyColumn__wrapper },
+            { "Handle_setFilterRegularExpression", &Handle_setFilterRegularExpression__wrapper },
+            { "Handle_setFilterRole", &Handle_setFilterRole__wrapper },
+            { "Handle_setSortLocaleAware", &Handle_setSortLocaleAware__wrapper },
+            { "Handle_setRecursiveFilteringEnabled", &Handle_setRecursiveFilteringEnabled__wrapper },
+            { "Handle_setSortCaseSensitivity", &Handle_setSortCaseSensitivity__wrapper },
+            { "Handle_setSortRole", &Handle_setSortRole__wrapper },
+            { "Handle_setSignalMask", &Handle_setSignalMask__wrapper },
+            { "Handle_dispose", &Handle_dispose__wrapper },
+        };
         auto m = ni_registerModule("SortFilterProxyModel");
-        ni_registerModuleMethod(m, "create", &create__wrapper);
-        ni_registerModuleMethod(m, "Handle_setAutoAcceptChildRows", &Handle_setAutoAcceptChildRows__wrapper);
-        ni_registerModuleMethod(m, "Handle_setDynamicSortFilter", &Handle_setDynamicSortFilter__wrapper);
-        ni_registerModuleMethod(m, "Handle_setFilterCaseSensitivity", &Handle_setFilterCaseSensitivity__wrapper);
-        ni_registerModuleMethod(m, "Handle_setFilterKeyColumn", &Handle_setFilterKeyColumn__wrapper);
-        ni_registerModuleMethod(m, "Handle_setFilterRegularExpression", &Handle_setFilterRegularExpression__wrapper);
-        ni_registerModuleMethod(m, "Handle_setFilterRole", &Handle_setFilterRole__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSortLocaleAware", &Handle_setSortLocaleAware__wrapper);
-        ni_registerModuleMethod(m, "Handle_setRecursiveFilteringEnabled", &Handle_setRecursiveFilteringEnabled__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSortCaseSensitivity", &Handle_setSortCaseSensitivity__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSortRole", &Handle_setSortRole__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSignalMask", &Handle_setSignalMask__wrapper);
-        ni_registerModuleMethod(m, "Handle_dispose", &Handle_dispose__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         auto signalHandler = ni_registerInterface(m, "SignalHandler");
         signalHandler_destroyed = ni_registerInterfaceMethod(signalHandler, "destroyed", &SignalHandler_destroyed__wrapper);
         signalHandler_objectNameChanged = ni_registerInterfaceMethod(signalHandler, "objectNameChanged", &SignalHandler_objectNameChanged__wrapper);
@@ -205,14 +205,17 @@ namespace StatusBar
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "create", &create__wrapper },
+            { "Handle_isSizeGripEnabled", &Handle_isSizeGripEnabled__wrapper },
+            { "Handle_setSizeGripEnabled", &Handle_setSizeGripEnabled__wrapper },
+            { "Handle_clearMessage", &Handle_clearMessage__wrapper },
+            { "Handle_showMessage", &Handle_showMessage__wrapper },
+            { "Handle_setSignalMask", &Handle_setSignalMask__wrapper },
+            { "Handle_dispose", &Handle_dispose__wrapper },
+        };
         auto m = ni_registerModule("StatusBar");
-        ni_registerModuleMethod(m, "create", &create__wrapper);
-        ni_registerModuleMethod(m, "Handle_isSizeGripEnabled", &Handle_isSizeGripEnabled__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSizeGripEnabled", &Handle_setSizeGripEnabled__wrapper);
-        ni_registerModuleMethod(m, "Handle_clearMessage", &Handle_clearMessage__wrapper);
-        ni_registerModuleMethod(m, "Handle_showMessage", &Handle_showMessage__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSignalMask", &Handle_setSignalMask__wrapper);
-        ni_registerModuleMethod(m, "Handle_dispose", &Handle_dispose__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         auto signalHandler = ni_registerInterface(m, "SignalHandler");
         signalHandler_destroyed = ni_registerInterfaceMethod(signalHandler, "destroyed", &SignalHandler_destroyed__wrapper);
         signalHandler_objectNameChanged = ni_registerInterfaceMethod(signalHandler, "objectNameChanged", &SignalHandler_objectNameChanged__wrapper);
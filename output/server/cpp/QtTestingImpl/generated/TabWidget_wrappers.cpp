@@ -334,26 +334,29 @@ namespace TabWidget
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "create", &create__wrapper },
+            { "Handle_count", &Handle_count__wrapper },
+            { "Handle_setCurrentIndex", &Handle_setCurrentIndex__wrapper },
+            { "Handle_setDocumentMode", &Handle_setDocumentMode__wrapper },
+            { "Handle_setElideMode", &Handle_setElideMode__wrapper },
+            { "Handle_setIconSize", &Handle_setIconSize__wrapper },
+            { "Handle_setMovable", &Handle_setMovable__wrapper },
+            { "Handle_setTabBarAutoHide", &Handle_setTabBarAutoHide__wrapper },
+            { "Handle_setTabPosition", &Handle_setTabPosition__wrapper },
+            { "Handle_setTabShape", &Handle_setTabShape__wrapper },
+            { "Handle_setTabsClosable", &Handle_setTabsClosable__wrapper },
+            { "Handle_setUsesScrollButtons", &Handle_setUsesScrollButtons__wrapper },
+            { "Handle_addTab", &Handle_addTab__wrapper },
+            { "Handle_insertTab", &Handle_insertTab__wrapper },
+            { "Handle_widgetAt", &Handle_widgetAt__wrapper },
+            { "Handle_clear", &Handle_clear__wrapper },
+            { "Handle_removeTab", &Handle_removeTab__wrapper },
+            { "Handle_setSignalMask", &Handle_setSignalMask__wrapper },
+            { "Handle_dispose", &Handle_dispose__wrapper },
+        };
         auto m = ni_registerModule("TabWidget");
-        ni_registerModuleMethod(m, "create", &create__wrapper);
-        ni_registerModuleMethod(m, "Handle_count", &Handle_count__wrapper);
-        ni_registerModuleMethod(m, "Handle_setCurrentIndex", &Handle_setCurrentIndex__wrapper);
-        ni_registerModuleMethod(m, "Handle_setDocumentMode", &Handle_setDocumentMode__wrapper);
-        ni_registerModuleMethod(m, "Handle_setElideMode", &Handle_setElideMode__wrapper);
-        ni_registerModuleMethod(m, "Handle_setIconSize", &Handle_setIconSize__wrapper);
-        ni_registerModuleMethod(m, "Handle_setMovable", &Handle_setMovable__wrapper);
-        ni_registerModuleMethod(m, "Handle_setTabBarAutoHide", &Handle_setTabBarAutoHide__wrapper);
-        ni_registerModuleMethod(m, "Handle_setTabPosition", &Handle_setTabPosition__wrapper);
-        ni_registerModuleMethod(m, "Handle_setTabShape", &Handle_setTabShape__wrapper);
-        ni_registerModuleMethod(m, "Handle_setTabsClosable", &Handle_setTabsClosable__wrapper);
-        ni_registerModuleMethod(m, "Handle_setUsesScrollButtons", &Handle_setUsesScrollButtons__wrapper);
-        ni_registerModuleMethod(m, "Handle_addTab", &Handle_addTab__wrapper);
-        ni_registerModuleMethod(m, "Handle_insertTab", &Handle_insertTab__wrapper);
-        ni_registerModuleMethod(m, "Handle_widgetAt", &Handle_widgetAt__wrapper);
-        ni_registerModuleMethod(m, "Handle_clear", &Handle_clear__wrapper);
-        ni_registerModuleMethod(m, "Handle_removeTab", &Handle_removeTab__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSignalMask", &Handle_setSignalMask__wrapper);
-        ni_registerModuleMethod(m, "Handle_dispose", &Handle_dispose__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         auto signalHandler = ni_registerInterface(m, "SignalHandler");
         signalHandler_destroyed = ni_registerInterfaceMethod(signalHandler, "destroyed", &SignalHandler_destroyed__wrapper);
         signalHandler_objectNameChanged = ni_registerInterfaceMethod(signalHandler, "objectNameChanged", &SignalHandler_objectNameChanged__wrapper);
@@ -182,18 +182,21 @@ namespace Timer
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "create", &create__wrapper },
+            { "Handle_isActive", &Handle_isActive__wrapper },
+            { "Handle_setInterval", &Handle_setInterval__wrapper },
+            { "Handle_remainingTime", &Handle_remainingTime__wrapper },
+            { "Handle_setSingleShot", &Handle_setSingleShot__wrapper },
+            { "Handle_setTimerType", &Handle_setTimerType__wrapper },
+            { "Handle_start", &Handle_start__wrapper },
+            { "Handle_start_overload1", &Handle_start_overload1__wrapper },
+            { "Handle_stop", &Handle_stop__wrapper },
+            { "Handle_setSignalMask", &Handle_setSignalMask__wrapper },
+            { "Handle_dispose", &Handle_dispose__wrapper },
+        };
         auto m = ni_registerModule("Timer");
-        ni_registerModuleMethod(m, "create", &create__wrapper);
-        ni_registerModuleMethod(m, "Handle_isActive", &Handle_isActive__wrapper);
-        ni_registerModuleMethod(m, "Handle_setInterval", &Handle_setInterval__wrapper);
-        ni_registerModuleMethod(m, "Handle_remainingTime", &Handle_remainingTime__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSingleShot", &Handle_setSingleShot__wrapper);
-        ni_registerModuleMethod(m, "Handle_setTimerType", &Handle_setTimerType__wrapper);
-        ni_registerModuleMethod(m, "Handle_start", &Handle_start__wrapper);
-        ni_registerModuleMethod(m, "Handle_start_overload1", &Handle_start_overload1__wrapper);
-        ni_registerModuleMethod(m, "Handle_stop", &Handle_stop__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSignalMask", &Handle_setSignalMask__wrapper);
-        ni_registerModuleMethod(m, "Handle_dispose", &Handle_dispose__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         auto signalHandler = ni_registerInterface(m, "SignalHandler");
         signalHandler_destroyed = ni_registerInterfaceMethod(signalHandler, "destroyed", &SignalHandler_destroyed__wrapper);
         signalHandler_objectNameChanged = ni_registerInterfaceMethod(signalHandler, "objectNameChanged", &SignalHandler_objectNameChanged__wrapper);
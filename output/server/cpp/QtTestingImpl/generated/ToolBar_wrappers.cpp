@@ -329,20 +329,23 @@ namespace ToolBar
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "create", &create__wrapper },
+            { "Handle_setAllowedAreas", &Handle_setAllowedAreas__wrapper },
+            { "Handle_setFloatable", &Handle_setFloatable__wrapper },
+            { "Handle_isFloating", &Handle_isFloating__wrapper },
+            { "Handle_setIconSize", &Handle_setIconSize__wrapper },
+            { "Handle_setMovable", &Handle_setMovable__wrapper },
+            { "Handle_setOrientation", &Handle_setOrientation__wrapper },
+            { "Handle_setToolButtonStyle", &Handle_setToolButtonStyle__wrapper },
+            { "Handle_addSeparator", &Handle_addSeparator__wrapper },
+            { "Handle_addWidget", &Handle_addWidget__wrapper },
+            { "Handle_clear", &Handle_clear__wrapper },
+            { "Handle_setSignalMask", &Handle_setSignalMask__wrapper },
+            { "Handle_dispose", &Handle_dispose__wrapper },
+        };
         auto m = ni_registerModule("ToolBar");
-        ni_registerModuleMethod(m, "create", &create__wrapper);
-        ni_registerModuleMethod(m, "Handle_setAllowedAreas", &Handle_setAllowedAreas__wrapper);
-        ni_registerModuleMethod(m, "Handle_setFloatable", &Handle_setFloatable__wrapper);
-        ni_registerModuleMethod(m, "Handle_isFloating", &Handle_isFloating__wrapper);
-        ni_registerModuleMethod(m, "Handle_setIconSize", &Handle_setIconSize__wrapper);
-        ni_registerModuleMethod(m, "Handle_setMovable", &Handle_setMovable__wrapper);
-        ni_registerModuleMethod(m, "Handle_setOrientation", &Handle_setOrientation__wrapper);
-        ni_registerModuleMethod(m, "Handle_setToolButtonStyle", &Handle_setToolButtonStyle__wrapper);
-        ni_registerModuleMethod(m, "Handle_addSeparator", &Handle_addSeparator__wrapper);
-        ni_registerModuleMethod(m, "Handle_addWidget", &Handle_addWidget__wrapper);
-        ni_registerModuleMethod(m, "Handle_clear", &Handle_clear__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSignalMask", &Handle_setSignalMask__wrapper);
-        ni_registerModuleMethod(m, "Handle_dispose", &Handle_dispose__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         auto signalHandler = ni_registerInterface(m, "SignalHandler");
         signalHandler_destroyed = ni_registerInterfaceMethod(signalHandler, "destroyed", &SignalHandler_destroyed__wrapper);
         signalHandler_objectNameChanged = ni_registerInterfaceMethod(signalHandler, "objectNameChanged", &SignalHandler_objectNameChanged__wrapper);
@@ -348,21 +348,24 @@ namespace TreeView
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "create", &create__wrapper },
+            { "Handle_setAllColumnsShowFocus", &Handle_setAllColumnsShowFocus__wrapper },
+            { "Handle_setAnimated", &Handle_setAnimated__wrapper },
+            { "Handle_setAutoExpandDelay", &Handle_setAutoExpandDelay__wrapper },
+            { "Handle_setExpandsOnDoubleClick", &Handle_setExpandsOnDoubleClick__wrapper },
+            { "Handle_setHeaderHidden", &Handle_setHeaderHidden__wrapper },
+            { "Handle_setIndentation", &Handle_setIndentation__wrapper },
+            { "Handle_setItemsExpandable", &Handle_setItemsExpandable__wrapper },
+            { "Handle_setRootIsDecorated", &Handle_setRootIsDecorated__wrapper },
+            { "Handle_setSortingEnabled", &Handle_setSortingEnabled__wrapper },
+            { "Handle_setUniformRowHeights", &Handle_setUniformRowHeights__wrapper },
+            { "Handle_setWordWrap", &Handle_setWordWrap__wrapper },
+            { "Handle_setSignalMask", &Handle_setSignalMask__wrapper },
+            { "Handle_dispose", &Handle_dispose__wrapper },
+        };
         auto m = ni_registerModule("TreeView");
-        ni_registerModuleMethod(m, "create", &create__wrapper);
-        ni_registerModuleMethod(m, "Handle_setAllColumnsShowFocus", &Handle_setAllColumnsShowFocus__wrapper);
-        ni_registerModuleMethod(m, "Handle_setAnimated", &Handle_setAnimated__wrapper);
-        ni_registerModuleMethod(m, "Handle_setAutoExpandDelay", &Handle_setAutoExpandDelay__wrapper);
-        ni_registerModuleMethod(m, "Handle_setExpandsOnDoubleClick", &Handle_setExpandsOnDoubleClick__wrapper);
-        ni_registerModuleMethod(m, "Handle_setHeaderHidden", &Handle_setHeaderHidden__wrapper);
-        ni_registerModuleMethod(m, "Handle_setIndentation", &Handle_setIndentation__wrapper);
-        ni_registerModuleMethod(m, "Handle_setItemsExpandable", &Handle_setItemsExpandable__wrapper);
-        ni_registerModuleMethod(m, "Handle_setRootIsDecorated", &Handle_setRootIsDecorated__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSortingEnabled", &Handle_setSortingEnabled__wrapper);
-        ni_registerModuleMethod(m, "Handle_setUniformRowHeights", &Handle_setUniformRowHeights__wrapper);
-        ni_registerModuleMethod(m, "Handle_setWordWrap", &Handle_setWordWrap__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSignalMask", &Handle_setSignalMask__wrapper);
-        ni_registerModuleMethod(m, "Handle_dispose", &Handle_dispose__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         auto signalHandler = ni_registerInterface(m, "SignalHandler");
         signalHandler_destroyed = ni_registerInterfaceMethod(signalHandler, "destroyed", &SignalHandler_destroyed__wrapper);
         signalHandler_objectNameChanged = ni_registerInterfaceMethod(signalHandler, "objectNameChanged", &SignalHandler_objectNameChanged__wrapper);
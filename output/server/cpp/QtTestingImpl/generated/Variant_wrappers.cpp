@@ -120,12 +120,15 @@ namespace Variant
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "Handle_isValid", &Handle_isValid__wrapper },
+            { "Handle_toString2", &Handle_toString2__wrapper },
+            { "Handle_toInt", &Handle_toInt__wrapper },
+            { "Handle_dispose", &Handle_dispose__wrapper },
+            { "OwnedHandle_dispose", &OwnedHandle_dispose__wrapper },
+        };
         auto m = ni_registerModule("Variant");
-        ni_registerModuleMethod(m, "Handle_isValid", &Handle_isValid__wrapper);
-        ni_registerModuleMethod(m, "Handle_toString2", &Handle_toString2__wrapper);
-        ni_registerModuleMethod(m, "Handle_toInt", &Handle_toInt__wrapper);
-        ni_registerModuleMethod(m, "Handle_dispose", &Handle_dispose__wrapper);
-        ni_registerModuleMethod(m, "OwnedHandle_dispose", &OwnedHandle_dispose__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         return 0; // = OK
     }
 }
@@ -106,9 +106,9 @@ namespace Widget
     void Handle_setSizePolicy(HandleRef _this, std::shared_ptr<SizePolicy::Deferred::Base> policy);
     void Handle_setSizePolicy(HandleRef _this, SizePolicy::Policy hPolicy, SizePolicy::Policy vPolicy);
     void Handle_setStatusTip(HandleRef _this, std::string tip);
-    void Handle_setStyleSheet(HandleRef _this, std::string styles);
+    void Handle_setStyleSheet(HandleRef _this, StringArg styles);
     void Handle_setTabletTracking(HandleRef _this, bool state);
-    void Handle_setToolTip(HandleRef _this, std::string tip);
+    void Handle_setToolTip(HandleRef _this, StringArg tip);
     void Handle_setToolTipDuration(HandleRef _this, int32_t duration);
     void Handle_setUpdatesEnabled(HandleRef _this, bool enabled);
     void Handle_setVisible(HandleRef _this, bool visible);
@@ -120,7 +120,7 @@ namespace Widget
     void Handle_setWindowModality(HandleRef _this, Enums::WindowModality modality);
     void Handle_setWindowModified(HandleRef _this, bool modified);
     void Handle_setWindowOpacity(HandleRef _this, double opacity);
-    void Handle_setWindowTitle(HandleRef _this, std::string title);
+    void Handle_setWindowTitle(HandleRef _this, StringArg title);
     int32_t Handle_x(HandleRef _this);
     int32_t Handle_y(HandleRef _this);
     void Handle_addAction(HandleRef _this, Action::HandleRef action);
@@ -440,7 +440,7 @@ namespace Widget
 
     void Handle_setStyleSheet__wrapper() {
         auto _this = Handle__pop();
-        auto styles = popStringInternal();
+        auto styles = popStringArg();
         Handle_setStyleSheet(_this, styles);
     }
 
@@ -452,7 +452,7 @@ namespace Widget
 
     void Handle_setToolTip__wrapper() {
         auto _this = Handle__pop();
-        auto tip = popStringInternal();
+        auto tip = popStringArg();
         Handle_setToolTip(_this, tip);
     }
 
@@ -523,7 +523,7 @@ namespace Widget
 
     void Handle_setWindowTitle__wrapper() {
         auto _this = Handle__pop();
-        auto title = popStringInternal();
+        auto title = popStringArg();
         Handle_setWindowTitle(_this, title);
     }
 
@@ -991,106 +991,109 @@ namespace Widget
     }
 
     int __register() {
+        static constexpr ni_ModuleMethodEntry methods[] = {
+            { "create", &create__wrapper },
+            { "createNoHandler", &createNoHandler__wrapper },
+            { "createMimeData", &createMimeData__wrapper },
+            { "createDrag", &createDrag__wrapper },
+            { "createSubclassed", &createSubclassed__wrapper },
+            { "Handle_setAcceptDrops", &Handle_setAcceptDrops__wrapper },
+            { "Handle_setAccessibleDescription", &Handle_setAccessibleDescription__wrapper },
+            { "Handle_setAccessibleName", &Handle_setAccessibleName__wrapper },
+            { "Handle_setAutoFillBackground", &Handle_setAutoFillBackground__wrapper },
+            { "Handle_setBaseSize", &Handle_setBaseSize__wrapper },
+            { "Handle_childrenRect", &Handle_childrenRect__wrapper },
+            { "Handle_childrenRegion", &Handle_childrenRegion__wrapper },
+            { "Handle_setContextMenuPolicy", &Handle_setContextMenuPolicy__wrapper },
+            { "Handle_getCursor", &Handle_getCursor__wrapper },
+            { "Handle_setEnabled", &Handle_setEnabled__wrapper },
+            { "Handle_hasFocus", &Handle_hasFocus__wrapper },
+            { "Handle_setFocusPolicy", &Handle_setFocusPolicy__wrapper },
+            { "Handle_frameGeometry", &Handle_frameGeometry__wrapper },
+            { "Handle_frameSize", &Handle_frameSize__wrapper },
+            { "Handle_isFullscreen", &Handle_isFullscreen__wrapper },
+            { "Handle_setGeometry", &Handle_setGeometry__wrapper },
+            { "Handle_setGeometry_overload1", &Handle_setGeometry_overload1__wrapper },
+            { "Handle_height", &Handle_height__wrapper },
+            { "Handle_setInputMethodHints", &Handle_setInputMethodHints__wrapper },
+            { "Handle_isActiveWindow", &Handle_isActiveWindow__wrapper },
+            { "Handle_setLayoutDirection", &Handle_setLayoutDirection__wrapper },
+            { "Handle_isMaximized", &Handle_isMaximized__wrapper },
+            { "Handle_setMaximumHeight", &Handle_setMaximumHeight__wrapper },
+            { "Handle_setMaximumWidth", &Handle_setMaximumWidth__wrapper },
+            { "Handle_setMaximumSize", &Handle_setMaximumSize__wrapper },
+            { "Handle_isMinimized", &Handle_isMinimized__wrapper },
+            { "Handle_setMinimumHeight", &Handle_setMinimumHeight__wrapper },
+            { "Handle_setMinimumSize", &Handle_setMinimumSize__wrapper },
+            { "Handle_minimumSizeHint", &Handle_minimumSizeHint__wrapper },
+            { "Handle_setMinimumWidth", &Handle_setMinimumWidth__wrapper },
+            { "Handle_isModal", &Handle_isModal__wrapper },
+            { "Handle_setMouseTracking", &Handle_setMouseTracking__wrapper },
+            { "Handle_normalGeometry", &Handle_normalGeometry__wrapper },
+            { "Handle_move", &Handle_move__wrapper },
+            { "Handle_move_overload1", &Handle_move_overload1__wrapper },
+            { "Handle_rect", &Handle_rect__wrapper },
+            { "Handle_resize", &Handle_resize__wrapper },
+            { "Handle_resize_overload1", &Handle_resize_overload1__wrapper },
+            { "Handle_sizeHint", &Handle_sizeHint__wrapper },
+            { "Handle_setSizeIncrement", &Handle_setSizeIncrement__wrapper },
+            { "Handle_setSizeIncrement_overload1", &Handle_setSizeIncrement_overload1__wrapper },
+            { "Handle_setSizePolicy", &Handle_setSizePolicy__wrapper },
+            { "Handle_setSizePolicy_overload1", &Handle_setSizePolicy_overload1__wrapper },
+            { "Handle_setStatusTip", &Handle_setStatusTip__wrapper },
+            { "Handle_setStyleSheet", &Handle_setStyleSheet__wrapper },
+            { "Handle_setTabletTracking", &Handle_setTabletTracking__wrapper },
+            { "Handle_setToolTip", &Handle_setToolTip__wrapper },
+            { "Handle_setToolTipDuration", &Handle_setToolTipDuration__wrapper },
+            { "Handle_setUpdatesEnabled", &Handle_setUpdatesEnabled__wrapper },
+            { "Handle_setVisible", &Handle_setVisible__wrapper },
+            { "Handle_setWhatsThis", &Handle_setWhatsThis__wrapper },
+            { "Handle_width", &Handle_width__wrapper },
+            { "Handle_setWindowFilePath", &Handle_setWindowFilePath__wrapper },
+            { "Handle_setWindowFlags", &Handle_setWindowFlags__wrapper },
+            { "Handle_setWindowIcon", &Handle_setWindowIcon__wrapper },
+            { "Handle_setWindowModality", &Handle_setWindowModality__wrapper },
+            { "Handle_setWindowModified", &Handle_setWindowModified__wrapper },
+            { "Handle_setWindowOpacity", &Handle_setWindowOpacity__wrapper },
+            { "Handle_setWindowTitle", &Handle_setWindowTitle__wrapper },
+            { "Handle_x", &Handle_x__wrapper },
+            { "Handle_y", &Handle_y__wrapper },
+            { "Handle_addAction", &Handle_addAction__wrapper },
+            { "Handle_setParent", &Handle_setParent__wrapper },
+            { "Handle_getWindow", &Handle_getWindow__wrapper },
+            { "Handle_updateGeometry", &Handle_updateGeometry__wrapper },
+            { "Handle_adjustSize", &Handle_adjustSize__wrapper },
+            { "Handle_setFixedWidth", &Handle_setFixedWidth__wrapper },
+            { "Handle_setFixedHeight", &Handle_setFixedHeight__wrapper },
+            { "Handle_setFixedSize", &Handle_setFixedSize__wrapper },
+            { "Handle_show", &Handle_show__wrapper },
+            { "Handle_hide", &Handle_hide__wrapper },
+            { "Handle_update", &Handle_update__wrapper },
+            { "Handle_update_overload1", &Handle_update_overload1__wrapper },
+            { "Handle_update_overload2", &Handle_update_overload2__wrapper },
+            { "Handle_setLayout", &Handle_setLayout__wrapper },
+            { "Handle_getLayout", &Handle_getLayout__wrapper },
+            { "Handle_mapToGlobal", &Handle_mapToGlobal__wrapper },
+            { "Handle_setSignalMask", &Handle_setSignalMask__wrapper },
+            { "Handle_dispose", &Handle_dispose__wrapper },
+            { "Event_accept", &Event_accept__wrapper },
+            { "Event_ignore", &Event_ignore__wrapper },
+            { "MimeData_formats", &MimeData_formats__wrapper },
+            { "MimeData_hasFormat", &MimeData_hasFormat__wrapper },
+            { "MimeData_text", &MimeData_text__wrapper },
+            { "MimeData_setText", &MimeData_setText__wrapper },
+            { "MimeData_urls", &MimeData_urls__wrapper },
+            { "MimeData_setUrls", &MimeData_setUrls__wrapper },
+            { "Drag_setMimeData", &Drag_setMimeData__wrapper },
+            { "Drag_exec", &Drag_exec__wrapper },
+            { "DragMoveEvent_proposedAction", &DragMoveEvent_proposedAction__wrapper },
+            { "DragMoveEvent_acceptProposedAction", &DragMoveEvent_acceptProposedAction__wrapper },
+            { "DragMoveEvent_possibleActions", &DragMoveEvent_possibleActions__wrapper },
+            { "DragMoveEvent_acceptDropAction", &DragMoveEvent_acceptDropAction__wrapper },
+        };
         auto m = ni_registerModule("Widget");
         ni_registerModuleConstants(m, &__constantsFunc);
-        ni_registerModuleMethod(m, "create", &create__wrapper);
-        ni_registerModuleMethod(m, "createNoHandler", &createNoHandler__wrapper);
-        ni_registerModuleMethod(m, "createMimeData", &createMimeData__wrapper);
-        ni_registerModuleMethod(m, "createDrag", &createDrag__wrapper);
-        ni_registerModuleMethod(m, "createSubclassed", &createSubclassed__wrapper);
-        ni_registerModuleMethod(m, "Handle_setAcceptDrops", &Handle_setAcceptDrops__wrapper);
-        ni_registerModuleMethod(m, "Handle_setAccessibleDescription", &Handle_setAccessibleDescription__wrapper);
-        ni_registerModuleMethod(m, "Handle_setAccessibleName", &Handle_setAccessibleName__wrapper);
-        ni_registerModuleMethod(m, "Handle_setAutoFillBackground", &Handle_setAutoFillBackground__wrapper);
-        ni_registerModuleMethod(m, "Handle_setBaseSize", &Handle_setBaseSize__wrapper);
-        ni_registerModuleMethod(m, "Handle_childrenRect", &Handle_childrenRect__wrapper);
-        ni_registerModuleMethod(m, "Handle_childrenRegion", &Handle_childrenRegion__wrapper);
-        ni_registerModuleMethod(m, "Handle_setContextMenuPolicy", &Handle_setContextMenuPolicy__wrapper);
-        ni_registerModuleMethod(m, "Handle_getCursor", &Handle_getCursor__wrapper);
-        ni_registerModuleMethod(m, "Handle_setEnabled", &Handle_setEnabled__wrapper);
-        ni_registerModuleMethod(m, "Handle_hasFocus", &Handle_hasFocus__wrapper);
-        ni_registerModuleMethod(m, "Handle_setFocusPolicy", &Handle_setFocusPolicy__wrapper);
-        ni_registerModuleMethod(m, "Handle_frameGeometry", &Handle_frameGeometry__wrapper);
-        ni_registerModuleMethod(m, "Handle_frameSize", &Handle_frameSize__wrapper);
-        ni_registerModuleMethod(m, "Handle_isFullscreen", &Handle_isFullscreen__wrapper);
-        ni_registerModuleMethod(m, "Handle_setGeometry", &Handle_setGeometry__wrapper);
-        ni_registerModuleMethod(m, "Handle_setGeometry_overload1", &Handle_setGeometry_overload1__wrapper);
-        ni_registerModuleMethod(m, "Handle_height", &Handle_height__wrapper);
-        ni_registerModuleMethod(m, "Handle_setInputMethodHints", &Handle_setInputMethodHints__wrapper);
-        ni_registerModuleMethod(m, "Handle_isActiveWindow", &Handle_isActiveWindow__wrapper);
-        ni_registerModuleMethod(m, "Handle_setLayoutDirection", &Handle_setLayoutDirection__wrapper);
-        ni_registerModuleMethod(m, "Handle_isMaximized", &Handle_isMaximized__wrapper);
-        ni_registerModuleMethod(m, "Handle_setMaximumHeight", &Handle_setMaximumHeight__wrapper);
-        ni_registerModuleMethod(m, "Handle_setMaximumWidth", &Handle_setMaximumWidth__wrapper);
-        ni_registerModuleMethod(m, "Handle_setMaximumSize", &Handle_setMaximumSize__wrapper);
-        ni_registerModuleMethod(m, "Handle_isMinimized", &Handle_isMinimized__wrapper);
-        ni_registerModuleMethod(m, "Handle_setMinimumHeight", &Handle_setMinimumHeight__wrapper);
-        ni_registerModuleMethod(m, "Handle_setMinimumSize", &Handle_setMinimumSize__wrapper);
-        ni_registerModuleMethod(m, "Handle_minimumSizeHint", &Handle_minimumSizeHint__wrapper);
-        ni_registerModuleMethod(m, "Handle_setMinimumWidth", &Handle_setMinimumWidth__wrapper);
-        ni_registerModuleMethod(m, "Handle_isModal", &Handle_isModal__wrapper);
-        ni_registerModuleMethod(m, "Handle_setMouseTracking", &Handle_setMouseTracking__wrapper);
-        ni_registerModuleMethod(m, "Handle_normalGeometry", &Handle_normalGeometry__wrapper);
-        ni_registerModuleMethod(m, "Handle_move", &Handle_move__wrapper);
-        ni_registerModuleMethod(m, "Handle_move_overload1", &Handle_move_overload1__wrapper);
-        ni_registerModuleMethod(m, "Handle_rect", &Handle_rect__wrapper);
-        ni_registerModuleMethod(m, "Handle_resize", &Handle_resize__wrapper);
-        ni_registerModuleMethod(m, "Handle_resize_overload1", &Handle_resize_overload1__wrapper);
-        ni_registerModuleMethod(m, "Handle_sizeHint", &Handle_sizeHint__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSizeIncrement", &Handle_setSizeIncrement__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSizeIncrement_overload1", &Handle_setSizeIncrement_overload1__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSizePolicy", &Handle_setSizePolicy__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSizePolicy_overload1", &Handle_setSizePolicy_overload1__wrapper);
-        ni_registerModuleMethod(m, "Handle_setStatusTip", &Handle_setStatusTip__wrapper);
-        ni_registerModuleMethod(m, "Handle_setStyleSheet", &Handle_setStyleSheet__wrapper);
-        ni_registerModuleMethod(m, "Handle_setTabletTracking", &Handle_setTabletTracking__wrapper);
-        ni_registerModuleMethod(m, "Handle_setToolTip", &Handle_setToolTip__wrapper);
-        ni_registerModuleMethod(m, "Handle_setToolTipDuration", &Handle_setToolTipDuration__wrapper);
-        ni_registerModuleMethod(m, "Handle_setUpdatesEnabled", &Handle_setUpdatesEnabled__wrapper);
-        ni_registerModuleMethod(m, "Handle_setVisible", &Handle_setVisible__wrapper);
-        ni_registerModuleMethod(m, "Handle_setWhatsThis", &Handle_setWhatsThis__wrapper);
-        ni_registerModuleMethod(m, "Handle_width", &Handle_width__wrapper);
-        ni_registerModuleMethod(m, "Handle_setWindowFilePath", &Handle_setWindowFilePath__wrapper);
-        ni_registerModuleMethod(m, "Handle_setWindowFlags", &Handle_setWindowFlags__wrapper);
-        ni_registerModuleMethod(m, "Handle_setWindowIcon", &Handle_setWindowIcon__wrapper);
-        ni_registerModuleMethod(m, "Handle_setWindowModality", &Handle_setWindowModality__wrapper);
-        ni_registerModuleMethod(m, "Handle_setWindowModified", &Handle_setWindowModified__wrapper);
-        ni_registerModuleMethod(m, "Handle_setWindowOpacity", &Handle_setWindowOpacity__wrapper);
-        ni_registerModuleMethod(m, "Handle_setWindowTitle", &Handle_setWindowTitle__wrapper);
-        ni_registerModuleMethod(m, "Handle_x", &Handle_x__wrapper);
-        ni_registerModuleMethod(m, "Handle_y", &Handle_y__wrapper);
-        ni_registerModuleMethod(m, "Handle_addAction", &Handle_addAction__wrapper);
-        ni_registerModuleMethod(m, "Handle_setParent", &Handle_setParent__wrapper);
-        ni_registerModuleMethod(m, "Handle_getWindow", &Handle_getWindow__wrapper);
-        ni_registerModuleMethod(m, "Handle_updateGeometry", &Handle_updateGeometry__wrapper);
-        ni_registerModuleMethod(m, "Handle_adjustSize", &Handle_adjustSize__wrapper);
-        ni_registerModuleMethod(m, "Handle_setFixedWidth", &Handle_setFixedWidth__wrapper);
-        ni_registerModuleMethod(m, "Handle_setFixedHeight", &Handle_setFixedHeight__wrapper);
-        ni_registerModuleMethod(m, "Handle_setFixedSize", &Handle_setFixedSize__wrapper);
-        ni_registerModuleMethod(m, "Handle_show", &Handle_show__wrapper);
-        ni_registerModuleMethod(m, "Handle_hide", &Handle_hide__wrapper);
-        ni_registerModuleMethod(m, "Handle_update", &Handle_update__wrapper);
-        ni_registerModuleMethod(m, "Handle_update_overload1", &Handle_update_overload1__wrapper);
-        ni_registerModuleMethod(m, "Handle_update_overload2", &Handle_update_overload2__wrapper);
-        ni_registerModuleMethod(m, "Handle_setLayout", &Handle_setLayout__wrapper);
-        ni_registerModuleMethod(m, "Handle_getLayout", &Handle_getLayout__wrapper);
-        ni_registerModuleMethod(m, "Handle_mapToGlobal", &Handle_mapToGlobal__wrapper);
-        ni_registerModuleMethod(m, "Handle_setSignalMask", &Handle_setSignalMask__wrapper);
-        ni_registerModuleMethod(m, "Handle_dispose", &Handle_dispose__wrapper);
-        ni_registerModuleMethod(m, "Event_accept", &Event_accept__wrapper);
-        ni_registerModuleMethod(m, "Event_ignore", &Event_ignore__wrapper);
-        ni_registerModuleMethod(m, "MimeData_formats", &MimeData_formats__wrapper);
-        ni_registerModuleMethod(m, "MimeData_hasFormat", &MimeData_hasFormat__wrapper);
-        ni_registerModuleMethod(m, "MimeData_text", &MimeData_text__wrapper);
-        ni_registerModuleMethod(m, "MimeData_setText", &MimeData_setText__wrapper);
-        ni_registerModuleMethod(m, "MimeData_urls", &MimeData_urls__wrapper);
-        ni_registerModuleMethod(m, "MimeData_setUrls", &MimeData_setUrls__wrapper);
-        ni_registerModuleMethod(m, "Drag_setMimeData", &Drag_setMimeData__wrapper);
-        ni_registerModuleMethod(m, "Drag_exec", &Drag_exec__wrapper);
-        ni_registerModuleMethod(m, "DragMoveEvent_proposedAction", &DragMoveEvent_proposedAction__wrapper);
-        ni_registerModuleMethod(m, "DragMoveEvent_acceptProposedAction", &DragMoveEvent_acceptProposedAction__wrapper);
-        ni_registerModuleMethod(m, "DragMoveEvent_possibleActions", &DragMoveEvent_possibleActions__wrapper);
-        ni_registerModuleMethod(m, "DragMoveEvent_acceptDropAction", &DragMoveEvent_acceptDropAction__wrapper);
+        ni_registerModuleMethods(m, methods, sizeof(methods) / sizeof(methods[0]));
         auto signalHandler = ni_registerInterface(m, "SignalHandler");
         signalHandler_destroyed = ni_registerInterfaceMethod(signalHandler, "destroyed", &SignalHandler_destroyed__wrapper);
         signalHandler_objectNameChanged = ni_registerInterfaceMethod(signalHandler, "objectNameChanged", &SignalHandler_objectNameChanged__wrapper);
@@ -0,0 +1,241 @@
+#include "BufferPool.h"
+
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+#include <malloc.h>
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace BufferPool {
+	static constexpr size_t HugePageSize = 2 * 1024 * 1024;
+
+	// all guarded by lock (the allocations themselves happen outside it)
+	struct State {
+		std::mutex lock;
+		Config config;
+		const Source* source = nullptr;
+		std::unordered_map<size_t, std::vector<Block>> freeLists; // by capacity
+		size_t cachedBytes = 0;
+		size_t mappedBytes = 0;
+		uint64_t acquired = 0;
+		uint64_t reused = 0;
+	};
+	// never destroyed: buffers still registered at exit are released from another file's static destructors
+	static State& state = *new State();
+
+	static size_t pageSize() {
+#ifdef _WIN32
+		static const size_t size = [] {
+			SYSTEM_INFO info;
+			GetSystemInfo(&info);
+			return (size_t)info.dwPageSize;
+		}();
+#else
+		static const size_t size = (size_t)sysconf(_SC_PAGESIZE);
+#endif
+		return size;
+	}
+
+	static inline size_t roundUp(size_t size, size_t multiple) {
+		return (size + multiple - 1) / multiple * multiple;
+	}
+
+	// multiples of the alignment up to 256, then 4 steps per power of two
+	static size_t sizeClass(size_t size) {
+		size = roundUp(size == 0 ? 1 : size, Alignment);
+		if (size <= 4 * Alignment) {
+			return size;
+		}
+		size_t base = 1;
+		while (base * 2 < size) {
+			base *= 2;
+		}
+		return roundUp(size, base / 4);
+	}
+
+	static void* mapBlock(size_t size, bool hugePages) {
+#ifdef _WIN32
+		// (large pages need a privilege the user normally doesn't have, so not attempted)
+		(void)hugePages;
+		return VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+#ifdef MADV_HUGEPAGE
+		if (hugePages && size >= HugePageSize) {
+			// over-map so the block can start on a huge page boundary, then give back the slack on either side
+			auto raw = mmap(nullptr, size + HugePageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (raw == MAP_FAILED) {
+				return nullptr;
+			}
+			auto start = (char*)roundUp((uintptr_t)raw, HugePageSize);
+			auto head = (size_t)(start - (char*)raw);
+			if (head > 0) {
+				munmap(raw, head);
+			}
+			munmap(start + size, HugePageSize - head);
+			madvise(start, size, MADV_HUGEPAGE);
+			return start;
+		}
+#endif
+		(void)hugePages;
+		auto start = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		return start == MAP_FAILED ? nullptr : start;
+#endif
+	}
+
+	static void* allocBlock(size_t size) {
+#ifdef _WIN32
+		return _aligned_malloc(size, Alignment);
+#else
+		void* start;
+		return posix_memalign(&start, Alignment, size) == 0 ? start : nullptr;
+#endif
+	}
+
+	// not under the lock
+	static void freeBlock(const Block& block) {
+		if (block.source) {
+			block.source->free(block.start, block.capacity);
+		}
+		else if (block.mapped) {
+#ifdef _WIN32
+			VirtualFree(block.start, 0, MEM_RELEASE);
+#else
+			munmap(block.start, block.capacity);
+#endif
+		}
+		else {
+#ifdef _WIN32
+			_aligned_free(block.start);
+#else
+			free(block.start);
+#endif
+		}
+	}
+
+	// takes cached blocks off the free lists until at most limit bytes remain, for freeing once the lock is dropped
+	static std::vector<Block> takeCachedOver(size_t limit) {
+		std::vector<Block> ret;
+		for (auto it = state.freeLists.begin(); it != state.freeLists.end() && state.cachedBytes > limit; it++) {
+			auto& list = it->second;
+			while (!list.empty() && state.cachedBytes > limit) {
+				ret.push_back(list.back());
+				state.cachedBytes -= list.back().capacity;
+				list.pop_back();
+			}
+		}
+		for (auto& block : ret) {
+			if (block.mapped) {
+				state.mappedBytes -= block.capacity;
+			}
+		}
+		return ret;
+	}
+
+	void configure(const Config& newConfig) {
+		std::vector<Block> excess;
+		{
+			std::lock_guard<std::mutex> guard(state.lock);
+			state.config = newConfig;
+			excess = takeCachedOver(state.config.maxCachedBytes);
+		}
+		for (auto& block : excess) {
+			freeBlock(block);
+		}
+	}
+
+	void setSource(const Source* source) {
+		std::vector<Block> cached;
+		{
+			std::lock_guard<std::mutex> guard(state.lock);
+			state.source = source;
+			cached = takeCachedOver(0);
+		}
+		for (auto& block : cached) {
+			freeBlock(block);
+		}
+	}
+
+	Block acquire(size_t size) {
+		Block block;
+		block.capacity = sizeClass(size);
+		bool hugePages;
+		{
+			std::lock_guard<std::mutex> guard(state.lock);
+			state.acquired++;
+			block.source = state.source;
+			block.mapped = !block.source && block.capacity >= state.config.mmapThreshold;
+			if (block.mapped) {
+				block.capacity = roundUp(block.capacity, pageSize());
+			}
+			auto found = state.freeLists.find(block.capacity);
+			if (found != state.freeLists.end() && !found->second.empty()) {
+				state.reused++;
+				block = found->second.back();
+				found->second.pop_back();
+				state.cachedBytes -= block.capacity;
+				return block;
+			}
+			if (block.mapped) {
+				state.mappedBytes += block.capacity;
+			}
+			hugePages = state.config.hugePages;
+		}
+		if (block.source) {
+			block.start = block.source->allocate(block.capacity);
+		}
+		else {
+			block.start = block.mapped ? mapBlock(block.capacity, hugePages) : allocBlock(block.capacity);
+		}
+		if (!block.start) {
+			if (block.mapped) {
+				std::lock_guard<std::mutex> guard(state.lock);
+				state.mappedBytes -= block.capacity;
+			}
+			throw std::bad_alloc();
+		}
+		return block;
+	}
+
+	void release(Block block, Reuse reuse) {
+		if (!block.start) {
+			return;
+		}
+		if (reuse == Reuse::Pooled) {
+			std::lock_guard<std::mutex> guard(state.lock);
+			if (block.source == state.source && state.cachedBytes + block.capacity <= state.config.maxCachedBytes) {
+				state.freeLists[block.capacity].push_back(block);
+				state.cachedBytes += block.capacity;
+				return;
+			}
+		}
+		if (block.mapped) {
+			std::lock_guard<std::mutex> guard(state.lock);
+			state.mappedBytes -= block.capacity;
+		}
+		freeBlock(block);
+	}
+
+	void trim() {
+		std::vector<Block> all;
+		{
+			std::lock_guard<std::mutex> guard(state.lock);
+			all = takeCachedOver(0);
+		}
+		for (auto& block : all) {
+			freeBlock(block);
+		}
+	}
+
+	Stats stats() {
+		std::lock_guard<std::mutex> guard(state.lock);
+		return { state.acquired, state.reused, state.cachedBytes, state.mappedBytes };
+	}
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// backing memory for ServerBuffer: 64-byte aligned blocks (for SIMD consumers), rounded up to size classes (4 per doubling, so at most 25% over)
+// blocks from mmapThreshold up are mapped straight from the OS, optionally asking for transparent huge pages
+// released blocks can be kept on their size class's free list and handed back out for the next request of that class,
+// without going to the allocator/OS (and so without the page faults of fresh memory) - see Reuse
+// safe to use from any thread
+
+namespace BufferPool {
+	constexpr size_t Alignment = 64;
+
+	enum class Reuse {
+		Pooled, // kept for the next buffer of the same size class when released (as long as the pool's under maxCachedBytes)
+		None,   // given back to the allocator/OS right away - for one-offs that would only crowd out the buffers that do repeat
+	};
+
+	struct Config {
+		size_t mmapThreshold = 256 * 1024;
+		bool hugePages = true;                     // madvise(MADV_HUGEPAGE) on mapped blocks of 2MB and up (Linux only, ignored elsewhere)
+		size_t maxCachedBytes = 256 * 1024 * 1024; // across all size classes, released blocks past this are given back
+	};
+	// the cached blocks are trimmed to the new limit, blocks already handed out keep going back the way they came
+	void configure(const Config& config);
+
+	// somewhere other than the allocator/OS for blocks to come from, eg a shared memory heap (see remote/Remote.h)
+	struct Source {
+		void* (*allocate)(size_t size); // Alignment-aligned, null when out of space
+		void (*free)(void* start, size_t size);
+	};
+	// null to go back to the allocator/OS. meant for startup: the cached blocks are given back,
+	// and blocks already handed out go back where they came from (without being cached)
+	void setSource(const Source* source);
+
+	struct Block {
+		void* start = nullptr;
+		size_t capacity = 0; // the size class, >= the requested size
+		bool mapped = false;
+		const Source* source = nullptr;
+	};
+	// never fails (throws std::bad_alloc, like new)
+	Block acquire(size_t size);
+	void release(Block block, Reuse reuse);
+
+	// gives every cached block back
+	void trim();
+
+	struct Stats {
+		uint64_t acquired;    // total acquire() calls
+		uint64_t reused;      // ... of which were served from a free list
+		size_t cachedBytes;   // currently on the free lists
+		size_t mappedBytes;   // currently mapped (handed out or cached)
+	};
+	Stats stats();
+}
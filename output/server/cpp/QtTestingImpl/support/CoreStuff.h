@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <string>
 
 #define NIHANDLE(x) struct ni_##x; typedef struct ni_##x* ni_##x##Ref
@@ -31,90 +33,186 @@ extern "C" {
 
 	extern ni_ModuleRef ni_registerModule(const char *name);
 	extern ni_ModuleMethodRef ni_registerModuleMethod(ni_ModuleRef m, const char* name, ModuleFunc func);
+	struct ni_ModuleMethodEntry {
+		const char* name;
+		ModuleFunc func;
+	};
+	extern void ni_registerModuleMethods(ni_ModuleRef m, const ni_ModuleMethodEntry* entries, size_t count);
 	extern void ni_registerModuleConstants(ni_ModuleRef m, ConstantsFunc func);
 	extern ni_InterfaceRef ni_registerInterface(ni_ModuleRef m, const char* name);
 	extern ni_InterfaceMethodRef ni_registerInterfaceMethod(ni_InterfaceRef iface, const char* name, InterfaceFunc ifunc);
 	extern ni_ExceptionRef ni_registerException(ni_ModuleRef m, const char* name, ExceptionBuilder builder);
+	// (mirrors the core's ni_BatchArgType, of which the struct field types use the scalar codes)
+	enum ni_BatchArgType : uint8_t {
+		ni_BatchNull, ni_BatchPtr, ni_BatchSizeT, ni_BatchBool,
+		ni_BatchInt8, ni_BatchUInt8, ni_BatchInt16, ni_BatchUInt16, ni_BatchInt32, ni_BatchUInt32,
+		ni_BatchInt64, ni_BatchUInt64, ni_BatchFloat, ni_BatchDouble,
+		ni_BatchPtrArray, ni_BatchSizeTArray, ni_BatchBoolArray,
+		ni_BatchInt8Array, ni_BatchUInt8Array, ni_BatchInt16Array, ni_BatchUInt16Array, ni_BatchInt32Array, ni_BatchUInt32Array,
+		ni_BatchInt64Array, ni_BatchUInt64Array, ni_BatchFloatArray, ni_BatchDoubleArray,
+		ni_BatchString, ni_BatchStringArray,
+		ni_BatchInstance, ni_BatchClientFunc, ni_BatchServerFunc, ni_BatchBuffer,
+		ni_BatchStruct, ni_BatchStructArray,
+		ni_BatchBitArray
+	};
+	struct ni_StructField {
+		const char* name;
+		uint32_t offset;
+		uint8_t type;
+	};
+	extern int ni_registerStruct(ni_ModuleRef m, const char* name, size_t size, const ni_StructField* fields, size_t fieldCount);
+	typedef int (*ModuleRegisterFunc)();
+	struct ni_ModuleDescriptor {
+		const char* name;
+		ModuleRegisterFunc registerFunc;
+		const char* const* dependencies; // null-terminated, or null
+	};
+	extern void ni_registerModuleDescriptors(const ni_ModuleDescriptor* descriptors, size_t count);
 
 	extern void ni_pushPtr(void* value);
 	extern void* ni_popPtr();
 	extern void ni_pushPtrArray(void** values, size_t count);
+	extern void ni_pushPtrArrayBorrowed(void* const* values, size_t count);
 	extern void ni_popPtrArray(void*** values, size_t* count);
+	extern void ni_popPtrArrayView(void* const** values, size_t* count);
 
 	extern void ni_pushSizeT(size_t value);
 	extern size_t ni_popSizeT();
 	extern void ni_pushSizeTArray(size_t* values, size_t count);
+	extern void ni_pushSizeTArrayBorrowed(const size_t* values, size_t count);
 	extern void ni_popSizeTArray(size_t** values, size_t* count);
+	extern void ni_popSizeTArrayView(const size_t** values, size_t* count);
 
 	extern void ni_pushBool(bool b);
 	extern bool ni_popBool();
 	extern void ni_pushBoolArray(bool* values, size_t count);
+	extern void ni_pushBoolArrayBorrowed(const bool* values, size_t count);
 	extern void ni_popBoolArray(bool** values, size_t* count);
+	extern void ni_popBoolArrayView(const bool** values, size_t* count);
+	extern void ni_pushBitArray(const uint64_t* words, size_t count);
+	extern void ni_pushBitArrayBorrowed(const uint64_t* words, size_t count);
+	extern uint64_t* ni_pushBitArrayInPlace(size_t count);
+	extern void ni_popBitArray(uint64_t** words, size_t* count);
+	extern void ni_popBitArrayView(const uint64_t** words, size_t* count);
+	extern void ni_packBits(const bool* values, size_t count, uint64_t* words);
+	extern void ni_unpackBits(const uint64_t* words, size_t count, bool* values);
 
 	extern void ni_pushInt8(int8_t x);
 	extern int8_t ni_popInt8();
 	extern void ni_pushInt8Array(int8_t* values, size_t count);
+	extern void ni_pushInt8ArrayBorrowed(const int8_t* values, size_t count);
 	extern void ni_popInt8Array(int8_t** values, size_t* count);
+	extern void ni_popInt8ArrayView(const int8_t** values, size_t* count);
 
 	extern void ni_pushUInt8(uint8_t x);
 	extern uint8_t ni_popUInt8();
 	extern void ni_pushUInt8Array(uint8_t* values, size_t count);
+	extern void ni_pushUInt8ArrayBorrowed(const uint8_t* values, size_t count);
 	extern void ni_popUInt8Array(uint8_t** values, size_t* count);
+	extern void ni_popUInt8ArrayView(const uint8_t** values, size_t* count);
 
 	extern void ni_pushInt16(int16_t x);
 	extern int16_t ni_popInt16();
 	extern void ni_pushInt16Array(int16_t* values, size_t count);
+	extern void ni_pushInt16ArrayBorrowed(const int16_t* values, size_t count);
 	extern void ni_popInt16Array(int16_t** values, size_t* count);
+	extern void ni_popInt16ArrayView(const int16_t** values, size_t* count);
 
 	extern void ni_pushUInt16(uint16_t x);
 	extern uint16_t ni_popUInt16();
 	extern void ni_pushUInt16Array(uint16_t* values, size_t count);
+	extern void ni_pushUInt16ArrayBorrowed(const uint16_t* values, size_t count);
 	extern void ni_popUInt16Array(uint16_t** values, size_t* count);
+	extern void ni_popUInt16ArrayView(const uint16_t** values, size_t* count);
 
 	extern void ni_pushInt32(int32_t x);
 	extern int32_t ni_popInt32();
 	extern void ni_pushInt32Array(int32_t* values, size_t count);
+	extern void ni_pushInt32ArrayBorrowed(const int32_t* values, size_t count);
 	extern void ni_popInt32Array(int32_t** values, size_t* count);
+	extern void ni_popInt32ArrayView(const int32_t** values, size_t* count);
 
 	extern void ni_pushUInt32(uint32_t x);
 	extern uint32_t ni_popUInt32();
 	extern void ni_pushUInt32Array(uint32_t* values, size_t count);
+	extern void ni_pushUInt32ArrayBorrowed(const uint32_t* values, size_t count);
 	extern void ni_popUInt32Array(uint32_t** values, size_t* count);
+	extern void ni_popUInt32ArrayView(const uint32_t** values, size_t* count);
 
 	extern void ni_pushInt64(int64_t x);
 	extern int64_t ni_popInt64();
 	extern void ni_pushInt64Array(int64_t* values, size_t count);
+	extern void ni_pushInt64ArrayBorrowed(const int64_t* values, size_t count);
 	extern void ni_popInt64Array(int64_t** values, size_t* count);
+	extern void ni_popInt64ArrayView(const int64_t** values, size_t* count);
 
 	extern void ni_pushUInt64(uint64_t x);
 	extern uint64_t ni_popUInt64();
 	extern void ni_pushUInt64Array(uint64_t* values, size_t count);
+	extern void ni_pushUInt64ArrayBorrowed(const uint64_t* values, size_t count);
 	extern void ni_popUInt64Array(uint64_t** values, size_t* count);
+	extern void ni_popUInt64ArrayView(const uint64_t** values, size_t* count);
 
 	extern void ni_pushFloat(float x);
 	extern float ni_popFloat();
 	extern void ni_pushFloatArray(float* values, size_t count);
+	extern void ni_pushFloatArrayBorrowed(const float* values, size_t count);
 	extern void ni_popFloatArray(float** values, size_t* count);
+	extern void ni_popFloatArrayView(const float** values, size_t* count);
 
 	extern void ni_pushDouble(double x);
 	extern double ni_popDouble();
 	extern void ni_pushDoubleArray(double* values, size_t count);
+	extern void ni_pushDoubleArrayBorrowed(const double* values, size_t count);
 	extern void ni_popDoubleArray(double** values, size_t* count);
+	extern void ni_popDoubleArrayView(const double** values, size_t* count);
 
 	extern void ni_pushString(const char* str, size_t length);
+	extern void ni_pushStringBorrowed(const char* str, size_t length);
 	extern void ni_popString(const char** strPtr, size_t* length);
+	extern void ni_popStringView(const char** strPtr, size_t* length);
 	extern void ni_pushStringArray(const char** strs, size_t* lengths, size_t count);
+	extern void ni_pushStringArrayBorrowed(const char* const* strs, const size_t* lengths, size_t count);
 	extern void ni_popStringArray(const char*** strs, size_t** lengths, size_t* count);
+	extern void ni_popStringArrayView(const char* const** strs, const size_t** lengths, size_t* count);
+	extern void ni_pushStringArrayBlob(const char* bytes, const uint64_t* offsets, size_t count);
+	extern void ni_pushStringArrayBlobBorrowed(const char* bytes, const uint64_t* offsets, size_t count);
+	extern char* ni_pushStringArrayBlobInPlace(size_t count, size_t totalLength, uint64_t** offsets);
+	extern void ni_popStringArrayBlob(const char** bytes, const uint64_t** offsets, size_t* count);
+	extern int ni_internString(const char* str, size_t length);
+	extern bool ni_getInternedString(int id, const char** str, size_t* length);
+	extern bool ni_pushInternedString(int id);
+	extern int ni_popStringViewInterned(const char** strPtr, size_t* length);
 
+	extern int ni_getStructType(ni_ModuleRef m, const char* name);
+	extern bool ni_getStructLayout(int typeId, size_t* size, const ni_StructField** fields, size_t* fieldCount);
+	extern void ni_pushStruct(int typeId, const void* value, size_t size);
+	extern void ni_popStruct(int typeId, void* value, size_t size);
+	extern void ni_pushStructArray(int typeId, const void* values, size_t count);
+	extern void ni_pushStructArrayBorrowed(int typeId, const void* values, size_t count);
+	extern void ni_popStructArray(int typeId, void** values, size_t* count);
+	extern void ni_popStructArrayView(int typeId, const void** values, size_t* count);
+
+	// a buffer, or a view into part of one: rank dimensions (outermost first) of shape[i] elements each,
+	// consecutive elements along dimension i being strides[i] bytes apart
+	// rank 0 is the original flat form (totalCount elements back to back), pushed descriptors are always normalized to rank 1+
+	enum { ni_BufferMaxRank = 4 };
 	struct ni_BufferDescriptor {
-		// TODO: provisions for multi-dimensional, indirect pointers, instead of contiguous, stride, etc?
-		void* start;
+		void* start;          // the view's first element
 		int elementSize;
-		size_t totalCount;
-		size_t totalSize;
+		size_t totalCount;    // elements in the view (the product of shape)
+		size_t totalSize;     // bytes from start through the end of the last element - all of it, for a contiguous one
+		int rank;
+		int reserved;
+		uint64_t shape[ni_BufferMaxRank];
+		uint64_t strides[ni_BufferMaxRank]; // in bytes
 	};
 	extern void ni_pushBuffer(int id, bool isClientId, ni_BufferDescriptor* descriptor);
 	extern void ni_popBuffer(int* id, bool* isClientId, ni_BufferDescriptor* descriptor);
+	extern bool ni_describeBuffer(ni_BufferDescriptor* descriptor, void* start, int elementSize, int rank, const uint64_t* shape);
+	extern bool ni_bufferRegion(const ni_BufferDescriptor* buffer, const uint64_t* begin, const uint64_t* extent, ni_BufferDescriptor* view);
+	extern bool ni_bufferSlice(const ni_BufferDescriptor* buffer, int dim, uint64_t index, ni_BufferDescriptor* view);
+	extern bool ni_bufferIsContiguous(const ni_BufferDescriptor* buffer);
 
 	extern int ni_popClientFunc();
 	extern void ni_pushServerFunc(int id);
@@ -129,4 +227,42 @@ extern "C" {
 	extern void ni_processExceptions(); // formerly buildAndThrow
 
 	extern void ni_clearClientSafetyArea();
+	extern void ni_serverSafetyAreaInUse(); // protections lapse when the client's next invocation on this thread begins
+
+	// deferred/batched release of client resources (falls back to ni_clientResourceRelease if the client didn't opt in)
+	extern void ni_releaseClientResource(int id);
+	extern void ni_flushClientResourceReleases();
 }
+
+// tracing - see NativeImplCore.h
+extern "C" {
+	enum ni_TraceLevel : uint8_t {
+		ni_TraceOff, ni_TraceError, ni_TraceWarn, ni_TraceInfo, ni_TraceDebug
+	};
+	enum ni_TraceEvent : uint16_t {
+		ni_TraceServerResourceReleased,     // a = id
+		ni_TraceServerResourceDeref,        // a = id, b = remaining refcount
+		ni_TraceServerResourceRefBumped,    // a = id, b = new refcount
+		ni_TraceServerResourceStaleRelease, // a = id
+		ni_TraceServerFuncValReleased,      // a = id
+		ni_TraceServerSafetyAreaCleared,    // a = number of resources let go
+		ni_TraceClientResourceSafePush,     // a = id
+		ni_TraceClientResourceReleased,     // a = id (server-side proxy destroyed)
+		ni_TraceEventCount
+	};
+	extern std::atomic<uint8_t> ni_traceLevel;
+	extern void ni_setTraceLevel(int level);
+	extern void ni_traceRecord(ni_TraceLevel level, ni_TraceEvent event, int32_t a, int32_t b);
+	extern void ni_dumpTrace();
+}
+
+#ifndef NI_TRACE_MAX_LEVEL
+#define NI_TRACE_MAX_LEVEL ni_TraceDebug
+#endif
+
+#define NI_TRACE(level, event, a, b) \
+	do { \
+		if ((level) <= NI_TRACE_MAX_LEVEL && (level) <= ni_traceLevel.load(std::memory_order_relaxed)) { \
+			ni_traceRecord(level, event, a, b); \
+		} \
+	} while (0)
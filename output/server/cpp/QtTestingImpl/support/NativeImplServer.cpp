@@ -1,13 +1,35 @@
 #include "NativeImplServer.h"
+#include "ResourceTable.h"
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <assert.h>
+#include <cstring>
 
-static int nextServerObjId = 1;
-static std::map<int, std::shared_ptr<ServerResource>> serverResources;
-static std::map<size_t, int> reverseServerFuncVals; // to attempt to de-duplicate identical std::functions
+// everything here may be called from any thread (the core's value stack is per-thread too)
+static ResourceTable<ServerResource> serverResources;
+
+// to attempt to de-duplicate identical std::functions - sharded by key, so workers creating func vals don't all queue on one lock
+struct FuncValShard {
+	std::mutex lock;
+	std::map<size_t, int> ids;
+};
+static FuncValShard reverseServerFuncVals[16];
+
+static inline FuncValShard& funcValShard(size_t key) {
+	return reverseServerFuncVals[(key ^ (key >> 4) ^ (key >> 16)) % 16];
+}
+
+// a server resource going into the table (refcount 0 -> 1) or out of it (1 -> 0) holds one of these for the whole of it,
+// so the two can't interleave - every other push/release is a plain CAS on the refcount (sharded by address, like the above)
+static std::mutex resourceTransitionLocks[16];
+
+static inline std::mutex& resourceTransitionLock(const void* resource) {
+	auto key = (uintptr_t)resource;
+	return resourceTransitionLocks[(key ^ (key >> 6) ^ (key >> 16)) % 16];
+}
 
 void ni_dumpTables() {
 	ServerResource::dumpTables();
@@ -34,31 +56,58 @@ void pushStringInternal(std::string str)
 }
 
 std::string popStringInternal()
+{
+	return std::string(popStringView());
+}
+
+std::string_view popStringView()
 {
 	const char* ptr;
 	size_t length;
-	ni_popString(&ptr, &length);
-	std::string ret;
-	ret.assign(ptr, length);
-	return ret;
+	ni_popStringView(&ptr, &length);
+	return std::string_view(ptr, length);
+}
+
+StringArg popStringArg()
+{
+	const char* ptr;
+	size_t length;
+	auto id = ni_popStringViewInterned(&ptr, &length);
+	return { std::string_view(ptr, length), id };
+}
+
+void pushBoolArrayInternal(const std::vector<bool>& values)
+{
+	// (vector<bool> doesn't expose its words, so a bit at a time - but straight into the stack's own)
+	auto words = ni_pushBitArrayInPlace(values.size());
+	for (size_t w = 0; w * 64 < values.size(); w++) {
+		uint64_t word = 0;
+		for (size_t i = w * 64, b = 0; i < values.size() && b < 64; i++, b++) {
+			word |= (uint64_t)values[i] << b;
+		}
+		words[w] = word;
+	}
 }
 
-void pushBoolArrayInternal(std::vector<bool> values)
+void pushBoolArrayInternal(std::span<const bool> values)
 {
-	auto unpacked = new bool[values.size()];
-	std::copy(values.begin(), values.end(), unpacked);
-	ni_pushBoolArray(unpacked, values.size());
-	delete[] unpacked;
+	ni_packBits(values.data(), values.size(), ni_pushBitArrayInPlace(values.size()));
 }
 
 std::vector<bool> popBoolArrayInternal()
 {
-	bool* values;
+	auto view = popBoolArrayView();
+	std::vector<bool> ret(view.size());
+	view.forEachSet([&](size_t i) { ret[i] = true; });
+	return ret;
+}
+
+BitArrayView popBoolArrayView()
+{
+	const uint64_t* words;
 	size_t count;
-	ni_popBoolArray(&values, &count);
-	std::vector<bool> result;
-	result.assign(values, values + count);
-	return result;
+	ni_popBitArrayView(&words, &count);
+	return BitArrayView(words, count);
 }
 
 // INT8 =====
@@ -70,14 +119,16 @@ void pushInt8ArrayInternal(std::vector<int8_t> values)
 
 std::vector<int8_t> popInt8ArrayInternal()
 {
-	std::vector<int8_t> ret;
-	int8_t* values;
+	auto view = popInt8ArrayView();
+	return std::vector<int8_t>(view.begin(), view.end());
+}
+
+std::span<const int8_t> popInt8ArrayView()
+{
+	const int8_t* values;
 	size_t count;
-	ni_popInt8Array(&values, &count);
-	if (count > 0) {
-		ret.assign(values, values + count);
-	}
-	return ret;
+	ni_popInt8ArrayView(&values, &count);
+	return std::span<const int8_t>(values, count);
 }
 
 void pushUInt8ArrayInternal(std::vector<uint8_t> values)
@@ -86,14 +137,16 @@ void pushUInt8ArrayInternal(std::vector<uint8_t> values)
 }
 
 std::vector<uint8_t> popUInt8ArrayInternal() {
-	std::vector<uint8_t> ret;
-	uint8_t* values;
+	auto view = popUInt8ArrayView();
+	return std::vector<uint8_t>(view.begin(), view.end());
+}
+
+std::span<const uint8_t> popUInt8ArrayView()
+{
+	const uint8_t* values;
 	size_t count;
-	ni_popUInt8Array(&values, &count);
-	if (count > 0) {
-		ret.assign(values, values + count);
-	}
-	return ret;
+	ni_popUInt8ArrayView(&values, &count);
+	return std::span<const uint8_t>(values, count);
 }
 
 // INT16 =====
@@ -105,14 +158,16 @@ void pushInt16ArrayInternal(std::vector<int16_t> values)
 
 std::vector<int16_t> popInt16ArrayInternal()
 {
-	std::vector<int16_t> ret;
-	int16_t* values;
+	auto view = popInt16ArrayView();
+	return std::vector<int16_t>(view.begin(), view.end());
+}
+
+std::span<const int16_t> popInt16ArrayView()
+{
+	const int16_t* values;
 	size_t count;
-	ni_popInt16Array(&values, &count);
-	if (count > 0) {
-		ret.assign(values, values + count);
-	}
-	return ret;
+	ni_popInt16ArrayView(&values, &count);
+	return std::span<const int16_t>(values, count);
 }
 
 void pushUInt16ArrayInternal(std::vector<uint16_t> values)
@@ -121,14 +176,16 @@ void pushUInt16ArrayInternal(std::vector<uint16_t> values)
 }
 
 std::vector<uint16_t> popUInt16ArrayInternal() {
-	std::vector<uint16_t> ret;
-	uint16_t* values;
+	auto view = popUInt16ArrayView();
+	return std::vector<uint16_t>(view.begin(), view.end());
+}
+
+std::span<const uint16_t> popUInt16ArrayView()
+{
+	const uint16_t* values;
 	size_t count;
-	ni_popUInt16Array(&values, &count);
-	if (count > 0) {
-		ret.assign(values, values + count);
-	}
-	return ret;
+	ni_popUInt16ArrayView(&values, &count);
+	return std::span<const uint16_t>(values, count);
 }
 
 // INT32 =====
@@ -140,14 +197,16 @@ void pushInt32ArrayInternal(std::vector<int32_t> values)
 
 std::vector<int32_t> popInt32ArrayInternal()
 {
-	std::vector<int32_t> ret;
-	int32_t* values;
+	auto view = popInt32ArrayView();
+	return std::vector<int32_t>(view.begin(), view.end());
+}
+
+std::span<const int32_t> popInt32ArrayView()
+{
+	const int32_t* values;
 	size_t count;
-	ni_popInt32Array(&values, &count);
-	if (count > 0) {
-		ret.assign(values, values + count);
-	}
-	return ret;
+	ni_popInt32ArrayView(&values, &count);
+	return std::span<const int32_t>(values, count);
 }
 
 void pushUInt32ArrayInternal(std::vector<uint32_t> values)
@@ -156,14 +215,16 @@ void pushUInt32ArrayInternal(std::vector<uint32_t> values)
 }
 
 std::vector<uint32_t> popUInt32ArrayInternal() {
-	std::vector<uint32_t> ret;
-	uint32_t* values;
+	auto view = popUInt32ArrayView();
+	return std::vector<uint32_t>(view.begin(), view.end());
+}
+
+std::span<const uint32_t> popUInt32ArrayView()
+{
+	const uint32_t* values;
 	size_t count;
-	ni_popUInt32Array(&values, &count);
-	if (count > 0) {
-		ret.assign(values, values + count);
-	}
-	return ret;
+	ni_popUInt32ArrayView(&values, &count);
+	return std::span<const uint32_t>(values, count);
 }
 
 // INT64 =====
@@ -175,14 +236,16 @@ void pushInt64ArrayInternal(std::vector<int64_t> values)
 
 std::vector<int64_t> popInt64ArrayInternal()
 {
-	std::vector<int64_t> ret;
-	int64_t* values;
+	auto view = popInt64ArrayView();
+	return std::vector<int64_t>(view.begin(), view.end());
+}
+
+std::span<const int64_t> popInt64ArrayView()
+{
+	const int64_t* values;
 	size_t count;
-	ni_popInt64Array(&values, &count);
-	if (count > 0) {
-		ret.assign(values, values + count);
-	}
-	return ret;
+	ni_popInt64ArrayView(&values, &count);
+	return std::span<const int64_t>(values, count);
 }
 
 void pushUInt64ArrayInternal(std::vector<uint64_t> values)
@@ -191,47 +254,54 @@ void pushUInt64ArrayInternal(std::vector<uint64_t> values)
 }
 
 std::vector<uint64_t> popUInt64ArrayInternal() {
-	std::vector<uint64_t> ret;
-	uint64_t* values;
+	auto view = popUInt64ArrayView();
+	return std::vector<uint64_t>(view.begin(), view.end());
+}
+
+std::span<const uint64_t> popUInt64ArrayView()
+{
+	const uint64_t* values;
 	size_t count;
-	ni_popUInt64Array(&values, &count);
-	if (count > 0) {
-		ret.assign(values, values + count);
-	}
-	return ret;
+	ni_popUInt64ArrayView(&values, &count);
+	return std::span<const uint64_t>(values, count);
 }
 
 // end ints =====
 
 void pushStringArrayInternal(std::vector<std::string> values)
 {
-	auto count = values.size();
-	auto ptrs = new const char*[count];
-	auto lengths = new size_t[count];
-	for (auto i = 0; i < count; i++) {
-		ptrs[i] = values[i].data();
-		lengths[i] = values[i].size();
+	size_t total = 0;
+	for (auto& str : values) {
+		total += str.size();
+	}
+	uint64_t* offsets;
+	auto bytes = ni_pushStringArrayBlobInPlace(values.size(), total, &offsets);
+	for (size_t i = 0; i < values.size(); i++) {
+		memcpy(bytes + offsets[i], values[i].data(), values[i].size());
+		offsets[i + 1] = offsets[i] + values[i].size();
 	}
-	ni_pushStringArray(ptrs, lengths, count);
-	delete[] ptrs;
-	delete[] lengths;
 }
 
 std::vector<std::string> popStringArrayInternal()
 {
-	const char** strs;
-	size_t* lengths;
-	size_t count;
-	ni_popStringArray(&strs, &lengths, &count);
+	auto view = popStringArrayView();
 	std::vector<std::string> ret;
-	for (auto i = 0; i < count; i++) {
-		std::string str;
-		str.assign(strs[i], strs[i] + lengths[i]);
-		ret.push_back(str);
+	ret.reserve(view.size());
+	for (auto str : view) {
+		ret.emplace_back(str);
 	}
 	return ret;
 }
 
+StringArrayView popStringArrayView()
+{
+	const char* bytes;
+	const uint64_t* offsets;
+	size_t count;
+	ni_popStringArrayBlob(&bytes, &offsets, &count);
+	return StringArrayView(bytes, offsets, count);
+}
+
 void pushSizeTArrayInternal(std::vector<size_t> values)
 {
 	ni_pushSizeTArray(values.data(), values.size());
@@ -239,12 +309,16 @@ void pushSizeTArrayInternal(std::vector<size_t> values)
 
 std::vector<size_t> popSizeTArrayInternal()
 {
-	std::vector<size_t> ret;
-	size_t* values;
+	auto view = popSizeTArrayView();
+	return std::vector<size_t>(view.begin(), view.end());
+}
+
+std::span<const size_t> popSizeTArrayView()
+{
+	const size_t* values;
 	size_t count;
-	ni_popSizeTArray(&values, &count);
-	ret.assign(values, values + count);
-	return ret;
+	ni_popSizeTArrayView(&values, &count);
+	return std::span<const size_t>(values, count);
 }
 
 void pushFloatArrayInternal(std::vector<float> values)
@@ -254,12 +328,16 @@ void pushFloatArrayInternal(std::vector<float> values)
 
 std::vector<float> popFloatArrayInternal()
 {
-	std::vector<float> ret;
-	float* values;
+	auto view = popFloatArrayView();
+	return std::vector<float>(view.begin(), view.end());
+}
+
+std::span<const float> popFloatArrayView()
+{
+	const float* values;
 	size_t count;
-	ni_popFloatArray(&values, &count);
-	ret.assign(values, values + count);
-	return ret;
+	ni_popFloatArrayView(&values, &count);
+	return std::span<const float>(values, count);
 }
 
 void pushDoubleArrayInternal(std::vector<double> values)
@@ -269,24 +347,28 @@ void pushDoubleArrayInternal(std::vector<double> values)
 
 std::vector<double> popDoubleArrayInternal()
 {
-	std::vector<double> ret;
-	double* values;
+	auto view = popDoubleArrayView();
+	return std::vector<double>(view.begin(), view.end());
+}
+
+std::span<const double> popDoubleArrayView()
+{
+	const double* values;
 	size_t count;
-	ni_popDoubleArray(&values, &count);
-	ret.assign(values, values + count);
-	return ret;
+	ni_popDoubleArrayView(&values, &count);
+	return std::span<const double>(values, count);
 }
 
 std::shared_ptr<ServerResource> ServerResource::getResourceById(int id) {
-	return serverResources[id];
+	return serverResources.get(id);
 }
 
 void ServerResource::dumpTables()
 {
 	printf("== C++ server resources:\n");
-	for (auto i = serverResources.begin(); i != serverResources.end(); i++) {
-		printf(" - id %d (%s): refcount %d\n",  i->first, i->second->kind, i->second->refCount);
-	}
+	serverResources.forEach([](int id, const std::shared_ptr<ServerResource>& res) {
+		printf(" - id %d (%s): refcount %d\n", id, res->kind, res->refCount.load());
+	});
 }
 
 ServerResource::~ServerResource()
@@ -296,36 +378,56 @@ ServerResource::~ServerResource()
 
 void ServerResource::release()
 {
-	refCount -= 1;
-	if (refCount == 0) {
-		printf("C++: releasing server obj %d\n", id); // only removes from table, still might exist on this side somewhere
-		serverResources.erase(id);
+	// not the last ref: nothing to take out of the table
+	auto resourceId = id; // (read while the ref's still held, see id)
+	auto count = refCount.load();
+	while (count > 1) {
+		if (refCount.compare_exchange_weak(count, count - 1)) {
+			NI_TRACE(ni_TraceDebug, ni_TraceServerResourceDeref, resourceId, count - 1);
+			return;
+		}
+	}
+	std::lock_guard<std::mutex> guard(resourceTransitionLock(this));
+	auto remaining = --refCount; // (a push may have got in since, and then this isn't the last one after all)
+	if (remaining == 0) {
+		NI_TRACE(ni_TraceDebug, ni_TraceServerResourceReleased, id, 0); // only removes from table, still might exist on this side somewhere
+		serverResources.remove(id);
 	}
 	else {
-		printf("C++: releaseServerInstID(%d) - refCount still %d\n", id, refCount);
+		NI_TRACE(ni_TraceDebug, ni_TraceServerResourceDeref, id, remaining);
 	}
 }
 
-void ServerResource::push(std::shared_ptr<Pushable> outer, bool isReturn) {
+void ServerResource::push(std::shared_ptr<Pushable> outer, [[maybe_unused]] bool isReturn) {
 	// isReturn not used for server stuff, that's just to help out with the safe area / protecting client objects
-	if (id == -1) { // unset as of yet
-		id = nextServerObjId++;
-		refCount = 1;
-		serverResources[id] = std::dynamic_pointer_cast<ServerResource>(outer);
-		//printf("ServerObject::soPush()ed into serverObjects[%d]\n", id);
+	// already in the table: add a ref, which never brings it back from 0 (that's the table entry's to do, below)
+	// this assumes that it's going across a boundary which will be balanced by an eventual deref. is that always true?
+	auto count = refCount.load();
+	while (count > 0) {
+		if (refCount.compare_exchange_weak(count, count + 1)) {
+			NI_TRACE(ni_TraceDebug, ni_TraceServerResourceRefBumped, id, count + 1);
+			nativePush();
+			return;
+		}
 	}
-	else {
-		// add ref to existing
-		refCount++; // this assumes that it's going across a boundary which will be balanced by an eventual deref. is that always true?
-		printf("bumped server ID %d refcount to %d\n", id, refCount);
+	{
+		// never pushed, or released since (a fresh id then - the old one stays stale)
+		std::lock_guard<std::mutex> guard(resourceTransitionLock(this));
+		if (refCount.load() == 0) {
+			id = serverResources.add(std::static_pointer_cast<ServerResource>(outer));
+			refCount.store(1);
+		}
+		else {
+			auto count = ++refCount;
+			NI_TRACE(ni_TraceDebug, ni_TraceServerResourceRefBumped, id, count);
+		}
 	}
 	nativePush();
 }
 
 std::shared_ptr<ServerObject> ServerObject::getByID(int id)
 {
-	auto res = ServerResource::getResourceById(id);
-	return std::dynamic_pointer_cast<ServerObject>(res);
+	return ServerResource::getTypedById<ServerObject>(id);
 }
 
 void ServerObject::nativePush()
@@ -335,38 +437,58 @@ void ServerObject::nativePush()
 
 void ni_releaseServerResource(int id)
 {
-	ServerResource::getResourceById(id)->release();
+	auto res = ServerResource::getResourceById(id);
+	if (!res) {
+		NI_TRACE(ni_TraceWarn, ni_TraceServerResourceStaleRelease, id, 0);
+		return;
+	}
+	res->release();
+}
+
+// same as above for a whole run of ids, eg from a client finalizer sweep - one crossing instead of one per resource
+void ni_releaseServerResources(const int* ids, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		ni_releaseServerResource(ids[i]);
+	}
 }
 
 // while server objects are kept alive ("checked out") via the serverObjects/refcount,
 // any client objects that currently only exist on this side, need to be protected during returns to keep their shared_ptr from going away
 // and releasing them prematurely (dropping remote refcount to 0)
-// the other side will call clearServerSafetyArea when it's gotten the return value
+// it's cleared when the client's next invocation on this thread begins (by then it's popped the return values), see ni_serverSafetyAreaInUse
 // each side has its own safety area, to protect the other's resources during function return handoff
-static std::vector<std::shared_ptr<ClientResource>> safeArea;
+// (per thread, same as the value stack the return values travel on)
+static thread_local std::vector<std::shared_ptr<ClientResource>> safeArea;
 
 // clear server resources from safety area (protects values being returned with no other shared_ptrs existing on this side)
 void ni_clearServerSafetyArea() {
-	printf("C++ before safety clear =====\n");
-	safeArea.clear();
-	printf("C++ after safety clear!! ====\n");
+	NI_TRACE(ni_TraceDebug, ni_TraceServerSafetyAreaCleared, (int32_t)safeArea.size(), 0);
+	// released proxies can call out to the client, which can call back in and return more - so the area is emptied before anything is destroyed
+	std::vector<std::shared_ptr<ClientResource>> expiring;
+	expiring.swap(safeArea);
+	expiring.clear();
+	if (safeArea.empty()) {
+		safeArea.swap(expiring); // keeping the capacity
+	}
 }
 
 void ClientResource::push(std::shared_ptr<Pushable> outer, bool isReturn) {
 	if (isReturn) {
 		// for return values, to keep them alive until other side has taken them
-		printf("C++ ClientObject %d safepush\n", id);
+		NI_TRACE(ni_TraceDebug, ni_TraceClientResourceSafePush, id, 0);
 		// preserve for return values etc
-		auto clientOuter = std::dynamic_pointer_cast<ClientResource>(outer);
-		safeArea.push_back(clientOuter);
+		if (safeArea.empty()) {
+			::ni_serverSafetyAreaInUse();
+		}
+		safeArea.push_back(std::static_pointer_cast<ClientResource>(outer)); // (clearing keeps the capacity, so no allocation after the first few)
 	}
 	nativePush();
 }
 
 ClientResource::~ClientResource() {
-	printf("C++ ClientResource::dtor (id %d), remote releasing\n", id);
-	fflush(stdout);
-	::ni_clientResourceRelease(id);
+	NI_TRACE(ni_TraceDebug, ni_TraceClientResourceReleased, id, 0);
+	::ni_releaseClientResource(id); // queued, and handed over in batches if the client supports it
 }
 
 void ClientObject::nativePush()
@@ -403,35 +525,43 @@ void ClientFuncVal::nativePush()
 
 void ServerFuncVal::nativePush()
 {
+	if (uniqueKey != 0) {
+		// the id only exists from the first push on, so this is where it goes in the reverse map
+		auto& shard = funcValShard(uniqueKey);
+		std::lock_guard<std::mutex> guard(shard.lock);
+		shard.ids[uniqueKey] = id;
+	}
 	ni_pushServerFunc(id);
 }
 
 std::shared_ptr<ServerFuncVal> ServerFuncVal::getById(int id)
 {
-	return std::dynamic_pointer_cast<ServerFuncVal>(ServerResource::getResourceById(id));
+	return ServerResource::getTypedById<ServerFuncVal>(id);
 }
 
 std::shared_ptr<ServerFuncVal> ServerFuncVal::create(std::function<void()> wrapper, size_t key)
 {
 	if (key != 0) {
-		auto found = reverseServerFuncVals.find(key);
-		if (found != reverseServerFuncVals.end()) {
-			// reuse existing
-			auto id = found->second;
-			return ServerFuncVal::getById(id);
+		auto& shard = funcValShard(key);
+		std::lock_guard<std::mutex> guard(shard.lock);
+		auto found = shard.ids.find(key);
+		if (found != shard.ids.end()) {
+			// reuse existing (if it's still around - a stale id just comes back null)
+			if (auto existing = ServerFuncVal::getById(found->second)) {
+				return existing;
+			}
+			shard.ids.erase(found);
 		}
 	}
 	// either no key provided, or not found: create anew
-	auto funcVal = new ServerFuncVal(wrapper, key);
-	if (key != 0) {
-		// no point stuffing keyless things in the reverse map, all on top of each other!
-		reverseServerFuncVals[key] = funcVal->id;
-	}
-	return std::shared_ptr<ServerFuncVal>(funcVal);
+	// (keyless ones never go in the reverse map, no point stuffing them all on top of each other)
+	return std::shared_ptr<ServerFuncVal>(new ServerFuncVal(wrapper, key));
 }
 
 void ServerFuncVal::releaseExtra()
 {
-	printf("server releaseFuncVal(%d): refcount 0, releasing\n", id);
-	reverseServerFuncVals.erase(uniqueKey);
+	NI_TRACE(ni_TraceDebug, ni_TraceServerFuncValReleased, id, 0);
+	auto& shard = funcValShard(uniqueKey);
+	std::lock_guard<std::mutex> guard(shard.lock);
+	shard.ids.erase(uniqueKey);
 }
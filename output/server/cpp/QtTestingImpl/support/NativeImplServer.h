@@ -1,10 +1,15 @@
 #pragma once
 
 #include "CoreStuff.h"
+#include "BufferPool.h"
 
+#include <atomic>
+#include <bit>
 #include <memory>
 #include <functional>
 #include <vector>
+#include <span>
+#include <string_view>
 
 class Pushable {
 public:
@@ -13,16 +18,29 @@ public:
 
 class ServerResource : public Pushable {
 private:
-	int refCount = 0;
+	std::atomic<int> refCount = 0;
 	const char* kind = "unknown";
+	const void* typeKey; // address of the concrete class's typeKey member, for typed lookups without RTTI
 protected:
+	// -1 until first pushed. only ever set while the refcount is 0 (under its transition lock, see push), and only read by
+	// whoever holds a ref - so plain is fine
 	int id = -1;
-	ServerResource(const char* kind) : kind(kind) {}
+	ServerResource(const char* kind, const void* typeKey) : kind(kind), typeKey(typeKey) {}
 public:
 	void release();
 	void push(std::shared_ptr<Pushable> outer, bool isReturn) override;
 	~ServerResource();
+	// null for ids that are unknown or stale (already released)
 	static std::shared_ptr<ServerResource> getResourceById(int id);
+	// as above, and also null if the resource isn't a T (T being the class that passed &T::typeKey to the constructor)
+	template <typename T>
+	static std::shared_ptr<T> getTypedById(int id) {
+		auto res = getResourceById(id);
+		if (res && res->typeKey == &T::typeKey) {
+			return std::static_pointer_cast<T>(std::move(res));
+		}
+		return nullptr;
+	}
 	static void dumpTables();
 protected:
 	virtual void nativePush() = 0; // implemented specifically for: objects, buffers, etc
@@ -44,7 +62,8 @@ public:
 
 class ServerObject : public ServerResource {
 public:
-	ServerObject() : ServerResource("object") {}
+	static inline const char typeKey = 0;
+	ServerObject() : ServerResource("object", &typeKey) {}
 	static std::shared_ptr<ServerObject> getByID(int id);
 protected:
 	void nativePush() override;
@@ -71,11 +90,12 @@ protected:
 class ServerFuncVal : public ServerResource {
 private:
 	ServerFuncVal(std::function<void()> wrapper, size_t uniqueKey)
-		: ServerResource("funcval"),
+		: ServerResource("funcval", &typeKey),
 		wrapper(wrapper),
 		uniqueKey(uniqueKey) {}
 	size_t uniqueKey;
 public:
+	static inline const char typeKey = 0;
 	std::function<void()> wrapper;
 	void nativePush() override;
 	static std::shared_ptr<ServerFuncVal> getById(int id);
@@ -87,7 +107,10 @@ protected:
 template <typename T>
 class NativeBuffer {
 public:
+	// the elements from the first through the last, *length of them - every one of them the buffer's only when it's contiguous
 	virtual T* getSpan(size_t* length) = 0;
+	// the shape and strides to go by otherwise
+	virtual const ni_BufferDescriptor& getDescriptor() = 0;
 };
 
 template <typename T>
@@ -98,9 +121,12 @@ public:
 	ClientBuffer(int id, ni_BufferDescriptor& descriptor)
 		: ClientResource(id), descriptor(descriptor) {}
 	T* getSpan(size_t* length) override {
-		*length = descriptor.totalCount;
+		*length = descriptor.totalSize / sizeof(T);
 		return (T*)descriptor.start;
 	}
+	const ni_BufferDescriptor& getDescriptor() override {
+		return descriptor;
+	}
 	void nativePush() override {
 		ni_pushBuffer(id, true, &descriptor);
 	}
@@ -109,42 +135,87 @@ public:
 template <typename T>
 class ServerBuffer : public ServerResource, public NativeBuffer<T> {
 private:
-	void* block;
-	int elementSize;
-	size_t totalCount;
-	size_t totalSize;
+	BufferPool::Block block; // (none for a view, the memory is its root's)
+	BufferPool::Reuse reuse = BufferPool::Reuse::Pooled;
+	std::shared_ptr<ServerBuffer<T>> root; // what a view looks into, kept alive by it
+	ni_BufferDescriptor descriptor;
+
+	ServerBuffer(std::shared_ptr<ServerBuffer<T>> root, const ni_BufferDescriptor& view)
+		: ServerResource("buffer", &typeKey),
+		root(std::move(root)),
+		descriptor(view) {}
+	static std::shared_ptr<ServerBuffer<T>> makeView(const std::shared_ptr<ServerBuffer<T>>& buffer, const ni_BufferDescriptor& view) {
+		return std::shared_ptr<ServerBuffer<T>>(new ServerBuffer<T>(buffer->root ? buffer->root : buffer, view));
+	}
 protected:
 	void nativePush() override {
-		ni_BufferDescriptor desc;
-		desc.start = block;
-		desc.elementSize = elementSize;
-		desc.totalCount = totalCount;
-		desc.totalSize = totalSize;
-		ni_pushBuffer(id, false, &desc);
-	}
-	void releaseExtra() override {
-		free(block);
-		block = nullptr;
+		ni_pushBuffer(id, false, &descriptor);
 	}
 public:
-	ServerBuffer(std::vector<int> dims)
-		: ServerResource("buffer")
+	static inline const char typeKey = 0;
+	// per-frame buffers (images, samples) of a repeating shape should keep the default Pooled, so that each frame's reuses the last one's memory
+	ServerBuffer(std::vector<int> dims, BufferPool::Reuse reuse = BufferPool::Reuse::Pooled)
+		: ServerResource("buffer", &typeKey),
+		reuse(reuse)
 	{
-		elementSize = sizeof(T);
-		totalCount = 1;
-		for (auto i = dims.begin(); i != dims.end(); i++) {
-			totalCount *= *i;
+		// (past the maximum rank, the innermost dimensions are folded into one)
+		uint64_t shape[ni_BufferMaxRank];
+		int rank = 0;
+		for (size_t i = 0; i < dims.size(); i++) {
+			if (rank < ni_BufferMaxRank) {
+				shape[rank++] = (uint64_t)dims[i];
+			}
+			else {
+				shape[rank - 1] *= (uint64_t)dims[i];
+			}
+		}
+		if (rank == 0) {
+			shape[rank++] = 1;
 		}
-		totalSize = totalCount * elementSize;
-		block = malloc(totalSize);
+		ni_describeBuffer(&descriptor, nullptr, sizeof(T), rank, shape);
+		block = BufferPool::acquire(descriptor.totalSize);
+		descriptor.start = block.start;
+	}
+	// (here rather than in releaseExtra, which ~ServerResource can only ever call its own no-op version of)
+	~ServerBuffer() {
+		BufferPool::release(block, reuse);
 	}
 	T* getSpan(size_t* length) override {
-		*length = totalCount;
-		return (T*)block;
+		*length = descriptor.totalSize / sizeof(T);
+		return (T*)descriptor.start;
 	}
+	const ni_BufferDescriptor& getDescriptor() override {
+		return descriptor;
+	}
+
+	// zero-copy views, sharing the memory (and the lifetime) of the buffer they're taken from - pushed as buffers in their own right
+	// null if out of bounds, see ni_bufferRegion/ni_bufferSlice
+	static std::shared_ptr<ServerBuffer<T>> region(const std::shared_ptr<ServerBuffer<T>>& buffer, std::vector<uint64_t> begin, std::vector<uint64_t> extent) {
+		ni_BufferDescriptor view;
+		if (begin.size() != (size_t)buffer->descriptor.rank || extent.size() != begin.size()
+			|| !ni_bufferRegion(&buffer->descriptor, begin.data(), extent.data(), &view))
+		{
+			return nullptr;
+		}
+		return makeView(buffer, view);
+	}
+	// rows [first, first + count) of dimension 0, eg a band of an image's scanlines
+	static std::shared_ptr<ServerBuffer<T>> rows(const std::shared_ptr<ServerBuffer<T>>& buffer, uint64_t first, uint64_t count) {
+		std::vector<uint64_t> begin(buffer->descriptor.rank, 0), extent(buffer->descriptor.shape, buffer->descriptor.shape + buffer->descriptor.rank);
+		begin[0] = first;
+		extent[0] = count;
+		return region(buffer, begin, extent);
+	}
+	static std::shared_ptr<ServerBuffer<T>> slice(const std::shared_ptr<ServerBuffer<T>>& buffer, int dim, uint64_t index) {
+		ni_BufferDescriptor view;
+		if (!ni_bufferSlice(&buffer->descriptor, dim, index, &view)) {
+			return nullptr;
+		}
+		return makeView(buffer, view);
+	}
+
 	static std::shared_ptr<ServerBuffer<T>> getByID(int id) {
-		auto res = ServerResource::getResourceById(id);
-		return std::dynamic_pointer_cast<ServerBuffer<T>>(res);
+		return ServerResource::getTypedById<ServerBuffer<T>>(id);
 	}
 };
 
@@ -157,6 +228,7 @@ extern "C" {
 	void ni_execServerFunc(int id);
 	ni_ExceptionRef ni_execServerFuncWithExceptions(int id);
 	void ni_releaseServerResource(int id);
+	void ni_releaseServerResources(const int* ids, size_t count);
 	void ni_clearServerSafetyArea();
 }
 
@@ -165,7 +237,9 @@ void pushServerFuncVal(std::function<void()> wrapper, size_t key);
 void pushStringInternal(std::string str);
 std::string popStringInternal();
 
-void pushBoolArrayInternal(std::vector<bool> values);
+// bool arrays cross bit-packed (see ni_pushBitArray)
+void pushBoolArrayInternal(const std::vector<bool>& values);
+void pushBoolArrayInternal(std::span<const bool> values);
 std::vector<bool> popBoolArrayInternal();
 
 void pushInt8ArrayInternal(std::vector<int8_t> values);
@@ -198,8 +272,112 @@ std::vector<float> popFloatArrayInternal();
 void pushDoubleArrayInternal(std::vector<double> values);
 std::vector<double> popDoubleArrayInternal();
 
+// (written straight into the stack's blob, see ni_pushStringArrayBlobInPlace)
 void pushStringArrayInternal(std::vector<std::string> values);
 std::vector<std::string> popStringArrayInternal();
 
 void pushSizeTArrayInternal(std::vector<size_t> values);
 std::vector<size_t> popSizeTArrayInternal();
+
+// a string array as the core keeps it (one blob plus offsets, see ni_popStringArrayBlob), its strings as string_views
+class StringArrayView {
+	const char* bytes = nullptr;
+	const uint64_t* offsets = nullptr;
+	size_t count = 0;
+public:
+	StringArrayView() = default;
+	StringArrayView(const char* bytes, const uint64_t* offsets, size_t count) : bytes(bytes), offsets(offsets), count(count) {}
+
+	size_t size() const { return count; }
+	bool empty() const { return count == 0; }
+	std::string_view operator[](size_t i) const {
+		return std::string_view(bytes + offsets[i], (size_t)(offsets[i + 1] - offsets[i]));
+	}
+
+	class iterator {
+		const StringArrayView* view;
+		size_t i;
+	public:
+		iterator(const StringArrayView* view, size_t i) : view(view), i(i) {}
+		std::string_view operator*() const { return (*view)[i]; }
+		iterator& operator++() { i++; return *this; }
+		bool operator==(const iterator& other) const { return i == other.i; }
+		bool operator!=(const iterator& other) const { return i != other.i; }
+	};
+	iterator begin() const { return iterator(this, 0); }
+	iterator end() const { return iterator(this, count); }
+};
+
+// a bool array as it crosses: count bits packed into uint64 words, low bit first, the last word's unused bits clear
+// (so the whole-word operations - counting, finding the set ones - can go a word at a time)
+class BitArrayView {
+	const uint64_t* words = nullptr;
+	size_t count = 0;
+public:
+	BitArrayView() = default;
+	BitArrayView(const uint64_t* words, size_t count) : words(words), count(count) {}
+
+	size_t size() const { return count; }
+	bool empty() const { return count == 0; }
+	bool operator[](size_t i) const { return (words[i / 64] >> (i % 64)) & 1; }
+	const uint64_t* data() const { return words; }
+	size_t wordCount() const { return (count + 63) / 64; }
+
+	// how many are set
+	size_t countSet() const {
+		size_t total = 0;
+		for (size_t w = 0, n = wordCount(); w < n; w++) {
+			total += (size_t)std::popcount(words[w]);
+		}
+		return total;
+	}
+	// calls f(index) for each set one, in order
+	template <typename F>
+	void forEachSet(F&& f) const {
+		for (size_t w = 0, n = wordCount(); w < n; w++) {
+			for (auto word = words[w]; word != 0; word &= word - 1) {
+				f(w * 64 + (size_t)std::countr_zero(word));
+			}
+		}
+	}
+	// one bool per byte, values having room for size() of them
+	void unpack(bool* values) const { ni_unpackBits(words, count, values); }
+
+	class iterator {
+		const BitArrayView* view;
+		size_t i;
+	public:
+		iterator(const BitArrayView* view, size_t i) : view(view), i(i) {}
+		bool operator*() const { return (*view)[i]; }
+		iterator& operator++() { i++; return *this; }
+		bool operator==(const iterator& other) const { return i == other.i; }
+		bool operator!=(const iterator& other) const { return i != other.i; }
+	};
+	iterator begin() const { return iterator(this, 0); }
+	iterator end() const { return iterator(this, count); }
+};
+
+// borrowed pops (no copying) for wrappers whose implementation only reads the data:
+// these point into the core's value stack and are only good until the current invocation returns, so copy anything you need to keep
+std::string_view popStringView();
+StringArrayView popStringArrayView();
+BitArrayView popBoolArrayView();
+std::span<const int8_t> popInt8ArrayView();
+std::span<const uint8_t> popUInt8ArrayView();
+std::span<const int16_t> popInt16ArrayView();
+std::span<const uint16_t> popUInt16ArrayView();
+std::span<const int32_t> popInt32ArrayView();
+std::span<const uint32_t> popUInt32ArrayView();
+std::span<const int64_t> popInt64ArrayView();
+std::span<const uint64_t> popUInt64ArrayView();
+std::span<const float> popFloatArrayView();
+std::span<const double> popDoubleArrayView();
+std::span<const size_t> popSizeTArrayView();
+
+// a borrowed string (same lifetime as popStringView's) plus the intern id it was pushed by, 0 if it wasn't (ni_internString) -
+// for implementations that hand the string straight to Qt, toQString (util/convert.h) converts each interned one only once
+struct StringArg {
+	std::string_view utf8;
+	int internId;
+};
+StringArg popStringArg();
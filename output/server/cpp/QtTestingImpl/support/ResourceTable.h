@@ -0,0 +1,168 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+// slot map for server resources: ids pack (generation, slot index), so a lookup is a bounds check plus a generation compare,
+// and an id whose slot has since been freed (and maybe reused) resolves to null rather than to somebody else's resource
+// slots live in fixed-size pages, so growing the table never moves existing entries
+// safe to use from any thread: the slots are split across shards, each with its own lock,
+// the low bits of the slot index say which shard, and each thread adds to "its" shard so that workers don't contend
+template <typename T>
+class ResourceTable {
+public:
+	static constexpr int IndexBits = 24; // up to 16M live resources
+	static constexpr uint32_t IndexMask = (1u << IndexBits) - 1;
+	static constexpr uint32_t MaxGeneration = 127; // 7 bits: ids stay positive, and never 0 (which means null on the wire)
+	static constexpr int ShardBits = 4;
+	static constexpr uint32_t NumShards = 1u << ShardBits;
+private:
+	static constexpr uint32_t ShardMask = NumShards - 1;
+	static constexpr uint32_t MaxShardSlots = 1u << (IndexBits - ShardBits);
+	static constexpr uint32_t PageBits = 12;
+	static constexpr uint32_t PageSize = 1u << PageBits;
+	static constexpr uint32_t NoSlot = ~0u;
+
+	struct Slot {
+		std::shared_ptr<T> item;
+		uint32_t generation = 1;
+		uint32_t nextFree = NoSlot;
+	};
+	// slot numbers in here are local to the shard, index = (local << ShardBits) | shard
+	struct alignas(64) Shard {
+		std::mutex lock;
+		std::vector<std::unique_ptr<Slot[]>> pages;
+		uint32_t numSlots = 0;
+		// freed slots are reused oldest-first, so any one slot's generation (and thus stale id detection) turns over as slowly as possible
+		uint32_t freeHead = NoSlot;
+		uint32_t freeTail = NoSlot;
+		size_t liveCount = 0;
+
+		inline Slot& slotAt(uint32_t local) {
+			return pages[local >> PageBits][local & (PageSize - 1)];
+		}
+	};
+	Shard shards[NumShards];
+	std::atomic<uint32_t> nextShard = 0;
+
+	static inline int makeId(uint32_t generation, uint32_t local, uint32_t shard) {
+		return (int)((generation << IndexBits) | (local << ShardBits) | shard);
+	}
+	// call with the shard locked
+	static inline Slot* lookup(Shard& shard, int id) {
+		auto local = ((uint32_t)id & IndexMask) >> ShardBits;
+		if (id <= 0 || local >= shard.numSlots) {
+			return nullptr;
+		}
+		auto& slot = shard.slotAt(local);
+		return (slot.generation == ((uint32_t)id >> IndexBits) && slot.item) ? &slot : nullptr;
+	}
+	inline Shard& shardOf(int id) {
+		return shards[(uint32_t)id & ShardMask];
+	}
+	// threads get shards round-robin on their first add, so concurrent adds land in different shards
+	inline uint32_t homeShard() {
+		thread_local uint32_t home = NoSlot;
+		if (home == NoSlot) {
+			home = nextShard.fetch_add(1, std::memory_order_relaxed) & ShardMask;
+		}
+		return home;
+	}
+
+public:
+	int add(std::shared_ptr<T> item) {
+		auto home = homeShard();
+		// a full home shard spills over into the next one
+		for (uint32_t i = 0; i < NumShards; i++) {
+			auto shardIndex = (home + i) & ShardMask;
+			auto& shard = shards[shardIndex];
+			std::lock_guard<std::mutex> guard(shard.lock);
+			uint32_t local;
+			if (shard.freeHead != NoSlot) {
+				local = shard.freeHead;
+				shard.freeHead = shard.slotAt(local).nextFree;
+				if (shard.freeHead == NoSlot) {
+					shard.freeTail = NoSlot;
+				}
+			}
+			else if (shard.numSlots < MaxShardSlots) {
+				if ((shard.numSlots & (PageSize - 1)) == 0) {
+					shard.pages.emplace_back(new Slot[PageSize]);
+				}
+				local = shard.numSlots++;
+			}
+			else {
+				continue;
+			}
+			auto& slot = shard.slotAt(local);
+			slot.item = std::move(item);
+			slot.nextFree = NoSlot;
+			shard.liveCount++;
+			return makeId(slot.generation, local, shardIndex);
+		}
+		throw std::length_error("ResourceTable: out of slots");
+	}
+
+	// null if the id was never handed out, or has been removed since
+	inline std::shared_ptr<T> get(int id) {
+		auto& shard = shardOf(id);
+		std::lock_guard<std::mutex> guard(shard.lock);
+		auto slot = lookup(shard, id);
+		return slot ? slot->item : nullptr;
+	}
+
+	// false for a stale/unknown id
+	bool remove(int id) {
+		std::shared_ptr<T> item;
+		{
+			auto& shard = shardOf(id);
+			std::lock_guard<std::mutex> guard(shard.lock);
+			auto slot = lookup(shard, id);
+			if (!slot) {
+				return false;
+			}
+			// moved out, so that the resource's destructor runs after the table is consistent again (and unlocked)
+			item = std::move(slot->item);
+			slot->generation = slot->generation % MaxGeneration + 1;
+			auto local = ((uint32_t)id & IndexMask) >> ShardBits;
+			if (shard.freeTail != NoSlot) {
+				shard.slotAt(shard.freeTail).nextFree = local;
+			}
+			else {
+				shard.freeHead = local;
+			}
+			shard.freeTail = local;
+			shard.liveCount--;
+		}
+		return true;
+	}
+
+	// a snapshot - other threads may be adding/removing meanwhile
+	size_t size() {
+		size_t total = 0;
+		for (auto& shard : shards) {
+			std::lock_guard<std::mutex> guard(shard.lock);
+			total += shard.liveCount;
+		}
+		return total;
+	}
+
+	// f(id, item) for every live entry, one shard locked at a time (so f mustn't add/remove)
+	template <typename F>
+	void forEach(F&& f) {
+		for (uint32_t s = 0; s < NumShards; s++) {
+			auto& shard = shards[s];
+			std::lock_guard<std::mutex> guard(shard.lock);
+			for (uint32_t i = 0; i < shard.numSlots; i++) {
+				auto& slot = shard.slotAt(i);
+				if (slot.item) {
+					f(makeId(slot.generation, i, s), slot.item);
+				}
+			}
+		}
+	}
+};
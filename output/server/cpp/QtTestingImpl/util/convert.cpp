@@ -1,2 +1,21 @@
 #include "convert.h"
 
+#include <optional>
+#include <vector>
+
+QString toQString(const StringArg& str) {
+    if (str.internId <= 0) {
+        return QString::fromUtf8(str.utf8.data(), (qsizetype)str.utf8.size());
+    }
+    // indexed by id, which only ever count up from 1. per thread so there's no locking,
+    // QString's reference counting being thread-safe is what makes handing out copies of these fine
+    thread_local std::vector<std::optional<QString>> converted;
+    if ((size_t)str.internId >= converted.size()) {
+        converted.resize((size_t)str.internId + 1);
+    }
+    auto& cached = converted[str.internId];
+    if (!cached) {
+        cached = QString::fromUtf8(str.utf8.data(), (qsizetype)str.utf8.size());
+    }
+    return *cached;
+}
@@ -12,14 +12,21 @@ using namespace Enums;
 
 #define STRUCT_CAST(b,a) *((b*)&a)
 
-inline QStringList toQStringList(const std::vector<std::string>& strings) {
+// any range of strings with data()/size() (std::vector<std::string>, StringArrayView ...)
+template <typename Strings>
+inline QStringList toQStringList(const Strings& strings) {
     QStringList ret;
-    for (auto & str : strings) {
-        ret.push_back(QString::fromStdString(str));
+    ret.reserve((qsizetype)strings.size());
+    for (auto && str : strings) {
+        ret.push_back(QString::fromUtf8(str.data(), (qsizetype)str.size()));
     }
     return ret;
 }
 
+// interned strings (StringArg::internId != 0) are converted the first time each thread sees them,
+// after that it's a copy of the cached QString (implicitly shared, so no conversion and no allocation)
+QString toQString(const StringArg& str);
+
 inline QSize toQSize(const Size& sz) {
     return {sz.width, sz.height };
 }